@@ -16,6 +16,13 @@ if(ASCENT_OPENMP_ENABLED)
     endif()
 endif()
 
+###############################################################################
+# Setup Threads (flow uses std::thread)
+###############################################################################
+if(NOT TARGET Threads::Threads)
+    find_dependency(Threads REQUIRED)
+endif()
+
 ###############################################################################
 # HIP related tpls will require targets from hip
 ###############################################################################
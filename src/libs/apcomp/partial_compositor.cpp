@@ -19,40 +19,30 @@
 namespace apcomp {
 namespace detail
 {
+//
+// Blend the partials of each pixel front to back. The partials of
+// segment i are partials[order[segments[i]]] ... partials[order[segments[i+1]-1]]
+//
 template<template <typename> class PartialType, typename FloatType>
-void BlendPartials(const int &total_segments,
-                   const int &total_partial_comps,
-                   std::vector<int> &pixel_work_ids,
+void BlendPartials(const std::vector<int> &segments,
+                   const std::vector<int> &order,
                    std::vector<PartialType<FloatType>> &partials,
-                   std::vector<PartialType<FloatType>> &output_partials,
-                   const int output_offset)
+                   std::vector<PartialType<FloatType>> &output_partials)
 {
-  //
-  // Perform the compositing and output the result in the output
-  //
+  const int total_segments = static_cast<int>(segments.size()) - 1;
 #ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
+  #pragma omp parallel for schedule(dynamic, 256)
 #endif
   for(int i = 0; i < total_segments; ++i)
   {
-    int current_index = pixel_work_ids[i];
-    PartialType<FloatType> result = partials[current_index];
-    ++current_index;
-    PartialType<FloatType> next = partials[current_index];
-    // TODO: we could just count the amount of work and make this a for loop(vectorize??)
-    while(result.m_pixel_id == next.m_pixel_id)
+    const int segment_end = segments[i + 1];
+    PartialType<FloatType> result = partials[order[segments[i]]];
+    // blending past 1.0 alpha is no op.
+    for(int p = segments[i] + 1; p < segment_end; ++p)
     {
-      result.blend(next);
-      if(current_index + 1 >= total_partial_comps)
-      {
-        // we could break early for volumes,
-        // but blending past 1.0 alpha is no op.
-        break;
-      }
-      ++current_index;
-      next = partials[current_index];
+      result.blend(partials[order[p]]);
     }
-    output_partials[output_offset + i] = result;
+    output_partials[i] = result;
   }
 
   //placeholder
@@ -61,129 +51,77 @@ void BlendPartials(const int &total_segments,
 }
 template<typename T>
 void
-BlendEmission(const int &total_segments,
-              const int &total_partial_comps,
-              std::vector<int> &pixel_work_ids,
+BlendEmission(const std::vector<int> &segments,
+              const std::vector<int> &order,
               std::vector<EmissionPartial<T>> &partials,
-              std::vector<EmissionPartial<T>> &output_partials,
-              const int output_offset)
+              std::vector<EmissionPartial<T>> &output_partials)
 {
-  //
-  // Perform the compositing and output the result in the output
-  // This code computes the optical depth (total absorption)
-  // along each rays path.
-  //
-#ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
-#endif
-  for(int i = 0; i < total_segments; ++i)
-  {
-    int current_index = pixel_work_ids[i];
-    EmissionPartial<T> result = partials[current_index];
-    ++current_index;
-    EmissionPartial<T> next = partials[current_index];
-    // TODO: we could just count the amount of work and make this a for loop(vectorize??)
-    while(result.m_pixel_id == next.m_pixel_id)
-    {
-      result.blend_absorption(next);
-      if(current_index == total_partial_comps - 1)
-      {
-        break;
-      }
-      ++current_index;
-      next = partials[current_index];
-    }
-    output_partials[output_offset + i] = result;
-  }
-
-  //placeholder
-  //EmissionPartial::composite_background(output_partials);
-  // TODO: now blend source signature with output
-
-  //
-  //  Emission bins contain the amout of energy that leaves each
-  //  ray segment. To compute the amount of energy that reaches
-  //  the detector, we must multiply the segments emissed energy
-  //  by the optical depth of the remaining path to the detector.
-  //  To calculate the optical depth of the remaining path, we
-  //  do perform a reverse scan of absorption for each pixel id
-  //
+  const int total_segments = static_cast<int>(segments.size()) - 1;
 #ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
+  #pragma omp parallel for schedule(dynamic, 256)
 #endif
   for(int i = 0; i < total_segments; ++i)
   {
-    const int segment_start = pixel_work_ids[i];
-    int current_index = segment_start;
+    const int segment_start = segments[i];
+    const int segment_end = segments[i + 1];
     //
-    //  move forward to the end of the segment
+    // This computes the optical depth (total absorption)
+    // along each rays path.
     //
-    while(partials[current_index].m_pixel_id == partials[current_index + 1].m_pixel_id)
+    EmissionPartial<T> result = partials[order[segment_start]];
+    for(int p = segment_start + 1; p < segment_end; ++p)
     {
-      ++current_index;
-      if(current_index == total_partial_comps - 1)
-      {
-        break;
-      }
+      result.blend_absorption(partials[order[p]]);
     }
+
+    //
+    //  Emission bins contain the amout of energy that leaves each
+    //  ray segment. To compute the amount of energy that reaches
+    //  the detector, we must multiply the segments emissed energy
+    //  by the optical depth of the remaining path to the detector.
+    //  To calculate the optical depth of the remaining path, we
+    //  do perform a reverse scan of absorption for each pixel id
     //
     // set the intensity emerging out of the last segment
     //
-    output_partials[output_offset + i].m_emission_bins
-      = partials[current_index].m_emission_bins;
+    result.m_emission_bins = partials[order[segment_end - 1]].m_emission_bins;
 
     //
     // now move backwards accumulating absorption for each segment
     // and then blending the intensity emerging from the previous
     // segment.
     //
-    current_index--;
-    while(current_index != segment_start - 1)
+    for(int p = segment_end - 2; p >= segment_start; --p)
     {
-      partials[current_index].blend_absorption(partials[current_index + 1]);
+      EmissionPartial<T> &current = partials[order[p]];
+      EmissionPartial<T> &behind = partials[order[p + 1]];
+      current.blend_absorption(behind);
       // mult this segments emission by the absorption in front
-      partials[current_index].blend_emission(partials[current_index + 1]);
+      current.blend_emission(behind);
       // add remaining emissed engery to the output
-      output_partials[output_offset + i].add_emission(partials[current_index]);
-
-      --current_index;
+      result.add_emission(current);
     }
-  }
-
 
+    output_partials[i] = result;
+  }
 }
+
 template<>
-void BlendPartials<EmissionPartial, float>(const int &total_segments,
-                                           const int &total_partial_comps,
-                                           std::vector<int> &pixel_work_ids,
+void BlendPartials<EmissionPartial, float>(const std::vector<int> &segments,
+                                           const std::vector<int> &order,
                                            std::vector<EmissionPartial<float>> &partials,
-                                           std::vector<EmissionPartial<float>> &output_partials,
-                                           const int output_offset)
+                                           std::vector<EmissionPartial<float>> &output_partials)
 {
-
-  BlendEmission(total_segments,
-                total_partial_comps,
-                pixel_work_ids,
-                partials,
-                output_partials,
-                output_offset);
+  BlendEmission(segments, order, partials, output_partials);
 }
 
 template<>
-void BlendPartials<EmissionPartial, double>(const int &total_segments,
-                                            const int &total_partial_comps,
-                                            std::vector<int> &pixel_work_ids,
+void BlendPartials<EmissionPartial, double>(const std::vector<int> &segments,
+                                            const std::vector<int> &order,
                                             std::vector<EmissionPartial<double>> &partials,
-                                            std::vector<EmissionPartial<double>> &output_partials,
-                                            const int output_offset)
+                                            std::vector<EmissionPartial<double>> &output_partials)
 {
-
-  BlendEmission(total_segments,
-                total_partial_comps,
-                pixel_work_ids,
-                partials,
-                output_partials,
-                output_offset);
+  BlendEmission(segments, order, partials, output_partials);
 }
 
 } // namespace detail
@@ -294,162 +232,154 @@ PartialCompositor<PartialType>::merge(const std::vector<std::vector<PartialType>
 //--------------------------------------------------------------------------------------------
 template<typename PartialType>
 void
-PartialCompositor<PartialType>::composite_partials(std::vector<PartialType> &partials,
-                                            std::vector<PartialType> &output_partials)
+PartialCompositor<PartialType>::sort_partials(const std::vector<PartialType> &partials)
 {
-  const int total_partial_comps = partials.size();
-  if(total_partial_comps == 0)
-  {
-    output_partials = partials;
-    return;
-  }
-  //
-  // Sort the composites
-  //
-  std::sort(partials.begin(), partials.end());
-  //
-  // Find the number of unique pixel_ids with work
-  //
-  std::vector<unsigned char> work_flags;
-  std::vector<unsigned char> unique_flags;
-  work_flags.resize(total_partial_comps);
-  unique_flags.resize(total_partial_comps);
+  const int total_partial_comps = static_cast<int>(partials.size());
+
   //
-  // just check the first and last entries manualy to reduce the
-  // loop complexity
+  // pull the pixel ids out of the partials, so the counting
+  // passes only touch the ids
   //
-  if(partials[0].m_pixel_id == partials[1].m_pixel_id)
-  {
-    work_flags[0] = 1;
-    unique_flags[0] = 0;
-  }
-  else
-  {
-    work_flags[0] = 0;
-    unique_flags[0] = 1;
-  }
-  if(partials[total_partial_comps-1].m_pixel_id != partials[total_partial_comps-2].m_pixel_id)
-  {
-    unique_flags[total_partial_comps-1] = 1;
-  }
-  else
+  m_pixel_ids.resize(total_partial_comps);
+  int min_pixel = std::numeric_limits<int>::max();
+  int max_pixel = std::numeric_limits<int>::min();
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for reduction(min:min_pixel) reduction(max:max_pixel)
+#endif
+  for(int i = 0; i < total_partial_comps; ++i)
   {
-    unique_flags[total_partial_comps-1] = 0;
+    const int id = partials[i].m_pixel_id;
+    m_pixel_ids[i] = id;
+    min_pixel = std::min(min_pixel, id);
+    max_pixel = std::max(max_pixel, id);
   }
-  const int n_minus_one =  total_partial_comps - 1;
 
-#ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
-#endif
-  for(int i = 1; i < n_minus_one; ++i)
+  m_order.resize(total_partial_comps);
+  m_segments.clear();
+
+  // partials of the same pixel are ordered front to back, and by
+  // their index when tied so the result does not depend on the
+  // order the threads placed them in
+  auto front_to_back = [&partials](const int a, const int b)
   {
-    unsigned char work_flag = 0;
-    unsigned char unique_flag = 0;
-    bool is_begining = false;
-    if(partials[i].m_pixel_id != partials[i-1].m_pixel_id)
-    {
-      is_begining = true;
-    }
+    if(partials[a] < partials[b]) return true;
+    if(partials[b] < partials[a]) return false;
+    return a < b;
+  };
 
-    bool has_compositing_work = false;
-    if(partials[i].m_pixel_id == partials[i+1].m_pixel_id)
-    {
-      has_compositing_work = true;
-    }
-    if(is_begining && has_compositing_work)
+  const long long pixel_range = (long long)max_pixel - (long long)min_pixel + 1;
+  if(pixel_range > 4ll * total_partial_comps + 1024)
+  {
+    //
+    // the ids are too sparse to count, sort the indices instead
+    //
+    for(int i = 0; i < total_partial_comps; ++i)
     {
-      work_flag  = 1;
+      m_order[i] = i;
     }
-    if(is_begining && !has_compositing_work)
+    std::sort(m_order.begin(), m_order.end(), front_to_back);
+    m_segments.push_back(0);
+    for(int i = 1; i < total_partial_comps; ++i)
     {
-      unique_flag = 1;
+      if(m_pixel_ids[m_order[i]] != m_pixel_ids[m_order[i - 1]])
+      {
+        m_segments.push_back(i);
+      }
     }
-
-    work_flags[i]  = work_flag;
-    unique_flags[i] = unique_flag;
+    m_segments.push_back(total_partial_comps);
+    return;
   }
-  // count the number of of unique pixels
-  int total_segments = 0;
 
+  //
+  // counting sort by pixel id: count the partials of each pixel,
+  // scan the counts into offsets and scatter the partial indices
+  //
+  const int num_pixels = static_cast<int>(pixel_range);
+  m_offsets.assign(num_pixels + 1, 0);
 #ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for shared(work_flags) reduction(+:total_segments)
+  #pragma omp parallel for
 #endif
   for(int i = 0; i < total_partial_comps; ++i)
   {
-    total_segments += work_flags[i];
-  }
-
-  int total_unique_pixels = 0;
+    const int pixel = m_pixel_ids[i] - min_pixel;
 #ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for shared(unique_flags) reduction(+:total_unique_pixels)
+    #pragma omp atomic
 #endif
-  for(int i = 0; i < total_partial_comps; ++i)
-  {
-    total_unique_pixels += unique_flags[i];
+    m_offsets[pixel + 1]++;
   }
 
-  if(total_segments ==  0)
+  for(int i = 0; i < num_pixels; ++i)
   {
-    //nothing to do
+    if(m_offsets[i + 1] != 0)
+    {
+      m_segments.push_back(m_offsets[i]);
+    }
+    m_offsets[i + 1] += m_offsets[i];
   }
+  m_segments.push_back(total_partial_comps);
 
-  //
-  // find the pixel indexes that have compositing work
-  //
-  std::vector<int> pixel_work_ids;
-  pixel_work_ids.resize(total_segments);
-  int current_index = 0;
-  for(int i = 0;  i < total_partial_comps; ++i)
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(int i = 0; i < total_partial_comps; ++i)
   {
-    if(work_flags[i] == 1)
-    {
-      pixel_work_ids[current_index] = i;
-      ++current_index;
-    }
+    const int pixel = m_pixel_ids[i] - min_pixel;
+    int slot;
+#ifdef APCOMP_OPENMP_ENABLED
+    #pragma omp atomic capture
+#endif
+    slot = m_offsets[pixel]++;
+    m_order[slot] = i;
   }
 
   //
-  // find the pixel indexes that have NO compositing work
+  // sort each pixel's partials by depth
   //
-  std::vector<int> unique_ids;
-  unique_ids.resize(total_unique_pixels);
-  current_index = 0;
-  for(int i = 0;  i < total_partial_comps; ++i)
+  const int total_segments = static_cast<int>(m_segments.size()) - 1;
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(int i = 0; i < total_segments; ++i)
   {
-    if(unique_flags[i] == 1)
+    if(m_segments[i + 1] - m_segments[i] > 1)
     {
-      unique_ids[current_index] = i;
-      ++current_index;
+      std::sort(m_order.begin() + m_segments[i],
+                m_order.begin() + m_segments[i + 1],
+                front_to_back);
     }
   }
+}
 
-
-  const int total_output_pixels = total_unique_pixels + total_segments;
-
-  output_partials.resize(total_output_pixels);
+//--------------------------------------------------------------------------------------------
+template<typename PartialType>
+void
+PartialCompositor<PartialType>::composite_partials(std::vector<PartialType> &partials,
+                                            std::vector<PartialType> &output_partials)
+{
+  const int total_partial_comps = partials.size();
+  if(total_partial_comps == 0)
+  {
+    output_partials = partials;
+    return;
+  }
 
   //
-  // Gather the unique pixels into the output
+  // Group the partials by pixel, m_order holds the partial indices
+  // and m_segments where each pixel starts
   //
-#ifdef APCOMP_OPENMP_ENABLED
-  #pragma omp parallel for
-#endif
-  for(int i = 0; i < total_unique_pixels; ++i)
-  {
-    PartialType result = partials[unique_ids[i]];
-    output_partials[i] = result;
-  }
+  sort_partials(partials);
+
+  const int total_segments = static_cast<int>(m_segments.size()) - 1;
+  output_partials.resize(total_segments);
 
   //
-  // perform compositing if there are more than
-  // one segment per ray
+  // Composite the partials of each pixel. Pixels with a single
+  // partial are copied out as is.
   //
-  detail::BlendPartials(total_segments,
-                        total_partial_comps,
-                        pixel_work_ids,
+  detail::BlendPartials(m_segments,
+                        m_order,
                         partials,
-                        output_partials,
-                        total_unique_pixels);
+                        output_partials);
 
 }
 
@@ -471,7 +401,8 @@ PartialCompositor<PartialType>::composite(std::vector<std::vector<PartialType>>
   // we could have no data, but it could exist elsewhere
 #endif
 
-  std::vector<PartialType> partials;
+  // reuse the merge buffer from the previous frame
+  std::vector<PartialType> &partials = m_partials;
   int global_min_pixel;
   int global_max_pixel;
 
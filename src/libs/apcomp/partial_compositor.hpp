@@ -39,7 +39,20 @@ protected:
   void composite_partials(std::vector<PartialType> &partials,
                           std::vector<PartialType> &output_partials);
 
+  // groups the partials by pixel id and orders each group by depth
+  void sort_partials(const std::vector<PartialType> &partials);
+
   std::vector<typename PartialType::ValueType> m_background_values;
+
+  // scratch buffers, kept so compositing the next frame
+  // does not have to allocate them again
+  std::vector<PartialType> m_partials;
+  std::vector<int>         m_pixel_ids;
+  std::vector<int>         m_offsets;
+  // partial indices sorted by pixel and depth
+  std::vector<int>         m_order;
+  // start of each pixel's partials in m_order, plus the end
+  std::vector<int>         m_segments;
 };
 
 }; // namespace apcomp
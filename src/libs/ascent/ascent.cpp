@@ -544,6 +544,9 @@ Ascent::close()
     {
         if(m_runtime != NULL)
         {
+            // errors in cleanup can't leave the destructor, so
+            // clean up here where they can be reported
+            m_runtime->Cleanup();
             delete m_runtime;
             m_runtime = NULL;
         }
@@ -557,6 +560,11 @@ Ascent::close()
 
         if(m_forward_exceptions)
         {
+            if(m_runtime != NULL)
+            {
+              delete m_runtime;
+              m_runtime = NULL;
+            }
             throw e;
         }
         else
@@ -567,6 +575,8 @@ Ascent::close()
               msg << "[Error] Ascent::close"
                   << e.message() << std::endl;
               m_runtime->DisplayError(msg.str());
+              delete m_runtime;
+              m_runtime = NULL;
             }
             else
             {
@@ -24,7 +24,11 @@
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
 
+#include <deque>
 #include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -177,12 +181,93 @@ hola_mpi_comm_map(const conduit::Node &data,
                                           dest_offsets);
 }
 
+//-----------------------------------------------------------------------------
+// transfer engine helpers
+//-----------------------------------------------------------------------------
+
+// tags used for the per destination schema message and the domain data
+static const int HOLA_MPI_SCHEMA_TAG = 0;
+static const int HOLA_MPI_DATA_TAG   = 1;
+
+//-----------------------------------------------------------------------------
+// holds what was exchanged on the previous call, used when the
+// reuse_layout option is on. Keyed by communicator and peer rank.
+Node &
+hola_mpi_layout_cache()
+{
+    static Node cache;
+    return cache;
+}
+
+//-----------------------------------------------------------------------------
+void
+hola_mpi_clear_layout_cache()
+{
+    hola_mpi_layout_cache().reset();
+}
+
+//-----------------------------------------------------------------------------
+std::string
+hola_mpi_cache_path(MPI_Comm comm,
+                    const std::string &dir,
+                    int peer_rank)
+{
+    std::ostringstream oss;
+    oss << "comm_" << MPI_Comm_c2f(comm) << "/" << dir << "/" << peer_rank;
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+bool
+hola_mpi_reuse_layout(const Node &options)
+{
+    return options.has_child("reuse_layout") &&
+           options["reuse_layout"].as_string() == "true";
+}
+
+//-----------------------------------------------------------------------------
+index_t
+hola_mpi_max_in_flight_bytes(const Node &options)
+{
+    // 1 GiB
+    index_t max_bytes = 1 << 30;
+    if(options.has_child("max_in_flight_bytes"))
+    {
+        max_bytes = options["max_in_flight_bytes"].to_index_t();
+    }
+    return max_bytes;
+}
+
+//-----------------------------------------------------------------------------
+int
+hola_mpi_message_size(index_t num_bytes)
+{
+    if(num_bytes > std::numeric_limits<int>::max())
+    {
+        ASCENT_ERROR("hola_mpi: domain of " << num_bytes << " bytes is too "
+                     "large for a single message");
+    }
+    return static_cast<int>(num_bytes);
+}
+
 //-----------------------------------------------------------------------------
 void
 hola_mpi_send(const conduit::Node &data,
               MPI_Comm comm,
               int src_idx,
               const conduit::Node &comm_map)
+{
+    Node options;
+    hola_mpi_send(data, comm, src_idx, comm_map, options);
+}
+
+//-----------------------------------------------------------------------------
+void
+hola_mpi_send(const conduit::Node &data,
+              MPI_Comm comm,
+              int src_idx,
+              const conduit::Node &comm_map,
+              const conduit::Node &options)
 {
     const int32 *src_counts  = comm_map["src_counts"].value();
     const int32 *src_offsets = comm_map["src_offsets"].value();
@@ -194,29 +279,142 @@ hola_mpi_send(const conduit::Node &data,
     // responsible for sending src_offsets[src_idx] + src_counts[src_idx]
     // to who ever needs them
     // assumes multi domain mesh bp
-    // we expect: data.number_of_children() == src_counts[src_idx]
-    NodeConstIterator itr = data.children();
+    if(data.number_of_children() != src_counts[src_idx])
+    {
+        ASCENT_ERROR("hola_mpi: source " << src_idx << " has "
+                     << data.number_of_children() << " domains, but the"
+                     << " comm map expects " << src_counts[src_idx]);
+    }
+
+    const bool reuse = hola_mpi_reuse_layout(options);
+    const index_t max_in_flight = hola_mpi_max_in_flight_bytes(options);
+    Node &cache = hola_mpi_layout_cache();
 
+    const int num_doms = src_counts[src_idx];
+    const int first_dom = src_offsets[src_idx];
+
+    // world rank that receives each local domain
+    std::vector<int32> dom_dest(num_doms);
     int dest_idx = 0;
-    for(int i = src_offsets[src_idx];
-        i < src_offsets[src_idx] + src_counts[src_idx];
-        i++)
+    for(int i = 0; i < num_doms; i++)
     {
-        const Node &n_curr = itr.next();
         // find  i's dest
-        while( i >= dest_offsets[dest_idx] + dest_counts[dest_idx])
+        while( first_dom + i >= dest_offsets[dest_idx] + dest_counts[dest_idx])
         {
             dest_idx++;
         }
+        dom_dest[i] = dest_to_world[dest_idx];
+    }
+
+    //
+    // one schema message per destination, holding the number of domains
+    // and the compact schemas of all of them. When reusing layouts and
+    // the schemas match the last ones sent, the schema part is empty.
+    //
+    std::vector<std::string> headers;
+    std::vector<int32> header_dests;
+    int begin = 0;
+    while(begin < num_doms)
+    {
+        int end = begin;
+        Schema bundle;
+        while(end < num_doms && dom_dest[end] == dom_dest[begin])
+        {
+            data.child(end).schema().compact_to(bundle.append());
+            end++;
+        }
+
+        const int32 dest_rank = dom_dest[begin];
+        std::string schema_json = bundle.to_json();
+        std::string cache_path = hola_mpi_cache_path(comm, "send", dest_rank);
+
+        if(reuse && cache.has_path(cache_path) &&
+           cache[cache_path].as_string() == schema_json)
+        {
+            schema_json = "";
+        }
+        else if(reuse)
+        {
+            cache[cache_path] = schema_json;
+        }
 
-        int32 dest_rank = dest_to_world[(int32)dest_idx];
+        std::ostringstream oss;
+        oss << (end - begin) << "\n" << schema_json;
+        headers.push_back(oss.str());
+        header_dests.push_back(dest_rank);
+        begin = end;
+    }
+
+    const int num_headers = static_cast<int>(headers.size());
+    std::vector<MPI_Request> header_requests(num_headers);
+    for(int h = 0; h < num_headers; h++)
+    {
+        MPI_Isend(const_cast<char*>(headers[h].c_str()),
+                  hola_mpi_message_size(headers[h].size() + 1),
+                  MPI_CHAR,
+                  header_dests[h],
+                  HOLA_MPI_SCHEMA_TAG,
+                  comm,
+                  &header_requests[h]);
+    }
+
+    //
+    // post the domain data. Compact and contiguous domains are sent in
+    // place, everything else is compacted into a temporary that lives
+    // until its send completes. Once more than max_in_flight bytes are
+    // posted, wait on the oldest sends before posting more.
+    //
+    std::vector<Node> compacted(num_doms);
+    std::deque<int> in_flight;
+    std::vector<MPI_Request> requests(num_doms, MPI_REQUEST_NULL);
+    std::vector<index_t> dom_bytes(num_doms, 0);
+    index_t in_flight_bytes = 0;
+
+    for(int i = 0; i < num_doms; i++)
+    {
+        const Node &n_curr = data.child(i);
+        const index_t num_bytes = n_curr.total_bytes_compact();
+        if(num_bytes == 0)
+        {
+            continue;
+        }
+
+        while(!in_flight.empty() && in_flight_bytes + num_bytes > max_in_flight)
+        {
+            const int oldest = in_flight.front();
+            in_flight.pop_front();
+            MPI_Wait(&requests[oldest], MPI_STATUS_IGNORE);
+            compacted[oldest].reset();
+            in_flight_bytes -= dom_bytes[oldest];
+        }
+
+        const void *send_ptr = NULL;
+        if(n_curr.is_compact())
+        {
+            send_ptr = n_curr.contiguous_data_ptr();
+        }
 
-        // std::cout << "src_idx " << src_idx << " send " << i << " to "
-        //           << dest_idx << " (rank: " << dest_rank <<  " )" << std::endl;
+        if(send_ptr == NULL)
+        {
+            n_curr.compact_to(compacted[i]);
+            send_ptr = compacted[i].contiguous_data_ptr();
+        }
 
-        relay::mpi::send_using_schema(n_curr,dest_rank,0,comm);
+        MPI_Isend(const_cast<void*>(send_ptr),
+                  hola_mpi_message_size(num_bytes),
+                  MPI_BYTE,
+                  dom_dest[i],
+                  HOLA_MPI_DATA_TAG,
+                  comm,
+                  &requests[i]);
+
+        dom_bytes[i] = num_bytes;
+        in_flight_bytes += num_bytes;
+        in_flight.push_back(i);
     }
 
+    MPI_Waitall(num_doms, requests.data(), MPI_STATUSES_IGNORE);
+    MPI_Waitall(num_headers, header_requests.data(), MPI_STATUSES_IGNORE);
 }
 
 //-----------------------------------------------------------------------------
@@ -225,6 +423,18 @@ hola_mpi_recv(MPI_Comm comm,
               int dest_idx,
               const conduit::Node &comm_map,
               conduit::Node &data)
+{
+    Node options;
+    hola_mpi_recv(comm, dest_idx, comm_map, options, data);
+}
+
+//-----------------------------------------------------------------------------
+void
+hola_mpi_recv(MPI_Comm comm,
+              int dest_idx,
+              const conduit::Node &comm_map,
+              const conduit::Node &options,
+              conduit::Node &data)
 {
     const int32 *src_counts  = comm_map["src_counts"].value();
     const int32 *src_offsets = comm_map["src_offsets"].value();
@@ -233,8 +443,13 @@ hola_mpi_recv(MPI_Comm comm,
     const int32 *dest_counts  = comm_map["dest_counts"].value();
     const int32 *dest_offsets = comm_map["dest_offsets"].value();
 
+    const bool reuse = hola_mpi_reuse_layout(options);
+    Node &cache = hola_mpi_layout_cache();
+
     // responsible for receiving dest_offsets[dest_idx] + dest_counts[dest_idx]
-    // from who ever has them
+    // from who ever has them, in runs of domains from the same source
+    std::vector<int32> run_srcs;
+    std::vector<int32> run_counts;
     int src_idx = 0;
     for(int i = dest_offsets[dest_idx];
         i < dest_offsets[dest_idx] + dest_counts[dest_idx];
@@ -247,12 +462,92 @@ hola_mpi_recv(MPI_Comm comm,
         }
 
         int32 src_rank = src_to_world[(int32)src_idx];
-        // std::cout << "dest_idx " << dest_idx << " rcv "
-        //           << i <<  " from " << src_idx << " ( rank: " << src_rank << ") " <<std::endl;
-        Node &n_curr = data.append();
-        // rcv n_curr
-        relay::mpi::recv_using_schema(n_curr,src_rank,0,comm);
+        if(run_srcs.empty() || run_srcs.back() != src_rank)
+        {
+            run_srcs.push_back(src_rank);
+            run_counts.push_back(0);
+        }
+        run_counts.back()++;
+    }
+
+    std::vector<MPI_Request> requests;
+    const int num_runs = static_cast<int>(run_srcs.size());
+    for(int r = 0; r < num_runs; r++)
+    {
+        const int32 src_rank = run_srcs[r];
+
+        MPI_Status status;
+        MPI_Probe(src_rank, HOLA_MPI_SCHEMA_TAG, comm, &status);
+        int header_size = 0;
+        MPI_Get_count(&status, MPI_CHAR, &header_size);
+        std::vector<char> header(header_size);
+        MPI_Recv(header.data(),
+                 header_size,
+                 MPI_CHAR,
+                 src_rank,
+                 HOLA_MPI_SCHEMA_TAG,
+                 comm,
+                 MPI_STATUS_IGNORE);
+
+        std::string header_str(header.data());
+        const size_t split = header_str.find('\n');
+        const int num_doms = std::stoi(header_str.substr(0, split));
+        std::string schema_json = header_str.substr(split + 1);
+
+        if(num_doms != run_counts[r])
+        {
+            ASCENT_ERROR("hola_mpi: expected " << run_counts[r] << " domains"
+                         << " from rank " << src_rank << " but it is sending "
+                         << num_doms);
+        }
+
+        std::string cache_path = hola_mpi_cache_path(comm, "recv", src_rank);
+        if(schema_json.empty())
+        {
+            if(!reuse || !cache.has_path(cache_path))
+            {
+                ASCENT_ERROR("hola_mpi: rank " << src_rank << " reused its"
+                             << " previous layout, but none is cached here."
+                             << " Both sides must set 'reuse_layout'");
+            }
+            schema_json = cache[cache_path].as_string();
+        }
+        else if(reuse)
+        {
+            cache[cache_path] = schema_json;
+        }
+
+        Schema bundle(schema_json);
+        for(int d = 0; d < num_doms; d++)
+        {
+            Node &n_curr = data.append();
+            n_curr.set(bundle.child(d));
+            const index_t num_bytes = n_curr.total_bytes_compact();
+            if(num_bytes == 0)
+            {
+                continue;
+            }
+
+            void *recv_ptr = n_curr.contiguous_data_ptr();
+            if(recv_ptr == NULL)
+            {
+                ASCENT_ERROR("hola_mpi: received domain is not contiguous");
+            }
+
+            requests.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(recv_ptr,
+                      hola_mpi_message_size(num_bytes),
+                      MPI_BYTE,
+                      src_rank,
+                      HOLA_MPI_DATA_TAG,
+                      comm,
+                      &requests.back());
+        }
     }
+
+    MPI_Waitall(static_cast<int>(requests.size()),
+                requests.data(),
+                MPI_STATUSES_IGNORE);
 }
 
 
@@ -320,23 +615,64 @@ hola_mpi(const conduit::Node &options,
         data_ptr = &md_data;
     }
 
-    Node comm_map;
+    //
+    // building the comm map gathers the domain counts of all ranks.
+    // when reusing layouts, we keep the map from the previous call
+    // as long as the split, the communicator size and every source's
+    // domain count are the same. One allreduce checks that on all
+    // ranks, so they all either reuse the map or rebuild it together.
+    //
+    Node comm_map_store;
+    Node *comm_map_ptr = &comm_map_store;
+    bool build_comm_map = true;
 
-    hola_mpi_comm_map(*data_ptr,
-                      comm,
-                      world_to_src,
-                      world_to_dest,
-                      comm_map);
+    if(hola_mpi_reuse_layout(options))
+    {
+        std::ostringstream oss;
+        oss << "comm_" << MPI_Comm_c2f(comm) << "/comm_map/" << rank_split;
+        comm_map_ptr = &hola_mpi_layout_cache()[oss.str()];
+
+        const Node &cached = *comm_map_ptr;
+        int stale = 0;
+        if(!cached.has_child("src_counts") ||
+           !cached.has_child("comm_size") ||
+           cached["comm_size"].to_int() != total_size)
+        {
+            stale = 1;
+        }
+        else if(is_src_rank)
+        {
+            const int32 *src_counts = cached["src_counts"].value();
+            stale = src_counts[world_to_src[rank]] !=
+                    data_ptr->number_of_children();
+        }
+
+        int any_stale = 0;
+        MPI_Allreduce(&stale, &any_stale, 1, MPI_INT, MPI_MAX, comm);
+        build_comm_map = any_stale != 0;
+    }
+
+    Node &comm_map = *comm_map_ptr;
+
+    if(build_comm_map)
+    {
+        hola_mpi_comm_map(*data_ptr,
+                          comm,
+                          world_to_src,
+                          world_to_dest,
+                          comm_map);
+        comm_map["comm_size"] = total_size;
+    }
 
     if(is_src_rank )
     {
         int src_idx = world_to_src[rank];
-        hola_mpi_send(*data_ptr,comm,src_idx,comm_map);
+        hola_mpi_send(*data_ptr,comm,src_idx,comm_map,options);
     }
     else
     {
         int dest_idx = world_to_dest[rank];
-        hola_mpi_recv(comm,dest_idx,comm_map,*data_ptr);
+        hola_mpi_recv(comm,dest_idx,comm_map,options,*data_ptr);
     }
 }
 
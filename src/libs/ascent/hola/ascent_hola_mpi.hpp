@@ -47,12 +47,41 @@ void ASCENT_API hola_mpi_send(const conduit::Node &data,
                               int src_idx,
                               const conduit::Node &comm_map);
 
+/// executes a send with transfer options:
+///
+///  max_in_flight_bytes: limit on the bytes of domain data posted to
+///                       nonblocking sends that have not completed
+///                       (default: 1 GiB)
+///  reuse_layout: "true" to only send the schemas to a destination when
+///                they differ from the ones sent on the previous call
+///                (the receiver must also set reuse_layout)
+///
+/// The schemas of all domains that go to a destination are sent in one
+/// message, then the domain data is sent with nonblocking sends.
+void ASCENT_API hola_mpi_send(const conduit::Node &data,
+                              MPI_Comm comm,
+                              int src_idx,
+                              const conduit::Node &comm_map,
+                              const conduit::Node &options);
+
 /// executes a receive
 void ASCENT_API hola_mpi_recv(MPI_Comm comm,
                               int dest_idx,
                               const conduit::Node &comm_map,
                               conduit::Node &data);
 
+/// executes a receive with transfer options (see hola_mpi_send)
+void ASCENT_API hola_mpi_recv(MPI_Comm comm,
+                              int dest_idx,
+                              const conduit::Node &comm_map,
+                              const conduit::Node &options,
+                              conduit::Node &data);
+
+/// drops the comm maps and schemas kept by reuse_layout. Call this
+/// when a communicator used with reuse_layout is freed, since its
+/// handle may be reused by a new communicator.
+void ASCENT_API hola_mpi_clear_layout_cache();
+
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
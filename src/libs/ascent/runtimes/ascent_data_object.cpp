@@ -22,11 +22,13 @@
 #if defined(ASCENT_DRAY_ENABLED)
 #include <dray/data_model/collection.hpp>
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
 #endif
 
 #include "ascent_transmogrifier.hpp"
 
 #include <ascent_logging.hpp>
+#include <conduit_blueprint.hpp>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -68,6 +70,106 @@ void add_metadata(conduit::Node &dataset)
 
 } // namespace detail
 
+//-----------------------------------------------------------------------------
+// holds converted meshes across publishes
+//-----------------------------------------------------------------------------
+class DataObject::ConversionCache
+{
+public:
+#if defined(ASCENT_VTKM_ENABLED)
+  VTKHMeshCache m_vtkh_meshes;
+#endif
+
+#if defined(ASCENT_DRAY_ENABLED)
+  struct DRayEntry
+  {
+    std::string signature;
+    std::string connectivity;
+    // meshes only, shared by every data set created from this entry
+    dray::DataSet meshes;
+    std::map<std::string, dray::BlueprintLowOrder::TopologyInfo> topo_info;
+    bool used;
+  };
+
+  std::map<int, DRayEntry> m_dray_domains;
+
+  // converts a low order blueprint domain, reusing cached meshes
+  dray::DataSet low_order_to_dray(const conduit::Node &dom)
+  {
+    std::string signature;
+    std::string connectivity;
+    const std::vector<std::string> topo_names = dom["topologies"].child_names();
+    for(size_t t = 0; t < topo_names.size(); ++t)
+    {
+      signature += Transmogrifier::topology_signature(dom, topo_names[t]);
+      connectivity += Transmogrifier::connectivity_signature(dom, topo_names[t]);
+    }
+
+    int domain_id = 0;
+    if(dom.has_path("state/domain_id"))
+    {
+      domain_id = dom["state/domain_id"].to_int32();
+    }
+
+    auto itr = m_dray_domains.find(domain_id);
+    if(itr == m_dray_domains.end() || itr->second.signature != signature)
+    {
+      conduit::Node info;
+      if(!conduit::blueprint::verify("mesh", dom, info))
+      {
+        ASCENT_ERROR("Devil Ray conversion failed to verify "<<info.to_yaml());
+      }
+
+      DRayEntry &entry = m_dray_domains[domain_id];
+      // if only the coordinates moved, the new meshes can refit
+      // the bvhs of the old ones instead of building new trees
+      dray::DataSet previous;
+      if(entry.connectivity == connectivity)
+      {
+        previous = entry.meshes;
+      }
+      entry.signature = signature;
+      entry.connectivity = connectivity;
+      entry.meshes = dray::DataSet();
+      entry.topo_info.clear();
+      dray::BlueprintLowOrder::import_meshes(dom, entry.meshes, entry.topo_info);
+      for(int m = 0; m < entry.meshes.number_of_meshes(); ++m)
+      {
+        dray::Mesh *mesh = entry.meshes.mesh(m);
+        if(previous.has_mesh(mesh->name()))
+        {
+          mesh->refit_bvh_from(previous.mesh(mesh->name()));
+        }
+      }
+      itr = m_dray_domains.find(domain_id);
+    }
+
+    itr->second.used = true;
+    dray::DataSet dset = itr->second.meshes;
+    dray::BlueprintLowOrder::import_fields(dom, itr->second.topo_info, dset);
+    return dset;
+  }
+
+  // removes domains that were not converted since the last prune
+  void prune_dray()
+  {
+    auto itr = m_dray_domains.begin();
+    while(itr != m_dray_domains.end())
+    {
+      if(!itr->second.used)
+      {
+        itr = m_dray_domains.erase(itr);
+      }
+      else
+      {
+        itr->second.used = false;
+        ++itr;
+      }
+    }
+  }
+#endif
+};
+
 DataObject::DataObject()
   : m_low_bp(nullptr),
     m_high_bp(nullptr),
@@ -77,7 +179,8 @@ DataObject::DataObject()
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
 #endif
-    m_source(Source::INVALID)
+    m_source(Source::INVALID),
+    m_mutex(std::make_shared<std::recursive_mutex>())
 {
   m_name = "default";
 }
@@ -90,7 +193,8 @@ DataObject::DataObject(VTKHCollection *dataset)
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
 #endif
-    m_source(Source::VTKH)
+    m_source(Source::VTKH),
+    m_mutex(std::make_shared<std::recursive_mutex>())
 {
   m_name = "default";
 }
@@ -104,7 +208,8 @@ DataObject::DataObject(dray::Collection *dataset)
     m_vtkh(nullptr),
 #endif
     m_dray(dataset),
-    m_source(Source::DRAY)
+    m_source(Source::DRAY),
+    m_mutex(std::make_shared<std::recursive_mutex>())
 {
   m_name = "default";
 }
@@ -119,6 +224,7 @@ DataObject::DataObject(conduit::Node *dataset)
 #if defined(ASCENT_DRAY_ENABLED)
     ,m_dray(nullptr)
 #endif
+    ,m_mutex(std::make_shared<std::recursive_mutex>())
 {
   reset(dataset);
   m_name = "default";
@@ -218,6 +324,7 @@ void DataObject::reset(conduit::Node *dataset)
 #if defined(ASCENT_DRAY_ENABLED)
 std::shared_ptr<dray::Collection> DataObject::as_dray_collection()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source == Source::INVALID)
   {
     ASCENT_ERROR("Source never initialized: default constructed");
@@ -250,8 +357,21 @@ std::shared_ptr<dray::Collection> DataObject::as_dray_collection()
       const int domains = low_order->number_of_children();
       for(int i = 0; i < domains; ++i)
       {
-        dray::DataSet dset = dray::BlueprintReader::blueprint_to_dray(low_order->child(i));
-        collection->add_domain(dset);
+        if(m_conversion_cache != nullptr && m_source == Source::LOW_BP)
+        {
+          dray::DataSet dset = m_conversion_cache->low_order_to_dray(low_order->child(i));
+          collection->add_domain(dset);
+        }
+        else
+        {
+          dray::DataSet dset = dray::BlueprintReader::blueprint_to_dray(low_order->child(i));
+          collection->add_domain(dset);
+        }
+      }
+
+      if(m_conversion_cache != nullptr && m_source == Source::LOW_BP)
+      {
+        m_conversion_cache->prune_dray();
       }
 
       m_dray = collection;
@@ -268,6 +388,7 @@ std::shared_ptr<dray::Collection> DataObject::as_dray_collection()
 #if defined(ASCENT_VTKM_ENABLED)
 std::shared_ptr<VTKHCollection> DataObject::as_vtkh_collection()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source == Source::INVALID)
   {
     ASCENT_ERROR("Source never initialized: default constructed");
@@ -303,9 +424,21 @@ std::shared_ptr<VTKHCollection> DataObject::as_vtkh_collection()
       }
     }
 
+    // only published low order data keeps the same buffers
+    // from one publish to the next
+    VTKHMeshCache *mesh_cache = nullptr;
+    if(m_conversion_cache != nullptr &&
+       m_source == Source::LOW_BP &&
+       zero_copy)
+    {
+      mesh_cache = &m_conversion_cache->m_vtkh_meshes;
+    }
+
     // convert to vtkh
     std::shared_ptr<VTKHCollection>
-      vtkh_dset(VTKHDataAdapter::BlueprintToVTKHCollection(*to_vtkh, zero_copy));
+      vtkh_dset(VTKHDataAdapter::BlueprintToVTKHCollection(*to_vtkh,
+                                                           zero_copy,
+                                                           mesh_cache));
 
     m_vtkh = vtkh_dset;
     
@@ -318,6 +451,7 @@ std::shared_ptr<VTKHCollection> DataObject::as_vtkh_collection()
 
 void DataObject::reset_vtkh_collection()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source != Source::VTKH)
     m_vtkh.reset();
 }
@@ -325,6 +459,7 @@ void DataObject::reset_vtkh_collection()
 
 std::shared_ptr<conduit::Node>  DataObject::as_low_order_bp()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source == Source::INVALID)
   {
     ASCENT_ERROR("Source never initialized: default constructed");
@@ -359,6 +494,7 @@ std::shared_ptr<conduit::Node>  DataObject::as_low_order_bp()
 
 std::shared_ptr<conduit::Node>  DataObject::as_high_order_bp()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source == Source::INVALID)
   {
     ASCENT_ERROR("Source never initialized: default constructed");
@@ -379,6 +515,7 @@ std::shared_ptr<conduit::Node>  DataObject::as_high_order_bp()
 
 std::shared_ptr<conduit::Node>  DataObject::as_node()
 {
+  std::lock_guard<std::recursive_mutex> lock(*m_mutex);
   if(m_source == Source::INVALID)
   {
     ASCENT_ERROR("Source never initialized: default constructed");
@@ -410,6 +547,23 @@ std::shared_ptr<conduit::Node>  DataObject::as_node()
   return nullptr;
 }
 
+void DataObject::enable_conversion_cache(bool enabled)
+{
+  if(enabled && m_conversion_cache == nullptr)
+  {
+    m_conversion_cache = std::make_shared<ConversionCache>();
+  }
+  else if(!enabled)
+  {
+    m_conversion_cache.reset();
+  }
+}
+
+bool DataObject::conversion_cache_enabled() const
+{
+  return m_conversion_cache != nullptr;
+}
+
 DataObject::Source DataObject::source() const
 {
   return m_source;
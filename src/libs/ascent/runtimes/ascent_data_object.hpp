@@ -17,6 +17,7 @@
 #include <ascent.hpp>
 #include <conduit.hpp>
 #include <memory>
+#include <mutex>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -73,7 +74,18 @@ public:
   std::shared_ptr<conduit::Node>  as_node();          // just return the coduit node
   DataObject::Source              source() const;
   std::string source_string() const;
+
+  // Opt-in cache of converted meshes that persists across reset()
+  // calls (i.e. across publishes). VTK-h coordinate systems and cell
+  // sets, and Devil Ray meshes (including their BVHs), are reused while
+  // the topology signature (see Transmogrifier::topology_signature) of
+  // each domain is unchanged. Fields are always re-bound.
+  void                            enable_conversion_cache(bool enabled);
+  bool                            conversion_cache_enabled() const;
 protected:
+  class ConversionCache;
+  std::shared_ptr<ConversionCache> m_conversion_cache;
+
   std::shared_ptr<conduit::Node>  m_low_bp;
   std::shared_ptr<conduit::Node>  m_high_bp;
 #if defined(ASCENT_VTKM_ENABLED)
@@ -85,6 +97,9 @@ protected:
 
   Source m_source;
   std::string m_name;
+  // guards the lazy conversions, filters executed concurrently
+  // (see flow::Workspace::set_number_of_threads) can share an input
+  std::shared_ptr<std::recursive_mutex> m_mutex;
 };
 
 //-----------------------------------------------------------------------------
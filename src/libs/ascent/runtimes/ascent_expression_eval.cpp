@@ -28,7 +28,10 @@
 #include "expressions/ascent_array_registry.hpp"
 #endif
 
+#include <cctype>
 #include <ctime>
+#include <set>
+#include <flow_filters.hpp>
 #include <flow_timer.hpp>
 #include <stdio.h>
 #include <stdlib.h>
@@ -1669,6 +1672,26 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
 
   // remove temporary fields, topologies, and coordsets from the dataset
   // TODO: We need a way to delete the intermediate results during execution
+  remove_temporaries(remove);
+
+  cache_result(return_val, expr_name, symbol_table, cycle);
+
+  delete root_node;
+  w.reset();
+#ifdef ASCENT_JIT_ENABLED
+  ASCENT_DATA_ADD("Device high water mark", ArrayRegistry::high_water_mark());
+  ASCENT_DATA_ADD("Current Device usage ", ArrayRegistry::device_usage());
+  ASCENT_DATA_ADD("Current host usage ", ArrayRegistry::host_usage());
+  ArrayRegistry::reset_high_water_mark();
+#endif
+  ASCENT_DATA_CLOSE();
+  return return_val;
+}
+
+//-----------------------------------------------------------------------------
+void
+ExpressionEval::remove_temporaries(conduit::Node &remove)
+{
   conduit::Node *dataset = m_data_object.as_node().get();
   const int num_domains = dataset->number_of_children();
   for(int i = 0; i < num_domains; ++i)
@@ -1687,9 +1710,15 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
       dom["coordsets"].remove(coords_name);
     }
   }
+}
 
-  //std::cout<<m_data_object.as_node()->to_summary_string()<<"\n";
-
+//-----------------------------------------------------------------------------
+void
+ExpressionEval::cache_result(conduit::Node &return_val,
+                             const std::string &expr_name,
+                             const conduit::Node &symbol_table,
+                             const int cycle)
+{
   // add the sim time
   conduit::Node n_time = get_state_var(*m_data_object.as_node().get(), "time");
   double time = 0;
@@ -1744,20 +1773,333 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
       m_cache.m_data[cache_entry.str()] = symbol;
     }
   }
+}
 
-  delete root_node;
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// true if expr uses one of names as an identifier
+bool
+references_any(const std::string &expr, const std::set<std::string> &names)
+{
+  for(const auto &name : names)
+  {
+    size_t pos = expr.find(name);
+    while(pos != std::string::npos)
+    {
+      const size_t end = pos + name.size();
+      const bool start_ok = pos == 0 ||
+        !(std::isalnum(expr[pos - 1]) || expr[pos - 1] == '_');
+      const bool end_ok = end == expr.size() ||
+        !(std::isalnum(expr[end]) || expr[end] == '_');
+      if(start_ok && end_ok)
+      {
+        return true;
+      }
+      pos = expr.find(name, pos + 1);
+    }
+  }
+  return false;
+}
+
+// the filter feeding port of filter_name
+flow::Filter *
+input_filter(flow::Graph &graph,
+             const std::string &filter_name,
+             const std::string &port)
+{
+  const conduit::Node &edges = graph.edges_in(filter_name);
+  if(!edges.has_child(port) || !edges[port].dtype().is_string())
+  {
+    return nullptr;
+  }
+  return graph.filters()[edges[port].as_string()];
+}
+
+// literal values and missing optional args can be known before execution
+bool
+static_input(flow::Graph &graph,
+             const std::string &filter_name,
+             const std::string &port,
+             conduit::Node &value)
+{
+  value.reset();
+  flow::Filter *f = input_filter(graph, filter_name, port);
+  if(f == nullptr)
+  {
+    return false;
+  }
+  const std::string type = f->type_name();
+  if(type == "expr_string" || type == "expr_integer" || type == "expr_double")
+  {
+    value = f->params()["value"];
+    return true;
+  }
+  return type == "expr_null";
+}
+
+// Find the field reductions in the graph whose field is a literal so they
+// can be computed together before the graph executes.
+void
+plan_fused_reductions(flow::Graph &graph, conduit::Node &requests)
+{
+  requests.reset();
+  for(auto &entry : graph.filters())
+  {
+    const std::string &name = entry.first;
+    const std::string type = entry.second->type_name();
+    const bool is_histogram = type == "expr_histogram";
+    if(!is_histogram &&
+       type != "expr_mesh_field_reduction_min" &&
+       type != "expr_mesh_field_reduction_max" &&
+       type != "expr_mesh_field_reduction_avg" &&
+       type != "expr_mesh_field_reduction_sum")
+    {
+      continue;
+    }
+
+    flow::Filter *field_filter = input_filter(graph, name, "arg1");
+    if(field_filter == nullptr ||
+       field_filter->type_name() != "expr_mesh_field")
+    {
+      continue;
+    }
+
+    conduit::Node field_name;
+    if(!static_input(graph, field_filter->name(), "field_name", field_name) ||
+       !field_name.dtype().is_string())
+    {
+      continue;
+    }
+
+    const std::string field = field_name.as_string();
+    conduit::Node &request = requests.has_child(field) ?
+                             requests.child(field) :
+                             requests.add_child(field);
+    if(!is_histogram)
+    {
+      continue;
+    }
+
+    conduit::Node hist;
+    conduit::Node value;
+    bool known = true;
+    const std::string ports[3] = {"num_bins", "min_val", "max_val"};
+    for(int i = 0; i < 3; ++i)
+    {
+      known &= static_input(graph, name, ports[i], value);
+      if(!value.dtype().is_empty())
+      {
+        hist[ports[i]] = value;
+      }
+    }
+    if(known)
+    {
+      request["histograms"].append() = hist;
+    }
+  }
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions::detail --
+//-----------------------------------------------------------------------------
+
+std::vector<conduit::Node>
+ExpressionEval::evaluate(const std::vector<std::string> &exprs,
+                         const std::vector<std::string> &expr_names)
+{
+  if(exprs.size() != expr_names.size())
+  {
+    ASCENT_ERROR("Expression batch: number of expressions ("
+                 << exprs.size() << ") does not match the number of names ("
+                 << expr_names.size() << ")");
+  }
+
+  std::vector<conduit::Node> results(exprs.size());
+
+  // expressions are built into the same graph until one of them refers
+  // to the result of another, which has to be in the cache first
+  std::vector<size_t> stage;
+  std::vector<ASTNode*> roots;
+  std::set<std::string> stage_names;
+
+  for(size_t i = 0; i < exprs.size(); ++i)
+  {
+    const std::string &expr = exprs[i];
+    const std::string expr_name = expr_names[i] == "" ? expr : expr_names[i];
+
+    if(detail::references_any(expr, stage_names))
+    {
+      evaluate_stage(exprs, expr_names, stage, roots, results);
+      stage.clear();
+      roots.clear();
+      stage_names.clear();
+    }
+
+    try
+    {
+      scan_string(expr.c_str());
+    }
+    catch(const char *msg)
+    {
+      for(auto root : roots)
+      {
+        delete root;
+      }
+      w.reset();
+      ASCENT_ERROR("Expression parsing error: " << msg << " in '" << expr << "'");
+    }
+
+    ASTNode *root_node = get_result();
+    // assignments define symbols that later expressions can use,
+    // so they are evaluated on their own
+    if(dynamic_cast<ASTBlock*>(root_node) != nullptr)
+    {
+      delete root_node;
+      evaluate_stage(exprs, expr_names, stage, roots, results);
+      stage.clear();
+      roots.clear();
+      stage_names.clear();
+      results[i] = evaluate(expr, expr_names[i]);
+      continue;
+    }
+
+    stage.push_back(i);
+    roots.push_back(root_node);
+    stage_names.insert(expr_name);
+  }
+
+  evaluate_stage(exprs, expr_names, stage, roots, results);
+
+  return results;
+}
+
+//-----------------------------------------------------------------------------
+void
+ExpressionEval::evaluate_stage(const std::vector<std::string> &exprs,
+                               const std::vector<std::string> &expr_names,
+                               const std::vector<size_t> &stage,
+                               const std::vector<ASTNode*> &roots,
+                               std::vector<conduit::Node> &results)
+{
+  if(stage.size() == 0)
+  {
+    return;
+  }
+
+  ASCENT_DATA_OPEN("expression_eval_batch");
+  ASCENT_DATA_ADD("expressions", static_cast<int>(stage.size()));
+  flow::Timer batch_timer;
+
+  // the results are kept alive with aliases, since a root of one
+  // expression can be a subexpression of another
+  flow::filters::register_builtin();
+
+  conduit::Node remove;
+  w.registry().add<conduit::Node>("remove", &remove, -1);
+  w.registry().add<DataObject>("dataset", &m_data_object, -1);
+  w.registry().add<conduit::Node>("cache", &m_cache.m_data, -1);
+  w.registry().add<conduit::Node>("function_table", &g_function_table, -1);
+  w.registry().add<conduit::Node>("object_table", &g_object_table, -1);
+  int cycle = get_state_var(*m_data_object.as_node().get(), "cycle").to_int32();
+  w.registry().add<int>("cycle", &cycle, -1);
+  // no assignments, so there are no symbols
+  conduit::Node symbol_table;
+  w.registry().add<conduit::Node>("symbol_table", &symbol_table, -1);
+  conduit::Node fused;
+
+  std::vector<std::string> result_names(stage.size());
+  size_t current = 0;
+  try
+  {
+    flow::Timer build_graph_timer;
+    // one visitor for all the expressions so that common
+    // subexpressions are only evaluated once
+    BuildGraphVisitor build_graph(
+        w, std::make_shared<const FusePolicy>(), false);
+    for(current = 0; current < stage.size(); ++current)
+    {
+      const size_t index = stage[current];
+      const std::string expr_name =
+        expr_names[index] == "" ? exprs[index] : expr_names[index];
+
+      roots[current]->accept(&build_graph);
+      conduit::Node root = build_graph.get_output();
+      if(root["type"].as_string() == "jitable")
+      {
+        jit_root(root, expr_name, "jit_execute_" + std::to_string(current));
+      }
+
+      result_names[current] = "expr_batch_result_" + std::to_string(current);
+      conduit::Node alias_params;
+      w.graph().add_filter("alias", result_names[current], alias_params);
+      w.graph().connect(root["filter_name"].as_string(),
+                        result_names[current],
+                        0);
+    }
+    ASCENT_DATA_ADD("build_graph time", build_graph_timer.elapsed());
+
+    flow::Timer fuse_timer;
+    conduit::Node requests;
+    detail::plan_fused_reductions(w.graph(), requests);
+    if(requests.number_of_children() > 0)
+    {
+      fused = field_reductions(*m_data_object.as_low_order_bp(), requests);
+      w.registry().add<conduit::Node>("fused_reductions", &fused, -1);
+    }
+    ASCENT_DATA_ADD("fused reductions", static_cast<int>(requests.number_of_children()));
+    ASCENT_DATA_ADD("fused reduction time", fuse_timer.elapsed());
+
+    flow::Timer execute_timer;
+    w.execute();
+    ASCENT_DATA_ADD("execute time", execute_timer.elapsed());
+  }
+  catch(std::exception &e)
+  {
+    for(auto root : roots)
+    {
+      delete root;
+    }
+    w.reset();
+    if(current < stage.size())
+    {
+      ASCENT_ERROR("Error while executing expression '"
+                   << exprs[stage[current]] << "': " << e.what());
+    }
+    ASCENT_ERROR("Error while executing expression batch: " << e.what());
+  }
+
+  for(size_t i = 0; i < stage.size(); ++i)
+  {
+    results[stage[i]] = *w.registry().fetch<conduit::Node>(result_names[i]);
+  }
+
+  remove_temporaries(remove);
+
+  for(size_t i = 0; i < stage.size(); ++i)
+  {
+    const size_t index = stage[i];
+    const std::string expr_name =
+      expr_names[index] == "" ? exprs[index] : expr_names[index];
+    cache_result(results[index], expr_name, symbol_table, cycle);
+  }
+
+  for(auto root : roots)
+  {
+    delete root;
+  }
   w.reset();
-#ifdef ASCENT_JIT_ENABLED
-  ASCENT_DATA_ADD("Device high water mark", ArrayRegistry::high_water_mark());
-  ASCENT_DATA_ADD("Current Device usage ", ArrayRegistry::device_usage());
-  ASCENT_DATA_ADD("Current host usage ", ArrayRegistry::host_usage());
-  ArrayRegistry::reset_high_water_mark();
-#endif
+  ASCENT_DATA_ADD("batch time", batch_timer.elapsed());
   ASCENT_DATA_CLOSE();
-  return return_val;
 }
 
-void ExpressionEval::jit_root(conduit::Node &root, const std::string &expr_name)
+void ExpressionEval::jit_root(conduit::Node &root,
+                              const std::string &expr_name,
+                              const std::string &filter_name)
 {
   // When the root node in the executiuon graph is a jittable
   // result, we have to complile that kernel and execute it
@@ -1765,7 +2107,7 @@ void ExpressionEval::jit_root(conduit::Node &root, const std::string &expr_name)
   {
     conduit::Node params;
     params["func"] = "execute";
-    params["filter_name"] = "jit_execute";
+    params["filter_name"] = filter_name;
     params["field_name"] = expr_name;
     conduit::Node &inp = params["inputs/jitable"];
     inp = root;
@@ -1773,11 +2115,11 @@ void ExpressionEval::jit_root(conduit::Node &root, const std::string &expr_name)
     w.graph().add_filter(
         register_jit_filter(
             w, 1, std::make_shared<const AlwaysExecutePolicy>()),
-        "jit_execute",
+        filter_name,
         params);
     // src, dest, port
-    w.graph().connect(root["filter_name"].as_string(), "jit_execute", 0);
-    root["filter_name"] = "jit_execute";
+    w.graph().connect(root["filter_name"].as_string(), filter_name, 0);
+    root["filter_name"] = filter_name;
     root["type"] = "field";
   }
 }
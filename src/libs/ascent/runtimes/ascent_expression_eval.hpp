@@ -18,6 +18,9 @@
 #include <ascent_data_object.hpp>
 
 #include "flow_workspace.hpp"
+
+class ASTNode;
+
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -70,7 +73,19 @@ protected:
   DataObject m_data_object;
   flow::Workspace w;
   static Cache m_cache;
-  void jit_root(conduit::Node &root, const std::string &expr_name);
+  void jit_root(conduit::Node &root,
+                const std::string &expr_name,
+                const std::string &filter_name = "jit_execute");
+  void remove_temporaries(conduit::Node &remove);
+  void cache_result(conduit::Node &result,
+                    const std::string &expr_name,
+                    const conduit::Node &symbol_table,
+                    const int cycle);
+  void evaluate_stage(const std::vector<std::string> &exprs,
+                      const std::vector<std::string> &expr_names,
+                      const std::vector<size_t> &stage,
+                      const std::vector<ASTNode*> &roots,
+                      std::vector<conduit::Node> &results);
 public:
   ExpressionEval(DataObject &dataset);
   ExpressionEval(conduit::Node *dataset);
@@ -89,6 +104,14 @@ public:
   static void save_cache();
 
   conduit::Node evaluate(const std::string expr, std::string exp_name = "");
+
+  // Evaluates several expressions at once and returns their results in
+  // order (empty names default to the expression). The expressions share
+  // one graph, so common subexpressions run once, and reductions of the
+  // same fields are computed in a single pass with packed collectives.
+  // Results are cached exactly as evaluate() would.
+  std::vector<conduit::Node> evaluate(const std::vector<std::string> &exprs,
+                                      const std::vector<std::string> &expr_names);
 };
 
 //-----------------------------------------------------------------------------
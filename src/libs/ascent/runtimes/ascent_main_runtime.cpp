@@ -16,6 +16,7 @@
 // standard lib includes
 #include <string.h>
 #include <algorithm>
+#include <exception>
 
 //-----------------------------------------------------------------------------
 // thirdparty includes
@@ -51,6 +52,8 @@
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/Logger.hpp>
+#include <vtkh/rendering/ImageWriter.hpp>
+#include <ascent_vtkh_data_adapter.hpp>
 
 #ifdef VTKM_CUDA
 #include <vtkm/cont/cuda/ChooseCudaDevice.h>
@@ -106,7 +109,9 @@ AscentRuntime::AscentRuntime()
  m_rank(0),
  m_default_output_dir("."),
  m_session_name("ascent_session"),
- m_field_filtering(false)
+ m_field_filtering(false),
+ m_domain_id_offset(-1),
+ m_cleaned_up(false)
 {
     m_ghost_fields.append() = "ascent_ghosts";
     flow::filters::register_builtin();
@@ -116,7 +121,16 @@ AscentRuntime::AscentRuntime()
 //-----------------------------------------------------------------------------
 AscentRuntime::~AscentRuntime()
 {
-    Cleanup();
+    // Ascent::close calls Cleanup and reports its errors, we can't
+    // throw from here
+    try
+    {
+        Cleanup();
+    }
+    catch(conduit::Error &e)
+    {
+        DisplayError(e.message());
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -384,6 +398,72 @@ AscentRuntime::Initialize(const conduit::Node &options)
       }
     }
 
+    if(options.has_path("conversion_cache"))
+    {
+      if(options["conversion_cache"].as_string() == "true")
+      {
+        m_data_object.enable_conversion_cache(true);
+      }
+    }
+
+    if(options.has_path("flow_threads"))
+    {
+      int flow_threads = options["flow_threads"].to_int32();
+      if(flow_threads < 1)
+      {
+        ASCENT_ERROR("'flow_threads' must be greater than 0");
+      }
+      m_workspace.set_number_of_threads(flow_threads);
+    }
+
+    if(options.has_path("async_image_output") &&
+       options["async_image_output"].as_string() == "true")
+    {
+#if defined(ASCENT_VTKM_ENABLED)
+      // only set once we hold a reference on async output,
+      // since Cleanup releases it
+      std::string image_output_barrier = "next_execute";
+      if(options.has_path("async_image_output_barrier"))
+      {
+        image_output_barrier = options["async_image_output_barrier"].as_string();
+        if(image_output_barrier != "execute" &&
+           image_output_barrier != "next_execute" &&
+           image_output_barrier != "close")
+        {
+          ASCENT_ERROR("'async_image_output_barrier' must be one of "
+                       <<"'execute', 'next_execute' or 'close', got '"
+                       <<image_output_barrier<<"'");
+        }
+      }
+
+      if(options.has_path("async_image_output_threads"))
+      {
+        int image_threads = options["async_image_output_threads"].to_int32();
+        if(image_threads < 1)
+        {
+          ASCENT_ERROR("'async_image_output_threads' must be greater than 0");
+        }
+        vtkh::ImageWriter::SetNumberOfThreads(image_threads);
+      }
+
+      if(options.has_path("async_image_output_queue_size"))
+      {
+        int queue_size = options["async_image_output_queue_size"].to_int32();
+        if(queue_size < 1)
+        {
+          ASCENT_ERROR("'async_image_output_queue_size' must be greater than 0");
+        }
+        vtkh::ImageWriter::SetQueueSize(queue_size);
+      }
+      // other instances in this process keep their own mode
+      vtkh::ImageWriter::AcquireAsync();
+      m_image_output_barrier = image_output_barrier;
+#else
+      ASCENT_ERROR("Ascent was not built with VTK-m support,"
+                   "but options[\"async_image_output\"] == \"true\"");
+#endif
+    }
+
     Node msg;
     ascent::about(msg["about"]);
     msg["options"] = options;
@@ -485,6 +565,31 @@ AscentRuntime::AddPublishedMeshInfo()
 void
 AscentRuntime::Cleanup()
 {
+    if(m_cleaned_up)
+    {
+        return;
+    }
+    m_cleaned_up = true;
+
+    // a failed image write is reported after the rest of the teardown
+    std::exception_ptr image_error;
+    if(!m_image_output_barrier.empty())
+    {
+        // make sure all images are on disk before we close
+        try
+        {
+            WaitForImages();
+        }
+        catch(...)
+        {
+            image_error = std::current_exception();
+        }
+#if defined(ASCENT_VTKM_ENABLED)
+        vtkh::ImageWriter::ReleaseAsync();
+#endif
+        m_image_output_barrier = "";
+    }
+
     if(m_runtime_options.has_child("timings") &&
        m_runtime_options["timings"].as_string() == "true")
     {
@@ -503,6 +608,11 @@ AscentRuntime::Cleanup()
         ftimings << m_workspace.timing_info();
         ftimings.close();
     }
+
+    if(image_error)
+    {
+        std::rethrow_exception(image_error);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -561,6 +671,23 @@ AscentRuntime::EnsureDomainIds()
       }
     }
 
+    // check if the domain layout matches the one that passed the
+    // uniqueness check on the previous publish. Missing ids are
+    // predicted using the previous offset, which only holds if
+    // every rank reports an unchanged layout
+    bool unchanged = m_domain_id_offset >= 0 &&
+                     num_domains == (int) m_domain_ids.size();
+    for(int i = 0; i < num_domains && unchanged; ++i)
+    {
+      const conduit::Node &dom = m_source.child(i);
+      int id = m_domain_id_offset + i;
+      if(dom.has_path("state/domain_id"))
+      {
+        id = dom["state/domain_id"].to_int32();
+      }
+      unchanged = id == m_domain_ids[i];
+    }
+
 #ifdef ASCENT_MPI_ENABLED
     int comm_id = flow::Workspace::default_mpi_comm();
 
@@ -568,31 +695,19 @@ AscentRuntime::EnsureDomainIds()
 
     int comm_size = 1;
     MPI_Comm_size(mpi_comm, &comm_size);
-    int *has_ids_array = new int[comm_size];
-    int *no_ids_array = new int[comm_size];
-    int boolean = has_ids ? 1 : 0;
-
-    MPI_Allgather(&boolean, 1, MPI_INT, has_ids_array, 1, MPI_INT, mpi_comm);
-    boolean = no_ids ? 1 : 0;
-    MPI_Allgather(&boolean, 1, MPI_INT, no_ids_array, 1, MPI_INT, mpi_comm);
 
-    bool global_has_ids = true;
-    bool global_no_ids = false;
-    for(int i = 0; i < comm_size; ++i)
-    {
-      if(has_ids_array[i] == 0)
-      {
-        global_has_ids = false;
-      }
-      if(no_ids_array[i] == 1)
-      {
-        global_no_ids = true;
-      }
-    }
-    has_ids = global_has_ids;
-    no_ids = global_no_ids;
-    delete[] has_ids_array;
-    delete[] no_ids_array;
+    // fuse the consistency and layout checks into a single
+    // fixed size reduction
+    int local_flags[3];
+    int global_flags[3];
+    local_flags[0] = has_ids ? 1 : 0;
+    local_flags[1] = no_ids ? 0 : 1;
+    local_flags[2] = unchanged ? 1 : 0;
+    MPI_Allreduce(local_flags, global_flags, 3, MPI_INT, MPI_MIN, mpi_comm);
+
+    has_ids = global_flags[0] == 1;
+    no_ids = global_flags[1] == 0;
+    unchanged = global_flags[2] == 1;
 #endif
 
     bool consistent_ids = (has_ids || no_ids);
@@ -602,6 +717,29 @@ AscentRuntime::EnsureDomainIds()
                   <<"or all domains do not have an id");
     }
 
+    if(unchanged)
+    {
+      // the ids are identical to the ones we already verified
+      for(int i = 0; i < num_domains; ++i)
+      {
+        conduit::Node &dom = m_source.child(i);
+        if(!dom.has_path("state/domain_id"))
+        {
+          dom["state/domain_id"] = m_domain_ids[i];
+        }
+      }
+#if _DEBUG
+      stream << "AscentRuntime::EnsureDomainIDs [CACHED]: "
+             << ensureDomainIDsTimer.elapsed() << "\n";
+      stream.close();
+#endif
+      return;
+    }
+
+    // invalidate the cache until the new layout passes the checks
+    m_domain_id_offset = -1;
+    m_domain_ids.clear();
+
     int domain_offset = 0;
 
 #if _DEBUG
@@ -609,21 +747,15 @@ AscentRuntime::EnsureDomainIds()
 #endif
 
 #ifdef ASCENT_MPI_ENABLED
-    int *domains_per_rank = new int[comm_size];
-    MPI_Allgather(&num_domains, 1, MPI_INT, domains_per_rank, 1, MPI_INT, mpi_comm);
-    for(int i = 0; i < m_rank; ++i)
-    {
-      domain_offset += domains_per_rank[i];
-    }
-    int total_domains = 0;
-    for(int i = 0; i < comm_size; i++)
+    MPI_Exscan(&num_domains, &domain_offset, 1, MPI_INT, MPI_SUM, mpi_comm);
+    // the result of the exclusive scan is undefined on rank 0
+    if(m_rank == 0)
     {
-      total_domains += domains_per_rank[i];
+      domain_offset = 0;
     }
-    delete[] domains_per_rank;
 #endif
 
-    std::unordered_set<int> local_unique_ids;
+    std::vector<int> domain_ids(num_domains);
     for(int i = 0; i < num_domains; ++i)
     {
       conduit::Node &dom = m_source.child(i);
@@ -631,107 +763,116 @@ AscentRuntime::EnsureDomainIds()
       if(!dom.has_path("state/domain_id"))
       {
         dom["state/domain_id"] = domain_offset + i;
-        local_unique_ids.insert(domain_offset + i);
-      }
-      else
-      {
-        local_unique_ids.insert(dom["state/domain_id"].to_int32());
       }
+      domain_ids[i] = dom["state/domain_id"].to_int32();
     }
 
-    int unique_ids = 1;
+#ifndef ASCENT_MPI_ENABLED
+    std::unordered_set<int> local_unique_ids(domain_ids.begin(),
+                                             domain_ids.end());
     if(local_unique_ids.size() != num_domains)
     {
-      unique_ids = 0;
-    }
-#ifdef ASCENT_MPI_ENABLED
-    conduit::Node n_ids;
-    n_ids.set(DataType::c_int(comm_size));
-    int *unique_ids_array = n_ids.value();//new int[comm_size];
-    MPI_Allgather(&unique_ids, 1, MPI_INT, unique_ids_array, 1, MPI_INT, mpi_comm);
-    std::stringstream ss;
-    for(int i = 0; i < comm_size; i++)
-    {
-      if(unique_ids_array[i] == 0)
-      {
-	unique_ids = 0;
-	ss << i << " ";
-      } 
-    }
-
-    if(!unique_ids)
-      ASCENT_ERROR("Local Domain IDs are not unique on ranks: " << ss.str());
-#else
-    if(!unique_ids)
       ASCENT_ERROR("Local Domain IDs are not unique ");
-#endif
+    }
 #if _DEBUG
     float local_check_timer_time = local_check_timer.elapsed();
     std::stringstream local_check_timer_log;
     local_check_timer_log << "Local Uniqueness Check: " << local_check_timer_time << "\n";
     stream << local_check_timer_log.str();
 #endif
-
-
-#ifdef ASCENT_MPI_ENABLED
+#else
 
 #if _DEBUG
     conduit::utils::Timer global_check_timer;
 #endif
-    conduit::Node n_dom_ids;
-    conduit::Node n_global_dom_ids;
-    conduit::Node n_dom_rank;
-    conduit::Node n_global_dom_rank;
-    n_dom_ids.set(DataType::c_int(total_domains));
-    n_global_dom_ids.set(DataType::c_int(total_domains));
-    n_dom_rank.set(DataType::c_int(total_domains));
-    n_global_dom_rank.set(DataType::c_int(total_domains));
-    int *domain_ids_per_rank = n_dom_ids.value();
-    int *global_domain_ids = n_global_dom_ids.value();
-    int *domain_rank = n_dom_rank.value();
-    int *global_domain_rank = n_global_dom_rank.value();
-
-    for(int i = 0; i < total_domains; i++)
-    {
-      domain_ids_per_rank[i] = -1;
-      domain_rank[i] = -1;
+    // each domain id is owned by rank (domain_id % comm_size). Every rank
+    // sends its ids to their owners, so each owner only sees the ids that
+    // map to it and can find duplicates (local or global) on its own.
+    std::vector<int> send_counts(comm_size, 0);
+    std::vector<int> recv_counts(comm_size, 0);
+    std::vector<int> send_displs(comm_size, 0);
+    std::vector<int> recv_displs(comm_size, 0);
+    std::vector<int> owners(num_domains);
+    for(int i = 0; i < num_domains; ++i)
+    {
+      int owner = domain_ids[i] % comm_size;
+      if(owner < 0)
+      {
+        owner += comm_size;
+      }
+      owners[i] = owner;
+      send_counts[owner]++;
+    }
+
+    MPI_Alltoall(&send_counts[0], 1, MPI_INT,
+                 &recv_counts[0], 1, MPI_INT,
+                 mpi_comm);
+
+    int total_recv = recv_counts[0];
+    for(int i = 1; i < comm_size; ++i)
+    {
+      send_displs[i] = send_displs[i-1] + send_counts[i-1];
+      recv_displs[i] = recv_displs[i-1] + recv_counts[i-1];
+      total_recv += recv_counts[i];
     }
+
+    std::vector<int> send_ids(num_domains);
+    std::vector<int> recv_ids(total_recv);
+    std::vector<int> offsets(send_displs);
     for(int i = 0; i < num_domains; ++i)
     {
-      conduit::Node &dom = m_source.child(i);
-      domain_ids_per_rank[domain_offset + i] = dom["state/domain_id"].to_int32();
-      domain_rank[domain_offset + i] = m_rank;
+      send_ids[offsets[owners[i]]++] = domain_ids[i];
     }
 
-    MPI_Allreduce(domain_ids_per_rank, global_domain_ids, total_domains, MPI_INT, MPI_MAX,  mpi_comm);
-    MPI_Allreduce(domain_rank, global_domain_rank, total_domains, MPI_INT, MPI_MAX,  mpi_comm);
+    MPI_Alltoallv(send_ids.data(), &send_counts[0], &send_displs[0], MPI_INT,
+                  recv_ids.data(), &recv_counts[0], &recv_displs[0], MPI_INT,
+                  mpi_comm);
 
-    std::unordered_set<int> global_ids;
-    for(int i = 0; i < total_domains; i++)
+    std::map<int,std::vector<int>> owned_ids;
+    for(int r = 0; r < comm_size; ++r)
     {
-      global_ids.insert(global_domain_ids[i]);
+      for(int i = 0; i < recv_counts[r]; ++i)
+      {
+        owned_ids[recv_ids[recv_displs[r] + i]].push_back(r);
+      }
     }
 
-    if(global_ids.size() != total_domains)
+    std::stringstream ss;
+    int local_duplicates = 0;
+    for(auto itr = owned_ids.begin(); itr != owned_ids.end(); ++itr)
     {
-      std::map<int,std::vector<int>> map_global_ids;
-      for(int i = 0; i < total_domains; i++)
+      if(itr->second.size() > 1)
       {
-        map_global_ids[global_domain_ids[i]].push_back(global_domain_rank[i]);
+        local_duplicates = 1;
+        ss << "domain: " << itr->first << " on ranks: ";
+        for(auto iitr = itr->second.begin(); iitr != itr->second.end(); ++iitr)
+        {
+          ss << *iitr << " ";
+        }
+        ss << "\n";
       }
-      for(auto itr = map_global_ids.begin(); itr != map_global_ids.end(); ++itr)
+    }
+
+    int global_duplicates = 0;
+    MPI_Allreduce(&local_duplicates, &global_duplicates, 1,
+                  MPI_INT, MPI_MAX, mpi_comm);
+
+    if(global_duplicates)
+    {
+      // error path only: gather the reports from the owning ranks
+      // so every rank throws the same message
+      conduit::Node n_report, n_reports;
+      n_report.set(ss.str());
+      conduit::relay::mpi::all_gather_using_schema(n_report,
+                                                   n_reports,
+                                                   mpi_comm);
+      std::stringstream report;
+      const int num_reports = n_reports.number_of_children();
+      for(int i = 0; i < num_reports; ++i)
       {
-        if(itr->second.size() > 1)
-	{
-	  ss << "domain: " << itr->first << " on ranks: ";
-	  for(auto iitr = itr->second.begin(); iitr != itr->second.end(); ++iitr)
-	  {
-            ss << *iitr << " ";
-	  }
-	  ss << "\n";
-	}
+        report << n_reports.child(i).as_string();
       }
-      ASCENT_ERROR("Global Domain IDs are not unique for " << ss.str());
+      ASCENT_ERROR("Domain IDs are not unique for " << report.str());
     }
 #if _DEBUG
     float global_check_timer_time = global_check_timer.elapsed();
@@ -741,6 +882,9 @@ AscentRuntime::EnsureDomainIds()
 #endif
 #endif
 
+    m_domain_ids = domain_ids;
+    m_domain_id_offset = domain_offset;
+
 #if _DEBUG
     float ensureDomainIDs_time = ensureDomainIDsTimer.elapsed();
     std::stringstream ensureDomainIDs_log;
@@ -1358,10 +1502,37 @@ void
 AscentRuntime::CreateTriggers(const conduit::Node &triggers)
 {
   std::vector<std::string> names = triggers.child_names();
+  // the conditions of triggers on the same pipeline are evaluated
+  // together by the first of them, which also fires the actions
+  std::map<std::string,int> heads;
+  conduit::Node batched;
   for(int i = 0; i < triggers.number_of_children(); ++i)
   {
-    conduit::Node trigger = triggers.child(i);
-    ConvertTriggerToFlow(trigger, names[i]);
+    conduit::Node &trigger = batched.append();
+    trigger = triggers.child(i);
+    if(!trigger.has_path("params/condition") ||
+       trigger.has_path("params/callback"))
+    {
+      continue;
+    }
+    std::string pipeline = "source";
+    if(trigger.has_path("pipeline"))
+    {
+      pipeline = trigger["pipeline"].as_string();
+    }
+    if(heads.find(pipeline) == heads.end())
+    {
+      heads[pipeline] = i;
+      continue;
+    }
+    conduit::Node &head = batched.child(heads[pipeline]);
+    head["params/batch/" + names[i]] = trigger["params"];
+    trigger["params/batch_head"] = names[heads[pipeline]];
+  }
+
+  for(int i = 0; i < triggers.number_of_children(); ++i)
+  {
+    ConvertTriggerToFlow(batched.child(i), names[i]);
   }
 }
 
@@ -1370,11 +1541,37 @@ void
 AscentRuntime::CreateQueries(const conduit::Node &queries)
 {
   std::vector<std::string> names = queries.child_names();
+  const std::string default_pipeline =
+    CreateDefaultFilters()["queries"].as_string();
+  // consecutive queries on the same pipeline are evaluated together
+  // by the first of them, later queries can still use earlier results
+  conduit::Node batched;
+  int head = -1;
+  std::string head_pipeline;
+  for(int i = 0; i < queries.number_of_children(); ++i)
+  {
+    conduit::Node &query = batched.append();
+    query = queries.child(i);
+    std::string pipeline = default_pipeline;
+    if(query.has_path("pipeline"))
+    {
+      pipeline = query["pipeline"].as_string();
+    }
+    if(head == -1 || pipeline != head_pipeline ||
+       !query.has_path("params/expression"))
+    {
+      head = i;
+      head_pipeline = pipeline;
+      continue;
+    }
+    batched.child(head)["params/batch/" + names[i]] = query["params"];
+    query["params/batch_head"] = names[head];
+  }
+
   std::string prev_name = "";
   for(int i = 0; i < queries.number_of_children(); ++i)
   {
-    conduit::Node query = queries.child(i);
-    ConvertQueryToFlow(query, names[i], prev_name);
+    ConvertQueryToFlow(batched.child(i), names[i], prev_name);
     prev_name = names[i];
   }
 }
@@ -1982,6 +2179,13 @@ AscentRuntime::Execute(const conduit::Node &actions)
     // --- open try --- //
     try
     {
+        // images from the previous execute are allowed to finish
+        // while the simulation advances
+        if(m_image_output_barrier == "next_execute")
+        {
+          WaitForImages();
+        }
+
         ResetInfo();
         AddPublishedMeshInfo();
 
@@ -2051,6 +2255,7 @@ AscentRuntime::Execute(const conduit::Node &actions)
           vtkh::DataLogger::GetInstance()->OpenLogEntry(ss.str());
           vtkh::DataLogger::GetInstance()->AddLogData("cycle", cycle);
         }
+        VTKHDataAdapter::ResetCopyReport();
 #endif
         // now execute the data flow graph
         m_workspace.execute();
@@ -2060,12 +2265,24 @@ AscentRuntime::Execute(const conduit::Node &actions)
         {
           vtkh::DataLogger::GetInstance()->CloseLogEntry();
         }
+        // arrays copied converting blueprint data for vtk-h
+        VTKHDataAdapter::CopyReport(m_info["vtkh_copies"]);
 #endif
         if(m_save_session_actions.number_of_children() > 0)
         {
           SaveSession();
         }
 
+        // with async image output renders are only guaranteed to
+        // be on disk after a barrier, the web interface needs them now
+        if(m_image_output_barrier == "execute" ||
+           (!m_image_output_barrier.empty() &&
+            m_runtime_options.has_path("web/stream") &&
+            m_runtime_options["web/stream"].as_string() == "true"))
+        {
+          WaitForImages();
+        }
+
         // add render results to info
         Node render_file_names;
         Node renders;
@@ -2150,6 +2367,15 @@ AscentRuntime::Execute(const conduit::Node &actions)
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::WaitForImages()
+{
+#if defined(ASCENT_VTKM_ENABLED)
+    vtkh::ImageWriter::Wait();
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::DisplayError(const std::string &msg)
@@ -87,6 +87,17 @@ private:
 
     conduit::Node     m_comments;
 
+    // domain ids (and offset used for generated ids) from the last
+    // publish that passed the uniqueness check, offset < 0 if invalid
+    std::vector<int>  m_domain_ids;
+    int               m_domain_id_offset;
+
+    // empty if images are written synchronously, otherwise where
+    // Execute waits for pending images ("execute", "next_execute", "close")
+    std::string       m_image_output_barrier;
+    // Cleanup is called by close and again by the destructor
+    bool              m_cleaned_up;
+
     void              ResetInfo();
     void              AddPublishedMeshInfo();
 
@@ -129,6 +140,7 @@ private:
 
     void BuildGraph(const conduit::Node &actions);
     void EnsureDomainIds();
+    void WaitForImages();
     void PopulateMetadata();
 
     std::string GetDefaultImagePrefix(const std::string scene);
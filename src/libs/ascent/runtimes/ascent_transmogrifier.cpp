@@ -19,6 +19,7 @@
 #include "ascent_logging.hpp"
 #include <conduit_blueprint.hpp>
 #include <algorithm>
+#include <cstdint>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -147,6 +148,85 @@ void Transmogrifier::to_poly(conduit::Node &doms, conduit::Node &to_vtkh)
   }
 }
 
+namespace detail
+{
+
+void describe_buffers(const conduit::Node &node, conduit::Node &out)
+{
+  const int num_children = node.number_of_children();
+  if(num_children > 0)
+  {
+    const bool is_list = node.dtype().is_list();
+    for(int i = 0; i < num_children; ++i)
+    {
+      const conduit::Node &child = node.child(i);
+      describe_buffers(child, is_list ? out.append() : out[child.name()]);
+    }
+  }
+  else if(node.dtype().is_string() ||
+          node.dtype().number_of_elements() <= 16)
+  {
+    // small values like dims, origin and shape names
+    out["value"].set(node);
+  }
+  else
+  {
+    out["ptr"] = (conduit::uint64)((uintptr_t)node.element_ptr(0));
+    out["dtype"] = node.dtype().name();
+    out["count"] = node.dtype().number_of_elements();
+    out["stride"] = node.dtype().stride();
+  }
+}
+
+} // namespace detail
+
+std::string Transmogrifier::topology_signature(const conduit::Node &dom,
+                                               const std::string &topo_name)
+{
+  const conduit::Node &n_topo = dom["topologies/" + topo_name];
+  const std::string coords_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = dom["coordsets/" + coords_name];
+
+  conduit::Node sig;
+  detail::describe_buffers(n_topo, sig["topology"]);
+  detail::describe_buffers(n_coords, sig["coordset"]);
+
+  if(dom.has_path("state/topology_generation"))
+  {
+    sig["generation"] = dom["state/topology_generation"].to_int64();
+  }
+
+  return sig.to_json();
+}
+
+//-----------------------------------------------------------------------------
+std::string Transmogrifier::connectivity_signature(const conduit::Node &dom,
+                                                   const std::string &topo_name)
+{
+  const conduit::Node &n_topo = dom["topologies/" + topo_name];
+  const std::string coords_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = dom["coordsets/" + coords_name];
+
+  conduit::Node sig;
+  detail::describe_buffers(n_topo, sig["topology"]);
+  sig["coordset/type"] = n_coords["type"].as_string();
+  if(n_coords.has_child("dims"))
+  {
+    sig["coordset/dims"].set(n_coords["dims"]);
+  }
+  if(n_coords.has_child("values"))
+  {
+    const conduit::Node &n_values = n_coords["values"];
+    for(int i = 0; i < n_values.number_of_children(); ++i)
+    {
+      sig["coordset/counts"].append() =
+        (conduit::int64) n_values.child(i).dtype().number_of_elements();
+    }
+  }
+
+  return sig.to_json();
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
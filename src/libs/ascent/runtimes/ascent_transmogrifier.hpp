@@ -37,6 +37,21 @@ static bool is_poly(const conduit::Node &doms);
 
 static void to_poly(conduit::Node &doms, conduit::Node &to_vtkh);
 
+// Describes the identity of a domain's topology and its coordset:
+// data pointers and sizes of large arrays, values of small ones
+// (e.g. uniform dims and spacing) and the optional user supplied
+// "state/topology_generation" stamp. Two domains with the same
+// signature share the same mesh, so conversions of it can be reused.
+static std::string topology_signature(const conduit::Node &dom,
+                                      const std::string &topo_name);
+
+// Like topology_signature, but only describes the connectivity: the
+// topology and the size of the coordset. It ignores the
+// "state/topology_generation" stamp, so domains whose coordinates
+// moved but whose connectivity did not share this signature.
+static std::string connectivity_signature(const conduit::Node &dom,
+                                          const std::string &topo_name);
+
 };
 
 //-----------------------------------------------------------------------------
@@ -40,6 +40,7 @@
 #include <ascent_logging.hpp>
 #include <ascent_block_timer.hpp>
 #include <ascent_mpi_utils.hpp>
+#include "ascent_transmogrifier.hpp"
 #include <vtkh/utils/vtkm_array_utils.hpp>
 #include <vtkh/utils/vtkm_dataset_info.hpp>
 
@@ -115,18 +116,94 @@ const float32* GetNodePointer<float32>(const conduit::Node &node)
   return node.as_float32_ptr();
 }
 
+//
+// arrays that were copied instead of zero copied since the last
+// reset, see VTKHDataAdapter::CopyReport
+//
+void ResetCopyReport(conduit::Node &report)
+{
+  report.reset();
+  report["bytes"] = (int64) 0;
+  report["arrays"].set(DataType::list());
+}
+
+conduit::Node &CopyReportNode()
+{
+  static conduit::Node report;
+  if(!report.has_child("bytes"))
+  {
+    ResetCopyReport(report);
+  }
+  return report;
+}
+
+void ResetCopyReport()
+{
+  ResetCopyReport(CopyReportNode());
+}
+
+void RecordCopy(const conduit::Node &source,
+                const std::string &reason,
+                const index_t bytes)
+{
+  conduit::Node &report = CopyReportNode();
+  conduit::Node &entry = report["arrays"].append();
+  entry["path"] = source.path();
+  entry["reason"] = reason;
+  entry["bytes"] = (int64) bytes;
+  report["bytes"] = report["bytes"].to_int64() + (int64) bytes;
+}
+
 template<typename T>
-void CopyArray(vtkm::cont::ArrayHandle<T> &vtkm_handle, const T* vals_ptr, const int size, bool zero_copy)
+void CopyArray(vtkm::cont::ArrayHandle<T> &vtkm_handle,
+               const T* vals_ptr,
+               const int size,
+               bool zero_copy,
+               const conduit::Node &source)
 {
   vtkm::CopyFlag copy = vtkm::CopyFlag::On;
   if(zero_copy)
   {
     copy = vtkm::CopyFlag::Off;
   }
+  else
+  {
+    RecordCopy(source, "zero copy disabled", size * sizeof(T));
+  }
 
   vtkm_handle = vtkm::cont::make_ArrayHandle(vals_ptr, size, copy);
 }
 
+//
+// copies a blueprint array with a (multiple of the native) element
+// stride into a compact handle, converting the values to T.
+// the copy is done by vtkm, so it runs on the active device
+//
+template<typename S, typename T>
+void CopyStridedArray(vtkm::cont::ArrayHandle<T> &vtkm_handle,
+                      const conduit::Node &source,
+                      const std::string &reason)
+{
+  const index_t size = source.dtype().number_of_elements();
+  if(size == 0)
+  {
+    vtkm_handle.Allocate(0);
+    return;
+  }
+  const index_t element_stride = source.dtype().stride() / sizeof(S);
+  const S *vals_ptr = (const S*) source.element_ptr(0);
+  vtkm::cont::ArrayHandle<S> source_array
+    = vtkm::cont::make_ArrayHandle(vals_ptr,
+                                   (size - 1) * element_stride + 1,
+                                   vtkm::CopyFlag::Off);
+  vtkm::cont::ArrayHandleStride<S> stride_handle(source_array,
+                                                 size,
+                                                 element_stride,
+                                                 0); // offset
+  vtkm::cont::Algorithm::Copy(stride_handle, vtkm_handle);
+  RecordCopy(source, reason, size * sizeof(T));
+}
+
 template<typename T>
 vtkm::cont::CoordinateSystem
 GetExplicitCoordinateSystem(const conduit::Node &n_coords,
@@ -137,12 +214,6 @@ GetExplicitCoordinateSystem(const conduit::Node &n_coords,
                             index_t &z_element_stride,
                             bool zero_copy)
 {
-    vtkm::CopyFlag copy = vtkm::CopyFlag::On;
-    if(zero_copy)
-    {
-      copy = vtkm::CopyFlag::Off;
-    }
-      
     int nverts = n_coords["values/x"].dtype().number_of_elements();
     //bool is_interleaved = blueprint::mcarray::is_interleaved(n_coords["values"]);
 
@@ -159,41 +230,33 @@ GetExplicitCoordinateSystem(const conduit::Node &n_coords,
     if(x_element_stride == 1)
     {
       const T *x_verts_ptr = n_coords["values/x"].value();
-      detail::CopyArray(x_coords_handle, x_verts_ptr, nverts, zero_copy);
+      detail::CopyArray(x_coords_handle,
+                        x_verts_ptr,
+                        nverts,
+                        zero_copy,
+                        n_coords["values/x"]);
     }
     else
     {
-      int x_verts_expanded = nverts * x_element_stride;
-      const T *x_verts_ptr = n_coords["values/x"].value();
-      vtkm::cont::ArrayHandle<T> x_source_array = vtkm::cont::make_ArrayHandle<T>(x_verts_ptr,
-                                                                                  x_verts_expanded,
-                                                                                  copy);
-      vtkm::cont::ArrayHandleStride<T> x_stride_handle(x_source_array,
-                                                       nverts,
-                                                       x_element_stride,
-                                                       0); // offset
-
-      vtkm::cont::Algorithm::Copy(x_stride_handle, x_coords_handle);
+      detail::CopyStridedArray<T>(x_coords_handle,
+                                  n_coords["values/x"],
+                                  "strided coordinates");
     }
 
     if(y_element_stride == 1)
     {
       const T *y_verts_ptr = n_coords["values/y"].value();
-      detail::CopyArray(y_coords_handle, y_verts_ptr, nverts, zero_copy);
+      detail::CopyArray(y_coords_handle,
+                        y_verts_ptr,
+                        nverts,
+                        zero_copy,
+                        n_coords["values/y"]);
     }
     else
     {
-      int y_verts_expanded = nverts * y_element_stride;
-      const T *y_verts_ptr = n_coords["values/y"].value();
-      vtkm::cont::ArrayHandle<T> y_source_array = vtkm::cont::make_ArrayHandle<T>(y_verts_ptr,
-                                                                                  y_verts_expanded,
-                                                                                  copy);
-      vtkm::cont::ArrayHandleStride<T> y_stride_handle(y_source_array,
-                                                       nverts,
-                                                       y_element_stride,
-                                                       0); // offset
-
-      vtkm::cont::Algorithm::Copy(y_stride_handle, y_coords_handle);
+      detail::CopyStridedArray<T>(y_coords_handle,
+                                  n_coords["values/y"],
+                                  "strided coordinates");
     }
 
     if(z_element_stride == 0)
@@ -208,22 +271,18 @@ GetExplicitCoordinateSystem(const conduit::Node &n_coords,
     {
       ndims = 3;
       const T *z_verts_ptr = n_coords["values/z"].value();
-      detail::CopyArray(z_coords_handle, z_verts_ptr, nverts, zero_copy);
+      detail::CopyArray(z_coords_handle,
+                        z_verts_ptr,
+                        nverts,
+                        zero_copy,
+                        n_coords["values/z"]);
     }
     else
     {
       ndims = 3;
-      int z_verts_expanded = nverts * z_element_stride;
-      const T *z_verts_ptr = n_coords["values/z"].value();
-      vtkm::cont::ArrayHandle<T> z_source_array = vtkm::cont::make_ArrayHandle<T>(z_verts_ptr,
-                                                                                  z_verts_expanded,
-                                                                                  copy);
-      vtkm::cont::ArrayHandleStride<T> z_stride_handle(z_source_array,
-                                                       nverts,
-                                                       z_element_stride,
-                                                       0); // offset
-
-      vtkm::cont::Algorithm::Copy(z_stride_handle, z_coords_handle);
+      detail::CopyStridedArray<T>(z_coords_handle,
+                                  n_coords["values/z"],
+                                  "strided coordinates");
     }
 
     return vtkm::cont::CoordinateSystem(name,
@@ -265,6 +324,11 @@ vtkm::cont::Field GetField(const conduit::Node &node,
 
   const T *values_ptr = node.value();
 
+  if(!zero_copy)
+  {
+    RecordCopy(node, "zero copy disabled", num_vals * element_stride * sizeof(T));
+  }
+
   vtkm::cont::Field field;
   // base case is naturally stride data
   if(element_stride == 1)
@@ -341,7 +405,51 @@ vtkm::cont::Field GetVectorField(T *values_ptr,
 }
 
 //
-// extract a vector from 3 separate arrays
+// wraps one component of a vector stored as separate arrays. compact
+// components follow zero_copy, strided components have to be copied
+// since the soa handle needs basic arrays
+//
+template<typename T>
+void VectorComponent(vtkm::cont::ArrayHandle<T> &handle,
+                     const conduit::Node &comp,
+                     const int num_vals,
+                     bool zero_copy)
+{
+  if(comp.dtype().is_compact())
+  {
+    detail::CopyArray(handle,
+                      GetNodePointer<T>(comp),
+                      num_vals,
+                      zero_copy,
+                      comp);
+  }
+  else if(comp.dtype().stride() % sizeof(T) == 0)
+  {
+    detail::CopyStridedArray<T>(handle, comp, "strided vector component");
+  }
+  else
+  {
+    handle.Allocate(num_vals);
+    Node n_tmp;
+    n_tmp.set_external(vtkh::GetVTKMPointer(handle), num_vals);
+    if(std::is_same<T,float32>::value)
+    {
+      comp.to_float32_array(n_tmp);
+    }
+    else
+    {
+      comp.to_float64_array(n_tmp);
+    }
+    RecordCopy(comp, "unaligned vector component", num_vals * sizeof(T));
+  }
+}
+
+//
+// extract a vector from 2 or 3 separate arrays
+//
+// the components are kept as separate arrays in a soa handle, which
+// vtk-m (and the default storage list vtk-h dispatches on) supports
+// for fields, so compact components are not copied
 //
 template<typename T>
 void ExtractVector(vtkm::cont::DataSet *dset,
@@ -355,8 +463,6 @@ void ExtractVector(vtkm::cont::DataSet *dset,
                    const std::string &topo_name,
                    bool zero_copy)
 {
-  // TODO: Do we need to fix this for striding?
-  // GetField<T> expects compact
   if(dims != 2 && dims != 3)
   {
     ASCENT_ERROR("Extract vector: only 2 and 3 dims supported given "<<dims);
@@ -377,62 +483,31 @@ void ExtractVector(vtkm::cont::DataSet *dset,
                  <<assoc_str<<" field_name "<<field_name);
   }
 
-  if(dims == 2)
-  {
-    const T *x_ptr = GetNodePointer<T>(u);
-    const T *y_ptr = GetNodePointer<T>(v);
-
-    vtkm::cont::ArrayHandle<T> x_handle;
-    vtkm::cont::ArrayHandle<T> y_handle;
+  vtkm::cont::ArrayHandle<T> x_handle;
+  vtkm::cont::ArrayHandle<T> y_handle;
 
-    // always zero copy because we are about to make a copy
-    detail::CopyArray(x_handle, x_ptr, num_vals, true);
-    detail::CopyArray(y_handle, y_ptr, num_vals, true);
+  VectorComponent(x_handle, u, num_vals, zero_copy);
+  VectorComponent(y_handle, v, num_vals, zero_copy);
 
-
-    auto composite  = make_ArrayHandleSOA(x_handle,
-                                          y_handle);
-
-    vtkm::cont::ArrayHandle<vtkm::Vec<T,2>> interleaved_handle;
-    interleaved_handle.Allocate(num_vals);
-    // Calling this without forcing serial could cause serious problems
-    {
-      vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
-      vtkm::cont::ArrayCopy(composite, interleaved_handle);
-    }
-
-    vtkm::cont::Field field(field_name, vtkm_assoc, interleaved_handle);
+  if(dims == 2)
+  {
+    vtkm::cont::Field field(field_name,
+                            vtkm_assoc,
+                            vtkm::cont::make_ArrayHandleSOA(x_handle,
+                                                            y_handle));
     dset->AddField(field);
   }
 
   if(dims == 3)
   {
-    const T *x_ptr = GetNodePointer<T>(u);
-    const T *y_ptr = GetNodePointer<T>(v);
-    const T *z_ptr = GetNodePointer<T>(w);
-
-    vtkm::cont::ArrayHandle<T> x_handle;
-    vtkm::cont::ArrayHandle<T> y_handle;
     vtkm::cont::ArrayHandle<T> z_handle;
+    VectorComponent(z_handle, w, num_vals, zero_copy);
 
-    // always zero copy because we are about to make a copy
-    detail::CopyArray(x_handle, x_ptr, num_vals, true);
-    detail::CopyArray(y_handle, y_ptr, num_vals, true);
-    detail::CopyArray(z_handle, z_ptr, num_vals, true);
-
-    auto composite  = make_ArrayHandleSOA(x_handle,
-                                          y_handle,
-                                          z_handle);
-
-    vtkm::cont::ArrayHandle<vtkm::Vec<T,3>> interleaved_handle;
-    interleaved_handle.Allocate(num_vals);
-    // Calling this without forcing serial could cause serious problems
-    {
-      vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
-      vtkm::cont::ArrayCopy(composite, interleaved_handle);
-    }
-
-    vtkm::cont::Field field(field_name, vtkm_assoc, interleaved_handle);
+    vtkm::cont::Field field(field_name,
+                            vtkm_assoc,
+                            vtkm::cont::make_ArrayHandleSOA(x_handle,
+                                                            y_handle,
+                                                            z_handle));
     dset->AddField(field);
   }
 }
@@ -495,9 +570,106 @@ bool allEqual(std::vector<T> const &v)
 // VTKHDataAdapter public methods
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// VTKHMeshCache methods
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+VTKHMeshCache::VTKHMeshCache()
+: m_hits(0),
+  m_misses(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+VTKHMeshCache::~VTKHMeshCache()
+{
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<vtkm::cont::DataSet>
+VTKHMeshCache::fetch(const std::string &key,
+                     const std::string &signature,
+                     int &neles,
+                     int &nverts)
+{
+    auto itr = m_entries.find(key);
+    if(itr == m_entries.end() || itr->second.signature != signature)
+    {
+      m_misses++;
+      return nullptr;
+    }
+
+    m_hits++;
+    itr->second.used = true;
+    neles  = itr->second.neles;
+    nverts = itr->second.nverts;
+    return itr->second.mesh;
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHMeshCache::add(const std::string &key,
+                   const std::string &signature,
+                   std::shared_ptr<vtkm::cont::DataSet> mesh,
+                   int neles,
+                   int nverts)
+{
+    Entry &entry = m_entries[key];
+    entry.signature = signature;
+    entry.mesh   = mesh;
+    entry.neles  = neles;
+    entry.nverts = nverts;
+    entry.used   = true;
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHMeshCache::prune()
+{
+    auto itr = m_entries.begin();
+    while(itr != m_entries.end())
+    {
+      if(!itr->second.used)
+      {
+        itr = m_entries.erase(itr);
+      }
+      else
+      {
+        itr->second.used = false;
+        ++itr;
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHMeshCache::clear()
+{
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+//-----------------------------------------------------------------------------
+int
+VTKHMeshCache::hits() const
+{
+    return m_hits;
+}
+
+//-----------------------------------------------------------------------------
+int
+VTKHMeshCache::misses() const
+{
+    return m_misses;
+}
+
+//-----------------------------------------------------------------------------
 VTKHCollection*
 VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
-                                           bool zero_copy)
+                                           bool zero_copy,
+                                           VTKHMeshCache *mesh_cache)
 {
     // We must separate different topologies into
     // different vtkh data sets
@@ -540,7 +712,33 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
       for(int t = 0; t < topo_names.size(); ++t)
       {
         const std::string topo_name = topo_names[t];
-        vtkm::cont::DataSet *dset = BlueprintToVTKmDataSet(dom, zero_copy, topo_name);
+        vtkm::cont::DataSet *dset = nullptr;
+        if(mesh_cache != nullptr)
+        {
+          std::ostringstream key;
+          key << domain_id << "/" << topo_name;
+          const std::string signature
+            = Transmogrifier::topology_signature(dom, topo_name);
+
+          int neles = 0;
+          int nverts = 0;
+          std::shared_ptr<vtkm::cont::DataSet> mesh
+            = mesh_cache->fetch(key.str(), signature, neles, nverts);
+
+          if(mesh == nullptr)
+          {
+            mesh.reset(BlueprintToVTKmMesh(dom, zero_copy, topo_name, neles, nverts));
+            mesh_cache->add(key.str(), signature, mesh, neles, nverts);
+          }
+
+          // shallow copy of the cached coordinate system and cell set
+          dset = new vtkm::cont::DataSet(*mesh);
+          AddFields(dom, topo_name, neles, nverts, dset, zero_copy);
+        }
+        else
+        {
+          dset = BlueprintToVTKmDataSet(dom, zero_copy, topo_name);
+        }
         datasets[topo_name].AddDomain(*dset,domain_id);
         delete dset;
       }
@@ -567,6 +765,12 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
       res->add(dset_it.second, dset_it.first);
     }
 
+    if(mesh_cache != nullptr)
+    {
+      // drop meshes of domains that are no longer present
+      mesh_cache->prune();
+    }
+
     return res;
 }
 
@@ -609,6 +813,20 @@ VTKHDataAdapter::BlueprintToVTKHDataSet(const Node &node,
     return res;
 }
 
+//-----------------------------------------------------------------------------
+void
+VTKHDataAdapter::CopyReport(conduit::Node &report)
+{
+    report.set(detail::CopyReportNode());
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHDataAdapter::ResetCopyReport()
+{
+    detail::ResetCopyReport();
+}
+
 //-----------------------------------------------------------------------------
 vtkh::DataSet *
 VTKHDataAdapter::VTKmDataSetToVTKHDataSet(vtkm::cont::DataSet *dset)
@@ -624,7 +842,33 @@ VTKHDataAdapter::VTKmDataSetToVTKHDataSet(vtkm::cont::DataSet *dset)
 vtkm::cont::DataSet *
 VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
                                         bool zero_copy,
-                                        const std::string &topo_name_str)
+                                        const std::string &topo_name)
+{
+    int neles  = 0;
+    int nverts = 0;
+
+    vtkm::cont::DataSet *result = BlueprintToVTKmMesh(node,
+                                                      zero_copy,
+                                                      topo_name,
+                                                      neles,
+                                                      nverts);
+    AddFields(node,
+              topo_name,
+              neles,
+              nverts,
+              result,
+              zero_copy);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+vtkm::cont::DataSet *
+VTKHDataAdapter::BlueprintToVTKmMesh(const Node &node,
+                                     bool zero_copy,
+                                     const std::string &topo_name_str,
+                                     int &neles,
+                                     int &nverts)
 {
     vtkm::cont::DataSet * result = NULL;
 
@@ -644,8 +888,8 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
     string coords_name   = n_topo["coordset"].as_string();
     const Node &n_coords = node["coordsets"][coords_name];
 
-    int neles  = 0;
-    int nverts = 0;
+    neles  = 0;
+    nverts = 0;
 
     if( mesh_type ==  "uniform")
     {
@@ -702,7 +946,18 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
         ASCENT_ERROR("Unsupported topology/type:" << mesh_type);
     }
 
+    return result;
+}
 
+//-----------------------------------------------------------------------------
+void
+VTKHDataAdapter::AddFields(const Node &node,
+                           const std::string &topo_name,
+                           int neles,
+                           int nverts,
+                           vtkm::cont::DataSet *result,
+                           bool zero_copy)
+{
     if(node.has_child("fields"))
     {
         // add all of the fields:
@@ -762,7 +1017,6 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
             }
         }
     }
-    return result;
 }
 
 
@@ -1052,6 +1306,12 @@ VTKHDataAdapter::RectilinearBlueprintToVTKmDataSet
       memcpy(x, x_coords_ptr, sizeof(float64) * x_npts);
       vtkm::Float64 *y = vtkh::GetVTKMPointer(y_coords_handle);
       memcpy(y, y_coords_ptr, sizeof(float64) * y_npts);
+      detail::RecordCopy(n_coords["values/x"],
+                         "zero copy disabled",
+                         sizeof(float64) * x_npts);
+      detail::RecordCopy(n_coords["values/y"],
+                         "zero copy disabled",
+                         sizeof(float64) * y_npts);
     }
 
     if(ndims == 3)
@@ -1065,6 +1325,9 @@ VTKHDataAdapter::RectilinearBlueprintToVTKmDataSet
         z_coords_handle.Allocate(z_npts);
         vtkm::Float64 *z = vtkh::GetVTKMPointer(z_coords_handle);
         memcpy(z, z_coords_ptr, sizeof(float64) * z_npts);
+        detail::RecordCopy(n_coords["values/z"],
+                           "zero copy disabled",
+                           sizeof(float64) * z_npts);
       }
     }
     else
@@ -1392,49 +1655,55 @@ VTKHDataAdapter::UnstructuredBlueprintToVTKmDataSet
     const Node &n_topo_eles = n_topo["elements"];
     std::string ele_shape = n_topo_eles["shape"].as_string();
 
-    // TODO: assumes int32, and contiguous
-
     const Node &n_topo_conn = n_topo_eles["connectivity"];
 
     vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
 
     int conn_size = n_topo_conn.dtype().number_of_elements();
 
-    if( sizeof(vtkm::Id) == 4)
-    {
-         if(n_topo_conn.is_compact() && n_topo_conn.dtype().is_int32())
-         {
-           const void *ele_idx_ptr = n_topo_conn.data_ptr();
-           detail::CopyArray(connectivity, (const vtkm::Id*)ele_idx_ptr, conn_size,zero_copy);
-         }
-         else
-         {
-             // convert to int32
-             // std::cout << "INT32 unstructured conversion: non zero copy" << std::endl;
-             connectivity.Allocate(conn_size);
-             void *ptr = (void*) vtkh::GetVTKMPointer(connectivity);
-             Node n_tmp;
-             n_tmp.set_external(DataType::int32(conn_size),ptr);
-             n_topo_conn.to_int32_array(n_tmp);
-        }
+    // CellSetSingleType<> needs a basic vtkm::Id array, so only
+    // connectivity that already has that layout can be zero copied.
+    // Other int arrays with a usable stride are converted by vtk-m,
+    // everything else by conduit.
+    const bool native_width = sizeof(vtkm::Id) == 4 ? n_topo_conn.dtype().is_int32()
+                                                    : n_topo_conn.dtype().is_int64();
+    if(n_topo_conn.dtype().is_compact() && native_width)
+    {
+        const vtkm::Id *ele_idx_ptr = (const vtkm::Id*) n_topo_conn.data_ptr();
+        detail::CopyArray(connectivity, ele_idx_ptr, conn_size, zero_copy, n_topo_conn);
+    }
+    else if(n_topo_conn.dtype().is_int32() &&
+            n_topo_conn.dtype().stride() % sizeof(int32) == 0)
+    {
+        detail::CopyStridedArray<int32>(connectivity,
+                                        n_topo_conn,
+                                        "connectivity conversion");
+    }
+    else if(n_topo_conn.dtype().is_int64() &&
+            n_topo_conn.dtype().stride() % sizeof(int64) == 0)
+    {
+        detail::CopyStridedArray<int64>(connectivity,
+                                        n_topo_conn,
+                                        "connectivity conversion");
     }
     else
     {
-        if(n_topo_conn.is_compact() && n_topo_conn.dtype().is_int64())
+        connectivity.Allocate(conn_size);
+        void *ptr = (void*) vtkh::GetVTKMPointer(connectivity);
+        Node n_tmp;
+        if(sizeof(vtkm::Id) == 4)
         {
-            const void *ele_idx_ptr = n_topo_conn.data_ptr();
-            detail::CopyArray(connectivity, (const vtkm::Id*)ele_idx_ptr, conn_size, zero_copy);
+          n_tmp.set_external(DataType::int32(conn_size),ptr);
+          n_topo_conn.to_int32_array(n_tmp);
         }
         else
         {
-             // convert to int64
-             // std::cout << "INT64 unstructured conversion: non zero copy" << std::endl;
-             connectivity.Allocate(conn_size);
-             void *ptr = (void*) vtkh::GetVTKMPointer(connectivity);
-             Node n_tmp;
-             n_tmp.set_external(DataType::int64(conn_size),ptr);
-             n_topo_conn.to_int64_array(n_tmp);
+          n_tmp.set_external(DataType::int64(conn_size),ptr);
+          n_topo_conn.to_int64_array(n_tmp);
         }
+        detail::RecordCopy(n_topo_conn,
+                           "connectivity conversion",
+                           conn_size * sizeof(vtkm::Id));
     }
 
     vtkm::UInt8 shape_id;
@@ -1620,13 +1889,32 @@ VTKHDataAdapter::AddField(const std::string &field_name,
 
             // convert to float64, we use this as a comprise to cover the widest range
             vtkm::cont::ArrayHandle<vtkm::Float64> vtkm_arr;
-            vtkm_arr.Allocate(num_vals);
+            const index_t stride = n_vals.dtype().stride();
 
-            // TODO -- FUTURE: Do this conversion w/ device if on device
-            void *ptr = (void*) vtkh::GetVTKMPointer(vtkm_arr);
-            Node n_tmp;
-            n_tmp.set_external(DataType::float64(num_vals),ptr);
-            n_vals.to_float64_array(n_tmp);
+            // the common int types are converted by vtk-m (on device when
+            // one is active) straight from the blueprint array
+            if(n_vals.dtype().is_int32() && stride % sizeof(int32) == 0)
+            {
+                detail::CopyStridedArray<int32>(vtkm_arr, n_vals, "dtype conversion");
+            }
+            else if(n_vals.dtype().is_int64() && stride % sizeof(int64) == 0)
+            {
+                detail::CopyStridedArray<int64>(vtkm_arr, n_vals, "dtype conversion");
+            }
+            else
+            {
+                vtkm_arr.Allocate(num_vals);
+
+                void *ptr = (void*) vtkh::GetVTKMPointer(vtkm_arr);
+                Node n_tmp;
+                n_tmp.set_external(DataType::float64(num_vals),ptr);
+                n_vals.to_float64_array(n_tmp);
+
+                bool is_float = n_vals.dtype().is_float32() || n_vals.dtype().is_float64();
+                detail::RecordCopy(n_vals,
+                                   is_float ? "unaligned stride" : "dtype conversion",
+                                   num_vals * sizeof(vtkm::Float64));
+            }
 
             // add field to dataset
             if(assoc_str == "vertex")
@@ -1695,6 +1983,13 @@ VTKHDataAdapter::AddVectorField(const std::string &field_name,
 
         if(interleaved)
         {
+            if(!zero_copy && (u.dtype().is_float32() || u.dtype().is_float64()))
+            {
+              detail::RecordCopy(n_vals,
+                                 "zero copy disabled",
+                                 num_vals * u.dtype().stride());
+            }
+
             if(dims == 3)
             {
               // we compile vtk-h with fp types
@@ -1766,10 +2061,8 @@ VTKHDataAdapter::AddVectorField(const std::string &field_name,
         }
         else
         {
-          // we have a vector with 2/3 separate arrays
-          // While vtkm supports ArrayHandleCompositeVectors for
-          // coordinate systems, it does not support composites
-          // for fields. Thus we have to copy the data.
+          // we have a vector with 2/3 separate arrays, these
+          // are wrapped (not copied) in a soa array handle
           if(dims == 3)
           {
             const conduit::Node &v = n_field["values"].child(1);
@@ -38,6 +38,9 @@ class DataSet;
 // conduit includes
 #include <conduit.hpp>
 
+#include <map>
+#include <memory>
+
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -45,6 +48,57 @@ class DataSet;
 namespace ascent
 {
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Cache of vtkm coordinate systems and cell sets created from blueprint
+// coordsets and topologies. Entries are keyed by domain and topology, and
+// are reused while the topology signature (see
+// Transmogrifier::topology_signature) does not change.
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+class ASCENT_API VTKHMeshCache
+{
+public:
+    VTKHMeshCache();
+    ~VTKHMeshCache();
+
+    // returns the cached mesh (no fields) or null if the
+    // key is missing or the signature changed
+    std::shared_ptr<vtkm::cont::DataSet> fetch(const std::string &key,
+                                               const std::string &signature,
+                                               int &neles,
+                                               int &nverts);
+
+    void add(const std::string &key,
+             const std::string &signature,
+             std::shared_ptr<vtkm::cont::DataSet> mesh,
+             int neles,
+             int nverts);
+
+    // removes entries that were not fetched or added since the
+    // last call to prune
+    void prune();
+    void clear();
+
+    // total hit and miss counts since creation or the last clear
+    int hits() const;
+    int misses() const;
+
+private:
+    struct Entry
+    {
+        std::string                          signature;
+        std::shared_ptr<vtkm::cont::DataSet> mesh;
+        int                                  neles;
+        int                                  nverts;
+        bool                                 used;
+    };
+
+    std::map<std::string,Entry> m_entries;
+    int                         m_hits;
+    int                         m_misses;
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // Class that Handles Blueprint to vtk-h, VTKm Data Transforms
@@ -59,8 +113,12 @@ public:
     // Convert a multi-domain blueprint data set to a VTKHCollection
     //  assumes: conduit::blueprint::mesh::verify(n,info) == true
     //
+    //  if a mesh cache is passed, coordinate systems and cell sets
+    //  are reused from it when possible, and only fields are converted
+    //
     static VTKHCollection* BlueprintToVTKHCollection(const conduit::Node &n,
-                                                     bool zero_copy);
+                                                     bool zero_copy,
+                                                     VTKHMeshCache *mesh_cache = nullptr);
     // convert blueprint data to a vtkh Data Set
     // assumes "n" conforms to the mesh blueprint
     //
@@ -71,6 +129,16 @@ public:
                                                   const std::string &topo_name,
                                                   bool zero_copy = false);
 
+    //
+    // describes the blueprint arrays that were copied instead of zero
+    // copied by conversions since the last call to ResetCopyReport:
+    //   bytes:  total number of bytes copied
+    //   arrays: list of copies, each with the source "path", the
+    //           "reason" it was copied, and the "bytes" copied
+    //
+    static void            CopyReport(conduit::Node &report);
+    static void            ResetCopyReport();
+
 
     // convert blueprint data to a vtkm Data Set
     // assumes "n" conforms to the mesh blueprint
@@ -98,6 +166,21 @@ public:
                                                               conduit::Node &node,
                                                               bool zero_copy = false);
 private:
+    // creates the coordinate system and cell set for the topology
+    static vtkm::cont::DataSet  *BlueprintToVTKmMesh(const conduit::Node &n,
+                                                     bool zero_copy,
+                                                     const std::string &topo_name,
+                                                     int &neles,
+                                                     int &nverts);
+
+    // adds all fields associated with the topology
+    static void                  AddFields(const conduit::Node &n,
+                                           const std::string &topo_name,
+                                           int neles,
+                                           int nverts,
+                                           vtkm::cont::DataSet *dset,
+                                           bool zero_copy);
+
     // helpers for specific conversion cases
     static vtkm::cont::DataSet  *UniformBlueprintToVTKmDataSet(const std::string &coords_name,
                                                                const conduit::Node &n_coords,
@@ -2556,7 +2556,7 @@ field_max(const conduit::Node &dataset, const std::string &field)
 
   if(domain != -1)
   {
-    const std::string assoc_str =
+    assoc_str =
         dataset.child(domain)["fields/" + field + "/association"].as_string();
 
     const std::string topo_str =
@@ -2617,6 +2617,287 @@ field_max(const conduit::Node &dataset, const std::string &field)
   return res;
 }
 
+namespace detail
+{
+// number of doubles used to share the location of an extremum:
+// position (3), domain_id, index, and assoc
+const int extremum_loc_size = 6;
+
+struct Extremum
+{
+  double value;
+  int domain;
+  int index;
+};
+
+void
+extremum_location(const conduit::Node &dataset,
+                  const std::string &field,
+                  const Extremum &ext,
+                  double *loc)
+{
+  for(int i = 0; i < extremum_loc_size; ++i)
+  {
+    loc[i] = 0.;
+  }
+  loc[3] = -1.;
+  loc[4] = -1.;
+
+  if(ext.domain == -1)
+  {
+    return;
+  }
+
+  const conduit::Node &dom = dataset.child(ext.domain);
+  const std::string assoc_str =
+      dom["fields/" + field + "/association"].as_string();
+  const std::string topo_str =
+      dom["fields/" + field + "/topology"].as_string();
+
+  conduit::Node n_loc;
+  if(assoc_str == "vertex")
+  {
+    n_loc = vert_location(dom, ext.index, topo_str);
+  }
+  else if(assoc_str == "element")
+  {
+    n_loc = element_location(dom, ext.index, topo_str);
+  }
+  else
+  {
+    ASCENT_ERROR("Location for " << assoc_str << " not implemented");
+  }
+
+  const double *pos = n_loc.as_float64_ptr();
+  loc[0] = pos[0];
+  loc[1] = pos[1];
+  loc[2] = pos[2];
+  loc[3] = dom["state/domain_id"].to_float64();
+  loc[4] = ext.index;
+  loc[5] = assoc_str == "vertex" ? 1. : 0.;
+}
+
+void
+extremum_result(const double value,
+                const int rank,
+                const double *loc,
+                conduit::Node &res)
+{
+  res["rank"] = rank;
+  res["domain_id"] = static_cast<int>(loc[3]);
+  res["index"] = static_cast<int>(loc[4]);
+  res["assoc"] = loc[5] == 1. ? "vertex" : "element";
+  res["position"].set(loc, 3);
+  res["value"] = value;
+}
+
+} // namespace detail
+
+conduit::Node
+field_reductions(const conduit::Node &dataset, const conduit::Node &requests)
+{
+  const int num_fields = requests.number_of_children();
+  const int num_domains = dataset.number_of_children();
+
+  // one pass over each field for min, max, and sum
+  std::vector<detail::Extremum> mins(num_fields);
+  std::vector<detail::Extremum> maxs(num_fields);
+  std::vector<double> sums(num_fields, 0.);
+  std::vector<double> counts(num_fields, 0.);
+
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const std::string field = requests.child(f).name();
+    const std::string path = "fields/" + field;
+    mins[f] = {std::numeric_limits<double>::max(), -1, -1};
+    maxs[f] = {std::numeric_limits<double>::lowest(), -1, -1};
+    for(int i = 0; i < num_domains; ++i)
+    {
+      const conduit::Node &dom = dataset.child(i);
+      if(!dom.has_path(path) || dom[path + "/values"].number_of_children() > 1)
+      {
+        continue;
+      }
+      conduit::Node res = field_reduction_moments(dom[path]);
+      const double a_min = res["min/value"].to_float64();
+      if(a_min < mins[f].value)
+      {
+        mins[f] = {a_min, i, res["min/index"].to_int32()};
+      }
+      const double a_max = res["max/value"].to_float64();
+      if(a_max > maxs[f].value)
+      {
+        maxs[f] = {a_max, i, res["max/index"].to_int32()};
+      }
+      sums[f] += res["sum/value"].to_float64();
+      counts[f] += res["sum/count"].to_float64();
+    }
+  }
+
+  int rank = 0;
+  // min and max are both reduced as a minimum (max as -value), so
+  // every extremum of every field is resolved with one collective
+  std::vector<int> winners(num_fields * 2, 0);
+  std::vector<double> extrema(num_fields * 2);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    extrema[f * 2 + 0] = mins[f].value;
+    extrema[f * 2 + 1] = -maxs[f].value;
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Comm_rank(mpi_comm, &rank);
+  {
+    struct MinLoc
+    {
+      double value;
+      int rank;
+    };
+    std::vector<MinLoc> local(num_fields * 2);
+    std::vector<MinLoc> global(num_fields * 2);
+    for(int i = 0; i < num_fields * 2; ++i)
+    {
+      local[i] = {extrema[i], rank};
+    }
+    MPI_Allreduce(local.data(),
+                  global.data(),
+                  num_fields * 2,
+                  MPI_DOUBLE_INT,
+                  MPI_MINLOC,
+                  mpi_comm);
+    for(int i = 0; i < num_fields * 2; ++i)
+    {
+      extrema[i] = global[i].value;
+      winners[i] = global[i].rank;
+    }
+  }
+#endif
+
+  // everything else is summed, so the sums, counts, extremum locations
+  // (only the owning rank contributes), and histogram bins share one buffer
+  std::vector<double> packed(num_fields * 2, 0.);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    packed[f * 2 + 0] = sums[f];
+    packed[f * 2 + 1] = counts[f];
+  }
+
+  const size_t loc_offset = packed.size();
+  packed.resize(loc_offset + num_fields * 2 * detail::extremum_loc_size, 0.);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const std::string field = requests.child(f).name();
+    double *min_loc = &packed[loc_offset + (f * 2 + 0) * detail::extremum_loc_size];
+    double *max_loc = &packed[loc_offset + (f * 2 + 1) * detail::extremum_loc_size];
+    if(winners[f * 2 + 0] == rank)
+    {
+      detail::extremum_location(dataset, field, mins[f], min_loc);
+    }
+    if(winners[f * 2 + 1] == rank)
+    {
+      detail::extremum_location(dataset, field, maxs[f], max_loc);
+    }
+  }
+
+  conduit::Node res;
+  std::vector<size_t> hist_offsets;
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const conduit::Node &request = requests.child(f);
+    const std::string field = request.name();
+    const std::string path = "fields/" + field;
+    conduit::Node &field_res = res.add_child(field);
+    if(!request.has_path("histograms"))
+    {
+      continue;
+    }
+    const conduit::Node &hists = request["histograms"];
+    for(int h = 0; h < hists.number_of_children(); ++h)
+    {
+      const conduit::Node &hist = hists.child(h);
+      const int num_bins = hist.has_path("num_bins") ?
+                           hist["num_bins"].to_int32() : 256;
+      const double min_val = hist.has_path("min_val") ?
+                             hist["min_val"].to_float64() : extrema[f * 2 + 0];
+      const double max_val = hist.has_path("max_val") ?
+                             hist["max_val"].to_float64() : -extrema[f * 2 + 1];
+
+      conduit::Node &hist_res = field_res["histograms"].append();
+      hist_res["min_val"] = min_val;
+      hist_res["max_val"] = max_val;
+      hist_res["num_bins"] = num_bins;
+
+      const size_t offset = packed.size();
+      hist_offsets.push_back(offset);
+      packed.resize(offset + num_bins, 0.);
+      // an empty range is an error the caller reports
+      if(min_val >= max_val)
+      {
+        continue;
+      }
+      for(int i = 0; i < num_domains; ++i)
+      {
+        const conduit::Node &dom = dataset.child(i);
+        if(!dom.has_path(path) || dom[path + "/values"].number_of_children() > 1)
+        {
+          continue;
+        }
+        conduit::Node dom_hist =
+          field_reduction_histogram(dom[path], min_val, max_val, num_bins);
+        const double *dom_bins = dom_hist["value"].as_float64_ptr();
+        for(int b = 0; b < num_bins; ++b)
+        {
+          packed[offset + b] += dom_bins[b];
+        }
+      }
+    }
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  std::vector<double> global_packed(packed.size());
+  MPI_Allreduce(packed.data(),
+                global_packed.data(),
+                static_cast<int>(packed.size()),
+                MPI_DOUBLE,
+                MPI_SUM,
+                mpi_comm);
+  packed.swap(global_packed);
+#endif
+
+  int hist_index = 0;
+  for(int f = 0; f < num_fields; ++f)
+  {
+    conduit::Node &field_res = res.child(f);
+    detail::extremum_result(extrema[f * 2 + 0],
+                            winners[f * 2 + 0],
+                            &packed[loc_offset + (f * 2 + 0) * detail::extremum_loc_size],
+                            field_res["min"]);
+    detail::extremum_result(-extrema[f * 2 + 1],
+                            winners[f * 2 + 1],
+                            &packed[loc_offset + (f * 2 + 1) * detail::extremum_loc_size],
+                            field_res["max"]);
+    const double sum = packed[f * 2 + 0];
+    const long long int count = static_cast<long long int>(packed[f * 2 + 1]);
+    field_res["sum/value"] = sum;
+    field_res["sum/count"] = count;
+    field_res["avg/value"] = sum / static_cast<double>(count);
+
+    if(field_res.has_path("histograms"))
+    {
+      conduit::Node &hists = field_res["histograms"];
+      for(int h = 0; h < hists.number_of_children(); ++h)
+      {
+        conduit::Node &hist = hists.child(h);
+        hist["value"].set(&packed[hist_offsets[hist_index++]],
+                          hist["num_bins"].to_int32());
+      }
+    }
+  }
+
+  return res;
+}
+
 conduit::Node
 get_state_var(const conduit::Node &dataset, const std::string &var_name)
 {
@@ -63,6 +63,18 @@ ASCENT_API
 conduit::Node field_avg(const conduit::Node &dataset,
                         const std::string &field_name);
 
+// Computes min, max, sum, avg, and histograms of several scalar fields at
+// once: each field is read in a single pass and the results of all fields
+// are combined with two collectives (one for the extrema, one for the rest).
+// requests has one child per field name, with an optional list of
+// "histograms" entries ({num_bins, min_val, max_val}, all optional, the
+// range defaults to the global field range). The result has the same
+// children, each holding "min", "max" (as returned by field_min/field_max),
+// "sum", "avg", and the "histograms" in request order.
+ASCENT_API
+conduit::Node field_reductions(const conduit::Node &dataset,
+                               const conduit::Node &requests);
+
 ASCENT_API
 conduit::Node field_nan_count(const conduit::Node &dataset,
                               const std::string &field_name);
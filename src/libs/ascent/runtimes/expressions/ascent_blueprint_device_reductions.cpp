@@ -141,6 +141,41 @@ struct SumFunctor
   }
 };
 
+// min, max (with locations) and sum in a single pass over the field
+struct MomentsFunctor
+{
+  template<typename T, typename Exec>
+  conduit::Node operator()(const DeviceAccessor<T> accessor,
+                           const Exec &) const
+  {
+    const int size = accessor.m_size;
+
+    using for_policy    = typename Exec::for_policy;
+    using reduce_policy = typename Exec::reduce_policy;
+
+    ascent::ReduceMinLoc<reduce_policy,T> min_reducer(std::numeric_limits<T>::max(),-1);
+    ascent::ReduceMaxLoc<reduce_policy,T> max_reducer(std::numeric_limits<T>::lowest(),-1);
+    ascent::ReduceSum<reduce_policy,T> sum(static_cast<T>(0));
+    ascent::forall<for_policy>(0, size, [=] ASCENT_LAMBDA(index_t i)
+    {
+      const T val = accessor[i];
+      min_reducer.minloc(val,i);
+      max_reducer.maxloc(val,i);
+      sum += val;
+    });
+    ASCENT_DEVICE_ERROR_CHECK();
+
+    conduit::Node res;
+    res["min/value"] = min_reducer.get();
+    res["min/index"] = min_reducer.getLoc();
+    res["max/value"] = max_reducer.get();
+    res["max/index"] = max_reducer.getLoc();
+    res["sum/value"] = sum.get();
+    res["sum/count"] = size;
+    return res;
+  }
+};
+
 struct DFAddFunctor
 {
     template<typename T, typename Exec>
@@ -493,6 +528,12 @@ field_reduction_sum(const conduit::Node &field, const std::string &component)
   return exec_dispatch_mcarray_component(field["values"], component, detail::SumFunctor());
 }
 
+conduit::Node
+field_reduction_moments(const conduit::Node &field, const std::string &component)
+{
+  return exec_dispatch_mcarray_component(field["values"], component, detail::MomentsFunctor());
+}
+
 conduit::Node
 field_reduction_nan_count(const conduit::Node &field, const std::string &component)
 {
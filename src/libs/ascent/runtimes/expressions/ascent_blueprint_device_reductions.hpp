@@ -69,6 +69,10 @@ conduit::Node ASCENT_API field_reduction_min(const conduit::Node &field,
 conduit::Node ASCENT_API field_reduction_sum(const conduit::Node &field,
                                   const std::string &component = "");
 
+// min, max and sum of a field computed with one pass over the values
+conduit::Node ASCENT_API field_reduction_moments(const conduit::Node &field,
+                                      const std::string &component = "");
+
 conduit::Node ASCENT_API field_reduction_nan_count(const conduit::Node &field,
                                         const std::string &component = "");
 
@@ -657,6 +657,25 @@ range_values_helper(const conduit::Node &history,
   return output;
 }
 
+// When a batch of expressions is evaluated, the reductions over plain
+// fields are computed up front (see field_reductions) and stored in the
+// registry. Returns the precomputed results for field or nullptr.
+const conduit::Node *
+fused_reductions(flow::Graph &graph, const std::string &field)
+{
+  flow::Registry &registry = graph.workspace().registry();
+  if(!registry.has_entry("fused_reductions"))
+  {
+    return nullptr;
+  }
+  conduit::Node *fused = registry.fetch<conduit::Node>("fused_reductions");
+  if(!fused->has_child(field))
+  {
+    return nullptr;
+  }
+  return &fused->child(field);
+}
+
 
 } // namespace detail
 
@@ -2873,6 +2892,8 @@ ExprHistogram::execute()
     num_bins = (*n_bins)["value"].as_int32();
   }
 
+  const conduit::Node *fused = detail::fused_reductions(graph(), field);
+
   double min_val;
   double max_val;
 
@@ -2880,6 +2901,10 @@ ExprHistogram::execute()
   {
     max_val = (*n_max)["value"].to_float64();
   }
+  else if(fused != nullptr)
+  {
+    max_val = (*fused)["max/value"].to_float64();
+  }
   else
   {
     max_val = field_max(*dataset, field)["value"].to_float64();
@@ -2889,6 +2914,10 @@ ExprHistogram::execute()
   {
     min_val = (*n_min)["value"].to_float64();
   }
+  else if(fused != nullptr)
+  {
+    min_val = (*fused)["min/value"].to_float64();
+  }
   else
   {
     min_val = field_min(*dataset, field)["value"].to_float64();
@@ -2901,10 +2930,35 @@ ExprHistogram::execute()
                  << ")");
   }
 
+  // look for the same histogram in the precomputed results
+  const conduit::Node *fused_hist = nullptr;
+  if(fused != nullptr && fused->has_path("histograms"))
+  {
+    const conduit::Node &hists = (*fused)["histograms"];
+    for(int i = 0; i < hists.number_of_children(); ++i)
+    {
+      const conduit::Node &hist = hists.child(i);
+      if(hist["num_bins"].to_int32() == num_bins &&
+         hist["min_val"].to_float64() == min_val &&
+         hist["max_val"].to_float64() == max_val)
+      {
+        fused_hist = &hist;
+        break;
+      }
+    }
+  }
+
   conduit::Node *output = new conduit::Node();
   (*output)["type"] = "histogram";
-  (*output)["attrs/value/value"] =
-      field_histogram(*dataset, field, min_val, max_val, num_bins)["value"];
+  if(fused_hist != nullptr)
+  {
+    (*output)["attrs/value/value"] = (*fused_hist)["value"];
+  }
+  else
+  {
+    (*output)["attrs/value/value"] =
+        field_histogram(*dataset, field, min_val, max_val, num_bins)["value"];
+  }
   (*output)["attrs/value/type"] = "array";
   (*output)["attrs/min_val/value"] = min_val;
   (*output)["attrs/min_val/type"] = "double";
@@ -3927,8 +3981,9 @@ ExprMeshFieldReductionMin::execute()
                  << field << "' is not a scalar field");
   }
 
-  // TODO
-  conduit::Node n_min = field_min(*dataset, field);
+  const conduit::Node *fused = detail::fused_reductions(graph(), field);
+  conduit::Node n_min = fused != nullptr ? (*fused)["min"]
+                                         : field_min(*dataset, field);
 
   (*output)["type"] = "value_position";
   (*output)["attrs/value/value"] = n_min["value"];
@@ -4000,7 +4055,9 @@ ExprMeshFieldReductionMax::execute()
     ASCENT_ERROR("FieldMax: field '" << field << "' is not a scalar field");
   }
 
-  conduit::Node n_max = field_max(*dataset, field);
+  const conduit::Node *fused = detail::fused_reductions(graph(), field);
+  conduit::Node n_max = fused != nullptr ? (*fused)["max"]
+                                         : field_max(*dataset, field);
 
   (*output)["type"] = "value_position";
   (*output)["attrs/value/value"] = n_max["value"];
@@ -4070,7 +4127,9 @@ ExprMeshFieldReductionAvg::execute()
     ASCENT_ERROR("FieldAvg: field '" << field << "' is not a scalar field");
   }
 
-  conduit::Node n_avg = field_avg(*dataset, field);
+  const conduit::Node *fused = detail::fused_reductions(graph(), field);
+  conduit::Node n_avg = fused != nullptr ? (*fused)["avg"]
+                                         : field_avg(*dataset, field);
 
   (*output)["value"] = n_avg["value"];
   (*output)["type"] = "double";
@@ -4123,8 +4182,17 @@ ExprMeshFieldReductionSum::execute()
     graph().workspace().registry().fetch<DataObject>("dataset");
   const conduit::Node *const dataset = data_object->as_low_order_bp().get();
 
+  const conduit::Node *fused = detail::fused_reductions(graph(), field);
+
   conduit::Node *output = new conduit::Node();
-  (*output)["value"] = field_sum(*dataset, field)["value"];
+  if(fused != nullptr)
+  {
+    (*output)["value"] = (*fused)["sum/value"];
+  }
+  else
+  {
+    (*output)["value"] = field_sum(*dataset, field)["value"];
+  }
   (*output)["type"] = "double";
 
   resolve_symbol_result(graph(), output, this->name());
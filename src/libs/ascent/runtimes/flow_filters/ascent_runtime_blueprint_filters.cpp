@@ -30,6 +30,7 @@
 #include <ascent_metadata.hpp>
 #include <runtimes/ascent_data_object.hpp>
 #include <ascent_runtime_param_check.hpp>
+#include <ascent_runtime_utils.hpp>
 #include "expressions/ascent_expression_filters.hpp"
 #include "expressions/ascent_blueprint_architect.hpp"
 #include <flow_graph.hpp>
@@ -238,6 +239,11 @@ ConduitExtract::declare_interface(Node &i)
     i["type_name"]   = "conduit_extract";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+#ifndef ASCENT_MPI_ENABLED
+    // only copies its input, but converting a vtk-h input
+    // is collective in mpi builds
+    i["concurrent"]  = "true";
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -269,19 +275,10 @@ ConduitExtract::execute()
     // be connected with exec info
 
     // add this to the extract results in the registry
-    if(!graph().workspace().registry().has_entry("extract_list"))
-    {
-      conduit::Node *extract_list = new conduit::Node();
-      graph().workspace().registry().add<Node>("extract_list",
-                                               extract_list,
-                                               -1); // TODO keep forever?
-    }
-
-    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
-
-    Node &einfo = extract_list->append();
+    Node einfo;
     einfo["type"] = "conduit";
-    einfo["data"].set(*n_input);
+    einfo["data"].set_external(*n_input);
+    add_extract_info(graph().workspace().registry(), einfo);
 }
 
 
@@ -98,6 +98,20 @@ HolaMPIExtract::verify_params(const conduit::Node &params,
         info["errors"].append() = "Missing required integer parameter 'rank_split'";
     }
 
+    if( params.has_child("max_in_flight_bytes") &&
+       ! params["max_in_flight_bytes"].dtype().is_integer() )
+    {
+        info["errors"].append() = "Optional parameter 'max_in_flight_bytes' must be an integer";
+        res = false;
+    }
+
+    if( params.has_child("reuse_layout") &&
+       ! params["reuse_layout"].dtype().is_string() )
+    {
+        info["errors"].append() = "Optional parameter 'reuse_layout' must be a string ('true' or 'false')";
+        res = false;
+    }
+
     return res;
 }
 
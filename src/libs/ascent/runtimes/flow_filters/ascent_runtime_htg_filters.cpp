@@ -34,9 +34,19 @@
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
 
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#endif
+
 // std includes
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <limits>
 #include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 using namespace std;
 using namespace conduit;
@@ -66,500 +76,516 @@ namespace filters
 namespace detail
 {
 
-
 //-----------------------------------------------------------------------------
-};
-//-----------------------------------------------------------------------------
-// -- end ascent::runtime::detail --
+//
+// The hyper tree grid is a single tree over an N^3 grid (N a power of 2).
+// The vertices of each level are stored in morton order, with the child
+// digit laid out as (z,y,x), which is the order a depth first traversal
+// visits them. Children of blank vertices are left out of the file.
+//
+// To build the tree in parallel, the grid is cut into aligned B^3 blocks.
+// Every block is the subtree rooted at level log2(N/B) and is built by a
+// single rank, one of the ranks that holds cells of it. Cells of a block
+// that sit on other ranks are sent to that rank first, which is a no-op
+// when the blocks lie inside the domains. Only the block roots are
+// reduced to build the coarse levels. In the file, a level is the coarse
+// part followed by the pieces of that level from every block in morton
+// order, so each rank can write its pieces in place once it knows the
+// sizes of everyone else's.
+//
+// The coarse levels and the per block sizes are kept on every rank, so
+// the number of blocks is capped at 8^HTG_MAX_COARSE_DEPTH.
+//
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-// helper used by io save
+static const int HTG_MAX_COARSE_DEPTH = 5;
+
 //-----------------------------------------------------------------------------
-bool
-verify_htg_params(const conduit::Node &params,
-                  conduit::Node &info)
+int
+htg_log2(long long n)
 {
-    bool res = true;
-
-    if( !params.has_child("path") )
-    {
-        info["errors"].append() = "missing required entry 'path'";
-        res = false;
-    }
-    else if(!params["path"].dtype().is_string())
+    int res = 0;
+    while(n > 1)
     {
-        info["errors"].append() = "'path' must be a string";
-        res = false;
-    }
-    else if(params["path"].as_string().empty())
-    {
-        info["errors"].append() = "'path' is an empty string";
-        res = false;
+        n = n >> 1;
+        res++;
     }
+    return res;
+}
 
-    if( !params.has_child("blank_value") )
-    {
-        info["errors"].append() = "missing required entry 'blank_value'";
-        res = false;
-    }
-    else if(!params["blank_value"].dtype().is_float())
+//-----------------------------------------------------------------------------
+long long
+htg_morton_encode(int i, int j, int k, int bits)
+{
+    long long code = 0;
+    for(int b = bits - 1; b >= 0; --b)
     {
-        info["errors"].append() = "'blank_value' must be a float";
-        res = false;
+        code = (code << 3) |
+               (((k >> b) & 1) << 2) |
+               (((j >> b) & 1) << 1) |
+               ((i >> b) & 1);
     }
+    return code;
+}
 
-    std::vector<std::string> valid_paths;
-    std::vector<std::string> ignore_paths;
-    valid_paths.push_back("path");
-    valid_paths.push_back("fields");
-    valid_paths.push_back("blank_value");
-    ignore_paths.push_back("fields");
-
-    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
-
-    if(surprises != "")
+//-----------------------------------------------------------------------------
+void
+htg_morton_decode(long long code, int bits, int &i, int &j, int &k)
+{
+    i = j = k = 0;
+    for(int b = 0; b < bits; ++b)
     {
-        info["errors"].append() = surprises;
-        res = false;
+        const int digit = static_cast<int>((code >> (3 * b)) & 7);
+        i |= (digit & 1) << b;
+        j |= ((digit >> 1) & 1) << b;
+        k |= ((digit >> 2) & 1) << b;
     }
-
-    return res;
 }
 
 //-----------------------------------------------------------------------------
-float htg_create(const float *var_in,
-                 float *var_out,
-                 int *mask,
-                 int n_levels,
-                 int nx,
-                 int blank_value,
-                 int level,
-                 int *offsets,
-                 int i_start,
-                 int j_start,
-                 int k_start)
+// average of the non blank children, blank if they are all blank
+float
+htg_average(const float *children, float blank_value)
 {
-    if (level < n_levels - 1)
+    float ave = 0.;
+    int n_val = 0;
+    for (int l = 0; l < 8; l++)
     {
-        // 
-        // Recurse over the 8 sub-blocks.
-        //
-        int nx_sub_box = 1 << (n_levels - level - 1);
-        int offset = offsets[level];
-        offsets[level] = offsets[level] + 8;
-
-        var_out[offset]   = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start, k_start);
-        var_out[offset+1] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start, k_start);
-        var_out[offset+2] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start + nx_sub_box, k_start);
-        var_out[offset+3] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start + nx_sub_box, k_start);
-        var_out[offset+4] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start, k_start + nx_sub_box);
-        var_out[offset+5] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start, k_start + nx_sub_box);
-        var_out[offset+6] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start, j_start + nx_sub_box, k_start + nx_sub_box);
-        var_out[offset+7] = htg_create(var_in, var_out, mask, n_levels, nx,
-            blank_value, level+1, offsets,
-            i_start + nx_sub_box, j_start + nx_sub_box, k_start + nx_sub_box);
-        mask[offset]   = var_out[offset]   == blank_value ? 1 : 0;
-        mask[offset+1] = var_out[offset+1] == blank_value ? 1 : 0;
-        mask[offset+2] = var_out[offset+2] == blank_value ? 1 : 0;
-        mask[offset+3] = var_out[offset+3] == blank_value ? 1 : 0;
-        mask[offset+4] = var_out[offset+4] == blank_value ? 1 : 0;
-        mask[offset+5] = var_out[offset+5] == blank_value ? 1 : 0;
-        mask[offset+6] = var_out[offset+6] == blank_value ? 1 : 0;
-        mask[offset+7] = var_out[offset+7] == blank_value ? 1 : 0;
-
-        //
-        // Calculate and return the average.
-        //
-        float ave = 0.;
-        int n_val = 0;
-        for (int l = 0; l < 8; l++)
+        if (children[l] != blank_value)
         {
-            if (var_out[offset+l] != blank_value)
-            {
-                n_val++;
-                ave += var_out[offset+l];
-            }
+            n_val++;
+            ave += children[l];
         }
-        if (n_val)
-            ave /= float(n_val);
-        else
-            ave = blank_value;
-        return ave;
     }
+    if (n_val)
+        ave /= float(n_val);
     else
+        ave = blank_value;
+    return ave;
+}
+
+//-----------------------------------------------------------------------------
+// Builds the levels of a (sub)tree from its leaves in morton order.
+// res[0] is the root and res[s] holds the vertices of level s whose
+// parent is not blank.
+void
+htg_build_levels(std::vector<float> &leaves,
+                 int depth,
+                 float blank_value,
+                 std::vector<std::vector<float>> &res)
+{
+    std::vector<std::vector<float>> levels(depth + 1);
+    levels[depth].swap(leaves);
+    for(int s = depth - 1; s >= 0; --s)
     {
-        //
-        // Base case. Reorder and store the values as the finest
-        // resolution.
-        //
-        int offset = offsets[level];
-        offsets[level] = offsets[level] + 8;
-
-        int index  = (k_start)   * nx * nx + (j_start)   * nx + (i_start);
-        int index2 = (k_start)   * nx * nx + (j_start)   * nx + (i_start+1);
-        int index3 = (k_start)   * nx * nx + (j_start+1) * nx + (i_start);
-        int index4 = (k_start)   * nx * nx + (j_start+1) * nx + (i_start+1);
-        int index5 = (k_start+1) * nx * nx + (j_start)   * nx + (i_start);
-        int index6 = (k_start+1) * nx * nx + (j_start)   * nx + (i_start+1);
-        int index7 = (k_start+1) * nx * nx + (j_start+1) * nx + (i_start);
-        int index8 = (k_start+1) * nx * nx + (j_start+1) * nx + (i_start+1);
-        var_out[offset]   = var_in[index];
-        var_out[offset+1] = var_in[index2];
-        var_out[offset+2] = var_in[index3];
-        var_out[offset+3] = var_in[index4];
-        var_out[offset+4] = var_in[index5];
-        var_out[offset+5] = var_in[index6];
-        var_out[offset+6] = var_in[index7];
-        var_out[offset+7] = var_in[index8];
-        mask[offset]   = var_out[offset]   == blank_value ? 1 : 0;
-        mask[offset+1] = var_out[offset+1] == blank_value ? 1 : 0;
-        mask[offset+2] = var_out[offset+2] == blank_value ? 1 : 0;
-        mask[offset+3] = var_out[offset+3] == blank_value ? 1 : 0;
-        mask[offset+4] = var_out[offset+4] == blank_value ? 1 : 0;
-        mask[offset+5] = var_out[offset+5] == blank_value ? 1 : 0;
-        mask[offset+6] = var_out[offset+6] == blank_value ? 1 : 0;
-        mask[offset+7] = var_out[offset+7] == blank_value ? 1 : 0;
+        const size_t n = levels[s + 1].size() / 8;
+        levels[s].resize(n);
+        for(size_t m = 0; m < n; ++m)
+        {
+            levels[s][m] = htg_average(&levels[s + 1][8 * m], blank_value);
+        }
+    }
 
-        //
-        // Calculate and return the average.
-        //
-        float ave = 0.;
-        int n_val = 0;
-        for (int l = 0; l < 8; l++)
+    res.resize(depth + 1);
+    res[0] = levels[0];
+    for(int s = 1; s <= depth; ++s)
+    {
+        res[s].clear();
+        const std::vector<float> &parents = levels[s - 1];
+        for(size_t m = 0; m < parents.size(); ++m)
         {
-            if (var_out[offset+l] != blank_value)
+            if(parents[m] != blank_value)
             {
-                n_val++;
-                ave += var_out[offset+l];
+                res[s].insert(res[s].end(),
+                              levels[s].begin() + 8 * m,
+                              levels[s].begin() + 8 * m + 8);
             }
         }
-        if (n_val)
-            ave /= float(n_val);
-        else
-            ave = blank_value;
-        return ave;
     }
 }
 
-void htg_write_file(const string &stem,
-                    const double *bounds,
-                    int n_levels,
-                    int n_vertices,
-                    int n_descriptor,
-                    int descriptor_min,
-                    int descriptor_max,
-                    const int *descriptor,
-                    int nb_vertices_by_level_max,
-                    const int *nb_vertices_by_level,
-                    int n_mask,
-                    int mask_min,
-                    int mask_max,
-                    const int *mask,
-                    double var_min,
-                    double var_max,
-                    const float *var)
+//-----------------------------------------------------------------------------
+// Appends entry p of an n entry ascii data array, six to a line.
+template<typename T>
+void
+htg_format_entry(std::ostringstream &oss, long long p, long long n, T value)
 {
-    //
-    // Write out the HTG VTK file. It is in ASCII format, which is the
-    // least efficient, but it's the simplest and was great for developing
-    // the algorithm. This should probably be improved at some point.
-    //
-    std::string filename = stem + ".htg";
-    ofstream *ofile = new ofstream(filename.c_str());
-
-    *ofile << "<VTKFile type=\"HyperTreeGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt32\">" << endl;
-    *ofile << "  <HyperTreeGrid BranchFactor=\"2\" TransposedRootIndexing=\"0\" Dimensions=\"2 2 2\">" << endl;
-    *ofile << "    <Grid>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"XCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[0] << "\" RangeMax=\"" << bounds[1] << "\">" << endl;
-    *ofile << "        " << bounds[0] << " " << bounds[1] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"YCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[2] << "\" RangeMax=\"" << bounds[3] << "\">" << endl;
-    *ofile << "        " << bounds[2] << " " << bounds[3] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "      <DataArray type=\"Float64\" Name=\"ZCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[4] << "\" RangeMax=\"" << bounds[5] << "\">" << endl;
-    *ofile << "        " << bounds[4] << " " << bounds[5] << endl;
-    *ofile << "      </DataArray>" << endl;
-    *ofile << "    </Grid>" << endl;
-    *ofile << "    <Trees>" << endl;
-    *ofile << "      <Tree Index=\"0\" NumberOfLevels=\"" << n_levels << "\" NumberOfVertices=\"" << n_vertices << "\">" << endl;
-    *ofile << "        <DataArray type=\"Bit\" Name=\"Descriptor\" NumberOfTuples=\"" << n_descriptor << "\" format=\"ascii\" RangeMin=\"" << descriptor_min << "\" RangeMax=\"" << descriptor_max << "\">" << endl;
-    for (int i = 0; i < n_descriptor; i += 6)
+    if(p % 6 == 0)
+    {
+        oss << "          ";
+    }
+    oss << value;
+    oss << ((p % 6 == 5 || p == n - 1) ? "\n" : " ");
+}
+
+//-----------------------------------------------------------------------------
+enum HTGReduceOp
+{
+    HTG_SUM,
+    HTG_MIN,
+    HTG_MAX
+};
+
+#ifdef ASCENT_MPI_ENABLED
+//-----------------------------------------------------------------------------
+MPI_Op
+htg_mpi_op(HTGReduceOp op)
+{
+    return op == HTG_SUM ? MPI_SUM : (op == HTG_MIN ? MPI_MIN : MPI_MAX);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+void
+htg_allreduce(std::vector<long long> &vals, HTGReduceOp op)
+{
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Allreduce(MPI_IN_PLACE,
+                  vals.data(),
+                  static_cast<int>(vals.size()),
+                  MPI_LONG_LONG,
+                  htg_mpi_op(op),
+                  mpi_comm);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+htg_allreduce(std::vector<double> &vals, HTGReduceOp op)
+{
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Allreduce(MPI_IN_PLACE,
+                  vals.data(),
+                  static_cast<int>(vals.size()),
+                  MPI_DOUBLE,
+                  htg_mpi_op(op),
+                  mpi_comm);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Writes text pieces at their byte offsets. Pieces of all ranks together
+// must tile the file.
+void
+htg_write_pieces(const std::string &filename,
+                 std::vector<std::pair<long long, std::string>> &pieces)
+{
+    std::sort(pieces.begin(),
+              pieces.end(),
+              [](const std::pair<long long, std::string> &a,
+                 const std::pair<long long, std::string> &b)
+              {
+                  return a.first < b.first;
+              });
+
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+
+    std::vector<int> lengths;
+    std::vector<MPI_Aint> displs;
+    std::string buffer;
+    for(size_t i = 0; i < pieces.size(); ++i)
     {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_descriptor) ? i + 6 : n_descriptor;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << descriptor[j] << " ";
-        *ofile << descriptor[jmax-1] << endl;;
+        if(pieces[i].second.empty())
+        {
+            continue;
+        }
+        lengths.push_back(static_cast<int>(pieces[i].second.size()));
+        displs.push_back(static_cast<MPI_Aint>(pieces[i].first));
+        buffer += pieces[i].second;
     }
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <DataArray type=\"Int64\" Name=\"NbVerticesByLevel\" NumberOfTuples=\"" << n_levels << "\" format=\"ascii\" RangeMin=\"1\" RangeMax=\"" << nb_vertices_by_level_max << "\">" << endl;
-    *ofile << "          ";
-    for (int i = 0; i < n_levels - 1; i++)
-        *ofile << nb_vertices_by_level[i] << " ";
-    *ofile << nb_vertices_by_level[n_levels-1] << endl;;
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <DataArray type=\"Bit\" Name=\"Mask\" NumberOfTuples=\"" << n_mask << "\" format=\"ascii\" RangeMin=\"" << mask_min << "\" RangeMax=\"" << mask_max << "\">" << endl;
-    for (int i = 0; i < n_mask; i += 6)
+
+    if(buffer.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
     {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_mask) ? i + 6 : n_mask;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << mask[j] << " ";
-        *ofile << mask[jmax-1] << endl;;
+        ASCENT_ERROR("htg extract: rank output is too large for a single write");
     }
-    *ofile << "        </DataArray>" << endl;
-    *ofile << "        <CellData>" << endl;
-    *ofile << "          <DataArray type=\"Float64\" Name=\"u\" NumberOfTuples=\"" << n_vertices << "\" format=\"ascii\" RangeMin=\"" << var_min << "\" RangeMax=\"" << var_max << "\">" << endl;
-    for (int i = 0; i < n_vertices; i += 6)
+
+    MPI_File fh;
+    int err = MPI_File_open(mpi_comm,
+                            const_cast<char*>(filename.c_str()),
+                            MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                            MPI_INFO_NULL,
+                            &fh);
+    if(err != MPI_SUCCESS)
     {
-        *ofile << "          ";
-        int jmax = (i + 6 < n_vertices) ? i + 6 : n_vertices;
-        for (int j = i; j < jmax - 1; j++)
-            *ofile << var[j] << " ";
-        *ofile << var[jmax-1] << endl;;
+        ASCENT_ERROR("htg extract: failed to open '" << filename << "'");
     }
-    *ofile << "          </DataArray>" << endl;
-    *ofile << "        </CellData>" << endl;
-    *ofile << "      </Tree>" << endl;
-    *ofile << "    </Trees>" << endl;
-    *ofile << "  </HyperTreeGrid>" << endl;
-    *ofile << "</VTKFile>" << endl;
+    // drop anything left from a longer file
+    MPI_File_set_size(fh, 0);
+
+    MPI_Datatype file_type;
+    MPI_Type_create_hindexed(static_cast<int>(lengths.size()),
+                             lengths.data(),
+                             displs.data(),
+                             MPI_CHAR,
+                             &file_type);
+    MPI_Type_commit(&file_type);
+    MPI_File_set_view(fh, 0, MPI_CHAR, file_type, "native", MPI_INFO_NULL);
+    MPI_File_write_all(fh,
+                       const_cast<char*>(buffer.data()),
+                       static_cast<int>(buffer.size()),
+                       MPI_CHAR,
+                       MPI_STATUS_IGNORE);
+    MPI_File_close(&fh);
+    MPI_Type_free(&file_type);
+#else
+    ofstream ofile(filename.c_str());
+    for(size_t i = 0; i < pieces.size(); ++i)
+    {
+        ofile << pieces[i].second;
+    }
+#endif
 }
 
-void htg_write(const std::string &path,
-               float blank_value,
-               int nx,
-               const double *bounds,
-               const float *value)
+//-----------------------------------------------------------------------------
+// the cells of one domain that fall inside one block
+struct HTGPiece
 {
-    //
-    // Determine the number of levels.
-    //
-    int n_levels = 1;
-    int dim = nx;
-    while (dim > 1)
+    long long m_code;        // morton code of the block in the coarse grid
+    int m_lo[3];             // first cell of the piece inside the block
+    int m_size[3];           // number of cells along each axis
+    const float *m_values;   // value of the first cell
+    long long m_strides[2];  // distance between rows and between planes
+};
+
+//-----------------------------------------------------------------------------
+// Sends the pieces of blocks owned by other ranks to their owners, and
+// replaces them with the pieces received from other ranks. Received values
+// are stored in recv_values, which must outlive the pieces.
+void
+htg_exchange_pieces(std::vector<HTGPiece> &pieces,
+                    const std::vector<long long> &owners,
+                    std::vector<float> &recv_values)
+{
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    const int rank = mpi_rank();
+    const int size = mpi_size();
+    // code, lo and size of each piece
+    const int header_size = 7;
+
+    std::vector<long long> send_counts(2 * size, 0);
+    for(size_t p = 0; p < pieces.size(); ++p)
     {
-        n_levels++;
-        dim = dim / 2;
+        const HTGPiece &piece = pieces[p];
+        const long long dest = owners[piece.m_code];
+        if(dest != rank)
+        {
+            send_counts[2 * dest] += header_size;
+            send_counts[2 * dest + 1] += static_cast<long long>(piece.m_size[0]) *
+                                         piece.m_size[1] * piece.m_size[2];
+        }
     }
 
-    //
-    // Calculate the total number of vertices.
-    //
-    int n_vertices = 0;
-    for (int i = 0; i < n_levels; i++)
-        n_vertices += 1 << i * 3;
-
-    //
-    // Calculate min and max for the variable. We only need to do
-    // the input array, since the output will contain the input and
-    // averages of the input. We exclude any blank values. If the
-    // array contains all blank values we throw an exception.
-    //
-    int nvals = nx * nx * nx;
+    std::vector<long long> recv_counts(2 * size, 0);
+    MPI_Alltoall(send_counts.data(), 2, MPI_LONG_LONG,
+                 recv_counts.data(), 2, MPI_LONG_LONG,
+                 mpi_comm);
 
-    //
-    // Find the first non blank value.
-    //
-    int i_real;
-    for (i_real = 0; i_real < nvals && value[i_real] == blank_value; i_real++)
-        /* Do nothing */;
+    std::vector<int> s_headers(size), s_values(size), s_header_displs(size), s_value_displs(size);
+    std::vector<int> r_headers(size), r_values(size), r_header_displs(size), r_value_displs(size);
+    long long totals[4] = {0, 0, 0, 0};
+    for(int r = 0; r < size; ++r)
+    {
+        if(totals[1] + send_counts[2 * r + 1] > std::numeric_limits<int>::max() ||
+           totals[3] + recv_counts[2 * r + 1] > std::numeric_limits<int>::max())
+        {
+            ASCENT_ERROR("htg extract: too many cells to redistribute between ranks");
+        }
+        s_header_displs[r] = static_cast<int>(totals[0]);
+        s_value_displs[r] = static_cast<int>(totals[1]);
+        r_header_displs[r] = static_cast<int>(totals[2]);
+        r_value_displs[r] = static_cast<int>(totals[3]);
+        s_headers[r] = static_cast<int>(send_counts[2 * r]);
+        s_values[r] = static_cast<int>(send_counts[2 * r + 1]);
+        r_headers[r] = static_cast<int>(recv_counts[2 * r]);
+        r_values[r] = static_cast<int>(recv_counts[2 * r + 1]);
+        totals[0] += s_headers[r];
+        totals[1] += s_values[r];
+        totals[2] += r_headers[r];
+        totals[3] += r_values[r];
+    }
 
-    if (i_real == nvals)
+    std::vector<long long> send_headers(totals[0]);
+    std::vector<float> send_values(totals[1]);
+    std::vector<HTGPiece> local;
+    std::vector<int> header_pos(s_header_displs);
+    std::vector<int> value_pos(s_value_displs);
+    for(size_t p = 0; p < pieces.size(); ++p)
     {
-        ASCENT_ERROR("htg extract: the variable only had blank values."<<endl);
+        const HTGPiece &piece = pieces[p];
+        const long long dest = owners[piece.m_code];
+        if(dest == rank)
+        {
+            local.push_back(piece);
+            continue;
+        }
+        long long *header = &send_headers[header_pos[dest]];
+        header[0] = piece.m_code;
+        for(int a = 0; a < 3; ++a)
+        {
+            header[1 + a] = piece.m_lo[a];
+            header[4 + a] = piece.m_size[a];
+        }
+        header_pos[dest] += header_size;
+
+        float *values = send_values.data() + value_pos[dest];
+        for(int k = 0; k < piece.m_size[2]; ++k)
+        {
+            for(int j = 0; j < piece.m_size[1]; ++j)
+            {
+                const float *row = piece.m_values + k * piece.m_strides[1] + j * piece.m_strides[0];
+                values = std::copy(row, row + piece.m_size[0], values);
+            }
+        }
+        value_pos[dest] = static_cast<int>(values - send_values.data());
     }
 
-    float var_min = value[i_real];
-    float var_max = value[i_real];
-    for (int i = i_real + 1; i < nvals; i++)
+    std::vector<long long> recv_headers(totals[2]);
+    recv_values.resize(totals[3]);
+    MPI_Alltoallv(send_headers.data(), s_headers.data(), s_header_displs.data(), MPI_LONG_LONG,
+                  recv_headers.data(), r_headers.data(), r_header_displs.data(), MPI_LONG_LONG,
+                  mpi_comm);
+    MPI_Alltoallv(send_values.data(), s_values.data(), s_value_displs.data(), MPI_FLOAT,
+                  recv_values.data(), r_values.data(), r_value_displs.data(), MPI_FLOAT,
+                  mpi_comm);
+
+    pieces.swap(local);
+    long long value_offset = 0;
+    for(long long h = 0; h < totals[2]; h += header_size)
     {
-        if (value[i] != blank_value)
+        HTGPiece piece;
+        piece.m_code = recv_headers[h];
+        for(int a = 0; a < 3; ++a)
         {
-            var_min = value[i] < var_min ? value[i] : var_min;
-            var_max = value[i] > var_max ? value[i] : var_max;
+            piece.m_lo[a] = static_cast<int>(recv_headers[h + 1 + a]);
+            piece.m_size[a] = static_cast<int>(recv_headers[h + 4 + a]);
         }
+        piece.m_values = recv_values.data() + value_offset;
+        piece.m_strides[0] = piece.m_size[0];
+        piece.m_strides[1] = static_cast<long long>(piece.m_size[0]) * piece.m_size[1];
+        value_offset += piece.m_strides[1] * piece.m_size[2];
+        pieces.push_back(piece);
     }
+#endif
+}
 
-    //
-    // Set the number of vertices in each level.
-    //
-    int *nb_vertices_by_level = new int[n_levels];
-    for (int i = 0; i < n_levels; i++)
-        nb_vertices_by_level[i] = 1 << i * 3;
+//-----------------------------------------------------------------------------
+// one block owned by this rank and the subtree built from it
+struct HTGBlock
+{
+    long long m_code;        // morton code of the block in the coarse grid
+    std::vector<int> m_pieces;
+    std::vector<std::vector<float>> m_levels;
+};
 
-    //
-    // Create the HTG, specifically the output variable and the mask.
-    //
-    int *mask = new int[n_vertices];
-    float *var = new float[n_vertices];
-
-    int i_level = 1;
-    int *offsets = new int[n_levels];
-    offsets[0] = 0;
-    for (int i = 1; i < n_levels; i++)
-       offsets[i] = offsets[i-1] + nb_vertices_by_level[i-1];
-    int i_start = 0;
-    int j_start = 0;
-    int k_start = 0;
-    var[0] = htg_create(value, var, mask, n_levels, nx, blank_value, i_level,
-        offsets, i_start, j_start, k_start);
-    mask[0] = var[0] == blank_value ? 1 : 0;
-    delete [] offsets;
+//-----------------------------------------------------------------------------
+// The layout of one domain inside the global grid
+struct HTGDomain
+{
+    long long m_offset[3];
+    long long m_dims[3];
+    conduit::Node m_values;
+};
 
-    //
-    // Compress the output variable based on the mask variable.
-    //
-    int *mask2 = new int[n_vertices];
-    int n_vertices2 = 9;
-    int i_var = 9;
-    int i_mask = 1;
-    for (int i = 0; i < 9; i++)
-        mask2[i] = mask[i];
-    for (int i = 1; i < n_levels - 1; i++)
-    {
-        int n_bits = 1 << i * 3;
-        int nb_vertices = 0;
-        for (int j = 0; j < n_bits; j++)
-        {
-             if (mask[i_mask] == 0)
-             {
-                 nb_vertices += 8;
-                 for (int k = 0; k < 8; k++)
-                 {
-                     mask2[n_vertices2] = mask[i_var];
-                     var[n_vertices2] = var[i_var];
-                     n_vertices2++;
-                     i_var++;
-                 }
-             }
-             else
-             {
-                 i_var += 8;
-             }
-             i_mask++;
-        }
-        nb_vertices_by_level[i+1] = nb_vertices;
-    }
-    n_vertices = n_vertices2;
-    delete [] mask;
-    mask = mask2;
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::detail --
+//-----------------------------------------------------------------------------
 
-    int nb_vertices_by_level_max = nb_vertices_by_level[n_levels-1];
+//-----------------------------------------------------------------------------
+// helper used by io save
+//-----------------------------------------------------------------------------
+bool
+verify_htg_params(const conduit::Node &params,
+                  conduit::Node &info)
+{
+    bool res = true;
 
-    //
-    // Determine the size of the mask variable. Remove any trailing zeros.
-    //
-    int last_zero = -1;
-    int last_one = -1;
-    for (int i = 0; i < n_vertices; i++)
+    if( !params.has_child("path") )
     {
-        if (mask[i] == 0)
-            last_zero = i;
-        else
-            last_one = i;
+        info["errors"].append() = "missing required entry 'path'";
+        res = false;
     }
-    int n_mask = 1;
-    int mask_min = 0;
-    int mask_max = 0;
-    if (last_one != -1)
+    else if(!params["path"].dtype().is_string())
     {
-        mask_max = 1;
-        n_mask = last_one + 1;
+        info["errors"].append() = "'path' must be a string";
+        res = false;
+    }
+    else if(params["path"].as_string().empty())
+    {
+        info["errors"].append() = "'path' is an empty string";
+        res = false;
     }
 
-    //
-    // Create the descriptor variable. It is the opposite of the mask
-    // variable for all but the last level.
-    //
-    int n_descriptor = 0;
-    for (int i = 0; i < n_levels-1; i++)
-        n_descriptor += nb_vertices_by_level[i];
-
-    int *descriptor = new int[n_descriptor];
-    for (int i = 0; i < n_descriptor; i++)
-        descriptor[i] = (mask[i] == 0) ? 1 : 0;
-
-    //
-    // Determine the size of the descriptor variable. Remove any trailing zeros.
-    //
-    last_zero = -1;
-    last_one = -1;
-    for (int i = 0; i < n_descriptor; i++)
+    if( !params.has_child("blank_value") )
     {
-        if (descriptor[i] == 0)
-            last_zero = i;
-        else
-            last_one = i;
+        info["errors"].append() = "missing required entry 'blank_value'";
+        res = false;
     }
-    n_descriptor = 1;
-    int descriptor_min = 0;
-    int descriptor_max = 0;
-    if (last_zero == -1)
-        descriptor_min = 1;
-    if (last_one != -1)
+    else if(!params["blank_value"].dtype().is_float())
     {
-        descriptor_max = 1;
-        n_descriptor = last_one + 1;
+        info["errors"].append() = "'blank_value' must be a float";
+        res = false;
     }
 
-    //
-    // Replace any blank_value with zero.
-    //
-    for (int i = 0; i <n_vertices; i++)
+    std::vector<std::string> valid_paths;
+    std::vector<std::string> ignore_paths;
+    valid_paths.push_back("path");
+    valid_paths.push_back("fields");
+    valid_paths.push_back("blank_value");
+    ignore_paths.push_back("fields");
+
+    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
+
+    if(surprises != "")
     {
-        if (var[i] == blank_value)
-            var[i] = 0.;
+        info["errors"].append() = surprises;
+        res = false;
     }
 
-    htg_write_file(path, bounds, n_levels, n_vertices, n_descriptor,
-                   descriptor_min, descriptor_max, descriptor,
-                   nb_vertices_by_level_max, nb_vertices_by_level,
-                   n_mask, mask_min, mask_max, mask, var_min, var_max, var);
+    return res;
 }
 
+//-----------------------------------------------------------------------------
 void htg_save(const Node &data,
               const Node &fields,
               const std::string &path,
               float blank_value)
 {
-    if (data.number_of_children() != 1)
-    {
-        ASCENT_ERROR("htg extract requires a single domain."<<endl);
-    }
+    using namespace detail;
 
-    const conduit::Node &dom = data.child(0);
+    const int num_domains = data.number_of_children();
+    const int rank = mpi_rank();
 
     //
     // Determine the fields. If the fields node is empty then use all
-    // the fields.
+    // the fields of all the domains.
     //
-    int nfields = fields.number_of_children();
     std::vector<std::string> fnames;
-    if (nfields == 0 && dom.has_path("fields"))
+    if (fields.number_of_children() == 0)
     {
-        fnames = dom["fields"].child_names();
-        nfields = fnames.size();
+        std::set<std::string> names;
+        for(int d = 0; d < num_domains; ++d)
+        {
+            if(data.child(d).has_path("fields"))
+            {
+                std::vector<std::string> dom_names = data.child(d)["fields"].child_names();
+                names.insert(dom_names.begin(), dom_names.end());
+            }
+        }
+        gather_strings(names);
+        fnames.assign(names.begin(), names.end());
     }
     else
     {
         fnames = fields.child_names();
     }
+    const int nfields = static_cast<int>(fnames.size());
 
     //
     // Loop over the fields.
@@ -567,9 +593,30 @@ void htg_save(const Node &data,
     for(int f = 0; f < nfields; ++f)
     {
         const std::string fname = fnames[f];
-        if(dom.has_path("fields/" + fname))
+        const std::string fpath = "fields/" + fname;
+
+        //
+        // Find where each domain sits in the global grid. Every rank
+        // has to agree on skipping a field, since the write is collective.
+        //
+        bool valid = true;
+        // reserved up front, so the value nodes are never copied
+        std::vector<HTGDomain> domains;
+        domains.reserve(num_domains);
+        // origin and spacing mins, followed by the spacing maxs
+        std::vector<double> g_min(6, std::numeric_limits<double>::infinity());
+        std::vector<double> g_max(3, -std::numeric_limits<double>::infinity());
+        std::vector<double> origins;
+        std::vector<double> spacings;
+
+        for(int d = 0; d < num_domains && valid; ++d)
         {
-            const std::string fpath = "fields/" + fname;
+            const conduit::Node &dom = data.child(d);
+            if(!dom.has_path(fpath))
+            {
+                continue;
+            }
+
             const std::string topo = dom[fpath + "/topology"].as_string();
             const std::string tpath = "topologies/" + topo;
             const std::string coords = dom[tpath + "/coordset"].as_string();
@@ -578,63 +625,555 @@ void htg_save(const Node &data,
             if(dom[fpath + "/association"].as_string() != "element")
             {
                 ASCENT_INFO(fname<<": htg extract requires an element association, skipping."<<endl);
+                valid = false;
                 continue;
             }
             if(dom[cpath + "/type"].as_string() != "uniform")
             {
                 ASCENT_INFO(fname<<": htg extract requires a uniform mesh, skipping."<<endl);
+                valid = false;
                 continue;
             }
             if (!dom.has_path(cpath + "/dims/k"))
             {
                 ASCENT_INFO(fname<<": htg extract requires a 3d mesh, skipping."<<endl);
+                valid = false;
                 continue;
             }
 
-            int nx, ny, nz;
-            nx = dom[cpath + "/dims/i"].to_int32();
-            ny = dom[cpath + "/dims/j"].to_int32();
-            nz = dom[cpath + "/dims/k"].to_int32();
-            if (nx != ny && ny != nz)
+            const std::string axes[3] = {"x", "y", "z"};
+            const std::string dims[3] = {"i", "j", "k"};
+            domains.emplace_back();
+            HTGDomain &domain = domains.back();
+            for(int a = 0; a < 3; ++a)
             {
-                ASCENT_INFO(fname<<": htg extract requires the dimensions to be equal, skipping."<<endl);
-                continue;
-            }
-            nx = nx - 1;
-            if (nx == 0 || ((nx & (nx - 1)) != 0))
-            {
-                ASCENT_INFO(fname<<": htg extract requires the grid dimension to be a power of 2, skipping."<<endl);
-                continue;
+                const double origin = dom[cpath + "/origin/" + axes[a]].to_float64();
+                const double spacing = dom[cpath + "/spacing/d" + axes[a]].to_float64();
+                domain.m_dims[a] = dom[cpath + "/dims/" + dims[a]].to_int64() - 1;
+                origins.push_back(origin);
+                spacings.push_back(spacing);
+                g_min[a] = std::min(g_min[a], origin);
+                g_min[3 + a] = std::min(g_min[3 + a], spacing);
+                g_max[a] = std::max(g_max[a], spacing);
             }
 
-            double x0, y0, z0, dx, dy, dz;
-            double bounds[6];
-            x0 = dom[cpath + "/origin/x"].to_float64();
-            y0 = dom[cpath + "/origin/y"].to_float64();
-            z0 = dom[cpath + "/origin/z"].to_float64();
-            dx = dom[cpath + "/spacing/dx"].to_float64();
-            dy = dom[cpath + "/spacing/dy"].to_float64();
-            dz = dom[cpath + "/spacing/dz"].to_float64();
-            bounds[0] = x0;
-            bounds[1] = x0 + dx * double(nx);
-            bounds[2] = y0;
-            bounds[3] = y0 + dy * double(nx);
-            bounds[4] = z0;
-            bounds[5] = z0 + dz * double(nx);
-            conduit::Node res;
             if (dom[fpath + "/values"].dtype().is_float() &&
                 dom[fpath + "/values"].dtype().is_compact())
             {
-                res.set_external(dom[fpath + "/values"]);
+                domain.m_values.set_external(dom[fpath + "/values"]);
             }
             else
             {
-                dom[fpath + "/values"].to_float_array(res);
+                dom[fpath + "/values"].to_float_array(domain.m_values);
+            }
+        }
+
+        if(!global_agreement(valid))
+        {
+            continue;
+        }
+
+        htg_allreduce(g_min, HTG_MIN);
+        htg_allreduce(g_max, HTG_MAX);
+
+        if(g_min[3] == std::numeric_limits<double>::infinity())
+        {
+            // no domain has the field
+            continue;
+        }
+
+        for(int a = 0; a < 3; ++a)
+        {
+            if(g_max[a] - g_min[3 + a] > 1e-6 * g_max[a])
+            {
+                valid = false;
+            }
+        }
+        if(!valid)
+        {
+            ASCENT_INFO(fname<<": htg extract requires the same spacing in all domains, skipping."<<endl);
+            continue;
+        }
+
+        const int num_local = static_cast<int>(domains.size());
+        std::vector<long long> extents(3, 0);
+        for(int d = 0; d < num_local; ++d)
+        {
+            for(int a = 0; a < 3; ++a)
+            {
+                const double shift = (origins[d * 3 + a] - g_min[a]) / g_min[3 + a];
+                domains[d].m_offset[a] = static_cast<long long>(std::llround(shift));
+                extents[a] = std::max(extents[a],
+                                      domains[d].m_offset[a] + domains[d].m_dims[a]);
+            }
+        }
+        htg_allreduce(extents, HTG_MAX);
+
+        const long long nx = extents[0];
+        if (nx != extents[1] || nx != extents[2])
+        {
+            ASCENT_INFO(fname<<": htg extract requires the dimensions to be equal, skipping."<<endl);
+            continue;
+        }
+        if (nx < 2 || ((nx & (nx - 1)) != 0))
+        {
+            ASCENT_INFO(fname<<": htg extract requires the grid dimension to be a power of 2, skipping."<<endl);
+            continue;
+        }
+
+        //
+        // Cut the grid into blocks and every domain into the pieces
+        // that fall inside each block.
+        //
+        const int n_levels = htg_log2(nx) + 1;
+        const int coarse_depth = std::min(HTG_MAX_COARSE_DEPTH, n_levels - 1);
+        const int depth = n_levels - 1 - coarse_depth;
+        const long long block_size = 1LL << depth;
+        const long long blocks_per_axis = nx / block_size;
+        const long long n_blocks = blocks_per_axis * blocks_per_axis * blocks_per_axis;
+
+        std::vector<HTGPiece> pieces;
+        for(int d = 0; d < num_local; ++d)
+        {
+            const HTGDomain &domain = domains[d];
+            if(domain.m_dims[0] < 1 || domain.m_dims[1] < 1 || domain.m_dims[2] < 1)
+            {
+                continue;
+            }
+            const float *values = domain.m_values.value();
+            const long long dx = domain.m_dims[0];
+            const long long dxy = domain.m_dims[0] * domain.m_dims[1];
+            long long first[3], last[3];
+            for(int a = 0; a < 3; ++a)
+            {
+                first[a] = domain.m_offset[a] / block_size;
+                last[a] = (domain.m_offset[a] + domain.m_dims[a] - 1) / block_size;
+            }
+            for(long long bk = first[2]; bk <= last[2]; ++bk)
+            {
+                for(long long bj = first[1]; bj <= last[1]; ++bj)
+                {
+                    for(long long bi = first[0]; bi <= last[0]; ++bi)
+                    {
+                        const long long block[3] = {bi, bj, bk};
+                        HTGPiece piece;
+                        long long start[3];
+                        for(int a = 0; a < 3; ++a)
+                        {
+                            const long long lo = std::max(domain.m_offset[a], block[a] * block_size);
+                            const long long hi = std::min(domain.m_offset[a] + domain.m_dims[a],
+                                                          (block[a] + 1) * block_size);
+                            piece.m_lo[a] = static_cast<int>(lo - block[a] * block_size);
+                            piece.m_size[a] = static_cast<int>(hi - lo);
+                            start[a] = lo - domain.m_offset[a];
+                        }
+                        piece.m_code = htg_morton_encode(static_cast<int>(bi),
+                                                         static_cast<int>(bj),
+                                                         static_cast<int>(bk),
+                                                         coarse_depth);
+                        piece.m_values = values + start[2] * dxy + start[1] * dx + start[0];
+                        piece.m_strides[0] = dx;
+                        piece.m_strides[1] = dxy;
+                        pieces.push_back(piece);
+                    }
+                }
+            }
+        }
+
+        //
+        // Each block is built by the lowest rank that holds cells of it,
+        // so blocks that lie inside a domain never move. Blocks that no
+        // domain covers have no owner and are blank.
+        //
+        std::vector<long long> owners(n_blocks, std::numeric_limits<long long>::max());
+        for(size_t p = 0; p < pieces.size(); ++p)
+        {
+            owners[pieces[p].m_code] = rank;
+        }
+        htg_allreduce(owners, HTG_MIN);
+
+        std::vector<float> recv_values;
+        htg_exchange_pieces(pieces, owners, recv_values);
+
+        std::vector<HTGBlock> blocks;
+        std::vector<int> block_index(n_blocks, -1);
+        for(long long code = 0; code < n_blocks; ++code)
+        {
+            if(owners[code] == rank)
+            {
+                block_index[code] = static_cast<int>(blocks.size());
+                blocks.emplace_back();
+                blocks.back().m_code = code;
+            }
+        }
+        for(size_t p = 0; p < pieces.size(); ++p)
+        {
+            blocks[block_index[pieces[p].m_code]].m_pieces.push_back(static_cast<int>(p));
+        }
+
+        //
+        // Build the subtree of every block. Cells of a block that no
+        // piece covers stay blank, cells covered twice mean that the
+        // domains overlap.
+        //
+        const int num_blocks = static_cast<int>(blocks.size());
+        const long long block_cells = block_size * block_size * block_size;
+        std::vector<float> block_min(num_blocks);
+        std::vector<float> block_max(num_blocks);
+        std::vector<long long> block_count(num_blocks, 0);
+        long long any_overlap = 0;
+
+#ifdef ASCENT_OPENMP_ENABLED
+        #pragma omp parallel for reduction(max:any_overlap)
+#endif
+        for(int b = 0; b < num_blocks; ++b)
+        {
+            HTGBlock &block = blocks[b];
+            std::vector<float> leaves(block_cells, blank_value);
+            std::vector<unsigned char> covered(block_cells, 0);
+            float vmin = std::numeric_limits<float>::max();
+            float vmax = -std::numeric_limits<float>::max();
+            long long count = 0;
+            bool overlap = false;
+            for(size_t p = 0; p < block.m_pieces.size(); ++p)
+            {
+                const HTGPiece &piece = pieces[block.m_pieces[p]];
+                for(int k = 0; k < piece.m_size[2]; ++k)
+                {
+                    for(int j = 0; j < piece.m_size[1]; ++j)
+                    {
+                        const float *row = piece.m_values +
+                                           k * piece.m_strides[1] +
+                                           j * piece.m_strides[0];
+                        for(int i = 0; i < piece.m_size[0]; ++i)
+                        {
+                            const long long m = htg_morton_encode(piece.m_lo[0] + i,
+                                                                  piece.m_lo[1] + j,
+                                                                  piece.m_lo[2] + k,
+                                                                  depth);
+                            const float value = row[i];
+                            overlap = overlap || covered[m];
+                            covered[m] = 1;
+                            leaves[m] = value;
+                            if(value != blank_value)
+                            {
+                                vmin = std::min(vmin, value);
+                                vmax = std::max(vmax, value);
+                                count++;
+                            }
+                        }
+                    }
+                }
+            }
+            block_min[b] = vmin;
+            block_max[b] = vmax;
+            block_count[b] = count;
+            if(overlap)
+            {
+                any_overlap = 1;
+            }
+            htg_build_levels(leaves, depth, blank_value, block.m_levels);
+        }
+
+        std::vector<long long> overlaps(1, any_overlap);
+        htg_allreduce(overlaps, HTG_MAX);
+        if(overlaps[0] != 0)
+        {
+            ASCENT_INFO(fname<<": htg extract requires domains that do not overlap, skipping."<<endl);
+            continue;
+        }
+
+        //
+        // Calculate min and max for the variable. We only need to do
+        // the input array, since the output will contain the input and
+        // averages of the input. We exclude any blank values. If the
+        // array contains all blank values we throw an exception.
+        //
+        std::vector<double> var_min(1, std::numeric_limits<double>::infinity());
+        std::vector<double> var_max(1, -std::numeric_limits<double>::infinity());
+        std::vector<long long> var_count(1, 0);
+        for(int b = 0; b < num_blocks; ++b)
+        {
+            if(block_count[b] > 0)
+            {
+                var_min[0] = std::min(var_min[0], double(block_min[b]));
+                var_max[0] = std::max(var_max[0], double(block_max[b]));
+                var_count[0] += block_count[b];
+            }
+        }
+        htg_allreduce(var_min, HTG_MIN);
+        htg_allreduce(var_max, HTG_MAX);
+        htg_allreduce(var_count, HTG_SUM);
+
+        if (var_count[0] == 0)
+        {
+            ASCENT_ERROR("htg extract: the variable only had blank values."<<endl);
+        }
+
+        //
+        // Reduce the block roots and build the coarse levels. Blocks
+        // that no domain covers are blank.
+        //
+        std::vector<double> roots(n_blocks, std::numeric_limits<double>::infinity());
+        for(int b = 0; b < num_blocks; ++b)
+        {
+            roots[blocks[b].m_code] = blocks[b].m_levels[0][0];
+        }
+        htg_allreduce(roots, HTG_MIN);
+
+        std::vector<float> coarse_leaves(n_blocks);
+        for(long long b = 0; b < n_blocks; ++b)
+        {
+            coarse_leaves[b] = roots[b] == std::numeric_limits<double>::infinity() ?
+                               blank_value : static_cast<float>(roots[b]);
+        }
+        std::vector<std::vector<float>> coarse;
+        htg_build_levels(coarse_leaves, coarse_depth, blank_value, coarse);
+
+        //
+        // Lay out the vertices. Segment 0 is the coarse levels, then
+        // come the pieces of every block for each finer level.
+        //
+        const long long n_segments = 1 + depth * n_blocks;
+        std::vector<long long> seg_counts(n_segments, 0);
+        for(int b = 0; b < num_blocks; ++b)
+        {
+            for(int s = 1; s <= depth; ++s)
+            {
+                seg_counts[1 + (s - 1) * n_blocks + blocks[b].m_code] =
+                  static_cast<long long>(blocks[b].m_levels[s].size());
+            }
+        }
+        htg_allreduce(seg_counts, HTG_SUM);
+
+        std::vector<long long> nb_vertices_by_level(n_levels, 0);
+        for(int l = 0; l <= coarse_depth; ++l)
+        {
+            nb_vertices_by_level[l] = static_cast<long long>(coarse[l].size());
+            seg_counts[0] += nb_vertices_by_level[l];
+        }
+        for(int s = 1; s <= depth; ++s)
+        {
+            for(long long b = 0; b < n_blocks; ++b)
+            {
+                nb_vertices_by_level[coarse_depth + s] += seg_counts[1 + (s - 1) * n_blocks + b];
+            }
+        }
+
+        std::vector<long long> seg_starts(n_segments, 0);
+        for(long long s = 1; s < n_segments; ++s)
+        {
+            seg_starts[s] = seg_starts[s - 1] + seg_counts[s - 1];
+        }
+        const long long n_vertices = seg_starts[n_segments - 1] + seg_counts[n_segments - 1];
+        // the descriptor covers all but the last level
+        const long long n_descriptor_full = n_vertices - nb_vertices_by_level[n_levels - 1];
+
+        //
+        // Gather the vertices of the segments this rank writes.
+        //
+        std::vector<long long> my_segments;
+        std::vector<const float*> my_values;
+        std::vector<float> coarse_values;
+        if(rank == 0)
+        {
+            for(int l = 0; l <= coarse_depth; ++l)
+            {
+                coarse_values.insert(coarse_values.end(), coarse[l].begin(), coarse[l].end());
+            }
+            my_segments.push_back(0);
+            my_values.push_back(coarse_values.data());
+        }
+        for(int b = 0; b < num_blocks; ++b)
+        {
+            for(int s = 1; s <= depth; ++s)
+            {
+                my_segments.push_back(1 + (s - 1) * n_blocks + blocks[b].m_code);
+                my_values.push_back(blocks[b].m_levels[s].data());
+            }
+        }
+        const int num_my_segments = static_cast<int>(my_segments.size());
+
+        //
+        // Determine the size of the mask and descriptor variables. The
+        // descriptor is the opposite of the mask for all but the last
+        // level. Remove any trailing zeros.
+        //
+        // last mask one, last descriptor one, has a descriptor zero
+        std::vector<long long> trims(3, -1);
+        for(int i = 0; i < num_my_segments; ++i)
+        {
+            const long long start = seg_starts[my_segments[i]];
+            const long long count = seg_counts[my_segments[i]];
+            for(long long v = 0; v < count; ++v)
+            {
+                const long long p = start + v;
+                const bool masked = my_values[i][v] == blank_value;
+                if(masked)
+                {
+                    trims[0] = std::max(trims[0], p);
+                }
+                if(p < n_descriptor_full)
+                {
+                    if(!masked)
+                    {
+                        trims[1] = std::max(trims[1], p);
+                    }
+                    else
+                    {
+                        trims[2] = 1;
+                    }
+                }
             }
-            const float *values = res.value();
+        }
+        htg_allreduce(trims, HTG_MAX);
 
-            htg_write(path, blank_value, nx, bounds, values);
+        const long long n_mask = trims[0] != -1 ? trims[0] + 1 : 1;
+        const int mask_min = 0;
+        const int mask_max = trims[0] != -1 ? 1 : 0;
+        const long long n_descriptor = trims[1] != -1 ? trims[1] + 1 : 1;
+        const int descriptor_min = trims[2] == 1 ? 0 : 1;
+        const int descriptor_max = trims[1] != -1 ? 1 : 0;
+
+        //
+        // Format the descriptor, mask and variable pieces of each segment.
+        // Blank values are written as zero.
+        //
+        std::vector<std::string> texts(num_my_segments * 3);
+        std::vector<long long> text_sizes(3 * n_segments, 0);
+#ifdef ASCENT_OPENMP_ENABLED
+        #pragma omp parallel for
+#endif
+        for(int i = 0; i < num_my_segments; ++i)
+        {
+            const long long start = seg_starts[my_segments[i]];
+            const long long count = seg_counts[my_segments[i]];
+            std::ostringstream descriptor_oss, mask_oss, var_oss;
+            for(long long v = 0; v < count; ++v)
+            {
+                const long long p = start + v;
+                const float value = my_values[i][v];
+                const int masked = value == blank_value ? 1 : 0;
+                if(p < n_descriptor)
+                {
+                    htg_format_entry(descriptor_oss, p, n_descriptor, 1 - masked);
+                }
+                if(p < n_mask)
+                {
+                    htg_format_entry(mask_oss, p, n_mask, masked);
+                }
+                htg_format_entry(var_oss, p, n_vertices, masked ? 0.f : value);
+            }
+            texts[i * 3 + 0] = descriptor_oss.str();
+            texts[i * 3 + 1] = mask_oss.str();
+            texts[i * 3 + 2] = var_oss.str();
+        }
+        for(int i = 0; i < num_my_segments; ++i)
+        {
+            for(int a = 0; a < 3; ++a)
+            {
+                text_sizes[a * n_segments + my_segments[i]] =
+                  static_cast<long long>(texts[i * 3 + a].size());
+            }
+        }
+        htg_allreduce(text_sizes, HTG_SUM);
+
+        //
+        // Write out the HTG VTK file. It is in ASCII format, which is the
+        // least efficient, but it's the simplest and was great for developing
+        // the algorithm. This should probably be improved at some point.
+        //
+        const double bounds[6] = {g_min[0], g_min[0] + g_min[3] * double(nx),
+                                  g_min[1], g_min[1] + g_min[4] * double(nx),
+                                  g_min[2], g_min[2] + g_min[5] * double(nx)};
+        const long long nb_vertices_by_level_max = nb_vertices_by_level[n_levels - 1];
+
+        std::string headers[4];
+        {
+            std::ostringstream oss;
+            oss << "<VTKFile type=\"HyperTreeGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt32\">" << "\n";
+            oss << "  <HyperTreeGrid BranchFactor=\"2\" TransposedRootIndexing=\"0\" Dimensions=\"2 2 2\">" << "\n";
+            oss << "    <Grid>" << "\n";
+            oss << "      <DataArray type=\"Float64\" Name=\"XCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[0] << "\" RangeMax=\"" << bounds[1] << "\">" << "\n";
+            oss << "        " << bounds[0] << " " << bounds[1] << "\n";
+            oss << "      </DataArray>" << "\n";
+            oss << "      <DataArray type=\"Float64\" Name=\"YCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[2] << "\" RangeMax=\"" << bounds[3] << "\">" << "\n";
+            oss << "        " << bounds[2] << " " << bounds[3] << "\n";
+            oss << "      </DataArray>" << "\n";
+            oss << "      <DataArray type=\"Float64\" Name=\"ZCoordinates\" NumberOfTuples=\"2\" format=\"ascii\" RangeMin=\"" << bounds[4] << "\" RangeMax=\"" << bounds[5] << "\">" << "\n";
+            oss << "        " << bounds[4] << " " << bounds[5] << "\n";
+            oss << "      </DataArray>" << "\n";
+            oss << "    </Grid>" << "\n";
+            oss << "    <Trees>" << "\n";
+            oss << "      <Tree Index=\"0\" NumberOfLevels=\"" << n_levels << "\" NumberOfVertices=\"" << n_vertices << "\">" << "\n";
+            oss << "        <DataArray type=\"Bit\" Name=\"Descriptor\" NumberOfTuples=\"" << n_descriptor << "\" format=\"ascii\" RangeMin=\"" << descriptor_min << "\" RangeMax=\"" << descriptor_max << "\">" << "\n";
+            headers[0] = oss.str();
+        }
+        {
+            std::ostringstream oss;
+            oss << "        </DataArray>" << "\n";
+            oss << "        <DataArray type=\"Int64\" Name=\"NbVerticesByLevel\" NumberOfTuples=\"" << n_levels << "\" format=\"ascii\" RangeMin=\"1\" RangeMax=\"" << nb_vertices_by_level_max << "\">" << "\n";
+            oss << "          ";
+            for (int i = 0; i < n_levels - 1; i++)
+                oss << nb_vertices_by_level[i] << " ";
+            oss << nb_vertices_by_level[n_levels-1] << "\n";
+            oss << "        </DataArray>" << "\n";
+            oss << "        <DataArray type=\"Bit\" Name=\"Mask\" NumberOfTuples=\"" << n_mask << "\" format=\"ascii\" RangeMin=\"" << mask_min << "\" RangeMax=\"" << mask_max << "\">" << "\n";
+            headers[1] = oss.str();
+        }
+        {
+            std::ostringstream oss;
+            oss << "        </DataArray>" << "\n";
+            oss << "        <CellData>" << "\n";
+            oss << "          <DataArray type=\"Float64\" Name=\"u\" NumberOfTuples=\"" << n_vertices << "\" format=\"ascii\" RangeMin=\"" << var_min[0] << "\" RangeMax=\"" << var_max[0] << "\">" << "\n";
+            headers[2] = oss.str();
         }
+        {
+            std::ostringstream oss;
+            oss << "          </DataArray>" << "\n";
+            oss << "        </CellData>" << "\n";
+            oss << "      </Tree>" << "\n";
+            oss << "    </Trees>" << "\n";
+            oss << "  </HyperTreeGrid>" << "\n";
+            oss << "</VTKFile>" << "\n";
+            headers[3] = oss.str();
+        }
+
+        //
+        // Every rank knows the size of every piece, so each one
+        // can place its own pieces in the file.
+        //
+        std::vector<std::pair<long long, std::string>> file_pieces;
+        long long offset = 0;
+        std::vector<long long> piece_offsets(3 * n_segments);
+        for(int a = 0; a < 3; ++a)
+        {
+            if(rank == 0)
+            {
+                file_pieces.push_back(std::make_pair(offset, headers[a]));
+            }
+            offset += static_cast<long long>(headers[a].size());
+            for(long long s = 0; s < n_segments; ++s)
+            {
+                piece_offsets[a * n_segments + s] = offset;
+                offset += text_sizes[a * n_segments + s];
+            }
+        }
+        if(rank == 0)
+        {
+            file_pieces.push_back(std::make_pair(offset, headers[3]));
+        }
+
+        for(int i = 0; i < num_my_segments; ++i)
+        {
+            for(int a = 0; a < 3; ++a)
+            {
+                file_pieces.push_back(std::make_pair(piece_offsets[a * n_segments + my_segments[i]],
+                                                texts[i * 3 + a]));
+            }
+        }
+
+        htg_write_pieces(path + ".htg", file_pieces);
     }
 }
 
@@ -673,10 +1212,6 @@ HTGIOSave::verify_params(const conduit::Node &params,
 void
 HTGIOSave::execute()
 {
-  
-#if ASCENT_MPI_ENABLED
-    ASCENT_ERROR("htg extract only supports serial execution"<<endl);  
-#endif
     std::string path;
     path = params()["path"].as_string();
     path = output_dir(path);
@@ -706,19 +1241,10 @@ HTGIOSave::execute()
     htg_save(*in, fields, path, blank_value);
 
     // add this to the extract results in the registry
-    if(!graph().workspace().registry().has_entry("extract_list"))
-    {
-      conduit::Node *extract_list = new conduit::Node();
-      graph().workspace().registry().add<Node>("extract_list",
-                                               extract_list,
-                                               -1); // TODO keep forever?
-    }
-
-    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
-
-    Node &einfo = extract_list->append();
+    Node einfo;
     einfo["type"] = "htg";
     einfo["path"] = path;
+    add_extract_info(graph().workspace().registry(), einfo);
 }
 
 
@@ -116,15 +116,28 @@ BasicQuery::execute()
       return;
     }
 
-    std::string expression = params()["expression"].as_string();
-    std::string name = params()["name"].as_string();
-    conduit::Node actions;
-
-    Node v_info;
+    // the results of batched queries were stored by the first query
+    // of the batch
+    if(!params().has_path("batch_head"))
+    {
+      std::vector<std::string> expressions;
+      std::vector<std::string> names;
+      expressions.push_back(params()["expression"].as_string());
+      names.push_back(params()["name"].as_string());
+      if(params().has_path("batch"))
+      {
+        const conduit::Node &batch = params()["batch"];
+        for(int i = 0; i < batch.number_of_children(); ++i)
+        {
+          expressions.push_back(batch.child(i)["expression"].as_string());
+          names.push_back(batch.child(i)["name"].as_string());
+        }
+      }
 
-    // The mere act of a query stores the results
-    runtime::expressions::ExpressionEval eval(*data_object);
-    conduit::Node res = eval.evaluate(expression, name);
+      // The mere act of a query stores the results
+      runtime::expressions::ExpressionEval eval(*data_object);
+      eval.evaluate(expressions, names);
+    }
 
     // we never actually use the output port
     // since we only use it to chain ordering
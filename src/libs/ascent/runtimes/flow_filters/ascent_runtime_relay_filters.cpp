@@ -56,6 +56,7 @@
 
 // std includes
 #include <limits>
+#include <mutex>
 #include <set>
 
 using namespace std;
@@ -87,6 +88,17 @@ namespace filters
 namespace detail
 {
 
+//-----------------------------------------------------------------------------
+// relay io (hdf5 in particular) is not thread safe, so io from filters
+// that execute concurrently is serialized
+//-----------------------------------------------------------------------------
+std::mutex &
+relay_io_mutex()
+{
+  static std::mutex io_mutex;
+  return io_mutex;
+}
+
 
 //-----------------------------------------------------------------------------
 // mfem needs special fields so look for them
@@ -520,6 +532,11 @@ RelayIOSave::declare_interface(Node &i)
     i["type_name"]   = "relay_io_save";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+#ifndef ASCENT_MPI_ENABLED
+    // serial saves issue no collectives, so they can overlap
+    // with rendering when the workspace has threads
+    i["concurrent"]  = "true";
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -632,6 +649,7 @@ RelayIOSave::execute()
 #endif
 
     std::string result_path;
+    std::lock_guard<std::mutex> io_lock(detail::relay_io_mutex());
     if(protocol.empty())
     {
         conduit::relay::io::save(selected,path);
@@ -675,21 +693,12 @@ RelayIOSave::execute()
     }
 
     // add this to the extract results in the registry
-    if(!graph().workspace().registry().has_entry("extract_list"))
-    {
-      conduit::Node *extract_list = new conduit::Node();
-      graph().workspace().registry().add<Node>("extract_list",
-                                               extract_list,
-                                               -1); // TODO keep forever?
-    }
-
-    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
-
-    Node &einfo = extract_list->append();
+    Node einfo;
     einfo["type"] = "relay";
     if(!protocol.empty())
         einfo["protocol"] = protocol;
     einfo["path"] = result_path;
+    add_extract_info(graph().workspace().registry(), einfo);
 }
 
 
@@ -740,6 +749,7 @@ RelayIOLoad::execute()
 
     Node *res = new Node();
 
+    std::lock_guard<std::mutex> io_lock(detail::relay_io_mutex());
     if(protocol.empty())
     {
         conduit::relay::io::load(path,*res);
@@ -772,6 +782,10 @@ BlueprintFlatten::declare_interface(Node &i)
     i["type_name"]   = "false";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+#ifndef ASCENT_MPI_ENABLED
+    // see RelayIOSave::declare_interface
+    i["concurrent"]  = "true";
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -883,6 +897,7 @@ BlueprintFlatten::execute()
 
     if(rank == root)
     {
+        std::lock_guard<std::mutex> io_lock(detail::relay_io_mutex());
         if(protocol.empty())
         {
             //path = path;
@@ -898,21 +913,12 @@ BlueprintFlatten::execute()
     }
 
     // add this to the extract results in the registry
-    if(!graph().workspace().registry().has_entry("extract_list"))
-    {
-      conduit::Node *extract_list = new conduit::Node();
-      graph().workspace().registry().add<Node>("extract_list",
-                                               extract_list,
-                                               -1); // TODO keep forever?
-    }
-
-    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
-
-    Node &einfo = extract_list->append();
+    Node einfo;
     einfo["type"] = "flatten";
     if(!protocol.empty())
         einfo["protocol"] = protocol;
     einfo["path"] = result_path;
+    add_extract_info(graph().workspace().registry(), einfo);
 }
 
 
@@ -176,6 +176,9 @@ check_renders_surprises(const conduit::Node &renders_node)
   r_valid_paths.push_back("auto_camera/bins");
   r_valid_paths.push_back("auto_camera/height");
   r_valid_paths.push_back("auto_camera/width");
+  r_valid_paths.push_back("auto_camera/batch_size");
+  r_valid_paths.push_back("auto_camera/coarse_scale");
+  r_valid_paths.push_back("auto_camera/refine");
   r_valid_paths.push_back("color_bar_position");
 
   std::vector<std::string> r_ignore_paths;
@@ -1196,18 +1199,10 @@ DefaultRender::execute()
 
           detail::CinemaManager &manager = detail::CinemaDatabases::get_db(db_name);
           // add this to the extract results in the registry
-          if(!graph().workspace().registry().has_entry("extract_list"))
-          {
-            conduit::Node *extract_list = new conduit::Node();
-            graph().workspace().registry().add<Node>("extract_list",
-                                               extract_list,
-                                               -1); // TODO keep forever?
-          }
-
-          conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
-          Node &einfo = extract_list->append();
+          Node einfo;
           einfo["type"] = "cinema";
           einfo["path"] = manager.db_path();
+          add_extract_info(graph().workspace().registry(), einfo);
 
           int image_width;
           int image_height;
@@ -1316,6 +1311,18 @@ DefaultRender::execute()
               width = render_node["auto_camera/width"].as_int32();
               auto_cam.SetWidth(width); 
             }
+            if(render_node.has_path("auto_camera/batch_size"))
+            {
+              auto_cam.SetBatchSize(render_node["auto_camera/batch_size"].to_int32());
+            }
+            if(render_node.has_path("auto_camera/coarse_scale"))
+            {
+              auto_cam.SetCoarseScale(render_node["auto_camera/coarse_scale"].to_int32());
+            }
+            if(render_node.has_path("auto_camera/refine"))
+            {
+              auto_cam.SetNumRefine(render_node["auto_camera/refine"].to_int32());
+            }
       
             auto_cam.SetInput(&dataset);
             auto_cam.SetField(field_name);
@@ -120,10 +120,14 @@ BasicTrigger::verify_params(const conduit::Node &params,
     valid_paths.push_back("callback");
     valid_paths.push_back("actions_file");
     valid_paths.push_back("actions");
+    // set by the runtime when triggers are evaluated together
+    valid_paths.push_back("batch");
+    valid_paths.push_back("batch_head");
 
     std::vector<std::string> ignore_paths;
     // don't go down the actions path
     ignore_paths.push_back("actions");
+    ignore_paths.push_back("batch");
 
     std::string surprises = surprise_check(valid_paths, ignore_paths,params);
 
@@ -146,24 +150,29 @@ BasicTrigger::execute()
         ASCENT_ERROR("Trigger input must be a data object");
     }
 
+    // batched triggers are evaluated and fired by the first
+    // trigger of the batch
+    if(params().has_path("batch_head"))
+    {
+      return;
+    }
+
     DataObject *data_object = input<DataObject>(0);
     std::shared_ptr<Node> n_input = data_object->as_low_order_bp();
 
-    bool use_actions_file = params().has_path("actions_file");
-
-    std::string actions_file = "";
-    conduit::Node actions;
-
-    if(use_actions_file)
+    // this trigger followed by the ones batched with it
+    std::vector<const conduit::Node*> triggers;
+    triggers.push_back(&params());
+    if(params().has_path("batch"))
     {
-      actions_file = params()["actions_file"].as_string();
-    }
-    else
-    {
-      actions = params()["actions"];
+      const conduit::Node &batch = params()["batch"];
+      for(int i = 0; i < batch.number_of_children(); ++i)
+      {
+        triggers.push_back(&batch.child(i));
+      }
     }
 
-    conduit::Node res;
+    std::vector<bool> fire(triggers.size(), false);
 
     bool has_callback = params().has_path("callback");
     bool has_condition = params().has_path("condition");
@@ -171,18 +180,28 @@ BasicTrigger::execute()
     if(has_callback)
     {
       std::string callback_name = params()["callback"].as_string();
-      res["value"] = ascent::execute_callback(callback_name);
-      res["type"] = "bool";
+      fire[0] = ascent::execute_callback(callback_name);
     }
     else if(has_condition)
     {
+      std::vector<std::string> expressions;
+      for(size_t i = 0; i < triggers.size(); ++i)
+      {
+        expressions.push_back((*triggers[i])["condition"].as_string());
+      }
+      // conditions are cached under the expression itself
+      std::vector<std::string> names(expressions.size(), "");
+
       runtime::expressions::ExpressionEval eval(n_input.get());
-      std::string expression = params()["condition"].as_string();
-      res = eval.evaluate(expression);
+      std::vector<conduit::Node> res = eval.evaluate(expressions, names);
 
-      if(res["type"].as_string() != "bool")
+      for(size_t i = 0; i < res.size(); ++i)
       {
-        ASCENT_ERROR("result of expression '"<<expression<<"' is not an bool");
+        if(res[i]["type"].as_string() != "bool")
+        {
+          ASCENT_ERROR("result of expression '"<<expressions[i]<<"' is not an bool");
+        }
+        fire[i] = res[i]["value"].to_uint8() != 0;
       }
     }
     else
@@ -190,9 +209,26 @@ BasicTrigger::execute()
       ASCENT_ERROR("must provide either a condition or a callback");
     }
 
-    bool fire = res["value"].to_uint8() != 0;
-    if(fire)
+    for(size_t i = 0; i < triggers.size(); ++i)
     {
+      if(!fire[i])
+      {
+        continue;
+      }
+
+      const conduit::Node &trigger = *triggers[i];
+      std::string actions_file = "";
+      conduit::Node actions;
+
+      if(trigger.has_path("actions_file"))
+      {
+        actions_file = trigger["actions_file"].as_string();
+      }
+      else
+      {
+        actions = trigger["actions"];
+      }
+
       Ascent ascent;
 
       Node ascent_opts;
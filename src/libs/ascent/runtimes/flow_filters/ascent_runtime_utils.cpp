@@ -16,7 +16,10 @@
 #include <ascent_string_utils.hpp>
 #include <ascent_metadata.hpp>
 
+#include <flow_registry.hpp>
+
 #include <algorithm>
+#include <mutex>
 
 using namespace conduit;
 
@@ -79,6 +82,26 @@ std::string filter_to_path(const std::string filter_name)
   }
   return res;
 }
+
+void add_extract_info(flow::Registry &registry,
+                      const conduit::Node &info)
+{
+  // the registry guards each call, but not the check and add
+  // or the append to the list
+  static std::mutex extract_list_mutex;
+  std::lock_guard<std::mutex> lock(extract_list_mutex);
+
+  if(!registry.has_entry("extract_list"))
+  {
+    conduit::Node *extract_list = new conduit::Node();
+    registry.add<conduit::Node>("extract_list",
+                                extract_list,
+                                -1); // TODO keep forever?
+  }
+
+  conduit::Node *extract_list = registry.fetch<conduit::Node>("extract_list");
+  extract_list->append().set(info);
+}
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
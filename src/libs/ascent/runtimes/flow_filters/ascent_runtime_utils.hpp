@@ -18,6 +18,17 @@
 #include <ascent_exports.h>
 #include <string>
 
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+class Registry;
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -47,6 +58,12 @@ std::string ASCENT_API default_dir();
 
 std::string ASCENT_API filter_to_path(const std::string filter_name);
 
+// Appends a copy of info to the "extract_list" entry of the registry,
+// creating the list on first use. Safe to call from filters that
+// execute concurrently.
+void ASCENT_API add_extract_info(flow::Registry &registry,
+                                 const conduit::Node &info);
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -18,6 +18,9 @@ struct BVH
   Array<int32> m_leaf_nodes;
   AABB<> m_bounds; // total bounds of primitives
   Array<int32> m_aabb_ids;
+  // surface area heuristic cost of the tree when it was built,
+  // used to decide when a refit tree should be rebuilt
+  float32 m_build_cost = 0.f;
   // multiple leaf nodes can point to the same
   // original primitive. m_aabb_ids point to the
   // index of the aabb given to construct
@@ -60,6 +60,13 @@ template <class ElemT> struct DeviceMesh
 
   DRAY_EXEC_ONLY ElemT get_elem (int32 el_idx) const;
   DRAY_EXEC_ONLY Location locate (const Vec<Float, 3> &point) const;
+  // Coherent version: first looks in the element of the hint and walks
+  // through the faces (see detail::face_neighbors) towards the point,
+  // falling back to the bvh if that does not find it.
+  DRAY_EXEC_ONLY Location locate (const Vec<Float, 3> &point,
+                                  const Location &hint,
+                                  const int32 *face_neighbors,
+                                  stats::Stats &mstat) const;
 };
 
 
@@ -244,8 +251,158 @@ template <> struct LocateHack<2>
     return eval_inverse(elem, stats, world_coords, guess_domain, ref_coords, use_init_guess);
   }
 };
+// Face of the reference element the point left through, numbered like
+// extract_faces. ref_coords are outside the element.
+template <ElemType etype> struct ExitFace
+{
+};
+
+template <> struct ExitFace<ElemType::Tensor>
+{
+  static constexpr int32 num_faces = 6;
+
+  static DRAY_EXEC Float center ()
+  {
+    return 0.5f;
+  }
+
+  static DRAY_EXEC int32 get (const Vec<Float, 3> &ref_coords)
+  {
+    // faces 0-2 are at x,y,z == 0 and faces 3-5 at x,y,z == 1
+    int32 face = -1;
+    Float worst = 0.f;
+    for (int32 d = 0; d < 3; ++d)
+    {
+      if (-ref_coords[d] > worst)
+      {
+        worst = -ref_coords[d];
+        face = d;
+      }
+      if (ref_coords[d] - 1.f > worst)
+      {
+        worst = ref_coords[d] - 1.f;
+        face = d + 3;
+      }
+    }
+    return face;
+  }
+};
+
+template <> struct ExitFace<ElemType::Simplex>
+{
+  static constexpr int32 num_faces = 4;
+
+  static DRAY_EXEC Float center ()
+  {
+    return 0.25f;
+  }
+
+  static DRAY_EXEC int32 get (const Vec<Float, 3> &ref_coords)
+  {
+    // faces 0-2 are at x,y,z == 0 and face 3 at x + y + z == 1
+    int32 face = -1;
+    Float worst = 0.f;
+    for (int32 d = 0; d < 3; ++d)
+    {
+      if (-ref_coords[d] > worst)
+      {
+        worst = -ref_coords[d];
+        face = d;
+      }
+    }
+    const Float over = ref_coords[0] + ref_coords[1] + ref_coords[2] - 1.f;
+    if (over > worst)
+    {
+      face = 3;
+    }
+    return face;
+  }
+};
+
+// Walk from the hinted element towards the point. Only 3D elements
+// have face neighbors.
+template <int32 d> struct LocateWalk
+{
+  template <class ElemT, class MeshT>
+  static bool DRAY_EXEC_ONLY walk (const MeshT &mesh,
+                                   const Vec<Float, 3> &point,
+                                   const Location &hint,
+                                   const int32 *face_neighbors,
+                                   stats::Stats &mstat,
+                                   Location &loc)
+  {
+    return false;
+  }
+};
+
+template <> struct LocateWalk<3u>
+{
+  template <class ElemT, class MeshT>
+  static bool DRAY_EXEC_ONLY walk (const MeshT &mesh,
+                                   const Vec<Float, 3> &point,
+                                   const Location &hint,
+                                   const int32 *face_neighbors,
+                                   stats::Stats &mstat,
+                                   Location &loc)
+  {
+    using Exit = ExitFace<ElemT::get_etype ()>;
+    // neighboring samples are rarely more than a few elements apart,
+    // past that the bvh is cheaper than walking
+    constexpr int32 max_steps = 3;
+
+    int32 cell = hint.m_cell_id;
+    Vec<Float, 3> ref_coords = hint.m_ref_pt;
+    for (int32 step = 0; step < max_steps && cell != -1; ++step)
+    {
+      if (mesh.get_elem (cell).eval_inverse_local (point, ref_coords))
+      {
+        if (step == 0)
+        {
+          mstat.acc_cache_hits (1);
+        }
+        else
+        {
+          mstat.acc_walk_hits (1);
+        }
+        loc.m_cell_id = cell;
+        loc.m_ref_pt = ref_coords;
+        return true;
+      }
+
+      const int32 face = Exit::get (ref_coords);
+      if (face == -1)
+      {
+        // newton did not converge inside, no direction to go
+        return false;
+      }
+      cell = face_neighbors[cell * Exit::num_faces + face];
+      ref_coords = { Exit::center (), Exit::center (), Exit::center () };
+    }
+    return false;
+  }
+};
+
 } // namespace detail
 
+template <class ElemT>
+DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point,
+                                                   const Location &hint,
+                                                   const int32 *face_neighbors,
+                                                   stats::Stats &mstat) const
+{
+  mstat.acc_locates (1);
+  if (hint.m_cell_id != -1 && face_neighbors != nullptr)
+  {
+    Location loc{ -1, { -1.f, -1.f, -1.f } };
+    if (detail::LocateWalk<dim>::template walk<ElemT> (*this, point, hint,
+                                                      face_neighbors, mstat, loc))
+    {
+      return loc;
+    }
+  }
+  return locate (point);
+}
+
 template <class ElemT>
 DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) const
 {
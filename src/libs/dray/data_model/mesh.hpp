@@ -33,6 +33,9 @@ public:
   virtual AABB<3> bounds() = 0;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) = 0;
   virtual void to_node(conduit::Node &n_topo) = 0;
+  // previous is a mesh from an earlier cycle with the same connectivity,
+  // its acceleration structure can be refit instead of rebuilt
+  virtual void refit_bvh_from(Mesh *previous) = 0;
 };
 
 } // namespace dray
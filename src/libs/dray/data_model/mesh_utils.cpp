@@ -367,6 +367,53 @@ Array<Vec<int32, 4>> extract_faces(UnstructuredMesh<Element<3, ncomp, ElemType::
   return faces;
 }
 
+// pairs up the faces shared by two elements
+Array<int32> match_faces (Array<Vec<int32, 4>> &faces, const int32 faces_per_elem)
+{
+  const int32 size = faces.size ();
+  Array<int32> neighbors;
+  neighbors.resize (size);
+  array_memset (neighbors, -1);
+  if (size < 2)
+  {
+    return neighbors;
+  }
+
+  Array<int32> orig_ids = sort_faces (faces);
+
+  const Vec<int32, 4> *faces_ptr = faces.get_device_ptr_const ();
+  const int32 *orig_ids_ptr = orig_ids.get_device_ptr_const ();
+  int32 *neighbors_ptr = neighbors.get_device_ptr ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size - 1), [=] DRAY_LAMBDA (int32 i) {
+    // sorted, so a shared face is next to its twin
+    if (is_same (faces_ptr[i], faces_ptr[i + 1]))
+    {
+      const int32 a = orig_ids_ptr[i];
+      const int32 b = orig_ids_ptr[i + 1];
+      neighbors_ptr[a] = b / faces_per_elem;
+      neighbors_ptr[b] = a / faces_per_elem;
+    }
+  });
+  DRAY_ERROR_CHECK();
+
+  return neighbors;
+}
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Tensor, P>> &mesh)
+{
+  Array<Vec<int32, 4>> faces = extract_faces (mesh);
+  return match_faces (faces, 6);
+}
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Simplex, P>> &mesh)
+{
+  Array<Vec<int32, 4>> faces = extract_faces (mesh);
+  return match_faces (faces, 4);
+}
+
 // Returns faces, where faces[i][0] = el_id and 0 <= faces[i][1] = face_id < 6.
 template <ElemType etype>
 Array<Vec<int32, 2>> reconstruct (Array<int32> &orig_ids)
@@ -513,7 +560,9 @@ namespace detail
 
 
 template <class ElemT>
-BVH construct_bvh (UnstructuredMesh<ElemT> &mesh, Array<typename get_subref<ElemT>::type> &ref_aabbs)
+BVH construct_bvh (UnstructuredMesh<ElemT> &mesh,
+                   Array<typename get_subref<ElemT>::type> &ref_aabbs,
+                   const BVH *refit_bvh)
 {
   DRAY_LOG_OPEN ("construct_bvh");
 
@@ -675,7 +724,8 @@ BVH construct_bvh (UnstructuredMesh<ElemT> &mesh, Array<typename get_subref<Elem
   DRAY_ERROR_CHECK();
 
   LinearBVHBuilder builder;
-  BVH bvh = builder.construct (aabbs, prim_ids);
+  BVH bvh = refit_bvh == nullptr ? builder.construct (aabbs, prim_ids)
+                                 : builder.refit (*refit_bvh, aabbs, prim_ids);
   DRAY_LOG_CLOSE ();
   return bvh;
 }
@@ -721,39 +771,68 @@ template Array<Vec<int32, 4>>
 extract_faces(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Quadratic>> &mesh);
 
 
+//
+// face_neighbors();
+//
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::Quadratic>> &mesh);
+
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Quadratic>> &mesh);
+
 //
 // construct_bvh();   // Tensor
 //
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::General>> &mesh,
-                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::Linear>> &mesh,
-                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Tensor, Order::Quadratic>> &mesh,
-                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::General>> &mesh,
-                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::Linear>> &mesh,
-                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Tensor, Order::Quadratic>> &mesh,
-                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Tensor>> &ref_aabbs,
+                            const BVH *refit_bvh);
 
 //
 // construct_bvh();   // Simplex
 //
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::General>> &mesh,
-                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::Linear>> &mesh,
-                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<2, ElemType::Simplex, Order::Quadratic>> &mesh,
-                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<2, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::General>> &mesh,
-                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::Linear>> &mesh,
-                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 template BVH construct_bvh (UnstructuredMesh<MeshElem<3, ElemType::Simplex, Order::Quadratic>> &mesh,
-                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs);
+                            Array<SubRef<3, ElemType::Simplex>> &ref_aabbs,
+                            const BVH *refit_bvh);
 
 struct GetDofDataFunctor
 {
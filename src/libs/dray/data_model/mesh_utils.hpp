@@ -53,8 +53,28 @@ Array<Vec<int32, 2>> reconstruct (Array<int32> &orig_ids);
 /// template<typename T, class ElemT>
 /// typename Mesh<T, ElemT>::ExternalFaces  external_faces(Mesh<T, ElemT> &mesh);
 
+// Element across each face of each element: neighbors[el * faces + face]
+// is the element sharing that face, or -1 on the boundary. Faces are
+// numbered like extract_faces.
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Tensor, P>> &mesh);
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Simplex, P>> &mesh);
+
+// 2D elements have no face neighbors
+template <int32 ncomp, ElemType etype, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<2, ncomp, etype, P>> &mesh)
+{
+  return Array<int32> ();
+}
+
+// refit_bvh: optional tree built for the same connectivity that is
+// refit to the current coordinates instead of building a new one
 template <class ElemT>
-BVH construct_bvh (UnstructuredMesh<ElemT> &mesh, Array<typename get_subref<ElemT>::type> &ref_aabbs);
+BVH construct_bvh (UnstructuredMesh<ElemT> &mesh,
+                   Array<typename get_subref<ElemT>::type> &ref_aabbs,
+                   const BVH *refit_bvh = nullptr);
 
 // Extracts the dof data from the given mesh.
 GridFunction<3>
@@ -0,0 +1,172 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <dray/data_model/span_index.hpp>
+#include <dray/error.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace dray
+{
+
+namespace detail
+{
+
+// The query binary searches every bucket and scans the one that
+// holds the value, so sqrt(n) sized buckets balance the two.
+static int32 span_bucket_size(const int32 num_elems)
+{
+  const int32 min_size = 64;
+  const int32 size = static_cast<int32>(std::sqrt(static_cast<double>(num_elems)));
+  return std::max(size, min_size);
+}
+
+} // namespace detail
+
+SpanIndex::SpanIndex()
+  : m_num_elems(0)
+{
+}
+
+void
+SpanIndex::build(const Array<Float> &elem_mins, const Array<Float> &elem_maxs)
+{
+  if(elem_mins.size() != elem_maxs.size())
+  {
+    DRAY_ERROR("SpanIndex: element mins and maxs have different sizes "
+               <<elem_mins.size()<<" != "<<elem_maxs.size());
+  }
+
+  const int32 size = static_cast<int32>(elem_mins.size());
+  const Float *mins_ptr = elem_mins.get_host_ptr_const();
+  const Float *maxs_ptr = elem_maxs.get_host_ptr_const();
+
+  std::vector<int32> order(size);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [=](int32 a, int32 b)
+  {
+    return mins_ptr[a] < mins_ptr[b] || (mins_ptr[a] == mins_ptr[b] && a < b);
+  });
+
+  const int32 bucket_size = detail::span_bucket_size(size);
+  const int32 buckets = (size + bucket_size - 1) / bucket_size;
+  m_bucket_offsets.resize(buckets + 1);
+  m_bucket_lower.resize(buckets);
+  m_bucket_upper.resize(buckets);
+  int32 *offsets_ptr = m_bucket_offsets.get_host_ptr();
+  Float *lower_ptr = m_bucket_lower.get_host_ptr();
+  Float *upper_ptr = m_bucket_upper.get_host_ptr();
+  for(int32 b = 0; b < buckets; ++b)
+  {
+    const int32 begin = b * bucket_size;
+    const int32 end = std::min(begin + bucket_size, size);
+    offsets_ptr[b] = begin;
+    lower_ptr[b] = mins_ptr[order[begin]];
+    upper_ptr[b] = mins_ptr[order[end - 1]];
+    std::sort(order.begin() + begin, order.begin() + end, [=](int32 x, int32 y)
+    {
+      return maxs_ptr[x] > maxs_ptr[y] || (maxs_ptr[x] == maxs_ptr[y] && x < y);
+    });
+  }
+  offsets_ptr[buckets] = size;
+
+  m_elem_ids.resize(size);
+  m_elem_mins.resize(size);
+  m_elem_maxs.resize(size);
+  int32 *ids_ptr = m_elem_ids.get_host_ptr();
+  Float *sorted_mins_ptr = m_elem_mins.get_host_ptr();
+  Float *sorted_maxs_ptr = m_elem_maxs.get_host_ptr();
+  for(int32 i = 0; i < size; ++i)
+  {
+    ids_ptr[i] = order[i];
+    sorted_mins_ptr[i] = mins_ptr[order[i]];
+    sorted_maxs_ptr[i] = maxs_ptr[order[i]];
+  }
+  m_num_elems = size;
+}
+
+bool
+SpanIndex::is_built() const
+{
+  return m_bucket_offsets.size() != 0;
+}
+
+int32
+SpanIndex::num_elems() const
+{
+  return m_num_elems;
+}
+
+int32
+SpanIndex::num_buckets() const
+{
+  return is_built() ? static_cast<int32>(m_bucket_offsets.size()) - 1 : 0;
+}
+
+Array<int32>
+SpanIndex::candidates(const Float value) const
+{
+  if(!is_built())
+  {
+    DRAY_ERROR("SpanIndex: candidates() called before build()");
+  }
+
+  const int32 buckets = num_buckets();
+  const int32 *offsets_ptr = m_bucket_offsets.get_host_ptr_const();
+  const Float *lower_ptr = m_bucket_lower.get_host_ptr_const();
+  const Float *upper_ptr = m_bucket_upper.get_host_ptr_const();
+  const int32 *ids_ptr = m_elem_ids.get_host_ptr_const();
+  const Float *mins_ptr = m_elem_mins.get_host_ptr_const();
+  const Float *maxs_ptr = m_elem_maxs.get_host_ptr_const();
+
+  std::vector<int32> res;
+  for(int32 b = 0; b < buckets; ++b)
+  {
+    const int32 begin = offsets_ptr[b];
+    const int32 end = offsets_ptr[b + 1];
+    // buckets are ordered by their mins, so nothing past
+    // this bucket can start below the value
+    if(lower_ptr[b] > value)
+    {
+      break;
+    }
+
+    if(upper_ptr[b] <= value)
+    {
+      // every min is below the value and the maxs are decreasing,
+      // so the candidates are a prefix of the bucket
+      const Float *first = maxs_ptr + begin;
+      const Float *last = std::partition_point(first, maxs_ptr + end,
+                                               [=](Float max) { return max > value; });
+      res.insert(res.end(), ids_ptr + begin, ids_ptr + begin + (last - first));
+    }
+    else
+    {
+      for(int32 i = begin; i < end && maxs_ptr[i] > value; ++i)
+      {
+        if(mins_ptr[i] <= value)
+        {
+          res.push_back(ids_ptr[i]);
+        }
+      }
+    }
+  }
+
+  // keep the element order so results match a full traversal
+  std::sort(res.begin(), res.end());
+
+  Array<int32> cands;
+  cands.resize(res.size());
+  if(res.size() > 0)
+  {
+    std::copy(res.begin(), res.end(), cands.get_host_ptr());
+  }
+  return cands;
+}
+
+} // namespace dray
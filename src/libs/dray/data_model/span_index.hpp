@@ -0,0 +1,55 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#ifndef DRAY_SPAN_INDEX_HPP
+#define DRAY_SPAN_INDEX_HPP
+
+#include <dray/array.hpp>
+#include <dray/types.hpp>
+
+namespace dray
+{
+
+/*
+ * @class SpanIndex
+ * @brief Span space index over the value range of each element of a field.
+ *
+ * Elements are sorted by their minimum value and split into buckets of
+ * equal size. Inside a bucket, elements are sorted by decreasing maximum.
+ * The elements whose range straddles a value are then found by taking a
+ * prefix of every bucket that lies completely below the value and scanning
+ * the single bucket that contains it, so an isovalue query only touches the
+ * candidate elements and one bucket worth of others.
+ */
+class SpanIndex
+{
+protected:
+  int32 m_num_elems;
+  // bucket b holds the sorted entries [m_bucket_offsets[b], m_bucket_offsets[b+1])
+  Array<int32> m_bucket_offsets;
+  // smallest and largest element min of each bucket
+  Array<Float> m_bucket_lower;
+  Array<Float> m_bucket_upper;
+  Array<int32> m_elem_ids;
+  Array<Float> m_elem_mins;
+  Array<Float> m_elem_maxs;
+public:
+  SpanIndex();
+
+  // builds the index from the value range of each element
+  void build(const Array<Float> &elem_mins, const Array<Float> &elem_maxs);
+
+  bool is_built() const;
+  int32 num_elems() const;
+  int32 num_buckets() const;
+
+  // ids, in ascending order, of the elements with min <= value < max.
+  // These are exactly the elements marching cubes can cut for value.
+  Array<int32> candidates(const Float value) const;
+};
+
+} // namespace dray
+
+#endif // DRAY_SPAN_INDEX_HPP
@@ -117,6 +117,42 @@ template <class ElemT> std::vector<Range> get_range (const UnstructuredField<Ele
   return ranges;
 }
 
+// The range of the dofs bounds the element: linear elements interpolate
+// them and Bernstein elements stay inside their convex hull.
+template <class ElemT> SpanIndex build_span_index (const UnstructuredField<ElemT> &field)
+{
+  const GridFunction<ElemT::get_ncomp ()> &gf = field.get_dof_data ();
+  const int32 num_elems = gf.get_num_elem ();
+  const int32 el_dofs = gf.m_el_dofs;
+
+  Array<Float> elem_mins;
+  Array<Float> elem_maxs;
+  elem_mins.resize (num_elems);
+  elem_maxs.resize (num_elems);
+  Float *mins_ptr = elem_mins.get_device_ptr ();
+  Float *maxs_ptr = elem_maxs.get_device_ptr ();
+  const int32 *ctrl_idx_ptr = gf.m_ctrl_idx.get_device_ptr_const ();
+  const Vec<Float, ElemT::get_ncomp ()> *values_ptr = gf.m_values.get_device_ptr_const ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, num_elems), [=] DRAY_LAMBDA (int32 el) {
+    Float min_val = infinity<Float>();
+    Float max_val = neg_infinity<Float>();
+    for (int32 i = 0; i < el_dofs; ++i)
+    {
+      const Float val = values_ptr[ctrl_idx_ptr[el * el_dofs + i]][0];
+      min_val = min_val < val ? min_val : val;
+      max_val = max_val > val ? max_val : val;
+    }
+    mins_ptr[el] = min_val;
+    maxs_ptr[el] = max_val;
+  });
+  DRAY_ERROR_CHECK();
+
+  SpanIndex index;
+  index.build (elem_mins, elem_maxs);
+  return index;
+}
+
 } // namespace detail
 
 template <class ElemT>
@@ -160,7 +196,8 @@ UnstructuredField<ElemT>::UnstructuredField(const UnstructuredField &other)
   : m_dof_data(other.m_dof_data),
     m_poly_order(other.m_poly_order),
     m_range_calculated(other.m_range_calculated),
-    m_ranges(other.m_ranges)
+    m_ranges(other.m_ranges),
+    m_span_index(other.m_span_index)
 {
   this->name(other.name());
 }
@@ -170,7 +207,8 @@ UnstructuredField<ElemT>::UnstructuredField(UnstructuredField &&other)
   : m_dof_data(other.m_dof_data),
     m_poly_order(other.m_poly_order),
     m_range_calculated(other.m_range_calculated),
-    m_ranges(other.m_ranges)
+    m_ranges(other.m_ranges),
+    m_span_index(other.m_span_index)
 {
   this->name(other.name());
 }
@@ -198,6 +236,15 @@ template <class ElemT> std::vector<Range> UnstructuredField<ElemT>::range () con
   return m_ranges;
 }
 
+template <class ElemT> const SpanIndex & UnstructuredField<ElemT>::span_index () const
+{
+  if(!m_span_index.is_built())
+  {
+    m_span_index = detail::build_span_index (*this);
+  }
+  return m_span_index;
+}
+
 template <class ElemT>
 int32 UnstructuredField<ElemT>::order() const
 {
@@ -12,6 +12,7 @@
 #include <dray/data_model/element.hpp>
 #include <dray/data_model/grid_function.hpp>
 #include <dray/data_model/field.hpp>
+#include <dray/data_model/span_index.hpp>
 #include <dray/vec.hpp>
 #include <dray/error.hpp>
 
@@ -36,6 +37,7 @@ template <class ElemT> class UnstructuredField : public Field
   int32 m_poly_order;
   mutable bool m_range_calculated;
   mutable std::vector<Range> m_ranges;
+  mutable SpanIndex m_span_index;
 
   public:
   UnstructuredField () = delete; // For now, probably need later.
@@ -81,6 +83,10 @@ template <class ElemT> class UnstructuredField : public Field
 
   virtual std::vector<Range> range () const override;
 
+  // span space index over the element ranges of the first component,
+  // built on first use and kept for the life of the field
+  const SpanIndex & span_index () const;
+
   virtual std::string type_name() const override;
 
   static UnstructuredField uniform_field(int32 num_els,
@@ -24,17 +24,31 @@ template <class Element> const BVH UnstructuredMesh<Element>::get_bvh ()
 {
   if(!m_is_constructed)
   {
-    m_bvh = detail::construct_bvh (*this, m_ref_aabbs);
+    m_bvh = detail::construct_bvh (*this,
+                                   m_ref_aabbs,
+                                   m_has_refit_bvh ? &m_refit_bvh : nullptr);
     m_is_constructed = true;
+    m_has_refit_bvh = false;
+    m_refit_bvh = BVH();
   }
   return m_bvh;
 }
 
+template <class Element> Array<int32> UnstructuredMesh<Element>::get_face_neighbors ()
+{
+  if(m_face_neighbors.size() == 0 && cells() > 0)
+  {
+    m_face_neighbors = detail::face_neighbors (*this);
+  }
+  return m_face_neighbors;
+}
+
 template <class Element>
 UnstructuredMesh<Element>::UnstructuredMesh (const GridFunction<3u> &dof_data, int32 poly_order)
 : m_dof_data (dof_data),
   m_poly_order (poly_order),
-  m_is_constructed(false)
+  m_is_constructed(false),
+  m_has_refit_bvh(false)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -68,7 +82,10 @@ UnstructuredMesh<Element>::UnstructuredMesh(const UnstructuredMesh &other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_refit_bvh(other.m_has_refit_bvh),
+    m_refit_bvh(other.m_refit_bvh),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -97,7 +114,10 @@ UnstructuredMesh<Element>::UnstructuredMesh(UnstructuredMesh &&other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_refit_bvh(other.m_has_refit_bvh),
+    m_refit_bvh(other.m_refit_bvh),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -147,6 +167,43 @@ Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoint
   return locations;
 }
 
+template <class Element>
+Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoints,
+                                                  Array<Location> &hints)
+{
+  DRAY_LOG_OPEN ("locate_hinted");
+
+  const int32 size = wpoints.size ();
+  if (hints.size () != size)
+  {
+    DRAY_ERROR ("locate: "<<size<<" points but "<<hints.size ()<<" hints");
+  }
+
+  Array<Location> locations;
+  locations.resize (size);
+
+  Array<int32> face_neighbors = get_face_neighbors ();
+  const int32 *neighbors_ptr = face_neighbors.size () > 0 ?
+                               face_neighbors.get_device_ptr_const () : nullptr;
+
+  Location *loc_ptr = locations.get_device_ptr ();
+  const Vec<Float,3> *points_ptr = wpoints.get_device_ptr_const();
+  const Location *hints_ptr = hints.get_device_ptr_const ();
+
+  DeviceMesh<Element> device_mesh (*this);
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
+    stats::Stats mstat;
+    mstat.construct ();
+    loc_ptr[i] = device_mesh.locate (points_ptr[i], hints_ptr[i], neighbors_ptr, mstat);
+  });
+
+  DRAY_ERROR_CHECK();
+  DRAY_LOG_CLOSE();
+
+  return locations;
+}
+
 template<typename Element>
 int32 UnstructuredMesh<Element>::cells() const
 {
@@ -189,6 +246,21 @@ void UnstructuredMesh<Element>::to_node(conduit::Node &n_topo)
 
 }
 
+template<typename Element>
+void UnstructuredMesh<Element>::refit_bvh_from(Mesh *previous)
+{
+  UnstructuredMesh<Element> *prev = dynamic_cast<UnstructuredMesh<Element>*>(previous);
+  // only a tree that was built for the same number of cells helps,
+  // and only if we have not built our own yet
+  if(prev == nullptr || prev == this || m_is_constructed ||
+     !prev->m_is_constructed || prev->cells() != cells())
+  {
+    return;
+  }
+  m_refit_bvh = prev->m_bvh;
+  m_has_refit_bvh = true;
+}
+
 // Currently supported topologies
 template class UnstructuredMesh<Hex3>;
 template class UnstructuredMesh<Hex_P1>;
@@ -52,6 +52,11 @@ protected:
   // we are lazy constructing these
   BVH m_bvh;
   Array<SubRef<dim, etype>> m_ref_aabbs;
+  // tree of an earlier mesh to refit when the bvh is constructed
+  bool m_has_refit_bvh;
+  BVH m_refit_bvh;
+  // element across each face, built on first use
+  Array<int32> m_face_neighbors;
 
   //// Accept input data (as shared).
   //// Useful for keeping same data but changing class template arguments.
@@ -85,6 +90,7 @@ public:
   virtual AABB<3> bounds() override;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) override;
   virtual void to_node(conduit::Node &n_topo) override;
+  virtual void refit_bvh_from(Mesh *previous) override;
 
 
   friend struct DeviceMesh<Element>;
@@ -97,6 +103,11 @@ public:
   UnstructuredMesh(const UnstructuredMesh &other);
 
   const BVH get_bvh ();
+  // see detail::face_neighbors
+  Array<int32> get_face_neighbors ();
+  // locates each point by walking from the element of its hint,
+  // see DeviceMesh::locate. Hints with cell id -1 use the bvh.
+  Array<Location> locate (Array<Vec<Float, 3>> &wpoints, Array<Location> &hints);
 
   GridFunction<3u> get_dof_data ()
   {
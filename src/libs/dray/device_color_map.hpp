@@ -58,7 +58,9 @@ class DeviceColorMap
 
   }
 
-  DRAY_EXEC Vec<float32, 4> color (const Float &scalar) const
+  // index of the color table sample used for a scalar. This is
+  // monotonic in the scalar, so a scalar range maps to an index range.
+  DRAY_EXEC int32 sample_index (const Float &scalar) const
   {
     Float s = scalar;
 
@@ -72,8 +74,13 @@ class DeviceColorMap
     const float32 normalized = static_cast<float32> ((s - m_min) * m_inv_range);
     int32 sample_idx = static_cast<int32> (normalized * float32 (m_size - 1));
     sample_idx = clamp (sample_idx, 0, m_size - 1);
+    return sample_idx;
+  }
+
+  DRAY_EXEC Vec<float32, 4> color (const Float &scalar) const
+  {
     //std::cout<<"s "<<sample_idx<<" "<<scalar<<" mn "<<m_min<<" mx "<<m_max<<"n";
-    return m_colors[sample_idx];
+    return m_colors[sample_index (scalar)];
   }
 }; // class device color map
 
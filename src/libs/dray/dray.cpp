@@ -103,6 +103,7 @@ int dray::m_face_subdivisions = 1;
 int dray::m_zone_subdivisions = 1;
 bool dray::m_prefer_native_order_mesh = true;
 bool dray::m_prefer_native_order_field = true;
+float dray::m_bvh_refit_threshold = 1.5f;
 
 void dray::set_face_subdivisions (int num_subdivisions)
 {
@@ -144,6 +145,16 @@ bool dray::prefer_native_order_field()
   return m_prefer_native_order_field;
 }
 
+void dray::set_bvh_refit_threshold(const float threshold)
+{
+  m_bvh_refit_threshold = threshold;
+}
+
+float dray::get_bvh_refit_threshold()
+{
+  return m_bvh_refit_threshold;
+}
+
 void dray::init ()
 {
 }
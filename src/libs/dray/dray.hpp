@@ -40,6 +40,12 @@ class dray
     static void prefer_native_order_field(bool on);
     static bool prefer_native_order_field();
 
+    // refit bvhs of meshes that only moved while the tree cost stays
+    // within threshold times the cost of the built tree. values
+    // below 1 turn refitting off
+    static void set_bvh_refit_threshold(const float threshold);
+    static float get_bvh_refit_threshold();
+
     static void set_host_allocator_id(int id);
     static void set_device_allocator_id(int id);
 
@@ -48,6 +54,7 @@ class dray
     static int m_zone_subdivisions;
     static bool m_prefer_native_order_mesh;
     static bool m_prefer_native_order_field;
+    static float m_bvh_refit_threshold;
 };
 
 } // namespace dray
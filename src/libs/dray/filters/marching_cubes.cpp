@@ -349,6 +349,7 @@ struct MarchingCubesFunctor
   Float m_isovalue;
   uint32 m_total_triangles;
   bool do_orig_cells;
+  bool use_span_index;
 
   MarchingCubesFunctor(DataSet &in,
                       const std::string &field,
@@ -362,7 +363,8 @@ struct MarchingCubesFunctor
   template<typename FEType>
   static void calculate_triangle_cases(ShapeTet,
                                        const DeviceField<FEType> &dfield,
-                                       const RAJA::RangeSegment &elem_range,
+                                       const RAJA::RangeSegment &cell_range,
+                                       const int32 *cells_ptr,
                                        const int8 *lookup_ptr,
                                        const Float isovalue,
                                        uint32 *cut_info_ptr,
@@ -371,7 +373,8 @@ struct MarchingCubesFunctor
   template<typename FEType>
   static void calculate_triangle_cases(ShapeHex,
                                        const DeviceField<FEType> &dfield,
-                                       const RAJA::RangeSegment &elem_range,
+                                       const RAJA::RangeSegment &cell_range,
+                                       const int32 *cells_ptr,
                                        const int8 *lookup_ptr,
                                        const Float isovalue,
                                        uint32 *cut_info_ptr,
@@ -386,7 +389,8 @@ struct MarchingCubesFunctor
 
   template<typename FEType>
   static Array<int32> create_original_cells(const uint32 total_triangles,
-                                            const int nelem,
+                                            const int ncells,
+                                            const int32 *cells_ptr,
                                             const uint32 *triangle_offsets_ptr,
                                             const uint32 *cut_info_ptr,
                                             const int8 *lookup_ptr);
@@ -399,7 +403,7 @@ MarchingCubesFunctor::MarchingCubesFunctor(DataSet &in,
                                            Float isoval)
   : m_input(in), m_output(), m_field(field), m_unique_edges_array(),
     m_conn_array(), m_original_cells(), m_weights_array(), m_isovalue(isoval), m_total_triangles(0),
-    do_orig_cells(true)
+    do_orig_cells(true), use_span_index(false)
 {
 
 }
@@ -410,27 +414,36 @@ MarchingCubesFunctor::operator()(UnstructuredField<FEType> &field)
 {
   static_assert(FEType::get_P() == Order::Linear, "Assert: FEType::get_P() == Order::Linear");
 
-  // Grab some useful information about the field
-
-  const int nelem = field.get_num_elem();
+  // Only the cells whose range straddles the isovalue can produce
+  // triangles. The span index hands us exactly those, in element order,
+  // otherwise we classify every cell. A null cells_ptr means all cells.
+  Array<int32> cells;
+  const int32 *cells_ptr = nullptr;
+  int ncells = field.get_num_elem();
+  if(use_span_index)
+  {
+    cells = field.span_index().candidates(m_isovalue);
+    cells_ptr = cells.get_device_ptr_const();
+    ncells = cells.size();
+  }
 
   // Get the proper lookup table for the current shape
   const Array<int8> lookup_array = detail::get_lookup_table(adapt_get_shape<FEType>());
   const int8 *lookup_ptr = lookup_array.get_device_ptr_const();
 
   Array<uint32> cut_info;
-  cut_info.resize(nelem);
+  cut_info.resize(ncells);
   uint32 *cut_info_ptr = cut_info.get_device_ptr();
 
   Array<uint32> num_triangles_array;
-  num_triangles_array.resize(nelem);
+  num_triangles_array.resize(ncells);
   uint32 *num_triangles_ptr = num_triangles_array.get_device_ptr();
 
   // Determine triangle cases and number of triangles
   DeviceField<FEType> dfield(field);
-  const auto elem_range = RAJA::RangeSegment(0, nelem);
+  const auto cell_range = RAJA::RangeSegment(0, ncells);
   MarchingCubesFunctor::calculate_triangle_cases(adapt_get_shape<FEType>(),
-    dfield, elem_range, lookup_ptr, m_isovalue, cut_info_ptr, num_triangles_ptr);
+    dfield, cell_range, cells_ptr, lookup_ptr, m_isovalue, cut_info_ptr, num_triangles_ptr);
 
   Array<uint32> triangle_offsets_array = array_exc_scan_plus(num_triangles_array, m_total_triangles);
   const uint32 *triangle_offsets_ptr = triangle_offsets_array.get_device_ptr_const();
@@ -438,8 +451,8 @@ MarchingCubesFunctor::operator()(UnstructuredField<FEType> &field)
   // Store original cells
   if(do_orig_cells)
   {
-    m_original_cells = create_original_cells<FEType>(m_total_triangles, nelem,
-      triangle_offsets_ptr, cut_info_ptr, lookup_ptr);
+    m_original_cells = create_original_cells<FEType>(m_total_triangles, ncells,
+      cells_ptr, triangle_offsets_ptr, cut_info_ptr, lookup_ptr);
   }
 
   // Compute edge ids and new connectivity
@@ -449,14 +462,15 @@ MarchingCubesFunctor::operator()(UnstructuredField<FEType> &field)
   uint64 *edge_ids_ptr = edge_ids_array.get_device_ptr();
 
   DEBUG_PRINT("triangle_edge_defs:");
-  RAJA::forall<for_policy>(elem_range,
-    [=] DRAY_LAMBDA (int eid) {
-      DEBUG_PRINT("\n  [" << eid << "]: " << num_triangles_ptr[eid] << " " << cut_info_ptr[eid]);
+  RAJA::forall<for_policy>(cell_range,
+    [=] DRAY_LAMBDA (int idx) {
+      const int32 eid = cells_ptr == nullptr ? idx : cells_ptr[idx];
+      DEBUG_PRINT("\n  [" << eid << "]: " << num_triangles_ptr[idx] << " " << cut_info_ptr[idx]);
       constexpr auto shape3d = adapt_get_shape<FEType>();
       const ReadDofPtr<Vec<Float, 1>> rdp = dfield.get_elem(eid).read_dof_ptr();
-      const int8 *edges = detail::get_triangle_edges(shape3d, lookup_ptr, cut_info_ptr[eid]);
+      const int8 *edges = detail::get_triangle_edges(shape3d, lookup_ptr, cut_info_ptr[idx]);
       const int32 *ctrl_idx_ptr = rdp.m_offset_ptr;
-      uint64 *edge_ids_offset = edge_ids_ptr + triangle_offsets_ptr[eid] * 3;
+      uint64 *edge_ids_offset = edge_ids_ptr + triangle_offsets_ptr[idx] * 3;
       while(*edges != detail::NO_EDGE)
       {
         const auto edge = detail::get_edge(shape3d, lookup_ptr, *edges++);
@@ -540,14 +554,16 @@ template<typename FEType>
 void
 MarchingCubesFunctor::calculate_triangle_cases(ShapeTet,
                                                const DeviceField<FEType> &dfield,
-                                               const RAJA::RangeSegment &elem_range,
+                                               const RAJA::RangeSegment &cell_range,
+                                               const int32 *cells_ptr,
                                                const int8 *lookup_ptr,
                                                const Float isovalue,
                                                uint32 *cut_info_ptr,
                                                uint32 *num_triangles_ptr)
 {
-  RAJA::forall<for_policy>(elem_range,
-    [=] DRAY_LAMBDA (int eid) {
+  RAJA::forall<for_policy>(cell_range,
+    [=] DRAY_LAMBDA (int idx) {
+      const int32 eid = cells_ptr == nullptr ? idx : cells_ptr[idx];
       constexpr OrderPolicy<Order::Linear> field_order_p;
       constexpr auto shape3d = adapt_get_shape<FEType>();
       constexpr auto ndofs = eattr::get_num_dofs(shape3d, field_order_p);
@@ -557,8 +573,8 @@ MarchingCubesFunctor::calculate_triangle_cases(ShapeTet,
       {
         info |= (rdp[i][0] > isovalue) << i;
       }
-      cut_info_ptr[eid] = info;
-      num_triangles_ptr[eid] = detail::get_num_triangles(shape3d, lookup_ptr, info);
+      cut_info_ptr[idx] = info;
+      num_triangles_ptr[idx] = detail::get_num_triangles(shape3d, lookup_ptr, info);
     });
   DRAY_ERROR_CHECK();
 }
@@ -567,7 +583,8 @@ template<typename FEType>
 void
 MarchingCubesFunctor::calculate_triangle_cases(ShapeHex,
                                                const DeviceField<FEType> &dfield,
-                                               const RAJA::RangeSegment &elem_range,
+                                               const RAJA::RangeSegment &cell_range,
+                                               const int32 *cells_ptr,
                                                const int8 *lookup_ptr,
                                                const Float isovalue,
                                                uint32 *cut_info_ptr,
@@ -575,8 +592,9 @@ MarchingCubesFunctor::calculate_triangle_cases(ShapeHex,
 {
   // NOTE: This is the same algorithm as for Tets but the Hex table is based off
   //       VTK / VisIt ordered hexes so we need to use a reorder array.
-  RAJA::forall<for_policy>(elem_range,
-    [=] DRAY_LAMBDA (int eid) {
+  RAJA::forall<for_policy>(cell_range,
+    [=] DRAY_LAMBDA (int idx) {
+      const int32 eid = cells_ptr == nullptr ? idx : cells_ptr[idx];
       constexpr OrderPolicy<Order::Linear> field_order_p;
       constexpr auto shape3d = adapt_get_shape<FEType>();
       constexpr auto ndofs = eattr::get_num_dofs(shape3d, field_order_p);
@@ -587,8 +605,8 @@ MarchingCubesFunctor::calculate_triangle_cases(ShapeHex,
       {
         info |= (rdp[reorder[i]][0] > isovalue) << i;
       }
-      cut_info_ptr[eid] = info;
-      num_triangles_ptr[eid] = detail::get_num_triangles(shape3d, lookup_ptr, info);
+      cut_info_ptr[idx] = info;
+      num_triangles_ptr[idx] = detail::get_num_triangles(shape3d, lookup_ptr, info);
     });
   DRAY_ERROR_CHECK();
 }
@@ -622,7 +640,8 @@ MarchingCubesFunctor::compute_interpolant_weights(const DeviceField<FEType> &dfi
 template<typename FEType>
 Array<int32>
 MarchingCubesFunctor::create_original_cells(const uint32 total_triangles,
-                                            const int nelem,
+                                            const int ncells,
+                                            const int32 *cells_ptr,
                                             const uint32 *triangle_offsets_ptr,
                                             const uint32 *cut_info_ptr,
                                             const int8 *lookup_ptr)
@@ -630,15 +649,16 @@ MarchingCubesFunctor::create_original_cells(const uint32 total_triangles,
   Array<int32> orig_cells_array;
   orig_cells_array.resize(total_triangles);
   int32 *orig_cells_ptr = orig_cells_array.get_device_ptr();
-  const RAJA::RangeSegment elem_range(0, nelem);
-  RAJA::forall<for_policy>(elem_range,
+  const RAJA::RangeSegment cell_range(0, ncells);
+  RAJA::forall<for_policy>(cell_range,
     [=] DRAY_LAMBDA (int idx) {
+      const int32 eid = cells_ptr == nullptr ? idx : cells_ptr[idx];
       constexpr auto shape3d = adapt_get_shape<FEType>();
       const auto ntris = detail::get_num_triangles(shape3d, lookup_ptr, cut_info_ptr[idx]);
       int32 *orig_cells_offset = orig_cells_ptr + triangle_offsets_ptr[idx];
       for(int i = 0; i < ntris; i++)
       {
-        orig_cells_offset[i] = idx;
+        orig_cells_offset[i] = eid;
       }
     });
   DRAY_ERROR_CHECK();
@@ -668,7 +688,7 @@ namespace dray
 {
 
 MarchingCubes::MarchingCubes()
-  : m_field(), m_isovalues()
+  : m_field(), m_isovalues(), m_use_span_index(false)
 {
 }
 
@@ -697,6 +717,12 @@ MarchingCubes::set_isovalues(const Float *values,
   memcpy(m_isovalues.data(), values, nvalues * sizeof(Float));
 }
 
+void
+MarchingCubes::set_use_span_index(bool use_index)
+{
+  m_use_span_index = use_index;
+}
+
 Collection
 MarchingCubes::execute(Collection &c)
 {
@@ -715,8 +741,7 @@ MarchingCubes::execute(Collection &c)
   auto domains = c.domains();
   for(auto &domain : domains)
   {
-    MarchingCubesFunctor func(domain, m_field, m_isovalues[0]);
-    func.do_orig_cells = MarchingCubesFunctor::has_cell_data(domain);
+    const bool do_orig_cells = MarchingCubesFunctor::has_cell_data(domain);
     auto field_ptr = domain.field_shared(m_field);
     // If the field if cell-centered, we will have to recenter it
     if(field_ptr->order() == Order::Constant)
@@ -728,8 +753,16 @@ MarchingCubes::execute(Collection &c)
       temp = pointavg.execute(temp);
       field_ptr = temp.domain(0).field_shared(m_field);
     }
-    DataSet iso_domain = func.execute(field_ptr.get());
-    output.add_domain(iso_domain);
+    // the span index lives on the field, so every isovalue
+    // (and later calls on the same field) share one build
+    for(const Float isovalue : m_isovalues)
+    {
+      MarchingCubesFunctor func(domain, m_field, isovalue);
+      func.do_orig_cells = do_orig_cells;
+      func.use_span_index = m_use_span_index;
+      DataSet iso_domain = func.execute(field_ptr.get());
+      output.add_domain(iso_domain);
+    }
   }
   return output;
 }
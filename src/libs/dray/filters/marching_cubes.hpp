@@ -15,6 +15,7 @@ class MarchingCubes
 {
   std::string m_field;
   std::vector<Float> m_isovalues;
+  bool m_use_span_index;
 public:
   MarchingCubes();
   ~MarchingCubes();
@@ -22,6 +23,11 @@ public:
   void set_field(const std::string &name);
   void set_isovalue(Float value);
   void set_isovalues(const Float *values, int nvalues);
+  // Only visit the cells whose range contains the isovalue, found with
+  // a span space index cached on the field. Building the index costs a
+  // sort of the cells, which pays off when sweeping several isovalues
+  // or contouring the same field repeatedly.
+  void set_use_span_index(bool use_index);
 
   Collection execute(Collection &);
 };
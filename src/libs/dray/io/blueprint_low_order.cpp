@@ -617,8 +617,18 @@ BlueprintLowOrder::import(const conduit::Node &n_dataset)
     DRAY_ERROR("Import failed to verify "<<info.to_yaml());
   }
 
-  std::map<std::string, std::string> topologies_shapes;
-  std::map<std::string, Array<int32>>  topologies_conn;
+  std::map<std::string, TopologyInfo> topo_info;
+  import_meshes(n_dataset, dataset, topo_info);
+  import_fields(n_dataset, topo_info, dataset);
+
+  return dataset;
+}
+
+void
+BlueprintLowOrder::import_meshes(const conduit::Node &n_dataset,
+                                 DataSet &dataset,
+                                 std::map<std::string, TopologyInfo> &topo_info)
+{
   const int32 num_topos = n_dataset["topologies"].number_of_children();
   for(int32 i = 0; i < num_topos; ++i)
   {
@@ -654,10 +664,16 @@ BlueprintLowOrder::import(const conduit::Node &n_dataset)
     }
     topo->name(topo_name);
     dataset.add_mesh(topo);
-    topologies_shapes[topo_name] = shape;
-    topologies_conn[topo_name] = conn;
+    topo_info[topo_name].shape = shape;
+    topo_info[topo_name].conn = conn;
   }
+}
 
+void
+BlueprintLowOrder::import_fields(const conduit::Node &n_dataset,
+                                 const std::map<std::string, TopologyInfo> &topo_info,
+                                 DataSet &dataset)
+{
   const int32 num_fields = n_dataset["fields"].number_of_children();
   std::vector<std::string> field_names = n_dataset["fields"].child_names();
 
@@ -670,14 +686,22 @@ BlueprintLowOrder::import(const conduit::Node &n_dataset)
     // import_field(n_field,shape,dataset);
 
     std::string field_topo = n_field["topology"].as_string();
-    std::string shape = topologies_shapes[field_topo];
+
+    auto topo_itr = topo_info.find(field_topo);
+    if(topo_itr == topo_info.end())
+    {
+      DRAY_ERROR("field '"<<field_names[i]<<"' references unknown topology '"
+                 <<field_topo<<"'");
+    }
+
+    std::string shape = topo_itr->second.shape;
 
     int32 components = n_field["values"].number_of_children();
     bool is_scalar = components == 0 || components == 1;
 
     std::string assoc = n_field["association"].as_string();
     const int32 n_elems = dataset.mesh(field_topo)->cells();
-    Array<int32> conn = topologies_conn[field_topo];
+    Array<int32> conn = topo_itr->second.conn;
 
     // if we are vertex assoced, we will use the 
     // vertex ids from the blueprint connectivity as 
@@ -744,7 +768,6 @@ BlueprintLowOrder::import(const conduit::Node &n_dataset)
     }
 
   }
-  return dataset;
 }
 
 std::shared_ptr<Mesh>
@@ -8,6 +8,9 @@
 
 #include <conduit.hpp>
 #include <dray/data_model/collection.hpp>
+
+#include <map>
+#include <string>
 //#include <dray/data_model/grid_function.hpp>
 
 namespace dray
@@ -17,7 +20,26 @@ class BlueprintLowOrder
 {
 public:
 
+  // shape and connectivity of an imported topology, needed to
+  // import the fields associated with it
+  struct TopologyInfo
+  {
+    std::string  shape;
+    Array<int32> conn;
+  };
+
   static DataSet import(const conduit::Node &n_dataset);
+
+  // import only the meshes. The topology info can be used later to
+  // import fields onto the same meshes (e.g. when only fields change)
+  static void import_meshes(const conduit::Node &n_dataset,
+                            DataSet &dataset,
+                            std::map<std::string, TopologyInfo> &topo_info);
+
+  static void import_fields(const conduit::Node &n_dataset,
+                            const std::map<std::string, TopologyInfo> &topo_info,
+                            DataSet &dataset);
+
   static
   std::shared_ptr<Mesh> import_uniform(const conduit::Node &n_coords,
                                        Array<int32> &conn,
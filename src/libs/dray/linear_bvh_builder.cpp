@@ -6,6 +6,7 @@
 #include <dray/linear_bvh_builder.hpp>
 
 #include <dray/array_utils.hpp>
+#include <dray/dray.hpp>
 #include <dray/error_check.hpp>
 #include <dray/math.hpp>
 #include <dray/morton_codes.hpp>
@@ -117,21 +118,130 @@ template <typename T> void reorder (Array<int32> &indices, Array<T> &array)
   array = temp;
 }
 
+namespace detail
+{
+// morton codes use 30 bits, sorted 8 bits at a time
+constexpr int32 radix_bits = 8;
+constexpr int32 radix_buckets = 1 << radix_bits;
+constexpr int32 radix_mask = radix_buckets - 1;
+// keep chunks large enough that the per chunk histograms pay off
+constexpr int32 radix_min_chunk = 1 << 14;
+constexpr int32 radix_max_chunks = 64;
+
+int32 radix_num_chunks (const int32 size)
+{
+  return max (1, min (radix_max_chunks, size / radix_min_chunk));
+}
+
+} // namespace detail
+
+//
+// LSD radix sort of the morton codes that also returns the original
+// position of each sorted code. The input is split into contiguous
+// chunks that build their own histograms and scatter independently,
+// so each pass runs in parallel and stays stable. The key and id
+// buffers are swapped between passes, and passes over digits that
+// are the same for every code are skipped.
+//
 Array<int32> sort_mcodes (Array<uint32> &mcodes)
 {
-  const int size = mcodes.size ();
-  Array<int32> iter = array_counting (size, 0, 1);
-  // TODO: create custom sort for GPU / CPU
-  int32 *iter_ptr = iter.get_host_ptr ();
-  uint32 *mcodes_ptr = mcodes.get_host_ptr ();
+  const int32 size = mcodes.size ();
+  Array<int32> ids = array_counting (size, 0, 1);
+  if (size < 2)
+  {
+    return ids;
+  }
 
-  std::sort (iter_ptr, iter_ptr + size,
-             [=] (int32 i1, int32 i2) { return mcodes_ptr[i1] < mcodes_ptr[i2]; });
+  const int32 num_chunks = detail::radix_num_chunks (size);
+  const int32 chunk_size = (size + num_chunks - 1) / num_chunks;
+
+  Array<uint32> keys_scratch;
+  Array<int32> ids_scratch;
+  keys_scratch.resize (size);
+  ids_scratch.resize (size);
+  Array<int32> histograms;
+  histograms.resize (num_chunks * detail::radix_buckets);
+
+  uint32 *keys_in = mcodes.get_host_ptr ();
+  int32 *ids_in = ids.get_host_ptr ();
+  uint32 *keys_out = keys_scratch.get_host_ptr ();
+  int32 *ids_out = ids_scratch.get_host_ptr ();
+  int32 *hist_ptr = histograms.get_host_ptr ();
+
+  // no need to sort bits above the largest code
+  RAJA::ReduceMax<reduce_cpu_policy, uint32> code_max (0);
+  RAJA::forall<for_cpu_policy> (RAJA::RangeSegment (0, size), [=] DRAY_CPU_LAMBDA (int32 i) {
+    code_max.max (keys_in[i]);
+  });
+  const uint32 max_code = code_max.get ();
+
+  for (int32 shift = 0; shift < 32 && (max_code >> shift) != 0;
+       shift += detail::radix_bits)
+  {
+    RAJA::forall<for_cpu_policy> (RAJA::RangeSegment (0, num_chunks), [=] DRAY_CPU_LAMBDA (int32 c) {
+      int32 *hist = hist_ptr + c * detail::radix_buckets;
+      for (int32 b = 0; b < detail::radix_buckets; ++b)
+      {
+        hist[b] = 0;
+      }
+      const int32 begin = c * chunk_size;
+      const int32 end = min (size, begin + chunk_size);
+      for (int32 i = begin; i < end; ++i)
+      {
+        hist[(keys_in[i] >> shift) & detail::radix_mask]++;
+      }
+    });
 
+    // turn the counts into the output offset of each chunk and bucket,
+    // buckets in order and chunks in order inside each bucket
+    bool single_bucket = false;
+    int32 offset = 0;
+    for (int32 b = 0; b < detail::radix_buckets; ++b)
+    {
+      const int32 bucket_begin = offset;
+      for (int32 c = 0; c < num_chunks; ++c)
+      {
+        const int32 count = hist_ptr[c * detail::radix_buckets + b];
+        hist_ptr[c * detail::radix_buckets + b] = offset;
+        offset += count;
+      }
+      if (offset - bucket_begin == size)
+      {
+        single_bucket = true;
+      }
+    }
 
-  reorder (iter, mcodes);
+    if (single_bucket)
+    {
+      // every code has the same digit, the order does not change
+      continue;
+    }
 
-  return iter;
+    RAJA::forall<for_cpu_policy> (RAJA::RangeSegment (0, num_chunks), [=] DRAY_CPU_LAMBDA (int32 c) {
+      int32 *hist = hist_ptr + c * detail::radix_buckets;
+      const int32 begin = c * chunk_size;
+      const int32 end = min (size, begin + chunk_size);
+      for (int32 i = begin; i < end; ++i)
+      {
+        const uint32 key = keys_in[i];
+        const int32 dest = hist[(key >> shift) & detail::radix_mask]++;
+        keys_out[dest] = key;
+        ids_out[dest] = ids_in[i];
+      }
+    });
+
+    std::swap (keys_in, keys_out);
+    std::swap (ids_in, ids_out);
+  }
+
+  // the sorted data can end up in the scratch buffers
+  if (keys_in != mcodes.get_host_ptr ())
+  {
+    mcodes = keys_scratch;
+    ids = ids_scratch;
+  }
+
+  return ids;
 }
 
 struct BVHData
@@ -316,6 +426,64 @@ void propagate_aabbs (BVHData &data)
   // std::cout<<"Root bounds "<<inner[0]<<"\n";
 }
 
+//
+// sum of the inner node surface areas relative to the root, the
+// surface area heuristic cost of the tree up to constant factors
+//
+float32 tree_cost (BVHData &data)
+{
+  const int32 inner_size = data.m_inner_aabbs.size ();
+  const AABB<> *inner_aabb_ptr = data.m_inner_aabbs.get_device_ptr_const ();
+
+  RAJA::ReduceSum<reduce_policy, float32> area_sum (0.f);
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, inner_size), [=] DRAY_LAMBDA (int32 i) {
+    area_sum += inner_aabb_ptr[i].surface_area ();
+  });
+  DRAY_ERROR_CHECK();
+
+  const float32 root_area = data.m_inner_aabbs.get_value (0).surface_area ();
+  return root_area > 0.f ? area_sum.get () / root_area : 0.f;
+}
+
+//
+// recovers the child and parent pointers of the tree from the
+// flattened bvh layout (see emit)
+//
+void unflatten (const BVH &bvh, BVHData &data)
+{
+  const int32 inner_size = bvh.m_inner_nodes.size () / 4;
+  data.m_left_children.resize (inner_size);
+  data.m_right_children.resize (inner_size);
+  data.m_parents.resize (inner_size + inner_size + 1);
+
+  const Vec<float32, 4> *flat_ptr = bvh.m_inner_nodes.get_device_ptr_const ();
+  int32 *lchildren_ptr = data.m_left_children.get_device_ptr ();
+  int32 *rchildren_ptr = data.m_right_children.get_device_ptr ();
+  int32 *parent_ptr = data.m_parents.get_device_ptr ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, inner_size), [=] DRAY_LAMBDA (int32 node) {
+    const Vec<float32, 4> vec4 = flat_ptr[node * 4 + 3];
+    int32 lchild, rchild;
+    constexpr int32 isize = sizeof (int32);
+    memcpy (&lchild, &vec4[0], isize);
+    memcpy (&rchild, &vec4[1], isize);
+    // leafs are stored as -(index + 1), inner nodes as index * 4
+    lchild = lchild < 0 ? inner_size - lchild - 1 : lchild / 4;
+    rchild = rchild < 0 ? inner_size - rchild - 1 : rchild / 4;
+
+    lchildren_ptr[node] = lchild;
+    rchildren_ptr[node] = rchild;
+    parent_ptr[lchild] = node;
+    parent_ptr[rchild] = node;
+    if (node == 0)
+    {
+      // flag the root
+      parent_ptr[0] = -1;
+    }
+  });
+  DRAY_ERROR_CHECK();
+}
+
 Array<Vec<float32, 4>> emit (BVHData &data)
 {
   const int inner_size = data.m_inner_aabbs.size ();
@@ -511,10 +679,80 @@ BVH LinearBVHBuilder::construct (Array<AABB<>> aabbs, Array<int32> primitive_ids
   bvh.m_leaf_nodes = bvh_data.m_leafs;
   bvh.m_bounds = bounds;
   bvh.m_aabb_ids = ids;
+  bvh.m_build_cost = tree_cost (bvh_data);
 
   DRAY_LOG_ENTRY ("tot_time", tot_time.elapsed ());
   DRAY_LOG_CLOSE ();
   return bvh;
 }
 
+BVH LinearBVHBuilder::refit (const BVH &bvh, Array<AABB<>> aabbs, Array<int32> primitive_ids)
+{
+  const int32 size = aabbs.size ();
+  // the tree has to come from the same number of boxes. The one and
+  // zero box cases are padded in construct, so just rebuild those.
+  if (size < 2 ||
+      bvh.m_aabb_ids.size () != size ||
+      bvh.m_inner_nodes.size () != (size - 1) * 4 ||
+      dray::get_bvh_refit_threshold () < 1.f)
+  {
+    return construct (aabbs, primitive_ids);
+  }
+
+  DRAY_LOG_OPEN ("bvh_refit");
+  DRAY_LOG_ENTRY ("num_aabbs", size);
+  Timer tot_time;
+  Timer timer;
+
+  AABB<> bounds = reduce (aabbs);
+  DRAY_LOG_ENTRY ("reduce", timer.elapsed ());
+  timer.reset ();
+
+  // put the boxes in the leaf order of the existing tree
+  Array<AABB<>> leaf_aabbs = aabbs;
+  Array<int32> ids = bvh.m_aabb_ids;
+  reorder (ids, leaf_aabbs);
+  DRAY_LOG_ENTRY ("reorder", timer.elapsed ());
+  timer.reset ();
+
+  BVHData bvh_data;
+  bvh_data.m_leafs = bvh.m_leaf_nodes;
+  bvh_data.m_leaf_aabbs = leaf_aabbs;
+  bvh_data.m_inner_aabbs.resize (size - 1);
+  unflatten (bvh, bvh_data);
+  DRAY_LOG_ENTRY ("unflatten", timer.elapsed ());
+  timer.reset ();
+
+  propagate_aabbs (bvh_data);
+  DRAY_LOG_ENTRY ("propagate", timer.elapsed ());
+  timer.reset ();
+
+  // the tree was built for the old positions, if the boxes have
+  // grown too much it is cheaper to trace a new one
+  const float32 cost = tree_cost (bvh_data);
+  DRAY_LOG_ENTRY ("build_cost", bvh.m_build_cost);
+  DRAY_LOG_ENTRY ("refit_cost", cost);
+  if (cost > bvh.m_build_cost * dray::get_bvh_refit_threshold ())
+  {
+    DRAY_LOG_ENTRY ("rebuild", 1);
+    DRAY_LOG_CLOSE ();
+    return construct (aabbs, primitive_ids);
+  }
+
+  BVH res;
+  res.m_inner_nodes = emit (bvh_data);
+  DRAY_LOG_ENTRY ("emit", timer.elapsed ());
+  timer.reset ();
+
+  res.m_leaf_nodes = bvh.m_leaf_nodes;
+  res.m_bounds = bounds;
+  res.m_aabb_ids = bvh.m_aabb_ids;
+  // keep comparing against the tree that was actually built
+  res.m_build_cost = bvh.m_build_cost;
+
+  DRAY_LOG_ENTRY ("tot_time", tot_time.elapsed ());
+  DRAY_LOG_CLOSE ();
+  return res;
+}
+
 } // namespace dray
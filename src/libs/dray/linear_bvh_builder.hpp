@@ -19,9 +19,16 @@ class LinearBVHBuilder
   public:
   BVH construct (Array<AABB<>> aabbs);
   BVH construct (Array<AABB<>> aabbs, Array<int32> primimitive_ids);
+  // Keeps the tree of a bvh built from the same primitives and only
+  // recomputes its boxes. aabbs must be in the order bvh was built
+  // from. Falls back to construct when the refit tree is worse than
+  // the built one by more than dray::get_bvh_refit_threshold().
+  BVH refit (const BVH &bvh, Array<AABB<>> aabbs, Array<int32> primimitive_ids);
 };
 
 AABB<> reduce (const Array<AABB<>> &aabbs);
+// sorts the morton codes in place and returns their original positions
+Array<int32> sort_mcodes (Array<uint32> &mcodes);
 
 } // namespace dray
 #endif
@@ -12,10 +12,13 @@
 #include <dray/error.hpp>
 #include <dray/error_check.hpp>
 #include <dray/policies.hpp>
+#include <dray/array_utils.hpp>
 
 #include <apcomp/compositor.hpp>
 #include <apcomp/partial_compositor.hpp>
 
+#include <algorithm>
+#include <numeric>
 #include <memory>
 #include <vector>
 
@@ -138,6 +141,74 @@ partials_to_framebuffer(const std::vector<apcomp::VolumePartial<float>> &input,
   }
 }
 
+// Bounds of each local domain of a traceable. Bounds are padded so
+// that flat (2D) domains can still be hit by the ray test.
+std::vector<AABB<3>> domain_bounds(Traceable &traceable)
+{
+  const int32 domains = traceable.num_domains();
+  std::vector<AABB<3>> bounds(domains);
+  for(int32 d = 0; d < domains; ++d)
+  {
+    AABB<3> dbounds = traceable.collection().domain(d).mesh()->bounds();
+    if(!dbounds.is_empty())
+    {
+      const float32 pad = (dbounds.max() - dbounds.min()).magnitude() * 1e-3f;
+      dbounds.expand(pad > 0.f ? pad : 1e-6f);
+    }
+    bounds[d] = dbounds;
+  }
+  return bounds;
+}
+
+// Domain indices sorted by the distance from the camera to their bounds.
+// Tracing the nearest domains first lets ray_max shorten the rays
+// before the domains behind them are traced.
+std::vector<int32> front_to_back(const std::vector<AABB<3>> &bounds,
+                                 const Vec<float32,3> &pos)
+{
+  const int32 size = static_cast<int32>(bounds.size());
+  std::vector<float32> dists(size);
+  std::vector<int32> order(size);
+  for(int32 d = 0; d < size; ++d)
+  {
+    order[d] = d;
+    // squared distance to the closest point of the box, 0 if inside
+    float32 dist2 = 0.f;
+    for(int32 i = 0; i < 3; ++i)
+    {
+      const float32 below = bounds[d].m_ranges[i].min() - pos[i];
+      const float32 above = pos[i] - bounds[d].m_ranges[i].max();
+      const float32 outside = std::max(0.f, std::max(below, above));
+      dist2 += outside * outside;
+    }
+    dists[d] = bounds[d].is_empty() ? infinity32() : dist2;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int32 a, int32 b)
+  {
+    return dists[a] < dists[b];
+  });
+  return order;
+}
+
+// ray_max for the hits of a subset of the rays
+void ray_max(Array<Ray> &rays, const Array<int32> &ids, const Array<RayHit> &hits)
+{
+  const int32 size = ids.size();
+  Ray *ray_ptr = rays.get_device_ptr();
+  const int32 *ids_ptr = ids.get_device_ptr_const();
+  const RayHit *hit_ptr = hits.get_device_ptr_const();
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, size), [=] DRAY_LAMBDA (int32 i)
+  {
+    const RayHit hit = hit_ptr[i];
+    if(hit.m_hit_idx != -1)
+    {
+      ray_ptr[ids_ptr[i]].m_far = hit.m_dist;
+    }
+  });
+  DRAY_ERROR_CHECK();
+}
+
 PointLight default_light(Camera &camera)
 {
   Vec<float32,3> look_at = camera.get_look_at();
@@ -166,7 +237,8 @@ Renderer::Renderer()
     m_world_annotations(false),
     m_color_bar(true),
     m_triad(false),
-    m_max_color_bars(2)
+    m_max_color_bars(2),
+    m_cull_domains(true)
 {
 }
 
@@ -205,6 +277,11 @@ void Renderer::use_lighting(bool use_it)
   m_use_lighting = use_it;
 }
 
+void Renderer::cull_domains(bool on)
+{
+  m_cull_domains = on;
+}
+
 void Renderer::add(std::shared_ptr<Traceable> traceable)
 {
   m_traceables.push_back(traceable);
@@ -259,24 +336,63 @@ Framebuffer Renderer::render(Camera &camera)
   const int32 size = m_traceables.size();
 
   bool need_composite = false;
+  int32 traced_rays = 0;
   for(int i = 0; i < size; ++i)
   {
-    const int domains = m_traceables[i]->num_domains();
-    for(int d = 0; d < domains; ++d)
+    // only trace the rays that can reach a domain, nearest domains first
+    const int32 domains = m_traceables[i]->num_domains();
+    std::vector<AABB<3>> bounds;
+    std::vector<int32> order(domains);
+    std::iota(order.begin(), order.end(), 0);
+    if(m_cull_domains)
     {
+      bounds = detail::domain_bounds(*m_traceables[i]);
+      order = detail::front_to_back(bounds, camera.get_pos());
+    }
+    for(const int32 d : order)
+    {
+      Array<int32> ray_ids;
+      bool cull = false;
+      if(m_cull_domains)
+      {
+        if(bounds[d].is_empty())
+        {
+          continue;
+        }
+        // uses the current ray extents, so rays already stopped
+        // in front of this domain are culled
+        Array<int32> active = mark_active(rays, bounds[d]);
+        ray_ids = index_flags(active);
+        if(ray_ids.size() == 0)
+        {
+          continue;
+        }
+        cull = ray_ids.size() < rays.size();
+      }
+      traced_rays += cull ? ray_ids.size() : rays.size();
+
+      Array<Ray> domain_rays = cull ? gather(rays, ray_ids) : rays;
+
       m_traceables[i]->active_domain(d);
-      Array<RayHit> hits = m_traceables[i]->nearest_hit(rays);
+      Array<RayHit> hits = m_traceables[i]->nearest_hit(domain_rays);
       Array<Fragment> fragments = m_traceables[i]->fragments(hits);
       if(m_use_lighting)
       {
-        m_traceables[i]->shade(rays, hits, fragments, lights, framebuffer);
+        m_traceables[i]->shade(domain_rays, hits, fragments, lights, framebuffer);
       }
       else
       {
-        m_traceables[i]->shade(rays, hits, fragments, framebuffer);
+        m_traceables[i]->shade(domain_rays, hits, fragments, framebuffer);
       }
 
-      ray_max(rays, hits);
+      if(cull)
+      {
+        detail::ray_max(rays, ray_ids, hits);
+      }
+      else
+      {
+        ray_max(rays, hits);
+      }
     }
     // we just did some rendering so we need to composite
     need_composite = true;
@@ -286,6 +402,8 @@ Framebuffer Renderer::render(Camera &camera)
     color_maps.push_back(m_traceables[i]->color_map());
   }
 
+  DRAY_LOG_ENTRY("traced_rays", traced_rays);
+
   // Do world objects if any
   if(m_world_annotations)
   {
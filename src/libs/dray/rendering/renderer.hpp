@@ -29,6 +29,7 @@ protected:
   bool m_color_bar;
   bool m_triad;
   int32 m_max_color_bars;
+  bool m_cull_domains;
 
 public:
   Renderer();
@@ -49,6 +50,8 @@ public:
   void triad(bool on);
   void world_annotations(bool on);
   void max_color_bars(const int32 max_bars);
+  // trace only the rays that reach each domain, nearest first (default on)
+  void cull_domains(bool on);
 
 };
 
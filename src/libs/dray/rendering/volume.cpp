@@ -11,6 +11,7 @@
 #include <dray/array_utils.hpp>
 #include <dray/error_check.hpp>
 #include <dray/device_color_map.hpp>
+#include <dray/linear_bvh_builder.hpp>
 
 #include <dray/utils/data_logger.hpp>
 #include <dray/utils/timer.hpp>
@@ -18,52 +19,239 @@
 #include <dray/data_model/device_mesh.hpp>
 #include <dray/data_model/device_field.hpp>
 
+#include <vector>
+
 namespace dray
 {
 
 namespace detail
 {
-void init_partials(Array<VolumePartial> &partials)
+// Puts the segments found in each round in ray order, and front to
+// back for each ray. round_partials[r] holds segment r of the rays in
+// round_rays[r].
+Array<VolumePartial>
+order_partials(std::vector<Array<VolumePartial>> &round_partials,
+               std::vector<Array<int32>> &round_rays,
+               Array<int32> &segment_counts)
 {
-  const int32 size = partials.size();
-  VolumePartial *partial_ptr = partials.get_device_ptr();
+  const int32 num_rounds = static_cast<int32>(round_partials.size());
+  if(num_rounds == 0)
+  {
+    return Array<VolumePartial>();
+  }
+  if(num_rounds == 1)
+  {
+    // one segment per ray, already in ray order
+    return round_partials[0];
+  }
 
-  RAJA::forall<for_policy>(RAJA::RangeSegment(0, size), [=] DRAY_LAMBDA (int32 i)
+  int32 total = 0;
+  Array<int32> offsets = array_exc_scan_plus(segment_counts, total);
+  const int32 *offsets_ptr = offsets.get_device_ptr_const();
+
+  Array<VolumePartial> partials;
+  partials.resize(total);
+  VolumePartial *partials_ptr = partials.get_device_ptr();
+
+  for(int32 r = 0; r < num_rounds; ++r)
   {
-    VolumePartial p;
-    p.m_pixel_id = -1;
-    p.m_depth = infinity32();
-    p.m_color = {0.f, 0.f, 0.f, 0.f};
-    partial_ptr[i] = p;
-  });
-  DRAY_ERROR_CHECK();
+    const int32 size = round_partials[r].size();
+    const VolumePartial *round_ptr = round_partials[r].get_device_ptr_const();
+    const int32 *rays_ptr = round_rays[r].get_device_ptr_const();
+    RAJA::forall<for_policy>(RAJA::RangeSegment(0, size), [=] DRAY_LAMBDA (int32 i)
+    {
+      partials_ptr[offsets_ptr[rays_ptr[i]] + r] = round_ptr[i];
+    });
+    DRAY_ERROR_CHECK();
+    // release rounds as soon as they are copied
+    round_partials[r] = Array<VolumePartial>();
+    round_rays[r] = Array<int32>();
+  }
+
+  return partials;
 }
 
-Array<VolumePartial> compact_partials(const Array<VolumePartial> &partials)
+// Flags the elements that can contribute to the image: their field
+// range (the bernstein coefficients bound the field) maps to at least
+// one color table sample with non-zero alpha. Returns the number
+// of visible elements.
+template<typename FieldElement>
+int32 visible_elements(UnstructuredField<FieldElement> &field,
+                       ColorMap &color_map,
+                       Array<int32> &visible)
 {
-  const int32 size = partials.size();
-
-  if(size == 0)
+  Array<Vec<float32,4>> colors = color_map.colors();
+  const int32 num_colors = colors.size();
+
+  // running count of the opaque samples in the color table
+  Array<int32> opaque;
+  opaque.resize(num_colors + 1);
+  const Vec<float32,4> *colors_ptr = colors.get_host_ptr_const();
+  int32 *opaque_ptr = opaque.get_host_ptr();
+  opaque_ptr[0] = 0;
+  for(int32 i = 0; i < num_colors; ++i)
   {
-    return partials;
+    opaque_ptr[i + 1] = opaque_ptr[i] + (colors_ptr[i][3] > 0.f ? 1 : 0);
   }
 
-  Array<int32> valid_segments;
-  valid_segments.resize(size);
-  int32 * valid_ptr = valid_segments.get_device_ptr();
+  GridFunction<FieldElement::get_ncomp()> dof_data = field.get_dof_data();
+  const int32 num_elems = dof_data.m_size_el;
+  const int32 el_dofs = dof_data.m_el_dofs;
+  const int32 *idx_ptr = dof_data.m_ctrl_idx.get_device_ptr_const();
+  const Vec<Float,FieldElement::get_ncomp()> *values_ptr
+    = dof_data.m_values.get_device_ptr_const();
+  const int32 *d_opaque_ptr = opaque.get_device_ptr_const();
+
+  visible.resize(num_elems);
+  int32 *visible_ptr = visible.get_device_ptr();
 
-  const VolumePartial *partial_ptr = partials.get_device_ptr_const();
+  DeviceColorMap d_color_map(color_map);
+  RAJA::ReduceSum<reduce_policy, int32> visible_count(0);
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, num_elems), [=] DRAY_LAMBDA (int32 el)
+  {
+    const int32 *el_idx_ptr = idx_ptr + el * el_dofs;
+    Float min_val = values_ptr[el_idx_ptr[0]][0];
+    Float max_val = min_val;
+    for(int32 d = 1; d < el_dofs; ++d)
+    {
+      const Float val = values_ptr[el_idx_ptr[d]][0];
+      min_val = fminf(min_val, val);
+      max_val = fmaxf(max_val, val);
+    }
+    const int32 first = d_color_map.sample_index(min_val);
+    const int32 last = d_color_map.sample_index(max_val);
+    const int32 is_visible = d_opaque_ptr[last + 1] - d_opaque_ptr[first] > 0 ? 1 : 0;
+    visible_ptr[el] = is_visible;
+    visible_count += is_visible;
+  });
+  DRAY_ERROR_CHECK();
 
+  return visible_count.get();
+}
+
+// Bvh over the bounds of the visible elements, used to jump over
+// the parts of a ray that cannot contribute.
+template<typename MeshElement>
+BVH visible_bvh(UnstructuredMesh<MeshElement> &mesh,
+                Array<int32> &visible)
+{
+  Array<int32> visible_ids = index_flags(visible);
+  const int32 size = visible_ids.size();
+  const int32 *ids_ptr = visible_ids.get_device_ptr_const();
+
+  Array<AABB<>> aabbs;
+  aabbs.resize(size);
+  AABB<> *aabb_ptr = aabbs.get_device_ptr();
+
+  DeviceMesh<MeshElement> device_mesh(mesh);
   RAJA::forall<for_policy>(RAJA::RangeSegment(0, size), [=] DRAY_LAMBDA (int32 i)
   {
-    const float32 depth = partial_ptr[i].m_depth;
-    valid_ptr[i] = (depth == infinity32()) ? 0 : 1;
+    AABB<> bounds;
+    device_mesh.get_elem(ids_ptr[i]).get_bounds(bounds);
+    // make sure samples on the faces count as inside
+    bounds.scale(1.000001);
+    aabb_ptr[i] = bounds;
   });
   DRAY_ERROR_CHECK();
 
-  Array<int32> compact_idxs = index_flags(valid_segments);
+  LinearBVHBuilder builder;
+  return builder.construct(aabbs, visible_ids);
+}
+
+// Distance of the first visible box along the ray at or after min_dist.
+// Returns max_dist if there is none.
+DRAY_EXEC_ONLY
+Float next_visible(const Vec<float32,4> *inner_ptr,
+                   const Ray &ray,
+                   const Float min_dist,
+                   const Float max_dist)
+{
+  Vec<Float,3> inv_dir;
+  inv_dir[0] = rcp_safe(ray.m_dir[0]);
+  inv_dir[1] = rcp_safe(ray.m_dir[1]);
+  inv_dir[2] = rcp_safe(ray.m_dir[2]);
+  Vec<Float,3> orig_dir;
+  orig_dir[0] = ray.m_orig[0] * inv_dir[0];
+  orig_dir[1] = ray.m_orig[1] * inv_dir[1];
+  orig_dir[2] = ray.m_orig[2] * inv_dir[2];
+
+  Float closest = max_dist;
+
+  int32 todo[64];
+  int32 stackptr = 0;
+  constexpr int32 barrier = -2000000000;
+  todo[stackptr] = barrier;
+  int32 current_node = 0;
+
+  while(current_node != barrier)
+  {
+    const Vec<float32,4> first4 = const_get_vec4f(&inner_ptr[current_node + 0]);
+    const Vec<float32,4> second4 = const_get_vec4f(&inner_ptr[current_node + 1]);
+    const Vec<float32,4> third4 = const_get_vec4f(&inner_ptr[current_node + 2]);
+    const Vec<float32,4> children = const_get_vec4f(&inner_ptr[current_node + 3]);
+
+    Float dists[2];
+    Float xmin = first4[0] * inv_dir[0] - orig_dir[0];
+    Float ymin = first4[1] * inv_dir[1] - orig_dir[1];
+    Float zmin = first4[2] * inv_dir[2] - orig_dir[2];
+    Float xmax = first4[3] * inv_dir[0] - orig_dir[0];
+    Float ymax = second4[0] * inv_dir[1] - orig_dir[1];
+    Float zmax = second4[1] * inv_dir[2] - orig_dir[2];
+    Float t_near = fmaxf(fmaxf(fmaxf(fminf(ymin, ymax), fminf(xmin, xmax)),
+                             fminf(zmin, zmax)), min_dist);
+    Float t_far = fminf(fminf(fminf(fmaxf(ymin, ymax), fmaxf(xmin, xmax)),
+                            fmaxf(zmin, zmax)), closest);
+    dists[0] = t_far >= t_near ? t_near : infinity<Float>();
+
+    xmin = second4[2] * inv_dir[0] - orig_dir[0];
+    ymin = second4[3] * inv_dir[1] - orig_dir[1];
+    zmin = third4[0] * inv_dir[2] - orig_dir[2];
+    xmax = third4[1] * inv_dir[0] - orig_dir[0];
+    ymax = third4[2] * inv_dir[1] - orig_dir[1];
+    zmax = third4[3] * inv_dir[2] - orig_dir[2];
+    t_near = fmaxf(fmaxf(fmaxf(fminf(ymin, ymax), fminf(xmin, xmax)),
+                       fminf(zmin, zmax)), min_dist);
+    t_far = fminf(fminf(fminf(fmaxf(ymin, ymax), fmaxf(xmin, xmax)),
+                      fmaxf(zmin, zmax)), closest);
+    dists[1] = t_far >= t_near ? t_near : infinity<Float>();
+
+    int32 child_ids[2];
+    constexpr int32 isize = sizeof(int32);
+    memcpy(&child_ids[0], &children[0], isize);
+    memcpy(&child_ids[1], &children[1], isize);
+
+    // leaves are the visible elements, so entering one is an answer
+    for(int32 c = 0; c < 2; ++c)
+    {
+      if(child_ids[c] < 0 && dists[c] < closest)
+      {
+        closest = dists[c];
+      }
+    }
+
+    const bool go_left = child_ids[0] > -1 && dists[0] < closest;
+    const bool go_right = child_ids[1] > -1 && dists[1] < closest;
+    if(go_left && go_right)
+    {
+      // visit the closer child first
+      const bool right_closer = dists[1] < dists[0];
+      current_node = right_closer ? child_ids[1] : child_ids[0];
+      stackptr++;
+      todo[stackptr] = right_closer ? child_ids[0] : child_ids[1];
+    }
+    else if(go_left || go_right)
+    {
+      current_node = go_left ? child_ids[0] : child_ids[1];
+    }
+    else
+    {
+      current_node = todo[stackptr];
+      stackptr--;
+    }
+  }
 
-  return gather(partials, compact_idxs);
+  return closest;
 }
 
 template<typename MeshElement, typename FieldElement>
@@ -75,7 +263,8 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
                    const int32 samples,
                    const AABB<3> bounds,
                    ColorMap &color_map,
-                   bool use_lighting)
+                   bool use_lighting,
+                   bool skip_empty_space)
 {
   DRAY_LOG_OPEN("volume");
   constexpr float32 correction_scalar = 10.f;
@@ -95,6 +284,37 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   DRAY_LOG_ENTRY("samples", samples);
   DRAY_LOG_ENTRY("sample_distance", sample_dist);
   DRAY_LOG_ENTRY("cells", num_elems);
+
+  // empty space skipping: elements the transfer function makes fully
+  // transparent are never shaded, and rays jump over the stretches
+  // where they cannot hit a visible element
+  Array<int32> visible;
+  int32 num_visible = num_elems;
+  if(skip_empty_space)
+  {
+    num_visible = visible_elements(field, corrected, visible);
+  }
+  else
+  {
+    visible.resize(num_elems);
+    array_memset(visible, 1);
+  }
+  DRAY_LOG_ENTRY("visible_cells", num_visible);
+  if(num_visible == 0)
+  {
+    DRAY_LOG_CLOSE();
+    return Array<VolumePartial>();
+  }
+  const bool skip_empty = num_visible < num_elems;
+  BVH skip_bvh;
+  if(skip_empty)
+  {
+    skip_bvh = visible_bvh(mesh, visible);
+  }
+  const Vec<float32,4> *skip_ptr = skip_empty ?
+                                   skip_bvh.m_inner_nodes.get_device_ptr_const() : nullptr;
+  const int32 *visible_ptr = visible.get_device_ptr_const();
+
   // Start the rays out at the min distance from calc ray start.
   // Note: Rays that have missed the mesh bounds will have near >= far,
   //       so after the copy, we can detect misses as dist >= far.
@@ -107,15 +327,13 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   const int32 ray_size = active_rays.size();
   const Ray *rays_ptr = active_rays.get_device_ptr_const();
 
-  constexpr int32 max_segments = 5;
-  Array<VolumePartial> partials;
-  partials.resize(ray_size * max_segments);
-  init_partials(partials);
-  VolumePartial *partials_ptr = partials.get_device_ptr();
-
-
   // complicated device stuff
   DeviceMesh<MeshElement> device_mesh(mesh);
+  // consecutive samples mostly land in the same or an adjacent element,
+  // so the previous location is used as a hint to avoid the bvh
+  Array<int32> face_neighbors = mesh.get_face_neighbors();
+  const int32 *neighbors_ptr = face_neighbors.size() > 0 ?
+                               face_neighbors.get_device_ptr_const() : nullptr;
 
   DeviceColorMap d_color_map(corrected);
 
@@ -129,35 +347,77 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   mstats.resize(ray_size);
   stats::Stats *mstats_ptr = mstats.get_device_ptr();
 
-  // TODO: somehow load balance based on far - near
-  Timer timer;
+  // state of each ray carried between rounds
+  Array<Float> distances;
+  distances.resize(ray_size);
+  Float *distances_ptr = distances.get_device_ptr();
+  Array<int32> segment_counts;
+  segment_counts.resize(ray_size);
+  int32 *segment_counts_ptr = segment_counts.get_device_ptr();
+
   RAJA::forall<for_policy>(RAJA::RangeSegment(0, ray_size), [=] DRAY_LAMBDA (int32 i)
   {
-    const Ray ray = rays_ptr[i];
     // advance the ray one step
-    Float distance = ray.m_near + sample_dist;
-    constexpr Vec4f clear = {0.f, 0.f, 0.f, 0.f};
-    const int32 partial_offset = max_segments * i;
-    int32 segment = 0;
-
-    VolumePartial partial;
-
-    partial.m_color = {{0.f, 0.f, 0.f, 0.f}};
-    partial.m_pixel_id = ray.m_pixel_id;
-
+    distances_ptr[i] = rays_ptr[i].m_near + sample_dist;
+    segment_counts_ptr[i] = 0;
     stats::Stats mstat;
     mstat.construct();
+    mstats_ptr[i] = mstat;
+  });
+  DRAY_ERROR_CHECK();
 
-    for(int s = 0; s < max_segments; ++s)
+  // Rays are integrated one segment per round, each round only
+  // looks at the rays that are not done. This way only the segments
+  // that exist are stored, no matter how many times a ray enters a
+  // concave mesh.
+  std::vector<Array<VolumePartial>> round_partials;
+  std::vector<Array<int32>> round_rays;
+  Array<int32> ray_ids = array_counting(ray_size, 0, 1);
+
+  // TODO: somehow load balance based on far - near
+  Timer timer;
+  while(ray_ids.size() > 0)
+  {
+    const int32 active_size = ray_ids.size();
+    const int32 *ray_ids_ptr = ray_ids.get_device_ptr_const();
+
+    Array<VolumePartial> partials;
+    partials.resize(active_size);
+    VolumePartial *partials_ptr = partials.get_device_ptr();
+    Array<int32> has_partial;
+    has_partial.resize(active_size);
+    int32 *has_partial_ptr = has_partial.get_device_ptr();
+    Array<int32> not_done;
+    not_done.resize(active_size);
+    int32 *not_done_ptr = not_done.get_device_ptr();
+
+    RAJA::forall<for_policy>(RAJA::RangeSegment(0, active_size), [=] DRAY_LAMBDA (int32 a)
     {
+      const int32 i = ray_ids_ptr[a];
+      const Ray ray = rays_ptr[i];
+      Float distance = distances_ptr[i];
+      stats::Stats mstat = mstats_ptr[i];
+
       bool found = false;
       // find next segment
-      Location loc;
+      Location loc{ -1, { -1.f, -1.f, -1.f } };
       while(distance < ray.m_far && !found)
       {
+        if(skip_ptr != nullptr)
+        {
+          const Float next = next_visible(skip_ptr, ray, distance, ray.m_far);
+          if(next >= ray.m_far)
+          {
+            distance = ray.m_far;
+            break;
+          }
+          // stay on the same sample positions as without skipping
+          distance += ceil((next - distance) / sample_dist) * sample_dist;
+        }
         Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
-        loc = device_mesh.locate(point);
-        if(loc.m_cell_id != -1)
+        loc = device_mesh.locate(point, loc, neighbors_ptr, mstat);
+        // segments start at the first sample that can add color
+        if(loc.m_cell_id != -1 && visible_ptr[loc.m_cell_id] == 1)
         {
           found = true;
         }
@@ -170,11 +430,16 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
       if(distance >= ray.m_far)
       {
         // we are done
-        break;
+        has_partial_ptr[a] = 0;
+        not_done_ptr[a] = 0;
+        mstats_ptr[i] = mstat;
+        return;
       }
 
+      VolumePartial partial;
+      partial.m_pixel_id = ray.m_pixel_id;
       partial.m_depth = distance;
-      partial.m_color = clear;
+      partial.m_color = {{0.f, 0.f, 0.f, 0.f}};
 
       int count = 0;
       mstat.acc_candidates(1);
@@ -182,46 +447,58 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
       {
         // we know we have a valid location
 
-        Vec<float32, 4> sample_color;
-        // shade
-        if(use_lighting)
-        {
-          sample_color = shader.shaded_color(loc, ray);
-        }
-        else
+        // transparent elements add nothing, don't bother shading
+        if(visible_ptr[loc.m_cell_id] == 1)
         {
-          sample_color = shader.color(loc);
+          Vec<float32, 4> sample_color;
+          // shade
+          if(use_lighting)
+          {
+            sample_color = shader.shaded_color(loc, ray);
+          }
+          else
+          {
+            sample_color = shader.color(loc);
+          }
+
+          blend(partial.m_color, sample_color);
         }
-
-        blend(partial.m_color, sample_color);
         count++;
 
         distance += sample_dist;
         Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
-        loc = device_mesh.locate(point);
+        loc = device_mesh.locate(point, loc, neighbors_ptr, mstat);
         found = loc.m_cell_id != -1;
       }
       while(distance < ray.m_far && found && partial.m_color[3] < 0.95f);
 
-      partials_ptr[partial_offset + segment] = partial;
-      segment++;
-
-      if(distance >= ray.m_far || partial.m_color[3] > 0.95f)
-      {
-        // we are done
-        break;
-      }
-
-    } // for segments
-    mstats_ptr[i] = mstat;
-  });
-  DRAY_ERROR_CHECK();
+      partials_ptr[a] = partial;
+      has_partial_ptr[a] = 1;
+      segment_counts_ptr[i] += 1;
+      not_done_ptr[a] = (distance >= ray.m_far || partial.m_color[3] > 0.95f) ? 0 : 1;
+      distances_ptr[i] = distance;
+      mstats_ptr[i] = mstat;
+    });
+    DRAY_ERROR_CHECK();
+
+    Array<int32> written = index_flags(has_partial);
+    if(written.size() > 0)
+    {
+      round_partials.push_back(gather(partials, written));
+      round_rays.push_back(gather(ray_ids, written));
+    }
+    ray_ids = index_flags(not_done, ray_ids);
+  }
   DRAY_LOG_ENTRY("integrate_partials",timer.elapsed());
+  DRAY_LOG_ENTRY("rounds", round_partials.size());
   stats::StatStore::add_ray_stats(active_rays, mstats);
 
   timer.reset();
-  partials = detail::compact_partials(partials);
-  DRAY_LOG_ENTRY("compact",timer.elapsed());
+  Array<VolumePartial> partials = order_partials(round_partials,
+                                                 round_rays,
+                                                 segment_counts);
+  DRAY_LOG_ENTRY("order",timer.elapsed());
+  DRAY_LOG_ENTRY("segments", partials.size());
 
   DRAY_LOG_CLOSE();
   return partials;
@@ -236,20 +513,23 @@ struct IntegratePartialsFunctor
   Float m_samples;
   AABB<3> m_bounds;
   bool m_use_lighting;
+  bool m_skip_empty_space;
   Array<VolumePartial> m_partials;
   IntegratePartialsFunctor(Array<Ray> *rays,
                            Array<PointLight> &lights,
                            ColorMap &color_map,
                            Float samples,
                            AABB<3> bounds,
-                           bool use_lighting)
+                           bool use_lighting,
+                           bool skip_empty_space)
     :
       m_rays(rays),
       m_lights(lights),
       m_color_map(color_map),
       m_samples(samples),
       m_bounds(bounds),
-      m_use_lighting(use_lighting)
+      m_use_lighting(use_lighting),
+      m_skip_empty_space(skip_empty_space)
 
   {
   }
@@ -264,7 +544,8 @@ struct IntegratePartialsFunctor
                                             m_samples,
                                             m_bounds,
                                             m_color_map,
-                                            m_use_lighting);
+                                            m_use_lighting,
+                                            m_skip_empty_space);
   }
 };
 
@@ -275,6 +556,7 @@ Volume::Volume(Collection &collection)
   : m_samples(100),
     m_collection(collection),
     m_use_lighting(true),
+    m_skip_empty_space(true),
     m_active_domain(0)
 {
   // add some default alpha
@@ -345,7 +627,8 @@ Volume::integrate(Array<Ray> &rays, Array<PointLight> &lights)
                                         m_color_map,
                                         m_samples,
                                         m_bounds,
-                                        m_use_lighting);
+                                        m_use_lighting,
+                                        m_skip_empty_space);
   dispatch_3d(mesh, field, func);
   return func.m_partials;
 }
@@ -363,6 +646,13 @@ void Volume::use_lighting(bool do_it)
   m_use_lighting = do_it;
 }
 
+// ------------------------------------------------------------------------
+
+void Volume::skip_empty_space(bool do_it)
+{
+  m_skip_empty_space = do_it;
+}
+
 
 // ------------------------------------------------------------------------
 
@@ -25,6 +25,7 @@ protected:
   std::string m_field;
   AABB<3> m_bounds;
   bool m_use_lighting;
+  bool m_skip_empty_space;
   int32 m_active_domain;
   Range m_field_range;
 
@@ -55,6 +56,9 @@ public:
 
   void use_lighting(bool do_it);
 
+  /// skip the elements the color table makes fully transparent (default on)
+  void skip_empty_space(bool do_it);
+
   ColorMap& color_map();
 };
 
@@ -33,9 +33,22 @@ void write_ray_data(const int32 width,
   std::vector<float32> f_field;
   f_field.resize(image_size);
 
+  std::vector<float32> l_field;
+  l_field.resize(image_size);
+  std::vector<float32> ch_field;
+  ch_field.resize(image_size);
+  std::vector<float32> wh_field;
+  wh_field.resize(image_size);
+  std::vector<float32> hr_field;
+  hr_field.resize(image_size);
+
   std::fill(c_field.begin(), c_field.end(), 0.f);
   std::fill(n_field.begin(), n_field.end(), 0.f);
   std::fill(f_field.begin(), f_field.end(), 0.f);
+  std::fill(l_field.begin(), l_field.end(), 0.f);
+  std::fill(ch_field.begin(), ch_field.end(), 0.f);
+  std::fill(wh_field.begin(), wh_field.end(), 0.f);
+  std::fill(hr_field.begin(), hr_field.end(), 0.f);
 
   for(int i = 0; i < ray_data.size(); ++i)
   {
@@ -43,6 +56,15 @@ void write_ray_data(const int32 width,
     c_field[p.first] = p.second.m_candidates;
     n_field[p.first] = p.second.m_newton_iters;
     f_field[p.first] = p.second.m_found;
+    l_field[p.first] = p.second.m_locates;
+    ch_field[p.first] = p.second.m_cache_hits;
+    wh_field[p.first] = p.second.m_walk_hits;
+    // fraction of locations that did not need the bvh
+    if(p.second.m_locates > 0)
+    {
+      hr_field[p.first] = float32(p.second.m_cache_hits + p.second.m_walk_hits)
+                          / float32(p.second.m_locates);
+    }
   }
 
   std::ofstream file;
@@ -76,6 +98,34 @@ void write_ray_data(const int32 width,
     file<<f_field[i]<<"\n";
   }
 
+  file<<"SCALARS locates float\n";
+  file<<"LOOKUP_TABLE default\n";
+  for(int i = 0; i < image_size; ++i)
+  {
+    file<<l_field[i]<<"\n";
+  }
+
+  file<<"SCALARS cache_hits float\n";
+  file<<"LOOKUP_TABLE default\n";
+  for(int i = 0; i < image_size; ++i)
+  {
+    file<<ch_field[i]<<"\n";
+  }
+
+  file<<"SCALARS walk_hits float\n";
+  file<<"LOOKUP_TABLE default\n";
+  for(int i = 0; i < image_size; ++i)
+  {
+    file<<wh_field[i]<<"\n";
+  }
+
+  file<<"SCALARS locate_hit_ratio float\n";
+  file<<"LOOKUP_TABLE default\n";
+  for(int i = 0; i < image_size; ++i)
+  {
+    file<<hr_field[i]<<"\n";
+  }
+
   file.close();
 #else
   (void) width;
@@ -24,12 +24,18 @@ struct Stats
   int32 m_newton_iters; // total newton iterations
   int32 m_candidates;   // number of candidates testes
   int32 m_found;        // found (1) or not (0)
+  int32 m_locates;      // point locations requested
+  int32 m_cache_hits;   // locations found in the hinted element
+  int32 m_walk_hits;    // locations found by walking to a neighbor
 
   void DRAY_EXEC construct()
   {
     m_newton_iters = 0;
     m_candidates = 0;
     m_found = 0;
+    m_locates = 0;
+    m_cache_hits = 0;
+    m_walk_hits = 0;
   }
 
   void DRAY_EXEC acc_iters(const int32 &iters)
@@ -47,6 +53,21 @@ struct Stats
     m_found = true;
   }
 
+  void DRAY_EXEC acc_locates(const int32 &locates)
+  {
+    m_locates += locates;
+  }
+
+  void DRAY_EXEC acc_cache_hits(const int32 &hits)
+  {
+    m_cache_hits += hits;
+  }
+
+  void DRAY_EXEC acc_walk_hits(const int32 &hits)
+  {
+    m_walk_hits += hits;
+  }
+
   int32 DRAY_EXEC iters()
   {
     return m_newton_iters;
@@ -58,6 +79,9 @@ struct Stats
   void DRAY_EXEC acc_iters(const int32&) { }
   void DRAY_EXEC acc_candidates(const int32&) { }
   void DRAY_EXEC found() { }
+  void DRAY_EXEC acc_locates(const int32&) { }
+  void DRAY_EXEC acc_cache_hits(const int32&) { }
+  void DRAY_EXEC acc_walk_hits(const int32&) { }
   int32 DRAY_EXEC iters() { return 0; }
 #endif
 
@@ -111,6 +111,11 @@ Filter::init(Graph *g,
         n_iface["port_names"] = DataType::empty();
     }
 
+    if( !n_iface.has_child("concurrent") )
+    {
+        n_iface["concurrent"] = "false";
+    }
+
 
     params().update(default_params());
     params().update(p);
@@ -151,6 +156,13 @@ Filter::output_port() const
     return properties()["interface/output_port"].as_string() == "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+Filter::concurrent() const
+{
+    return properties()["interface/concurrent"].as_string() == "true";
+}
+
 //-----------------------------------------------------------------------------
 bool
 Filter::has_port(const std::string &port_name) const
@@ -254,6 +266,19 @@ Filter::verify_interface(const Node &i,
         }
     }
 
+    if(i.has_child("concurrent"))
+    {
+        if(!i["concurrent"].dtype().is_string() ||
+           ( i["concurrent"].as_string() != "true" &&
+             i["concurrent"].as_string() != "false") )
+        {
+            std::string msg = "interface 'concurrent' expected "
+                              "{\"true\" | \"false\"}";
+            info["errors"].append().set(msg);
+            res = false;
+        }
+    }
+
     if(i.has_child("port_names"))
     {
         NodeConstIterator itr(&i["port_names"]);
@@ -61,6 +61,11 @@ class Graph;
 ///    // or DataType::empty() if there are no input ports.
 ///    i["port_names"].append().set("in");
 ///
+///    // optionally declare if this filter can execute concurrently with
+///    // other filters when the workspace uses more than one thread
+///    // (defaults to "false", see Workspace::set_number_of_threads())
+///    i["concurrent"] = {"true" | "false"};
+///
 ///    // Set any default parameters.
 ///    // default_params can be any conduit tree, params() will be
 ///    // inited with a *copy* of the default_params when the filter is
@@ -136,6 +141,7 @@ public:
     std::string           type_name()   const;
     const conduit::Node  &port_names()  const;
     bool                  output_port() const;
+    bool                  concurrent() const;
 
     const conduit::Node  &default_params() const;
 
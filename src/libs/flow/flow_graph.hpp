@@ -177,11 +177,16 @@ private:
 
     std::map<std::string,Filter*> &filters();
 
+    /// incremented each time filters or connections change,
+    /// used by the workspace to know when to recompile its plan
+    int                  version() const;
+
 
     Workspace                       *m_workspace;
     conduit::Node                    m_edges;
     std::map<std::string,Filter*>    m_filters;
     int                              m_filter_count;
+    int                              m_version;
 
 };
 
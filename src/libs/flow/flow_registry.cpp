@@ -18,6 +18,7 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <mutex>
 
 using namespace conduit;
 using namespace std;
@@ -119,8 +120,12 @@ public:
 
     void   reset();
 
+    // guards the registry when filters are executed concurrently
+    std::recursive_mutex &mutex();
+
 private:
 
+    std::recursive_mutex           m_mutex;
     std::map<void*,Value*>         m_values;
     std::map<std::string,Entry*>   m_entries;
 
@@ -518,6 +523,13 @@ Registry::Map::reset()
 
 
 
+//-----------------------------------------------------------------------------
+std::recursive_mutex &
+Registry::Map::mutex()
+{
+    return m_mutex;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 Registry::Registry()
@@ -538,6 +550,7 @@ Registry::~Registry()
 bool
 Registry::has_entry(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     return m_map->has_entry(key);
 }
 
@@ -545,6 +558,7 @@ Registry::has_entry(const std::string &key)
 void
 Registry::consume(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     if(m_map->has_entry(key))
     {
         m_map->dec(key);
@@ -555,6 +569,7 @@ Registry::consume(const std::string &key)
 void
 Registry::detach(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     if(m_map->has_entry(key))
     {
         m_map->detach(key);
@@ -566,6 +581,7 @@ Registry::detach(const std::string &key)
 void
 Registry::reset()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     m_map->reset();
 }
 
@@ -574,6 +590,7 @@ Registry::reset()
 void
 Registry::info(Node &out) const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     m_map->info(out);
 }
 
@@ -613,6 +630,7 @@ Registry::print() const
 Data &
 Registry::fetch(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     if(!m_map->has_entry(key))
     {
         print();
@@ -628,6 +646,7 @@ Registry::add(const std::string &key,
               Data &data,
               int refs_needed)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_map->mutex());
     if(m_map->has_entry(key))
     {
         CONDUIT_WARN("Attempt to overwrite existing entry with key: " << key);
@@ -19,6 +19,12 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -35,23 +41,46 @@ namespace flow
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
 static int g_timing_exec_count = 0;
+// guards timing output when filters are executed concurrently
+static std::mutex g_timing_mutex;
 
 //-----------------------------------------------------------------------------
 class Workspace::ExecutionPlan
 {
     public:
 
+        // one filter invocation in a compiled plan
+        struct Step
+        {
+            Filter                   *filter;
+            std::string               name;
+            int                       uref;
+            // port names and the step that feeds each port
+            std::vector<std::string>  port_names;
+            std::vector<int>          inputs;
+            // steps that consume this step's output
+            std::vector<int>          consumers;
+        };
+
+        ExecutionPlan();
+        ~ExecutionPlan();
+
         static void generate(Graph &g,
                              conduit::Node &traversals);
 
+        // flattens the traversals into an index based schedule
+        void compile(Graph &g);
+
+        const std::vector<Step> &steps() const;
+
     private:
-        ExecutionPlan();
-        ~ExecutionPlan();
 
         static void bf_topo_sort_visit(Graph &graph,
                                        const std::string &filter_name,
                                        conduit::Node &tags,
                                        conduit::Node &tarv);
+
+        std::vector<Step> m_steps;
 };
 
 //-----------------------------------------------------------------------------
@@ -148,6 +177,73 @@ Workspace::ExecutionPlan::generate(Graph &graph,
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::compile(Graph &graph)
+{
+    m_steps.clear();
+
+    Node traversals;
+    generate(graph,traversals);
+
+    std::map<std::string,int> step_ids;
+
+    // traversals are in topological order, so a filter's inputs
+    // are always assigned a step before the filter itself
+    NodeIterator travs_itr = traversals.children();
+    while(travs_itr.has_next())
+    {
+        NodeIterator trav_itr(&travs_itr.next());
+        while(trav_itr.has_next())
+        {
+            Node &t = trav_itr.next();
+
+            Step step;
+            step.name   = trav_itr.name();
+            step.filter = graph.filters()[step.name];
+            step.uref   = t.to_int32();
+
+            const Node &f_edges_in = graph.edges_in(step.name);
+            NodeConstIterator ports_itr(&step.filter->port_names());
+            while(ports_itr.has_next())
+            {
+                std::string port_name = ports_itr.next().as_string();
+                std::string f_in_name = f_edges_in[port_name].as_string();
+
+                std::map<std::string,int>::const_iterator itr;
+                itr = step_ids.find(f_in_name);
+                if(itr == step_ids.end())
+                {
+                    m_steps.clear();
+                    CONDUIT_ERROR("Filter " << step.filter->detailed_name()
+                                  << " input '" << f_in_name << "'"
+                                  << " is not part of the execution plan");
+                }
+
+                step.port_names.push_back(port_name);
+                step.inputs.push_back(itr->second);
+            }
+
+            int step_id = (int) m_steps.size();
+            step_ids[step.name] = step_id;
+
+            for(size_t i = 0; i < step.inputs.size(); i++)
+            {
+                m_steps[step.inputs[i]].consumers.push_back(step_id);
+            }
+
+            m_steps.push_back(step);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<Workspace::ExecutionPlan::Step> &
+Workspace::ExecutionPlan::steps() const
+{
+    return m_steps;
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
@@ -215,15 +311,18 @@ Workspace::Workspace()
 :m_graph(this),
  m_registry(),
  m_timing_info(),
- m_enable_timings(false)
+ m_enable_timings(false),
+ m_num_threads(1),
+ m_plan(NULL),
+ m_plan_graph_version(-1)
 {
-
+    m_plan = new ExecutionPlan();
 }
 
 //-----------------------------------------------------------------------------
 Workspace::~Workspace()
 {
-
+    delete m_plan;
 }
 
 //-----------------------------------------------------------------------------
@@ -263,91 +362,276 @@ Workspace::traversals(Node &traversals)
     ExecutionPlan::generate(graph(),traversals);
 }
 
+//-----------------------------------------------------------------------------
+void
+Workspace::update_plan()
+{
+    // only recompile when filters or connections changed
+    if(m_plan_graph_version != graph().version())
+    {
+        m_plan->compile(graph());
+        m_plan_graph_version = graph().version();
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::execute()
 {
     Timer t_total_exec;
-    Node traversals;
-    ExecutionPlan::generate(graph(),traversals);
-    // execute traversals
-    NodeIterator travs_itr = traversals.children();
+    update_plan();
 
-    while(travs_itr.has_next())
+    // execute plan
+    if(m_num_threads > 1)
     {
-        NodeIterator trav_itr(&travs_itr.next());
+        execute_concurrent();
+    }
+    else
+    {
+        execute_serial();
+    }
 
-        while(trav_itr.has_next())
+    if(m_enable_timings)
+    {
+        m_timing_info << g_timing_exec_count
+                      << " [total] "
+                      << std::fixed << t_total_exec.elapsed()
+                      <<"\n";
+        g_timing_exec_count++;
+    }
+
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::execute_serial()
+{
+    const int num_steps = (int) m_plan->steps().size();
+    for(int i = 0; i < num_steps; i++)
+    {
+        execute_step(i);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::execute_concurrent()
+{
+    const std::vector<ExecutionPlan::Step> &steps = m_plan->steps();
+    const int num_steps = (int) steps.size();
+
+    // number of inputs each step is still waiting on
+    std::vector<int> pending(num_steps);
+    // steps that must run on this thread, in plan order
+    std::vector<int> serial_steps;
+    // concurrent steps whose inputs are ready
+    std::deque<int>  ready_steps;
+
+    for(int i = 0; i < num_steps; i++)
+    {
+        pending[i] = (int) steps[i].inputs.size();
+
+        if(!steps[i].filter->concurrent())
         {
-            Node &t = trav_itr.next();
+            serial_steps.push_back(i);
+        }
+        else if(pending[i] == 0)
+        {
+            ready_steps.push_back(i);
+        }
+    }
 
-            std::string  f_name = trav_itr.name();
-            int          uref   = t.to_int32();
-            Filter      *f      = graph().filters()[f_name];
+    std::mutex              mtx;
+    std::condition_variable cv;
+    int                     num_done = 0;
+    std::exception_ptr      error;
 
-            f->reset_inputs_and_output();
+    // runs a step and updates the pending counts of its consumers,
+    // lock must be held on entry and is held on exit
+    auto run_step = [&](int id, std::unique_lock<std::mutex> &lock)
+    {
+        lock.unlock();
+        std::exception_ptr step_error;
+        try
+        {
+            execute_step(id);
+        }
+        catch(...)
+        {
+            step_error = std::current_exception();
+        }
+        lock.lock();
 
-            // fetch inputs from reg, attach to filter's ports
-            NodeConstIterator ports_itr = NodeConstIterator(&f->port_names());
-            //registry().print();
-            std::vector<std::string> f_i_names;
-            while(ports_itr.has_next())
+        if(step_error && !error)
+        {
+            error = step_error;
+        }
+
+        const std::vector<int> &consumers = steps[id].consumers;
+        for(size_t c = 0; c < consumers.size(); c++)
+        {
+            int cid = consumers[c];
+            pending[cid]--;
+            if(pending[cid] == 0 && steps[cid].filter->concurrent())
             {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                f->set_input(port_name,&registry().fetch(f_input_name));
+                ready_steps.push_back(cid);
             }
+        }
+        num_done++;
+        cv.notify_all();
+    };
 
-            Timer t_flt_exec;
-            // execute
-            f->execute();
-
-            if(m_enable_timings)
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        while(true)
+        {
+            cv.wait(lock, [&]{ return error ||
+                                      num_done == num_steps ||
+                                      !ready_steps.empty(); });
+            if(error || num_done == num_steps)
             {
-                m_timing_info << g_timing_exec_count
-                              << " " << f->name()
-                              << " " << std::fixed << t_flt_exec.elapsed()
-                              <<"\n";
+                return;
             }
+            int id = ready_steps.front();
+            ready_steps.pop_front();
+            run_step(id, lock);
+        }
+    };
 
-            // if has output, set output
-            if(f->output_port())
+    std::vector<std::thread> workers;
+    for(int i = 1; i < m_num_threads; i++)
+    {
+        workers.push_back(std::thread(worker));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        // run non-concurrent filters here, in plan order, so
+        // any collective operations they use are issued in the same
+        // order on every mpi task. help the pool while we wait.
+        for(size_t i = 0; i < serial_steps.size() && !error; i++)
+        {
+            int id = serial_steps[i];
+            while(pending[id] > 0 && !error)
             {
-                if(f->output().data_ptr() == NULL)
+                if(!ready_steps.empty())
                 {
-                    CONDUIT_ERROR("filter output is NULL, was set_output() called?");
+                    int rid = ready_steps.front();
+                    ready_steps.pop_front();
+                    run_step(rid, lock);
+                }
+                else
+                {
+                    cv.wait(lock);
                 }
-
-                registry().add(f_name,
-                               f->output(),
-                               uref);
             }
 
-            f->reset_inputs_and_output();
+            if(!error)
+            {
+                run_step(id, lock);
+            }
+        }
 
-            // consume inputs
-            ports_itr.to_front();
-            while(ports_itr.has_next())
+        // finish any remaining concurrent filters
+        while(num_done < num_steps && !error)
+        {
+            if(!ready_steps.empty())
             {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                registry().consume(f_input_name);
+                int rid = ready_steps.front();
+                ready_steps.pop_front();
+                run_step(rid, lock);
+            }
+            else
+            {
+                cv.wait(lock);
             }
         }
+        cv.notify_all();
+    }
+
+    for(size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
     }
 
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::execute_step(int step_idx)
+{
+    const std::vector<ExecutionPlan::Step> &steps = m_plan->steps();
+    const ExecutionPlan::Step &step = steps[step_idx];
+    Filter *f = step.filter;
+
+    f->reset_inputs_and_output();
+
+    // fetch inputs from reg, attach to filter's ports
+    for(size_t i = 0; i < step.inputs.size(); i++)
+    {
+        f->set_input(step.port_names[i],
+                     &registry().fetch(steps[step.inputs[i]].name));
+    }
+
+    Timer t_flt_exec;
+    // execute
+    f->execute();
+
     if(m_enable_timings)
     {
+        std::lock_guard<std::mutex> lock(g_timing_mutex);
         m_timing_info << g_timing_exec_count
-                      << " [total] "
-                      << std::fixed << t_total_exec.elapsed()
+                      << " " << step.name
+                      << " " << std::fixed << t_flt_exec.elapsed()
                       <<"\n";
-        g_timing_exec_count++;
     }
 
+    // if has output, set output
+    if(f->output_port())
+    {
+        if(f->output().data_ptr() == NULL)
+        {
+            CONDUIT_ERROR("filter output is NULL, was set_output() called?");
+        }
+
+        registry().add(step.name,
+                       f->output(),
+                       step.uref);
+    }
+
+    f->reset_inputs_and_output();
+
+    // consume inputs
+    for(size_t i = 0; i < step.inputs.size(); i++)
+    {
+        registry().consume(steps[step.inputs[i]].name);
+    }
+}
 
+//-----------------------------------------------------------------------------
+void
+Workspace::set_number_of_threads(int num_threads)
+{
+    if(num_threads < 1)
+    {
+        CONDUIT_ERROR("flow::Workspace number of threads must be >= 1"
+                      " (passed " << num_threads << ")");
+    }
+    m_num_threads = num_threads;
+}
 
+//-----------------------------------------------------------------------------
+int
+Workspace::number_of_threads() const
+{
+    return m_num_threads;
 }
+
 //-----------------------------------------------------------------------------
 
 void Workspace::enable_timings(bool enabled)
@@ -66,6 +66,16 @@ public:
     /// execute the filter graph.
     void             execute();
 
+    /// set the number of threads used to execute the filter graph.
+    /// 1 (the default) executes all filters serially in traversal order.
+    /// With more than one thread, filters that declare
+    /// i["concurrent"] = "true" run on a thread pool as soon as their
+    /// inputs are ready, while all other filters still run on the calling
+    /// thread in traversal order.
+    void             set_number_of_threads(int num_threads);
+    /// returns the number of threads used to execute the filter graph
+    int              number_of_threads() const;
+
     /// reset the registry and graph
     void             reset();
 
@@ -149,6 +159,12 @@ private:
 
     static Filter *create_filter(const std::string &filter_type);
 
+    // execute helpers
+    void update_plan();
+    void execute_serial();
+    void execute_concurrent();
+    void execute_step(int step_idx);
+
     static int  m_default_mpi_comm;
 
     class ExecutionPlan;
@@ -158,6 +174,10 @@ private:
     Registry          m_registry;
     std::stringstream m_timing_info;
     bool              m_enable_timings;
+    int               m_num_threads;
+    // compiled execution plan, rebuilt only when the graph changes
+    ExecutionPlan    *m_plan;
+    int               m_plan_graph_version;
 
 };
 
@@ -14,6 +14,9 @@
 
 // standard includes
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 
 // thirdparty includes
 #include <conduit.hpp>
@@ -28,121 +31,235 @@ namespace ascent
 {
 
 //-----------------------------------------------------------------------------
-PNGEncoder::PNGEncoder()
-:m_buffer(NULL),
- m_buffer_size(0)
-{}
-
+// -- begin ascent::detail --
 //-----------------------------------------------------------------------------
-PNGEncoder::~PNGEncoder()
+namespace detail
 {
-    Cleanup();
-}
 
 //-----------------------------------------------------------------------------
-void
-PNGEncoder::Encode(const unsigned char *rgba_in,
-                   const int width,
-                   const int height)
+// custom deflate that compresses strips of the filtered image data
+// independently (in parallel when openmp is available) and concatenates
+// them into a single deflate stream. custom_context holds the strip size.
+unsigned
+strip_deflate(unsigned char **out,
+              size_t *outsize,
+              const unsigned char *in,
+              size_t insize,
+              const lpng::LodePNGCompressSettings *settings)
 {
-    Cleanup();
+    const size_t strip_size = *static_cast<const size_t*>(settings->custom_context);
 
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
+    lpng::LodePNGCompressSettings strip_settings = *settings;
+    strip_settings.custom_deflate = NULL;
+    strip_settings.custom_context = NULL;
 
-    for (int y=0; y<height; ++y)
+    long long num_strips = (long long)((insize + strip_size - 1) / strip_size);
+    if(num_strips == 0)
     {
-        memcpy(&(rgba_flip[y*width*4]),
-               &(rgba_in[(height-y-1)*width*4]),
-               width*4);
+        num_strips = 1;
     }
 
-     unsigned error = lpng::lodepng_encode_memory(&m_buffer,
-                                            &m_buffer_size,
-                                            &rgba_flip[0],
-                                            width,
-                                            height,
-                                            lpng::LCT_RGBA, // these settings match those for
-                                            8);       // lodepng_encode32_file
+    std::vector<unsigned char*> strips(num_strips, NULL);
+    std::vector<size_t> strip_sizes(num_strips, 0);
+    std::vector<unsigned> errors(num_strips, 0);
+
+#ifdef ASCENT_OPENMP_ENABLED
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for(long long i = 0; i < num_strips; ++i)
+    {
+        size_t start = i * strip_size;
+        size_t end = std::min(start + strip_size, insize);
+        // only the last strip is marked final, the others end byte aligned
+        errors[i] = lpng::lodepng_deflate_chunk(&strips[i],
+                                                &strip_sizes[i],
+                                                in + start,
+                                                end - start,
+                                                &strip_settings,
+                                                i == num_strips - 1);
+    }
 
-    delete [] rgba_flip;
+    unsigned error = 0;
+    size_t total_size = 0;
+    for(long long i = 0; i < num_strips; ++i)
+    {
+        if(errors[i] != 0 && error == 0)
+        {
+            error = errors[i];
+        }
+        total_size += strip_sizes[i];
+    }
 
-    if(error)
+    if(error == 0)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed")
+        // lodepng frees the result with free()
+        unsigned char *res = (unsigned char*)malloc(total_size);
+        if(res == NULL)
+        {
+            // lodepng's memory allocation failed code
+            error = 83;
+        }
+        else
+        {
+            size_t offset = 0;
+            for(long long i = 0; i < num_strips; ++i)
+            {
+                memcpy(res + offset, strips[i], strip_sizes[i]);
+                offset += strip_sizes[i];
+            }
+            *out = res;
+            *outsize = total_size;
+        }
+    }
+
+    for(long long i = 0; i < num_strips; ++i)
+    {
+        free(strips[i]);
     }
+
+    return error;
 }
 
 //-----------------------------------------------------------------------------
+// converts rgba values in [0,1] to bytes, optionally flipping rows
+// (our images are upside down relative to what lodepng wants)
+template<typename T>
 void
-PNGEncoder::Encode(const float *rgba_in,
-                   const int width,
-                   const int height)
+to_rgba8(const T *rgba_in,
+         unsigned char *rgba_out,
+         const int width,
+         const int height,
+         const bool flip)
 {
-    Cleanup();
-
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
-
-
-    for(int x = 0; x < width; ++x)
+#ifdef ASCENT_OPENMP_ENABLED
+    #pragma omp parallel for
+#endif
+    for(int y = 0; y < height; ++y)
+    {
+        const T *in_row = rgba_in + (size_t)y * width * 4;
+        const int out_y = flip ? height - y - 1 : y;
+        unsigned char *out_row = rgba_out + (size_t)out_y * width * 4;
+        for(int i = 0; i < width * 4; ++i)
+        {
+            out_row[i] = (unsigned char)(in_row[i] * T(255));
+        }
+    }
+}
 
+//-----------------------------------------------------------------------------
+// converts a single channel with values in [0,1] to opaque gray rgba bytes
+template<typename T>
+void
+channel_to_rgba8(const T *buffer_in,
+                 unsigned char *rgba_out,
+                 const int width,
+                 const int height,
+                 const bool flip)
+{
 #ifdef ASCENT_OPENMP_ENABLED
-        #pragma omp parrallel for
+    #pragma omp parallel for
 #endif
-        for (int y = 0; y < height; ++y)
+    for(int y = 0; y < height; ++y)
+    {
+        const T *in_row = buffer_in + (size_t)y * width;
+        const int out_y = flip ? height - y - 1 : y;
+        unsigned char *out_row = rgba_out + (size_t)out_y * width * 4;
+        for(int x = 0; x < width; ++x)
         {
-            int inOffset = (y * width + x) * 4;
-            int outOffset = ((height - y - 1) * width + x) * 4;
-            rgba_flip[outOffset + 0] = (unsigned char)(rgba_in[inOffset + 0] * 255.f);
-            rgba_flip[outOffset + 1] = (unsigned char)(rgba_in[inOffset + 1] * 255.f);
-            rgba_flip[outOffset + 2] = (unsigned char)(rgba_in[inOffset + 2] * 255.f);
-            rgba_flip[outOffset + 3] = (unsigned char)(rgba_in[inOffset + 3] * 255.f);
+            const unsigned char value = (unsigned char)(in_row[x] * T(255));
+            out_row[x * 4 + 0] = value;
+            out_row[x * 4 + 1] = value;
+            out_row[x * 4 + 2] = value;
+            out_row[x * 4 + 3] = 255;
         }
+    }
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
 
-     unsigned error = lpng::lodepng_encode_memory(&m_buffer,
-                                            &m_buffer_size,
-                                            &rgba_flip[0],
-                                            width,
-                                            height,
-                                            lpng::LCT_RGBA, // these settings match those for
-                                            8);       // lodepng_encode32_file
+PNGEncoder::PNGEncoder()
+:m_buffer(NULL),
+ m_buffer_size(0),
+ m_compression_level(-1),
+ m_filter_strategy(FILTER_DEFAULT),
+ m_strip_size(0),
+ m_flip_y(true)
+{}
 
-    delete [] rgba_flip;
+PNGEncoder::~PNGEncoder()
+{
+    Cleanup();
+}
 
-    if(error)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::SetCompressionLevel(const int level)
+{
+    if(level < -1 || level > 9)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed");
+        CONDUIT_ERROR("PNGEncoder compression level must be in [-1,9], "
+                      "got " << level);
     }
+    m_compression_level = level;
 }
 
 //-----------------------------------------------------------------------------
 void
-PNGEncoder::Encode(const double *rgba_in,
-                   const int width,
-                   const int height)
+PNGEncoder::SetFilterStrategy(const FilterStrategy strategy)
 {
-  unsigned char *rgba = new unsigned char[width * height *4];
+    m_filter_strategy = strategy;
+}
 
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::SetStripSize(const size_t strip_size)
+{
+    m_strip_size = strip_size;
+}
 
-  for(int x = 0; x < width; ++x)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::SetFlipY(const bool flip)
+{
+    m_flip_y = flip;
+}
 
-#ifdef ASCENT_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-    for (int y = 0; y < height; ++y)
-    {
-      int offset = (y * width + x) * 4;
-      rgba[offset + 0] = (unsigned char)(rgba_in[offset + 0] * 255.);
-      rgba[offset + 1] = (unsigned char)(rgba_in[offset + 1] * 255.);
-      rgba[offset + 2] = (unsigned char)(rgba_in[offset + 2] * 255.);
-      rgba[offset + 3] = (unsigned char)(rgba_in[offset + 3] * 255.);
-    }
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const unsigned char *rgba_in,
+                   const int width,
+                   const int height)
+{
+    Cleanup();
+    EncodeBytes(rgba_in, width, height, std::vector<std::string>(), false);
+}
 
-  Encode(rgba, width, height);
-  delete[] rgba;
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const float *rgba_in,
+                   const int width,
+                   const int height)
+{
+    Cleanup();
+    std::vector<unsigned char> rgba(width * height * 4);
+    detail::to_rgba8(rgba_in, &rgba[0], width, height, m_flip_y);
+    EncodeRGBA8(&rgba[0], width, height, std::vector<std::string>(), false);
 }
 
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const double *rgba_in,
+                   const int width,
+                   const int height)
+{
+    Cleanup();
+    std::vector<unsigned char> rgba(width * height * 4);
+    detail::to_rgba8(rgba_in, &rgba[0], width, height, m_flip_y);
+    EncodeRGBA8(&rgba[0], width, height, std::vector<std::string>(), false);
+}
 
 //-----------------------------------------------------------------------------
 void
@@ -150,25 +267,10 @@ PNGEncoder::EncodeChannel(const double *buffer_in,
                           const int width,
                           const int height)
 {
-
-  unsigned char *rgba = new unsigned char[width * height *4];
-
-  for(int x = 0; x < width; ++x)
-
-#ifdef ASCENT_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-    for (int y = 0; y < height; ++y)
-    {
-      int offset = (y * width + x);
-      rgba[offset + 0] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 1] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 2] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 3] = 255;
-    }
-
-  Encode(rgba, width, height);
-  delete[] rgba;
+    Cleanup();
+    std::vector<unsigned char> rgba(width * height * 4);
+    detail::channel_to_rgba8(buffer_in, &rgba[0], width, height, m_flip_y);
+    EncodeRGBA8(&rgba[0], width, height, std::vector<std::string>(), false);
 }
 
 //-----------------------------------------------------------------------------
@@ -177,25 +279,10 @@ PNGEncoder::EncodeChannel(const float *buffer_in,
                           const int width,
                           const int height)
 {
-
-  unsigned char *rgba = new unsigned char[width * height *4];
-
-  for(int x = 0; x < width; ++x)
-
-#ifdef ASCENT_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-    for (int y = 0; y < height; ++y)
-    {
-      int offset = (y * width + x);
-      rgba[offset + 0] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 1] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 2] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 3] = 255;
-    }
-
-  Encode(rgba, width, height);
-  delete[] rgba;
+    Cleanup();
+    std::vector<unsigned char> rgba(width * height * 4);
+    detail::channel_to_rgba8(buffer_in, &rgba[0], width, height, m_flip_y);
+    EncodeRGBA8(&rgba[0], width, height, std::vector<std::string>(), false);
 }
 
 //-----------------------------------------------------------------------------
@@ -206,51 +293,40 @@ PNGEncoder::Encode(const unsigned char *rgba_in,
                    const std::vector<std::string> &comments)
 {
     Cleanup();
+    // use less aggressive compression by default
+    EncodeBytes(rgba_in, width, height, comments, true);
+}
 
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
-
-    for (int y=0; y<height; ++y)
-    {
-        memcpy(&(rgba_flip[y*width*4]),
-               &(rgba_in[(height-y-1)*width*4]),
-               width*4);
-    }
- 
-    lpng::LodePNGState state;
-    lpng::lodepng_state_init(&state);
-    // use less aggressive compression
-    state.encoder.zlibsettings.btype = 2;
-    state.encoder.zlibsettings.use_lz77 = 0;
-    if(comments.size() % 2 != 0)
-    {
-        CONDUIT_INFO("PNGEncoder::Encode comments missing value for the last key.\n"
-                     << "Ignoring the last key.\n");
-    }
-    if(comments.size() > 1)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::EncodeBytes(const unsigned char *rgba_in,
+                        const int width,
+                        const int height,
+                        const std::vector<std::string> &comments,
+                        const bool huffman_only)
+{
+    if(!m_flip_y)
     {
-        lpng::lodepng_info_init(&state.info_png);
-        // Comments are in pairs with a key and a value, using
-        // comments.size()-1 ensures that we don't use the last
-        // comment if the length of the vector isn't a multiple of 2.
-        for (int i = 0; i < comments.size()-1; i += 2)
-            lpng::lodepng_add_text(&state.info_png, comments[i].c_str(),
-                                                    comments[i+1].c_str());
+        // rows are already in the order lodepng wants, no copy needed
+        EncodeRGBA8(rgba_in, width, height, comments, huffman_only);
+        return;
     }
 
-    unsigned error = lodepng_encode(&m_buffer,
-                                    &m_buffer_size,
-                                    &rgba_flip[0],
-                                    width,
-                                    height,
-                                    &state);
-
-    delete [] rgba_flip;
+    // upside down relative to what lodepng wants
+    std::vector<unsigned char> rgba_flip(width * height * 4);
+    const size_t row_size = (size_t)width * 4;
 
-    if(error)
+#ifdef ASCENT_OPENMP_ENABLED
+    #pragma omp parallel for
+#endif
+    for (int y=0; y<height; ++y)
     {
-       CONDUIT_WARN("lodepng_encode_memory failed");
+        memcpy(&(rgba_flip[y*row_size]),
+               &(rgba_in[(height-y-1)*row_size]),
+               row_size);
     }
+
+    EncodeRGBA8(&rgba_flip[0], width, height, comments, huffman_only);
 }
 
 //-----------------------------------------------------------------------------
@@ -261,31 +337,73 @@ PNGEncoder::Encode(const float *rgba_in,
                    const std::vector<std::string> &comments)
 {
     Cleanup();
+    std::vector<unsigned char> rgba(width * height * 4);
+    detail::to_rgba8(rgba_in, &rgba[0], width, height, m_flip_y);
+    // use less aggressive compression by default
+    EncodeRGBA8(&rgba[0], width, height, comments, true);
+}
 
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
-
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::EncodeRGBA8(const unsigned char *rgba,
+                        const int width,
+                        const int height,
+                        const std::vector<std::string> &comments,
+                        const bool huffman_only)
+{
+    lpng::LodePNGState state;
+    lpng::lodepng_state_init(&state);
 
-    for(int x = 0; x < width; ++x)
+    lpng::LodePNGCompressSettings &zlib = state.encoder.zlibsettings;
+    if(huffman_only)
+    {
+        zlib.btype = 2;
+        zlib.use_lz77 = 0;
+    }
 
-#ifdef ASCENT_OPENMP_ENABLED
-        #pragma omp parallel for
-#endif
-        for (int y = 0; y < height; ++y)
+    if(m_compression_level == 0)
+    {
+        // store, no compression
+        zlib.btype = 0;
+    }
+    else if(m_compression_level == 1)
+    {
+        // huffman coding only
+        zlib.btype = 2;
+        zlib.use_lz77 = 0;
+    }
+    else if(m_compression_level > 1)
+    {
+        // lz77 with a window from 512 (level 2) to 32768 (level 8+)
+        zlib.btype = 2;
+        zlib.use_lz77 = 1;
+        zlib.windowsize = 1u << std::min(m_compression_level + 7, 15);
+        zlib.lazymatching = m_compression_level >= 4 ? 1 : 0;
+        if(m_compression_level == 9)
         {
-            int inOffset = (y * width + x) * 4;
-            int outOffset = ((height - y - 1) * width + x) * 4;
-            rgba_flip[outOffset + 0] = (unsigned char)(rgba_in[inOffset + 0] * 255.f);
-            rgba_flip[outOffset + 1] = (unsigned char)(rgba_in[inOffset + 1] * 255.f);
-            rgba_flip[outOffset + 2] = (unsigned char)(rgba_in[inOffset + 2] * 255.f);
-            rgba_flip[outOffset + 3] = (unsigned char)(rgba_in[inOffset + 3] * 255.f);
+            zlib.nicematch = 258;
         }
+    }
+
+    if(m_filter_strategy == FILTER_NONE)
+    {
+        state.encoder.filter_strategy = lpng::LFS_ZERO;
+    }
+    else if(m_filter_strategy == FILTER_MINSUM)
+    {
+        state.encoder.filter_strategy = lpng::LFS_MINSUM;
+    }
+    else if(m_filter_strategy == FILTER_ENTROPY)
+    {
+        state.encoder.filter_strategy = lpng::LFS_ENTROPY;
+    }
+
+    if(m_strip_size > 0)
+    {
+        zlib.custom_deflate = detail::strip_deflate;
+        zlib.custom_context = &m_strip_size;
+    }
 
-    lpng::LodePNGState state;
-    lpng::lodepng_state_init(&state);
-    // use less aggressive compression
-    state.encoder.zlibsettings.btype = 2;
-    state.encoder.zlibsettings.use_lz77 = 0;
     if(comments.size() % 2 != 0)
     {
         CONDUIT_INFO("PNGEncoder::Encode comments missing value for the last key.\n"
@@ -293,7 +411,6 @@ PNGEncoder::Encode(const float *rgba_in,
     }
     if(comments.size() > 1)
     {
-        vtkh:lodepng_info_init(&state.info_png);
         // Comments are in pairs with a key and a value, using
         // comments.size()-1 ensures that we don't use the last
         // comment if the length of the vector isn't a multiple of 2.
@@ -302,18 +419,18 @@ PNGEncoder::Encode(const float *rgba_in,
                                                     comments[i+1].c_str());
     }
 
-    unsigned error = lodepng_encode(&m_buffer,
-                                    &m_buffer_size,
-                                    &rgba_flip[0],
-                                    width,
-                                    height,
-                                    &state);
+    unsigned error = lpng::lodepng_encode(&m_buffer,
+                                          &m_buffer_size,
+                                          rgba,
+                                          width,
+                                          height,
+                                          &state);
 
-    delete [] rgba_flip;
+    lpng::lodepng_state_cleanup(&state);
 
     if(error)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed");
+        CONDUIT_WARN("lodepng_encode failed");
     }
 }
 
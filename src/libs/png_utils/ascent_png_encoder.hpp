@@ -16,6 +16,7 @@
 
 #include <conduit.hpp>
 #include <string>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -26,9 +27,32 @@ namespace ascent
 class ASCENT_API PNGEncoder
 {
 public:
+    // png filter applied to each row before compression
+    enum FilterStrategy
+    {
+        FILTER_DEFAULT, // lodepng's default (minsum)
+        FILTER_NONE,    // fastest
+        FILTER_MINSUM,
+        FILTER_ENTROPY
+    };
+
     PNGEncoder();
     ~PNGEncoder();
 
+    // -1 uses the default settings for each Encode call,
+    //  0 stores the image without compression (fastest),
+    //  1 only uses huffman coding,
+    //  2-9 add lz77 with increasing window sizes
+    void           SetCompressionLevel(const int level);
+    void           SetFilterStrategy(const FilterStrategy strategy);
+    // when > 0, the image data is split into strips of strip_size
+    // bytes that are compressed in parallel and concatenated
+    // into a single deflate stream. 0 (default) disables strips.
+    void           SetStripSize(const size_t strip_size);
+    // input images are bottom to top by default, if false rows
+    // are used as is (unsigned char input is encoded without a copy)
+    void           SetFlipY(const bool flip);
+
     void           Encode(const unsigned char *rgba_in,
                           const int width,
                           const int height);
@@ -71,9 +95,25 @@ public:
     void           Cleanup();
 
 private:
+    void           EncodeBytes(const unsigned char *rgba_in,
+                               const int width,
+                               const int height,
+                               const std::vector<std::string> &comments,
+                               const bool huffman_only);
+
+    void           EncodeRGBA8(const unsigned char *rgba,
+                               const int width,
+                               const int height,
+                               const std::vector<std::string> &comments,
+                               const bool huffman_only);
+
     unsigned char *m_buffer;
     size_t         m_buffer_size;
     conduit::Node  m_base64_data;
+    int            m_compression_level;
+    FilterStrategy m_filter_strategy;
+    size_t         m_strip_size;
+    bool           m_flip_y;
 };
 
 //-----------------------------------------------------------------------------
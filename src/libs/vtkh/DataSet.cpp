@@ -6,6 +6,7 @@
 // FIXME:UDA: vtkm_dataset_info depends on vtkm::rendering
 #include <vtkh/utils/vtkm_dataset_info.hpp>
 // std includes
+#include <algorithm>
 #include <limits>
 #include <sstream>
 //vtkm includes
@@ -97,6 +98,313 @@ void MemSet(vtkm::cont::ArrayHandle<T> &array, const T value, const vtkm::Id num
     .Invoke(array);
 }
 
+//
+// ids used to exchange field associations between ranks
+//
+int AssociationId(const vtkm::cont::Field::Association assoc)
+{
+  int assoc_id = -1;
+  if(assoc == vtkm::cont::Field::Association::Any)
+  {
+    assoc_id = 0;
+  }
+  else if(assoc == vtkm::cont::Field::Association::WholeDataSet)
+  {
+    assoc_id = 1;
+  }
+  else if(assoc == vtkm::cont::Field::Association::Points)
+  {
+    assoc_id = 2;
+  }
+  else if(assoc == vtkm::cont::Field::Association::Cells)
+  {
+    assoc_id = 3;
+  }
+  return assoc_id;
+}
+
+//
+// Layout of the fused summary reduction. The first SUMMARY_SUMS
+// entries are summed, the rest are reduced with max, so minimums
+// are stored negated.
+//
+enum SummaryHeader
+{
+  SUMMARY_CELLS = 0,
+  SUMMARY_DOMAINS,
+  SUMMARY_NEG_X_MIN,
+  SUMMARY_X_MAX,
+  SUMMARY_NEG_Y_MIN,
+  SUMMARY_Y_MAX,
+  SUMMARY_NEG_Z_MIN,
+  SUMMARY_Z_MAX,
+  SUMMARY_BOUNDS_FAILED,
+  SUMMARY_HASH_MAX,
+  SUMMARY_NEG_HASH_MIN,
+  SUMMARY_LENGTH_MAX,
+  SUMMARY_NEG_LENGTH_MIN,
+  SUMMARY_RANGES_MAX,
+  SUMMARY_SIZE
+};
+
+const int SUMMARY_SUMS = 2;
+
+#ifdef VTKH_PARALLEL
+void SummaryReduce(void *in, void *inout, int *len, MPI_Datatype *)
+{
+  const double *a = static_cast<const double*>(in);
+  double *b = static_cast<double*>(inout);
+  for(int i = 0; i < *len; ++i)
+  {
+    for(int h = 0; h < SUMMARY_SIZE; ++h)
+    {
+      const int idx = i * SUMMARY_SIZE + h;
+      b[idx] = h < SUMMARY_SUMS ? a[idx] + b[idx] : std::max(a[idx], b[idx]);
+    }
+  }
+}
+
+void ReduceSummaryHeader(double header[SUMMARY_SIZE])
+{
+  // the header is one element of a contiguous type, so the
+  // op always sees whole headers even if MPI splits the buffer
+  static MPI_Datatype header_type = MPI_DATATYPE_NULL;
+  static MPI_Op header_op = MPI_OP_NULL;
+  if(header_op == MPI_OP_NULL)
+  {
+    MPI_Type_contiguous(SUMMARY_SIZE, MPI_DOUBLE, &header_type);
+    MPI_Type_commit(&header_type);
+    MPI_Op_create(SummaryReduce, 1, &header_op);
+  }
+
+  double global_header[SUMMARY_SIZE];
+  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
+  MPI_Allreduce(header, global_header, 1, header_type, header_op, mpi_comm);
+  std::copy(global_header, global_header + SUMMARY_SIZE, header);
+}
+#endif
+
+struct LocalField
+{
+  int                      m_association;
+  vtkm::Id                 m_num_components;
+  // -1 if the range could not be computed, -2 if domains disagree
+  vtkm::Id                 m_num_ranges;
+  std::vector<vtkm::Range> m_ranges;
+};
+
+void LocalFields(const std::vector<vtkm::cont::DataSet> &domains,
+                 std::map<std::string, LocalField> &fields)
+{
+  const size_t num_domains = domains.size();
+  for(size_t i = 0; i < num_domains; ++i)
+  {
+    const vtkm::IdComponent num_fields = domains[i].GetNumberOfFields();
+    for(vtkm::IdComponent f = 0; f < num_fields; ++f)
+    {
+      const vtkm::cont::Field &field = domains[i].GetField(f);
+
+      std::vector<vtkm::Range> ranges;
+      vtkm::Id num_ranges = -1;
+      try
+      {
+        vtkm::cont::ArrayHandle<vtkm::Range> range = field.GetRange();
+        num_ranges = range.GetNumberOfValues();
+        auto portal = range.ReadPortal();
+        for(vtkm::Id c = 0; c < num_ranges; ++c)
+        {
+          ranges.push_back(portal.Get(c));
+        }
+      }
+      catch(const vtkm::cont::Error &)
+      {
+        num_ranges = -1;
+      }
+
+      auto it = fields.find(field.GetName());
+      if(it == fields.end())
+      {
+        // the first domain with the field decides the association
+        // and number of components, like GetFieldAssociation did
+        LocalField local;
+        local.m_association = AssociationId(field.GetAssociation());
+        local.m_num_components = field.GetData().GetNumberOfComponentsFlat();
+        local.m_num_ranges = num_ranges;
+        local.m_ranges = ranges;
+        fields[field.GetName()] = local;
+        continue;
+      }
+
+      LocalField &local = it->second;
+      if(local.m_num_ranges == -2)
+      {
+        continue;
+      }
+      if(num_ranges == -1 || local.m_num_ranges == -1)
+      {
+        local.m_num_ranges = -1;
+        continue;
+      }
+      if(num_ranges != local.m_num_ranges)
+      {
+        local.m_num_ranges = -2;
+        continue;
+      }
+      for(vtkm::Id c = 0; c < num_ranges; ++c)
+      {
+        local.m_ranges[c].Include(ranges[c]);
+      }
+    }
+  }
+}
+
+//
+// a field list that every rank can parse: the length of the name,
+// the name, the association, components and number of ranges
+//
+std::string DescribeFields(const std::map<std::string, LocalField> &fields)
+{
+  std::stringstream ss;
+  for(auto &field : fields)
+  {
+    ss<<field.first.size()<<" "<<field.first<<" "
+      <<field.second.m_association<<" "
+      <<field.second.m_num_components<<" "
+      <<field.second.m_num_ranges<<"\n";
+  }
+  return ss.str();
+}
+
+double HashFields(const std::string &description)
+{
+  // 32 bit FNV-1a, exactly representable as a double
+  vtkm::UInt32 hash = 2166136261u;
+  for(const char c : description)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return static_cast<double>(hash);
+}
+
+void MergeFields(const std::string &description,
+                 std::map<std::string, DataSet::GlobalField> &fields)
+{
+  std::stringstream ss(description);
+  size_t name_size;
+  while(ss>>name_size)
+  {
+    // skip the separator
+    ss.get();
+    std::string name(name_size, ' ');
+    ss.read(&name[0], name_size);
+    int assoc;
+    vtkm::Id num_components;
+    vtkm::Id num_ranges;
+    ss>>assoc>>num_components>>num_ranges;
+
+    auto it = fields.find(name);
+    if(it == fields.end())
+    {
+      DataSet::GlobalField field;
+      field.m_association = assoc;
+      field.m_num_components = num_components;
+      field.m_num_ranges = std::max(num_ranges, vtkm::Id(-1));
+      field.m_association_conflict = false;
+      field.m_range_conflict = num_ranges == -2;
+      fields[name] = field;
+      continue;
+    }
+
+    DataSet::GlobalField &field = it->second;
+    if(assoc != -1)
+    {
+      if(field.m_association == -1)
+      {
+        field.m_association = assoc;
+      }
+      else if(field.m_association != assoc)
+      {
+        field.m_association_conflict = true;
+      }
+    }
+    field.m_num_components = std::max(field.m_num_components, num_components);
+
+    if(num_ranges == -2)
+    {
+      field.m_range_conflict = true;
+    }
+    else if(num_ranges == -1 || field.m_num_ranges == -1)
+    {
+      field.m_num_ranges = -1;
+    }
+    else if(num_ranges != field.m_num_ranges)
+    {
+      field.m_range_conflict = true;
+    }
+  }
+}
+
+//
+// appends (-min, max) of every component of every global field with a
+// known range, ranks without the field contribute -inf
+//
+void PackRanges(const std::map<std::string, LocalField> &local_fields,
+                const std::map<std::string, DataSet::GlobalField> &fields,
+                std::vector<double> &buffer)
+{
+  const double lowest = vtkm::NegativeInfinity64();
+  for(auto &global : fields)
+  {
+    const DataSet::GlobalField &field = global.second;
+    if(field.m_range_conflict || field.m_num_ranges <= 0)
+    {
+      continue;
+    }
+    auto local = local_fields.find(global.first);
+    const bool has_field = local != local_fields.end() &&
+                           local->second.m_num_ranges == field.m_num_ranges;
+    for(vtkm::Id c = 0; c < field.m_num_ranges; ++c)
+    {
+      buffer.push_back(has_field ? -local->second.m_ranges[c].Min : lowest);
+      buffer.push_back(has_field ? local->second.m_ranges[c].Max : lowest);
+    }
+  }
+}
+
+void UnpackRanges(const double *buffer,
+                  std::map<std::string, DataSet::GlobalField> &fields)
+{
+  for(auto &global : fields)
+  {
+    DataSet::GlobalField &field = global.second;
+    if(field.m_range_conflict || field.m_num_ranges <= 0)
+    {
+      continue;
+    }
+    field.m_ranges.resize(field.m_num_ranges);
+    for(vtkm::Id c = 0; c < field.m_num_ranges; ++c)
+    {
+      field.m_ranges[c] = vtkm::Range(-buffer[0], buffer[1]);
+      buffer += 2;
+    }
+  }
+}
+
+vtkm::Id NumberOfRangeValues(const std::map<std::string, DataSet::GlobalField> &fields)
+{
+  vtkm::Id count = 0;
+  for(auto &global : fields)
+  {
+    const DataSet::GlobalField &field = global.second;
+    if(!field.m_range_conflict && field.m_num_ranges > 0)
+    {
+      count += 2 * field.m_num_ranges;
+    }
+  }
+  return count;
+}
+
 } // namespace detail
 
 bool
@@ -118,6 +426,7 @@ DataSet::AddDomain(vtkm::cont::DataSet data_set, vtkm::Id domain_id)
   assert(m_domains.size() == m_domain_ids.size());
   m_domains.push_back(data_set);
   m_domain_ids.push_back(domain_id);
+  InvalidateGlobalSummary();
 }
 
 vtkm::cont::Field
@@ -193,41 +502,13 @@ DataSet::GetNumberOfCells() const
 vtkm::Id
 DataSet::GetGlobalNumberOfCells() const
 {
-  vtkm::Id num_cells = GetNumberOfCells();;
-#ifdef VTKH_PARALLEL
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  long long int local_cells = static_cast<long long int>(num_cells);
-  long long int global_cells = 0;
-  MPI_Allreduce(&local_cells,
-                &global_cells,
-                1,
-                MPI_LONG_LONG,
-                MPI_SUM,
-                mpi_comm);
-  num_cells = global_cells;
-#endif
-  return num_cells;
+  return GetGlobalSummary().m_num_cells;
 }
 
-
-
 vtkm::Id
 DataSet::GetGlobalNumberOfDomains() const
 {
-  vtkm::Id domains = this->GetNumberOfDomains();
-#ifdef VTKH_PARALLEL
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  int local_doms = static_cast<int>(domains);
-  int global_doms = 0;
-  MPI_Allreduce(&local_doms,
-                &global_doms,
-                1,
-                MPI_INT,
-                MPI_SUM,
-                mpi_comm);
-  domains = global_doms;
-#endif
-  return domains;
+  return GetGlobalSummary().m_num_domains;
 }
 
 vtkm::Bounds
@@ -273,6 +554,15 @@ DataSet::GetBounds(vtkm::Id coordinate_system_index) const
 vtkm::Bounds
 DataSet::GetGlobalBounds(vtkm::Id coordinate_system_index) const
 {
+  if(coordinate_system_index == 0)
+  {
+    const GlobalSummary &summary = GetGlobalSummary();
+    if(summary.m_has_bounds)
+    {
+      return summary.m_bounds;
+    }
+  }
+
   VTKH_DATA_OPEN("GetGlobalBounds");
   vtkm::Bounds bounds;
   bounds = GetBounds(coordinate_system_index);
@@ -400,8 +690,37 @@ DataSet::GetRange(const std::string &field_name) const
 vtkm::cont::ArrayHandle<vtkm::Range>
 DataSet::GetGlobalRange(const std::string &field_name) const
 {
-  VTKH_DATA_OPEN("GetGlobalRange");
   vtkm::cont::ArrayHandle<vtkm::Range> range;
+  const GlobalSummary &summary = GetGlobalSummary();
+  auto it = summary.m_fields.find(field_name);
+  if(it == summary.m_fields.end())
+  {
+    return range;
+  }
+
+  const GlobalField &field = it->second;
+  if(field.m_range_conflict)
+  {
+    std::stringstream msg;
+    msg<<"GetRange call failed. The number of components in field "
+       <<field_name<<" does not match across domains or ranks";
+    throw Error(msg.str());
+  }
+
+  if(field.m_num_ranges >= 0)
+  {
+    range.Allocate(field.m_num_ranges);
+    auto portal = range.WritePortal();
+    for(vtkm::Id c = 0; c < field.m_num_ranges; ++c)
+    {
+      portal.Set(c, field.m_ranges[c]);
+    }
+    return range;
+  }
+
+  // some rank could not compute the range up front,
+  // let the reduction below report the error
+  VTKH_DATA_OPEN("GetGlobalRange");
   range = GetRange(field_name);
 
 #ifdef VTKH_PARALLEL
@@ -529,9 +848,7 @@ DataSet::IsEmpty() const
 bool
 DataSet::GlobalIsEmpty() const
 {
-  bool is_empty = IsEmpty();
-  is_empty = detail::GlobalAgreement(is_empty);
-  return is_empty;
+  return GetGlobalSummary().m_num_cells == 0;
 }
 
 bool
@@ -642,10 +959,30 @@ DataSet::GetTime() const
 }
 
 DataSet::DataSet()
-  : m_cycle(0), m_time(0)
+  : m_cycle(0), m_time(0), m_has_global_summary(false)
 {
 }
 
+DataSet::DataSet(const DataSet &other)
+  : m_domains(other.m_domains),
+    m_domain_ids(other.m_domain_ids),
+    m_cycle(other.m_cycle),
+    m_time(other.m_time),
+    m_has_global_summary(false)
+{
+}
+
+DataSet&
+DataSet::operator=(const DataSet &other)
+{
+  m_domains = other.m_domains;
+  m_domain_ids = other.m_domain_ids;
+  m_cycle = other.m_cycle;
+  m_time = other.m_time;
+  InvalidateGlobalSummary();
+  return *this;
+}
+
 DataSet::~DataSet()
 {
 }
@@ -690,6 +1027,7 @@ DataSet::AddConstantPointField(const vtkm::Float32 value, const std::string fiel
     vtkm::cont::Field field(fieldname, vtkm::cont::Field::Association::Points, array);
     m_domains[i].AddField(field);
   }
+  InvalidateGlobalSummary();
 }
 
 bool
@@ -737,120 +1075,37 @@ DataSet::RemoveField(const std::string &field_name)
         m_domains[i] = domain_new;
     }
   }
+  InvalidateGlobalSummary();
 }
 
 bool
 DataSet::GlobalFieldExists(const std::string &field_name) const
 {
-  bool exists = FieldExists(field_name);
-#ifdef VTKH_PARALLEL
-  int local_boolean = exists ? 1 : 0;
-  int global_boolean;
-
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Allreduce((void *)(&local_boolean),
-                (void *)(&global_boolean),
-                1,
-                MPI_INT,
-                MPI_SUM,
-                mpi_comm);
-
-
-  if(global_boolean > 0)
-  {
-    exists = true;
-  }
-  else
-  {
-    // this is technically not needed but added for clarity
-    exists = false;
-  }
-#endif
-  return exists;
+  const GlobalSummary &summary = GetGlobalSummary();
+  return summary.m_fields.find(field_name) != summary.m_fields.end();
 }
 
 vtkm::cont::Field::Association
 DataSet::GetFieldAssociation(const std::string field_name, bool &valid_field) const
 {
   valid_field = true;
-  if(!this->GlobalFieldExists(field_name))
+  const GlobalSummary &summary = GetGlobalSummary();
+  auto it = summary.m_fields.find(field_name);
+  if(it == summary.m_fields.end())
   {
     valid_field = false;
     return vtkm::cont::Field::Association::Any;
   }
 
-  int assoc_id = -1;
-  if(this->FieldExists(field_name))
+  if(it->second.m_association_conflict)
   {
-    const size_t num_domains = m_domains.size();
-    vtkm::Bounds bounds;
-
-    vtkm::cont::Field::Association local_assoc;
-    for(size_t i = 0; i < num_domains; ++i)
-    {
-      vtkm::cont::DataSet dom = m_domains[i];
-      if(dom.HasField(field_name))
-      {
-        local_assoc = dom.GetField(field_name).GetAssociation();
-        if(local_assoc == vtkm::cont::Field::Association::Any)
-        {
-          assoc_id = 0;
-        }
-        else if ( local_assoc == vtkm::cont::Field::Association::WholeDataSet)
-        {
-          assoc_id = 1;
-        }
-        else if ( local_assoc == vtkm::cont::Field::Association::Points)
-        {
-          assoc_id = 2;
-        }
-        else if ( local_assoc == vtkm::cont::Field::Association::Cells)
-        {
-          assoc_id = 3;
-        }
-        break;
-      }
-    }
-  }
-
-#ifdef VTKH_PARALLEL
-
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-
-
-  int *global_assocs = new int[vtkh::GetMPISize()];
-
-  MPI_Allgather(&assoc_id,
-                1,
-                MPI_INT,
-                global_assocs,
-                1,
-                MPI_INT,
-                mpi_comm);
-
-  int id = -1;
-
-  for(int i = 0; i < vtkh::GetMPISize(); ++i)
-  {
-    if(global_assocs[i] != -1)
-    {
-      if(id != -1 && global_assocs[i] != id)
-      {
-        std::stringstream msg;
-        msg<<"field "<< field_name
-           <<" has inconsistent associations";;
-        throw Error(msg.str());
-      }
-      else
-      {
-        id = std::max(id, global_assocs[i]);
-      }
-    }
+    std::stringstream msg;
+    msg<<"field "<< field_name
+       <<" has inconsistent associations";
+    throw Error(msg.str());
   }
-  assoc_id = id;
-  delete[] global_assocs;
-#endif
 
+  const int assoc_id = it->second.m_association;
   vtkm::cont::Field::Association assoc;
 
   if(assoc_id == 0)
@@ -878,32 +1133,181 @@ DataSet::GetFieldAssociation(const std::string field_name, bool &valid_field) co
 
 vtkm::Id DataSet::NumberOfComponents(const std::string &field_name) const
 {
-  int num_components = 0;
+  const GlobalSummary &summary = GetGlobalSummary();
+  auto it = summary.m_fields.find(field_name);
+  if(it == summary.m_fields.end())
+  {
+    return 0;
+  }
+  return it->second.m_num_components;
+}
 
-  const size_t num_domains = m_domains.size();
-  for(size_t i = 0; i < num_domains; ++i)
+void
+DataSet::InvalidateGlobalSummary()
+{
+  m_has_global_summary = false;
+  m_global_summary = GlobalSummary();
+}
+
+const DataSet::GlobalSummary&
+DataSet::GetGlobalSummary() const
+{
+  if(m_has_global_summary)
   {
-    if(m_domains[i].HasField(field_name))
-    {
-      num_components = m_domains[i].GetField(field_name).GetData().GetNumberOfComponentsFlat();
-      break;
-    }
+    return m_global_summary;
   }
 
+  VTKH_DATA_OPEN("GetGlobalSummary");
+  std::map<std::string, detail::LocalField> local_fields;
+  detail::LocalFields(m_domains, local_fields);
+  const std::string description = detail::DescribeFields(local_fields);
+  const bool has_fields = !local_fields.empty();
+
+  vtkm::Bounds bounds;
+  bool bounds_failed = false;
+  try
+  {
+    bounds = GetBounds(0);
+  }
+  catch(const Error &)
+  {
+    // GetGlobalBounds falls back to the old path and reports it
+    bounds_failed = true;
+  }
+
+  GlobalSummary summary;
+  // the local table tells how many range values this rank holds
+  detail::MergeFields(description, summary.m_fields);
+
+  const double lowest = vtkm::NegativeInfinity64();
+  const double hash = detail::HashFields(description);
+  double header[detail::SUMMARY_SIZE];
+  header[detail::SUMMARY_CELLS] = static_cast<double>(GetNumberOfCells());
+  header[detail::SUMMARY_DOMAINS] = static_cast<double>(GetNumberOfDomains());
+  header[detail::SUMMARY_NEG_X_MIN] = -bounds.X.Min;
+  header[detail::SUMMARY_X_MAX] = bounds.X.Max;
+  header[detail::SUMMARY_NEG_Y_MIN] = -bounds.Y.Min;
+  header[detail::SUMMARY_Y_MAX] = bounds.Y.Max;
+  header[detail::SUMMARY_NEG_Z_MIN] = -bounds.Z.Min;
+  header[detail::SUMMARY_Z_MAX] = bounds.Z.Max;
+  header[detail::SUMMARY_BOUNDS_FAILED] = bounds_failed ? 1. : 0.;
+  // ranks without fields must not break the agreement test
+  header[detail::SUMMARY_HASH_MAX] = has_fields ? hash : -1.;
+  header[detail::SUMMARY_NEG_HASH_MIN] = has_fields ? -hash : lowest;
+  header[detail::SUMMARY_LENGTH_MAX] = static_cast<double>(description.size());
+  header[detail::SUMMARY_NEG_LENGTH_MIN] =
+    has_fields ? -static_cast<double>(description.size()) : lowest;
+  header[detail::SUMMARY_RANGES_MAX] =
+    static_cast<double>(detail::NumberOfRangeValues(summary.m_fields));
+
+  std::vector<double> ranges;
 #ifdef VTKH_PARALLEL
+  detail::ReduceSummaryHeader(header);
   MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
 
-  int global_comps;
-  MPI_Allreduce((void *)(&num_components),
-                (void *)(&global_comps),
-                1,
-                MPI_INT,
-                MPI_MAX,
-                mpi_comm);
+  const int desc_size = static_cast<int>(header[detail::SUMMARY_LENGTH_MAX]);
+  const bool agree = header[detail::SUMMARY_HASH_MAX] == -header[detail::SUMMARY_NEG_HASH_MIN] &&
+                     header[detail::SUMMARY_LENGTH_MAX] == -header[detail::SUMMARY_NEG_LENGTH_MIN];
+  if(desc_size == 0)
+  {
+    // no rank has fields
+  }
+  else if(agree)
+  {
+    // every rank with fields has the same list, so one max reduction
+    // hands it to the ranks without fields together with the ranges
+    const int ranges_size = static_cast<int>(header[detail::SUMMARY_RANGES_MAX]);
+    std::vector<double> local(desc_size + ranges_size, 0.);
+    if(has_fields)
+    {
+      for(int i = 0; i < desc_size; ++i)
+      {
+        local[i] = static_cast<unsigned char>(description[i]);
+      }
+      detail::PackRanges(local_fields, summary.m_fields, ranges);
+    }
+    else
+    {
+      ranges.resize(ranges_size, lowest);
+    }
+    std::copy(ranges.begin(), ranges.end(), local.begin() + desc_size);
+
+    std::vector<double> global(local.size());
+    MPI_Allreduce(local.data(),
+                  global.data(),
+                  static_cast<int>(local.size()),
+                  MPI_DOUBLE,
+                  MPI_MAX,
+                  mpi_comm);
+
+    std::string global_description(desc_size, ' ');
+    for(int i = 0; i < desc_size; ++i)
+    {
+      global_description[i] = static_cast<char>(static_cast<unsigned char>(global[i]));
+    }
+    summary.m_fields.clear();
+    detail::MergeFields(global_description, summary.m_fields);
+    ranges.assign(global.begin() + desc_size, global.end());
+  }
+  else
+  {
+    // the lists differ, gather all of them and merge
+    const int size = vtkh::GetMPISize();
+    int local_size = static_cast<int>(description.size());
+    std::vector<int> sizes(size);
+    MPI_Allgather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, mpi_comm);
+
+    std::vector<int> offsets(size, 0);
+    for(int i = 1; i < size; ++i)
+    {
+      offsets[i] = offsets[i - 1] + sizes[i - 1];
+    }
+    std::vector<char> descriptions(offsets[size - 1] + sizes[size - 1]);
+    MPI_Allgatherv(const_cast<char*>(description.data()),
+                   local_size,
+                   MPI_CHAR,
+                   descriptions.data(),
+                   sizes.data(),
+                   offsets.data(),
+                   MPI_CHAR,
+                   mpi_comm);
+
+    summary.m_fields.clear();
+    for(int i = 0; i < size; ++i)
+    {
+      detail::MergeFields(std::string(descriptions.data() + offsets[i], sizes[i]),
+                          summary.m_fields);
+    }
 
-  num_components = global_comps;
+    std::vector<double> local;
+    detail::PackRanges(local_fields, summary.m_fields, local);
+    ranges.resize(local.size());
+    MPI_Allreduce(local.data(),
+                  ranges.data(),
+                  static_cast<int>(local.size()),
+                  MPI_DOUBLE,
+                  MPI_MAX,
+                  mpi_comm);
+  }
+#else
+  detail::PackRanges(local_fields, summary.m_fields, ranges);
 #endif
-  return num_components;
+  detail::UnpackRanges(ranges.data(), summary.m_fields);
+
+  summary.m_num_cells = static_cast<vtkm::Id>(header[detail::SUMMARY_CELLS]);
+  summary.m_num_domains = static_cast<vtkm::Id>(header[detail::SUMMARY_DOMAINS]);
+  summary.m_has_bounds = header[detail::SUMMARY_BOUNDS_FAILED] == 0.;
+  summary.m_bounds.X.Min = -header[detail::SUMMARY_NEG_X_MIN];
+  summary.m_bounds.X.Max = header[detail::SUMMARY_X_MAX];
+  summary.m_bounds.Y.Min = -header[detail::SUMMARY_NEG_Y_MIN];
+  summary.m_bounds.Y.Max = header[detail::SUMMARY_Y_MAX];
+  summary.m_bounds.Z.Min = -header[detail::SUMMARY_NEG_Z_MIN];
+  summary.m_bounds.Z.Max = header[detail::SUMMARY_Z_MAX];
+
+  m_global_summary = summary;
+  m_has_global_summary = true;
+  VTKH_DATA_CLOSE();
+  return m_global_summary;
 }
 
 } // namspace vtkh
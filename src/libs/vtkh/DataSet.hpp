@@ -2,6 +2,7 @@
 #define VTK_H_DATA_SET_HPP
 
 
+#include <map>
 #include <vector>
 #include <string>
 
@@ -14,13 +15,44 @@ namespace vtkh
 
 class VTKH_API DataSet
 {
+public:
+  // what all ranks know about a field, see GetGlobalSummary
+  struct GlobalField
+  {
+    // -1 unknown, 0 any, 1 whole data set, 2 points, 3 cells
+    int                      m_association;
+    vtkm::Id                 m_num_components;
+    // -1 if the range could not be computed on some rank
+    vtkm::Id                 m_num_ranges;
+    std::vector<vtkm::Range> m_ranges;
+    // ranks or domains disagree on the association / number of ranges
+    bool                     m_association_conflict;
+    bool                     m_range_conflict;
+  };
+
+  struct GlobalSummary
+  {
+    // bounds of coordinate system 0
+    vtkm::Bounds                        m_bounds;
+    bool                                m_has_bounds;
+    vtkm::Id                            m_num_cells;
+    vtkm::Id                            m_num_domains;
+    std::map<std::string, GlobalField>  m_fields;
+  };
+
 protected:
   std::vector<vtkm::cont::DataSet> m_domains;
   std::vector<vtkm::Id>            m_domain_ids;
   vtkm::UInt64                     m_cycle;
   double                           m_time;
+  mutable GlobalSummary            m_global_summary;
+  mutable bool                     m_has_global_summary;
 public:
   DataSet();
+  // copies do not share the cached global summary, since they
+  // are usually modified through GetDomain right after
+  DataSet(const DataSet &other);
+  DataSet& operator=(const DataSet &other);
   ~DataSet();
 
   void AddDomain(vtkm::cont::DataSet data_set, vtkm::Id domain_id);
@@ -111,6 +143,19 @@ public:
   bool IsPointMesh() const;
 
   void PrintSummary(std::ostream &stream) const;
+
+  // Returns the global bounds, cell and domain counts and the
+  // association, components and ranges of every field. The summary
+  // is gathered with one fused reduction (two when fields exist) and
+  // cached until AddDomain, RemoveField or AddConstantPointField is
+  // called. The GetGlobal* methods, GlobalFieldExists, GlobalIsEmpty,
+  // GetFieldAssociation and NumberOfComponents are answered from it.
+  // This is a collective call.
+  const GlobalSummary& GetGlobalSummary() const;
+  // Domains changed through the references returned by GetDomain are
+  // not tracked. Callers doing so on a data set that was already
+  // queried must call this on all ranks.
+  void InvalidateGlobalSummary();
 };
 
 } // namespace vtkh
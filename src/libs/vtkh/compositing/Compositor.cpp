@@ -1,4 +1,5 @@
 #include "Compositor.hpp"
+#include <vtkh/compositing/FragmentImage.hpp>
 #include <vtkh/compositing/ImageCompositor.hpp>
 
 #include <assert.h>
@@ -215,7 +216,23 @@ Compositor::CompositeZBufferSurface()
 void
 Compositor::CompositeZBufferBlend()
 {
-  assert("this is not implemented yet" == "error");
+  assert(m_images.size() != 0);
+  // keep every fragment until the end, blending before all
+  // ranks have contributed would get the order wrong
+  FragmentImage fragments;
+  fragments.Init(m_images);
+  m_images.resize(1);
+
+#ifdef VTKH_PARALLEL
+  vtkhdiy::mpi::communicator diy_comm;
+  diy_comm = vtkhdiy::mpi::communicator(MPI_Comm_f2c(GetMPICommHandle()));
+
+  RadixKCompositor compositor;
+  compositor.CompositeBlend(diy_comm, fragments, this->m_images[0]);
+  m_log_stream<<compositor.GetTimingString();
+#else
+  fragments.Flatten(m_images[0]);
+#endif
 }
 
 void
@@ -229,6 +246,7 @@ Compositor::CompositeVisOrder()
   assert(m_images.size() != 0);
   DirectSendCompositor compositor;
   compositor.CompositeVolume(diy_comm, this->m_images);
+  m_log_stream<<compositor.GetTimingString();
 #else
   vtkh::ImageCompositor compositor;
   compositor.OrderedComposite(m_images);
@@ -53,7 +53,7 @@ struct Redistribute
       typename std::map<vtkhdiy::BlockID,std::vector<Image>>::iterator it;
       for(it = outgoing.begin(); it != outgoing.end(); ++it)
       {
-        proxy.enqueue(it->first, it->second);
+        EnqueueImages(proxy, it->first, it->second, block->m_stats);
       }
     } // if
     else if(block->m_images.at(0).m_composite_order != -1)
@@ -102,6 +102,8 @@ struct Redistribute
       //
       ImageCompositor compositor;
       compositor.ZBufferBlend(images);
+
+      block->m_output.Swap(images[0]);
     }
 
   } // operator
@@ -127,6 +129,10 @@ DirectSendCompositor::CompositeVolume(vtkhdiy::mpi::communicator &diy_comm,
   const int num_blocks = diy_comm.size();
   const int magic_k = 8;
   Image sub_image;
+
+  // count the bytes of the images we send
+  m_exchange_stats.Reset();
+
   //
   // DIY does not seem to like being called with different block types
   // so we isolate them within separate blocks
@@ -143,7 +149,7 @@ DirectSendCompositor::CompositeVolume(vtkhdiy::mpi::communicator &diy_comm,
     // create an assigner with one block per rank
     vtkhdiy::ContiguousAssigner assigner(num_blocks, num_blocks);
 
-    AddMultiImageBlock create(master, images, sub_image);
+    AddMultiImageBlock create(master, images, sub_image, &m_exchange_stats);
 
     const int dims = 2;
     vtkhdiy::RegularDecomposer<vtkhdiy::DiscreteBounds> decomposer(dims, global_bounds, num_blocks);
@@ -166,7 +172,7 @@ DirectSendCompositor::CompositeVolume(vtkhdiy::mpi::communicator &diy_comm,
 
     const int dims = 2;
     vtkhdiy::RegularDecomposer<vtkhdiy::DiscreteBounds> decomposer(dims, global_bounds, num_blocks);
-    AddImageBlock<Image> all_create(master, sub_image);
+    AddImageBlock<Image> all_create(master, sub_image, &m_exchange_stats);
     decomposer.decompose(diy_comm.rank(), assigner, all_create);
     MPI_Barrier(diy_comm);
 
@@ -178,6 +184,7 @@ DirectSendCompositor::CompositeVolume(vtkhdiy::mpi::communicator &diy_comm,
   }
 
   images.at(0).Swap(sub_image);
+  m_timing_log<<m_exchange_stats.ToString();
 }
 
 std::string
@@ -2,6 +2,7 @@
 #define VTKH_DIY_DIRECT_SEND_HPP
 
 #include <vtkh/compositing/Image.hpp>
+#include <vtkh/compositing/vtkh_diy_image_block.hpp>
 #include <diy/mpi.hpp>
 #include <sstream>
 
@@ -18,6 +19,7 @@ public:
   std::string GetTimingString();
 private:
   std::stringstream m_timing_log;
+  ImageExchangeStats m_exchange_stats;
 };
 
 } // namespace vtkh
@@ -0,0 +1,349 @@
+#ifndef VTKH_DIY_FRAGMENT_IMAGE_HPP
+#define VTKH_DIY_FRAGMENT_IMAGE_HPP
+
+#include <assert.h>
+#include <algorithm>
+#include <vector>
+#include <vtkm/Bounds.h>
+
+#include <vtkh/vtkh_exports.h>
+#include <vtkh/compositing/Image.hpp>
+
+namespace vtkh
+{
+
+//
+// A FragmentImage keeps, for every pixel, the list of surface
+// fragments (color and depth) that land on it, sorted front to back.
+// It is used to composite transparent surfaces: fragments from all
+// ranks are merged during the exchange and only blended at the end.
+// Fragments behind an opaque fragment can never be seen, so they are
+// dropped as soon as the lists are built or merged.
+//
+// The lists are stored contiguously, the fragments of pixel i are in
+// [m_offsets[i], m_offsets[i+1]).
+//
+struct VTKH_API FragmentImage
+{
+    vtkm::Bounds                 m_orig_bounds;
+    vtkm::Bounds                 m_bounds;
+    std::vector<int>             m_offsets;
+    std::vector<unsigned char>   m_colors;
+    std::vector<float>           m_depths;
+
+    struct Fragment
+    {
+      unsigned char m_color[4];
+      float         m_depth;
+
+      bool operator < (const Fragment &other) const
+      {
+        return m_depth < other.m_depth;
+      }
+    };
+
+    int GetNumberOfPixels() const
+    {
+      return m_offsets.size() == 0 ? 0 : static_cast<int>(m_offsets.size() - 1);
+    }
+
+    int GetNumberOfFragments() const
+    {
+      return static_cast<int>(m_depths.size());
+    }
+
+    //
+    // Build the fragment lists from images that share the same bounds.
+    // Pixels with a depth greater than 1 are background.
+    //
+    void Init(const std::vector<Image> &images)
+    {
+      assert(images.size() > 0);
+      m_orig_bounds = images[0].m_orig_bounds;
+      m_bounds = images[0].m_bounds;
+
+      const int num_images = static_cast<int>(images.size());
+      const int size = images[0].GetNumberOfPixels();
+      m_offsets.resize(size + 1);
+      m_offsets[0] = 0;
+
+      // first pass counts the visible fragments of each pixel
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        std::vector<Fragment> fragments;
+        GatherPixel(images, num_images, i, fragments);
+        m_offsets[i + 1] = static_cast<int>(fragments.size());
+      }
+
+      Allocate();
+
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        std::vector<Fragment> fragments;
+        GatherPixel(images, num_images, i, fragments);
+        Store(i, fragments);
+      }
+    }
+
+    //
+    // Fill this image with a sub-region of another fragment image
+    //
+    void SubsetFrom(const FragmentImage &image,
+                    const vtkm::Bounds &sub_region)
+    {
+      m_orig_bounds = image.m_orig_bounds;
+      m_bounds = sub_region;
+
+      assert(sub_region.X.Min >= image.m_bounds.X.Min);
+      assert(sub_region.Y.Min >= image.m_bounds.Y.Min);
+      assert(sub_region.X.Max <= image.m_bounds.X.Max);
+      assert(sub_region.Y.Max <= image.m_bounds.Y.Max);
+
+      const int s_dx  = m_bounds.X.Max - m_bounds.X.Min + 1;
+      const int s_dy  = m_bounds.Y.Max - m_bounds.Y.Min + 1;
+      const int dx  = image.m_bounds.X.Max - image.m_bounds.X.Min + 1;
+      const int start_x = m_bounds.X.Min - image.m_bounds.X.Min;
+      const int start_y = m_bounds.Y.Min - image.m_bounds.Y.Min;
+      const int size = s_dx * s_dy;
+
+      m_offsets.resize(size + 1);
+      m_offsets[0] = 0;
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        const int from = (i / s_dx + start_y) * dx + start_x + i % s_dx;
+        m_offsets[i + 1] = image.m_offsets[from + 1] - image.m_offsets[from];
+      }
+
+      Allocate();
+
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        const int from = (i / s_dx + start_y) * dx + start_x + i % s_dx;
+        const int from_begin = image.m_offsets[from];
+        const int count = m_offsets[i + 1] - m_offsets[i];
+        std::copy(image.m_colors.data() + from_begin * 4,
+                  image.m_colors.data() + (from_begin + count) * 4,
+                  m_colors.data() + m_offsets[i] * 4);
+        std::copy(image.m_depths.data() + from_begin,
+                  image.m_depths.data() + from_begin + count,
+                  m_depths.data() + m_offsets[i]);
+      }
+    }
+
+    //
+    // Merge the fragment lists of another image with the same bounds
+    //
+    void Merge(const FragmentImage &other)
+    {
+      assert(m_bounds.X.Min == other.m_bounds.X.Min);
+      assert(m_bounds.Y.Min == other.m_bounds.Y.Min);
+      assert(m_bounds.X.Max == other.m_bounds.X.Max);
+      assert(m_bounds.Y.Max == other.m_bounds.Y.Max);
+
+      const int size = GetNumberOfPixels();
+      FragmentImage res;
+      res.m_orig_bounds = m_orig_bounds;
+      res.m_bounds = m_bounds;
+      res.m_offsets.resize(size + 1);
+      res.m_offsets[0] = 0;
+
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        std::vector<Fragment> fragments;
+        MergePixel(other, i, fragments);
+        res.m_offsets[i + 1] = static_cast<int>(fragments.size());
+      }
+
+      res.Allocate();
+
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        std::vector<Fragment> fragments;
+        MergePixel(other, i, fragments);
+        res.Store(i, fragments);
+      }
+
+      Swap(res);
+    }
+
+    //
+    // Blend the fragments of each pixel front to back into an image
+    // with the same bounds. Pixels without fragments are left as is.
+    //
+    void Flatten(Image &image) const
+    {
+      assert(m_bounds.X.Min == image.m_bounds.X.Min);
+      assert(m_bounds.Y.Min == image.m_bounds.Y.Min);
+      assert(m_bounds.X.Max == image.m_bounds.X.Max);
+      assert(m_bounds.Y.Max == image.m_bounds.Y.Max);
+
+      const int size = GetNumberOfPixels();
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = 0; i < size; ++i)
+      {
+        const int begin = m_offsets[i];
+        const int end = m_offsets[i + 1];
+        if(begin == end)
+        {
+          continue;
+        }
+
+        unsigned char color[4] = {m_colors[begin * 4 + 0],
+                                  m_colors[begin * 4 + 1],
+                                  m_colors[begin * 4 + 2],
+                                  m_colors[begin * 4 + 3]};
+
+        for(int f = begin + 1; f < end; ++f)
+        {
+          // same blend as ImageCompositor::Blend
+          const unsigned int opacity = 255 - color[3];
+          color[0] += static_cast<unsigned char>(opacity * m_colors[f * 4 + 0] / 255);
+          color[1] += static_cast<unsigned char>(opacity * m_colors[f * 4 + 1] / 255);
+          color[2] += static_cast<unsigned char>(opacity * m_colors[f * 4 + 2] / 255);
+          color[3] += static_cast<unsigned char>(opacity * m_colors[f * 4 + 3] / 255);
+        }
+
+        image.m_pixels[i * 4 + 0] = color[0];
+        image.m_pixels[i * 4 + 1] = color[1];
+        image.m_pixels[i * 4 + 2] = color[2];
+        image.m_pixels[i * 4 + 3] = color[3];
+        // the nearest fragment is the depth of the pixel
+        image.m_depths[i] = m_depths[begin];
+      }
+    }
+
+    void Swap(FragmentImage &other)
+    {
+      std::swap(m_orig_bounds, other.m_orig_bounds);
+      std::swap(m_bounds, other.m_bounds);
+      m_offsets.swap(other.m_offsets);
+      m_colors.swap(other.m_colors);
+      m_depths.swap(other.m_depths);
+    }
+
+    void Clear()
+    {
+      vtkm::Bounds empty;
+      m_orig_bounds = empty;
+      m_bounds = empty;
+      m_offsets.clear();
+      m_colors.clear();
+      m_depths.clear();
+    }
+
+private:
+    // turn per pixel counts in m_offsets[i+1] into offsets
+    // and size the fragment arrays
+    void Allocate()
+    {
+      const int size = static_cast<int>(m_offsets.size()) - 1;
+      for(int i = 0; i < size; ++i)
+      {
+        m_offsets[i + 1] += m_offsets[i];
+      }
+      m_colors.resize(m_offsets[size] * 4);
+      m_depths.resize(m_offsets[size]);
+    }
+
+    void Store(const int pixel, const std::vector<Fragment> &fragments)
+    {
+      const int offset = m_offsets[pixel];
+      const int count = static_cast<int>(fragments.size());
+      assert(offset + count == m_offsets[pixel + 1]);
+      for(int f = 0; f < count; ++f)
+      {
+        m_colors[(offset + f) * 4 + 0] = fragments[f].m_color[0];
+        m_colors[(offset + f) * 4 + 1] = fragments[f].m_color[1];
+        m_colors[(offset + f) * 4 + 2] = fragments[f].m_color[2];
+        m_colors[(offset + f) * 4 + 3] = fragments[f].m_color[3];
+        m_depths[offset + f] = fragments[f].m_depth;
+      }
+    }
+
+    // drop everything behind the first opaque fragment
+    static void PruneOccluded(std::vector<Fragment> &fragments)
+    {
+      const size_t count = fragments.size();
+      for(size_t f = 0; f < count; ++f)
+      {
+        if(fragments[f].m_color[3] == 255)
+        {
+          fragments.resize(f + 1);
+          return;
+        }
+      }
+    }
+
+    static void GatherPixel(const std::vector<Image> &images,
+                            const int num_images,
+                            const int pixel,
+                            std::vector<Fragment> &fragments)
+    {
+      for(int img = 0; img < num_images; ++img)
+      {
+        const float depth = images[img].m_depths[pixel];
+        if(depth > 1.f)
+        {
+          continue;
+        }
+        Fragment fragment;
+        fragment.m_color[0] = images[img].m_pixels[pixel * 4 + 0];
+        fragment.m_color[1] = images[img].m_pixels[pixel * 4 + 1];
+        fragment.m_color[2] = images[img].m_pixels[pixel * 4 + 2];
+        fragment.m_color[3] = images[img].m_pixels[pixel * 4 + 3];
+        fragment.m_depth = depth;
+        fragments.push_back(fragment);
+      }
+      std::stable_sort(fragments.begin(), fragments.end());
+      PruneOccluded(fragments);
+    }
+
+    void GetPixel(const int pixel, std::vector<Fragment> &fragments) const
+    {
+      for(int f = m_offsets[pixel]; f < m_offsets[pixel + 1]; ++f)
+      {
+        Fragment fragment;
+        fragment.m_color[0] = m_colors[f * 4 + 0];
+        fragment.m_color[1] = m_colors[f * 4 + 1];
+        fragment.m_color[2] = m_colors[f * 4 + 2];
+        fragment.m_color[3] = m_colors[f * 4 + 3];
+        fragment.m_depth = m_depths[f];
+        fragments.push_back(fragment);
+      }
+    }
+
+    void MergePixel(const FragmentImage &other,
+                    const int pixel,
+                    std::vector<Fragment> &fragments) const
+    {
+      std::vector<Fragment> a, b;
+      GetPixel(pixel, a);
+      other.GetPixel(pixel, b);
+      fragments.resize(a.size() + b.size());
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), fragments.begin());
+      PruneOccluded(fragments);
+    }
+};
+
+} //namespace  vtkh
+#endif
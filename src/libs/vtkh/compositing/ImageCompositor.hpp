@@ -1,6 +1,7 @@
 #ifndef VTKH_DIY_IMAGE_COMPOSITOR_HPP
 #define VTKH_DIY_IMAGE_COMPOSITOR_HPP
 
+#include <vtkh/compositing/FragmentImage.hpp>
 #include <vtkh/compositing/Image.hpp>
 #include <algorithm>
 
@@ -144,60 +145,10 @@ void CombineImages(const std::vector<vtkh::Image> &images, std::vector<Pixel> &p
 
 void ZBufferBlend(std::vector<vtkh::Image> &images)
 {
-  const int image_pixels = images[0].GetNumberOfPixels();
-  const int num_images = static_cast<int>(images.size());
-  std::vector<Pixel> pixels;
-  CombineImages(images, pixels);
-#ifdef VTKH_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-  for(int i = 0; i < image_pixels; ++i)
-  {
-    const int begin = image_pixels * i;
-    const int end = image_pixels * i - 1;
-    std::sort(pixels.begin() + begin, pixels.begin() + end);
-  }
-
-  // check to see if that worked
-  int pixel_id_0 = pixels[0].m_pixel_id;
-  for(int i = 1; i < num_images; ++i)
-  {
-    assert(pixel_id_0 == pixels[i].m_pixel_id);
-  }
-
-
-#ifdef VTKH_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-  for(int i = 0; i < image_pixels; ++i)
-  {
-    const int index = i * num_images;
-    Pixel pixel = pixels[index];
-    for(int j = 1; j < num_images; ++j)
-    {
-      if(pixel.m_color[3] == 255 || pixel.m_depth > 1.f)
-      {
-        break;
-      }
-      unsigned int alpha = pixel.m_color[3];
-      const unsigned int opacity = 255 - alpha;
-      pixel.m_color[0]
-        += static_cast<unsigned char>(opacity * pixels[index + j].m_color[0] / 255);
-      pixel.m_color[1]
-        += static_cast<unsigned char>(opacity * pixels[index + j].m_color[1] / 255);
-      pixel.m_color[2]
-        += static_cast<unsigned char>(opacity * pixels[index + j].m_color[2] / 255);
-      pixel.m_color[3]
-        += static_cast<unsigned char>(opacity * pixels[index + j].m_color[3] / 255);
-      pixel.m_depth = pixels[index + j].m_depth;
-    } // for each image
-    images[0].m_pixels[i * 4 + 0] = pixel.m_color[0];
-    images[0].m_pixels[i * 4 + 1] = pixel.m_color[1];
-    images[0].m_pixels[i * 4 + 2] = pixel.m_color[2];
-    images[0].m_pixels[i * 4 + 3] = pixel.m_color[3];
-    images[0].m_depths[i] = pixel.m_depth;
-  } // for each pixel
-
+  FragmentImage fragments;
+  fragments.Init(images);
+  images.resize(1);
+  fragments.Flatten(images[0]);
 }
 
 
@@ -31,6 +31,12 @@ void DepthComposite<Image>(Image &front, Image &back)
   compositor.ZBufferComposite(front, back);
 }
 
+template<>
+void DepthComposite<FragmentImage>(FragmentImage &front, FragmentImage &back)
+{
+  front.Merge(back);
+}
+
 template<typename ImageType>
 void reduce_images(void *b,
                    const vtkhdiy::ReduceProxy &proxy,
@@ -117,7 +123,7 @@ void reduce_images(void *b,
       }
       else
       {
-        proxy.enqueue(proxy.out_link().target(i), out_images[i]);
+        EnqueueImage(proxy, proxy.out_link().target(i), out_images[i], block->m_stats);
       }
   } //for
 
@@ -139,6 +145,9 @@ RadixKCompositor::CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType
 {
     vtkhdiy::DiscreteBounds global_bounds = VTKMBoundsToDIY(image.m_orig_bounds);
 
+    // count the bytes of the images we send
+    m_exchange_stats.Reset();
+
     // tells diy to use one thread
     const int num_threads = 1;
     const int num_blocks = diy_comm.size();
@@ -154,7 +163,7 @@ RadixKCompositor::CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType
 
     // create an assigner with one block per rank
     vtkhdiy::ContiguousAssigner assigner(num_blocks, num_blocks);
-    AddImageBlock<ImageType> create(master, image);
+    AddImageBlock<ImageType> create(master, image, &m_exchange_stats);
     const int num_dims = 2;
     vtkhdiy::RegularDecomposer<vtkhdiy::DiscreteBounds> decomposer(num_dims, global_bounds, num_blocks);
     decomposer.decompose(diy_comm.rank(), assigner, create);
@@ -177,6 +186,7 @@ RadixKCompositor::CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType
     {
       master.prof.output(m_timing_log);
     }
+    m_timing_log<<m_exchange_stats.ToString();
 }
 
 void
@@ -191,6 +201,73 @@ RadixKCompositor::CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Payload
   CompositeImpl(diy_comm, image);
 }
 
+void
+RadixKCompositor::CompositeBlend(vtkhdiy::mpi::communicator &diy_comm,
+                                 FragmentImage &fragments,
+                                 Image &image)
+{
+    vtkhdiy::DiscreteBounds global_bounds = VTKMBoundsToDIY(fragments.m_orig_bounds);
+
+    m_exchange_stats.Reset();
+
+    const int num_threads = 1;
+    const int num_blocks = diy_comm.size();
+    const int magic_k = 8;
+
+    vtkhdiy::ContiguousAssigner assigner(num_blocks, num_blocks);
+    const int num_dims = 2;
+    vtkhdiy::RegularDecomposer<vtkhdiy::DiscreteBounds> decomposer(num_dims, global_bounds, num_blocks);
+    vtkhdiy::RegularSwapPartners partners(decomposer,
+                                      magic_k,
+                                      false); // false == distance halving
+
+    // the fragment lists are merged during the swap, so every pixel
+    // ends up on a single rank with all of its fragments
+    vtkhdiy::Master frag_master(diy_comm, num_threads,
+                                -1, 0,
+                                [](void * b){
+                                   ImageBlock<FragmentImage> *block
+                                   = reinterpret_cast<ImageBlock<FragmentImage>*>(b);
+                                   delete block;
+                                });
+    AddImageBlock<FragmentImage> create_frag(frag_master, fragments);
+    decomposer.decompose(diy_comm.rank(), assigner, create_frag);
+    vtkhdiy::reduce(frag_master,
+                    assigner,
+                    partners,
+                    reduce_images<FragmentImage>);
+
+    // blend the region we own. Pixels without any fragments are
+    // background on every rank, so keep what we have.
+    Image region;
+    region.SubsetFrom(image, fragments.m_bounds);
+    fragments.Flatten(region);
+    fragments.Clear();
+
+    vtkhdiy::Master master(diy_comm, num_threads,
+                           -1, 0,
+                           [](void * b){
+                              ImageBlock<Image> *block
+                              = reinterpret_cast<ImageBlock<Image>*>(b);
+                              delete block;
+                           });
+    AddImageBlock<Image> create(master, region, &m_exchange_stats);
+    decomposer.decompose(diy_comm.rank(), assigner, create);
+    vtkhdiy::all_to_all(master,
+                    assigner,
+                    CollectImages<Image>(decomposer),
+                    magic_k);
+
+    image.Swap(region);
+
+    if(diy_comm.rank() == 0)
+    {
+      frag_master.prof.output(m_timing_log);
+      master.prof.output(m_timing_log);
+    }
+    m_timing_log<<m_exchange_stats.ToString();
+}
+
 std::string
 RadixKCompositor::GetTimingString()
 {
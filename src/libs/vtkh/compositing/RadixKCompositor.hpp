@@ -1,8 +1,10 @@
 #ifndef VTKH_DIY_RADIX_K_HPP
 #define VTKH_DIY_RADIX_K_HPP
 
+#include <vtkh/compositing/FragmentImage.hpp>
 #include <vtkh/compositing/Image.hpp>
 #include <vtkh/compositing/PayloadImage.hpp>
+#include <vtkh/compositing/vtkh_diy_image_block.hpp>
 #include <diy/mpi.hpp>
 #include <sstream>
 
@@ -16,6 +18,10 @@ public:
   ~RadixKCompositor();
   void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Image &image);
   void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, PayloadImage &image);
+  // merges the fragments of all ranks and blends them into image
+  void CompositeBlend(vtkhdiy::mpi::communicator &diy_comm,
+                      FragmentImage &fragments,
+                      Image &image);
 
   template<typename ImageType>
   void CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType &image);
@@ -23,6 +29,7 @@ public:
   std::string GetTimingString();
 private:
   std::stringstream m_timing_log;
+  ImageExchangeStats m_exchange_stats;
 };
 
 } // namspace vtkh
@@ -36,7 +36,7 @@ struct CollectImages
         int dest_gid = collection_rank;
         vtkhdiy::BlockID dest = proxy.out_link().target(dest_gid);
 
-        proxy.enqueue(dest, block->m_image);
+        EnqueueImage(proxy, dest, block->m_image, block->m_stats);
         block->m_image.Clear();
       }
     } // if
@@ -2,18 +2,129 @@
 #define VTKH_DIY_IMAGE_BLOCK_HPP
 
 #include <vtkh/compositing/Image.hpp>
+#include <vtkh/compositing/FragmentImage.hpp>
 #include <vtkh/compositing/PayloadImage.hpp>
 #include <diy/master.hpp>
+#include <diy/reduce.hpp>
+
+#include <cstring>
+#include <sstream>
 
 namespace vtkh
 {
 
+//
+// Byte counts for the images this rank serialized while compositing,
+// dense is what the images would have cost without active pixel
+// encoding. The compositors own one and hand it to their blocks.
+//
+struct ImageExchangeStats
+{
+  size_t m_images;
+  size_t m_encoded_images;
+  size_t m_dense_bytes;
+  size_t m_sent_bytes;
+
+  ImageExchangeStats()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    m_images = 0;
+    m_encoded_images = 0;
+    m_dense_bytes = 0;
+    m_sent_bytes = 0;
+  }
+
+  std::string ToString() const
+  {
+    std::stringstream ss;
+    ss<<"exchanged_images "<<m_images<<"\n";
+    ss<<"active_pixel_encoded_images "<<m_encoded_images<<"\n";
+    ss<<"exchanged_dense_bytes "<<m_dense_bytes<<"\n";
+    ss<<"exchanged_sent_bytes "<<m_sent_bytes<<"\n";
+    return ss.str();
+  }
+};
+
+//
+// Most of a rank's sub-image is usually background. Pixels that
+// differ from the background (the value of the first pixel) are
+// active, and the image is described by alternating spans of
+// background and active pixel counts, starting with background.
+// The encoding is lossless and only used when it is smaller.
+//
+struct ActivePixelSpans
+{
+  unsigned char    m_bg_color[4];
+  float            m_bg_depth;
+  std::vector<int> m_spans;
+  int              m_num_active;
+
+  bool IsBackground(const Image &image, const int index) const
+  {
+    // compare depth bits so the decoded image is bit for bit the same
+    return std::memcmp(&image.m_pixels[index * 4], m_bg_color, 4) == 0 &&
+           std::memcmp(&image.m_depths[index], &m_bg_depth, sizeof(float)) == 0;
+  }
+
+  // returns true if the encoding is smaller than the dense image
+  bool Build(const Image &image)
+  {
+    m_spans.clear();
+    m_num_active = 0;
+    const int size = image.GetNumberOfPixels();
+    if(size == 0)
+    {
+      return false;
+    }
+
+    std::memcpy(m_bg_color, &image.m_pixels[0], 4);
+    m_bg_depth = image.m_depths[0];
+
+    const size_t dense_bytes = DenseBytes(size);
+    int i = 0;
+    while(i < size)
+    {
+      int start = i;
+      while(i < size && IsBackground(image, i)) ++i;
+      m_spans.push_back(i - start);
+      start = i;
+      while(i < size && !IsBackground(image, i)) ++i;
+      m_spans.push_back(i - start);
+      m_num_active += i - start;
+      // give up early on images that will not compress
+      if(EncodedBytes() >= dense_bytes)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static size_t DenseBytes(const int num_pixels)
+  {
+    return static_cast<size_t>(num_pixels) * (4 + sizeof(float));
+  }
+
+  size_t EncodedBytes() const
+  {
+    return 4 + sizeof(float) +
+           m_spans.size() * sizeof(int) +
+           static_cast<size_t>(m_num_active) * (4 + sizeof(float));
+  }
+};
+
 template<typename ImageType>
 struct ImageBlock
 {
-  ImageType &m_image;
-  ImageBlock(ImageType &image)
-    : m_image(image)
+  ImageType          &m_image;
+  ImageExchangeStats *m_stats; // optional, counts the images we send
+  ImageBlock(ImageType &image, ImageExchangeStats *stats = nullptr)
+    : m_image(image),
+      m_stats(stats)
   {
   }
 };
@@ -22,10 +133,13 @@ struct MultiImageBlock
 {
   std::vector<Image> &m_images;
   Image              &m_output;
+  ImageExchangeStats *m_stats; // optional, counts the images we send
   MultiImageBlock(std::vector<Image> &images,
-                  Image &output)
+                  Image &output,
+                  ImageExchangeStats *stats = nullptr)
     : m_images(images),
-      m_output(output)
+      m_output(output),
+      m_stats(stats)
   {}
 };
 
@@ -34,10 +148,14 @@ struct AddImageBlock
 {
   ImageType             &m_image;
   const vtkhdiy::Master &m_master;
+  ImageExchangeStats    *m_stats;
 
-  AddImageBlock(vtkhdiy::Master &master, ImageType &image)
+  AddImageBlock(vtkhdiy::Master &master,
+                ImageType &image,
+                ImageExchangeStats *stats = nullptr)
     : m_image(image),
-      m_master(master)
+      m_master(master),
+      m_stats(stats)
   {
   }
   template<typename BoundsType, typename LinkType>
@@ -47,7 +165,7 @@ struct AddImageBlock
                   const BoundsType &,  // domain_bounds
                   const LinkType &link) const
   {
-    ImageBlock<ImageType> *block = new ImageBlock<ImageType>(m_image);
+    ImageBlock<ImageType> *block = new ImageBlock<ImageType>(m_image, m_stats);
     LinkType *linked = new LinkType(link);
     vtkhdiy::Master& master = const_cast<vtkhdiy::Master&>(m_master);
     master.add(gid, block, linked);
@@ -59,13 +177,16 @@ struct AddMultiImageBlock
   std::vector<Image> &m_images;
   Image              &m_output;
   const vtkhdiy::Master  &m_master;
+  ImageExchangeStats *m_stats;
 
   AddMultiImageBlock(vtkhdiy::Master &master,
                      std::vector<Image> &images,
-                     Image &output)
+                     Image &output,
+                     ImageExchangeStats *stats = nullptr)
     : m_master(master),
       m_images(images),
-      m_output(output)
+      m_output(output),
+      m_stats(stats)
   {}
   template<typename BoundsType, typename LinkType>
   void operator()(int gid,
@@ -74,7 +195,7 @@ struct AddMultiImageBlock
                   const BoundsType &,  // domain_bounds
                   const LinkType &link) const
   {
-    MultiImageBlock *block = new MultiImageBlock(m_images, m_output);
+    MultiImageBlock *block = new MultiImageBlock(m_images, m_output, m_stats);
     LinkType *linked = new LinkType(link);
     vtkhdiy::Master& master = const_cast<vtkhdiy::Master&>(m_master);
     int lid = master.add(gid, block, linked);
@@ -137,6 +258,14 @@ template<>
 struct Serialization<vtkh::Image>
 {
   static void save(BinaryBuffer &bb, const vtkh::Image &image)
+  {
+    save(bb, image, nullptr);
+  }
+
+  // stats is optional, see vtkh::EnqueueImage
+  static void save(BinaryBuffer &bb,
+                   const vtkh::Image &image,
+                   vtkh::ImageExchangeStats *stats)
   {
     vtkhdiy::save(bb, image.m_orig_bounds.X.Min);
     vtkhdiy::save(bb, image.m_orig_bounds.Y.Min);
@@ -152,8 +281,65 @@ struct Serialization<vtkh::Image>
     vtkhdiy::save(bb, image.m_bounds.Y.Max);
     vtkhdiy::save(bb, image.m_bounds.Z.Max);
 
-    vtkhdiy::save(bb, image.m_pixels);
-    vtkhdiy::save(bb, image.m_depths);
+    const int num_pixels = image.GetNumberOfPixels();
+    vtkh::ActivePixelSpans spans;
+    const bool encoded = spans.Build(image);
+    vtkhdiy::save(bb, encoded);
+
+    const size_t dense_bytes = vtkh::ActivePixelSpans::DenseBytes(num_pixels);
+    if(stats != nullptr)
+    {
+      stats->m_images++;
+      stats->m_dense_bytes += dense_bytes;
+    }
+
+    if(encoded)
+    {
+      vtkhdiy::save(bb, num_pixels);
+      vtkhdiy::save(bb, spans.m_bg_color, 4);
+      vtkhdiy::save(bb, spans.m_bg_depth);
+      vtkhdiy::save(bb, spans.m_spans);
+      vtkhdiy::save(bb, spans.m_num_active);
+      // active pixels, then active depths
+      int offset = 0;
+      const int num_spans = static_cast<int>(spans.m_spans.size());
+      for(int i = 0; i < num_spans; i += 2)
+      {
+        offset += spans.m_spans[i];
+        const int count = spans.m_spans[i + 1];
+        if(count > 0)
+        {
+          vtkhdiy::save(bb, &image.m_pixels[offset * 4], count * 4);
+        }
+        offset += count;
+      }
+      offset = 0;
+      for(int i = 0; i < num_spans; i += 2)
+      {
+        offset += spans.m_spans[i];
+        const int count = spans.m_spans[i + 1];
+        if(count > 0)
+        {
+          vtkhdiy::save(bb, &image.m_depths[offset], count);
+        }
+        offset += count;
+      }
+      if(stats != nullptr)
+      {
+        stats->m_encoded_images++;
+        stats->m_sent_bytes += spans.EncodedBytes();
+      }
+    }
+    else
+    {
+      vtkhdiy::save(bb, image.m_pixels);
+      vtkhdiy::save(bb, image.m_depths);
+      if(stats != nullptr)
+      {
+        stats->m_sent_bytes += dense_bytes;
+      }
+    }
+
     vtkhdiy::save(bb, image.m_orig_rank);
     vtkhdiy::save(bb, image.m_composite_order);
   }
@@ -174,13 +360,146 @@ struct Serialization<vtkh::Image>
     vtkhdiy::load(bb, image.m_bounds.Y.Max);
     vtkhdiy::load(bb, image.m_bounds.Z.Max);
 
-    vtkhdiy::load(bb, image.m_pixels);
-    vtkhdiy::load(bb, image.m_depths);
+    bool encoded;
+    vtkhdiy::load(bb, encoded);
+    if(encoded)
+    {
+      int num_pixels;
+      vtkh::ActivePixelSpans spans;
+      vtkhdiy::load(bb, num_pixels);
+      vtkhdiy::load(bb, spans.m_bg_color, 4);
+      vtkhdiy::load(bb, spans.m_bg_depth);
+      vtkhdiy::load(bb, spans.m_spans);
+      vtkhdiy::load(bb, spans.m_num_active);
+
+      image.m_pixels.resize(num_pixels * 4);
+      image.m_depths.resize(num_pixels);
+
+      int offset = 0;
+      const int num_spans = static_cast<int>(spans.m_spans.size());
+      for(int i = 0; i < num_spans; i += 2)
+      {
+        const int bg_count = spans.m_spans[i];
+        for(int p = offset; p < offset + bg_count; ++p)
+        {
+          std::memcpy(&image.m_pixels[p * 4], spans.m_bg_color, 4);
+          image.m_depths[p] = spans.m_bg_depth;
+        }
+        offset += bg_count;
+        const int count = spans.m_spans[i + 1];
+        if(count > 0)
+        {
+          vtkhdiy::load(bb, &image.m_pixels[offset * 4], count * 4);
+        }
+        offset += count;
+      }
+      offset = 0;
+      for(int i = 0; i < num_spans; i += 2)
+      {
+        offset += spans.m_spans[i];
+        const int count = spans.m_spans[i + 1];
+        if(count > 0)
+        {
+          vtkhdiy::load(bb, &image.m_depths[offset], count);
+        }
+        offset += count;
+      }
+    }
+    else
+    {
+      vtkhdiy::load(bb, image.m_pixels);
+      vtkhdiy::load(bb, image.m_depths);
+    }
     vtkhdiy::load(bb, image.m_orig_rank);
     vtkhdiy::load(bb, image.m_composite_order);
   }
 };
 
+template<>
+struct Serialization<vtkh::FragmentImage>
+{
+  static void save(BinaryBuffer &bb, const vtkh::FragmentImage &image)
+  {
+    vtkhdiy::save(bb, image.m_orig_bounds.X.Min);
+    vtkhdiy::save(bb, image.m_orig_bounds.Y.Min);
+    vtkhdiy::save(bb, image.m_orig_bounds.Z.Min);
+    vtkhdiy::save(bb, image.m_orig_bounds.X.Max);
+    vtkhdiy::save(bb, image.m_orig_bounds.Y.Max);
+    vtkhdiy::save(bb, image.m_orig_bounds.Z.Max);
+
+    vtkhdiy::save(bb, image.m_bounds.X.Min);
+    vtkhdiy::save(bb, image.m_bounds.Y.Min);
+    vtkhdiy::save(bb, image.m_bounds.Z.Min);
+    vtkhdiy::save(bb, image.m_bounds.X.Max);
+    vtkhdiy::save(bb, image.m_bounds.Y.Max);
+    vtkhdiy::save(bb, image.m_bounds.Z.Max);
+
+    vtkhdiy::save(bb, image.m_offsets);
+    vtkhdiy::save(bb, image.m_colors);
+    vtkhdiy::save(bb, image.m_depths);
+  }
+
+  static void load(BinaryBuffer &bb, vtkh::FragmentImage &image)
+  {
+    vtkhdiy::load(bb, image.m_orig_bounds.X.Min);
+    vtkhdiy::load(bb, image.m_orig_bounds.Y.Min);
+    vtkhdiy::load(bb, image.m_orig_bounds.Z.Min);
+    vtkhdiy::load(bb, image.m_orig_bounds.X.Max);
+    vtkhdiy::load(bb, image.m_orig_bounds.Y.Max);
+    vtkhdiy::load(bb, image.m_orig_bounds.Z.Max);
+
+    vtkhdiy::load(bb, image.m_bounds.X.Min);
+    vtkhdiy::load(bb, image.m_bounds.Y.Min);
+    vtkhdiy::load(bb, image.m_bounds.Z.Min);
+    vtkhdiy::load(bb, image.m_bounds.X.Max);
+    vtkhdiy::load(bb, image.m_bounds.Y.Max);
+    vtkhdiy::load(bb, image.m_bounds.Z.Max);
+
+    vtkhdiy::load(bb, image.m_offsets);
+    vtkhdiy::load(bb, image.m_colors);
+    vtkhdiy::load(bb, image.m_depths);
+  }
+};
+
 } // namespace diy
 
+namespace vtkh
+{
+
+// Enqueues an image for another block. Only vtkh::Image is active pixel
+// encoded, so only its bytes are added to stats (which may be null).
+template<typename ImageType>
+void EnqueueImage(const vtkhdiy::ReduceProxy &proxy,
+                  const vtkhdiy::BlockID &to,
+                  const ImageType &image,
+                  ImageExchangeStats *) // unused: stats
+{
+  proxy.enqueue(to, image);
+}
+
+inline void EnqueueImage(const vtkhdiy::ReduceProxy &proxy,
+                         const vtkhdiy::BlockID &to,
+                         const Image &image,
+                         ImageExchangeStats *stats)
+{
+  vtkhdiy::Serialization<Image>::save(proxy.outgoing(to), image, stats);
+}
+
+// same layout as proxy.enqueue(to, images), so it is dequeued as a vector
+inline void EnqueueImages(const vtkhdiy::ReduceProxy &proxy,
+                          const vtkhdiy::BlockID &to,
+                          const std::vector<Image> &images,
+                          ImageExchangeStats *stats)
+{
+  vtkhdiy::MemoryBuffer &bb = proxy.outgoing(to);
+  const size_t size = images.size();
+  vtkhdiy::save(bb, size);
+  for(size_t i = 0; i < size; ++i)
+  {
+    vtkhdiy::Serialization<Image>::save(bb, images[i], stats);
+  }
+}
+
+} // namespace vtkh
+
 #endif
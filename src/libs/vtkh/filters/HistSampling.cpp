@@ -350,6 +350,8 @@ void HistSampling::DoExecute()
       dom.AddCellField("valSampled", output);
     }
   }
+  // the domains were changed in place after GetFieldAssociation
+  input->InvalidateGlobalSummary();
 
   vtkh::Threshold thresher;
   thresher.SetInput(input);
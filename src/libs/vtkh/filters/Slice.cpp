@@ -2,8 +2,16 @@
 #include <vtkh/Error.hpp>
 #include <vtkh/filters/MarchingCubes.hpp>
 
+#include <vtkm/VecTraits.h>
 #include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleImplicit.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/TryExecute.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
@@ -79,6 +87,385 @@ public:
   }
 }; //class Offset
 
+//
+// true if the plane through point with the given normal crosses
+// the bounds, so contouring the domain can produce something
+//
+bool PlaneIntersects(const vtkm::Bounds &bounds,
+                     const vtkm::Vec<vtkm::Float32,3> &point,
+                     const vtkm::Vec<vtkm::Float32,3> &normal)
+{
+  if(!bounds.IsNonEmpty())
+  {
+    return false;
+  }
+
+  vtkm::Float64 min_dist = vtkm::Infinity64();
+  vtkm::Float64 max_dist = vtkm::NegativeInfinity64();
+  for(int c = 0; c < 8; ++c)
+  {
+    vtkm::Vec<vtkm::Float64,3> corner((c & 1) ? bounds.X.Max : bounds.X.Min,
+                                      (c & 2) ? bounds.Y.Max : bounds.Y.Min,
+                                      (c & 4) ? bounds.Z.Max : bounds.Z.Min);
+    vtkm::Float64 dist = 0.;
+    for(int d = 0; d < 3; ++d)
+    {
+      dist += (corner[d] - point[d]) * normal[d];
+    }
+    min_dist = vtkm::Min(min_dist, dist);
+    max_dist = vtkm::Max(max_dist, dist);
+  }
+  return min_dist <= 0. && max_dist >= 0.;
+}
+
+// returns the axis the normal points along or -1
+int AlignedAxis(vtkm::Vec<vtkm::Float32,3> normal)
+{
+  vtkm::Normalize(normal);
+  for(int i = 0; i < 3; ++i)
+  {
+    if(vtkm::Abs(normal[i]) > 1.f - 1e-6f)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+//
+// Maps an index of a one thick slab to the index of the same
+// value in layer m_layer of a structured array with m_dims
+//
+struct SlabIndex
+{
+  vtkm::Id3 m_dims;
+  vtkm::IdComponent m_axis;
+  vtkm::Id m_layer;
+
+  VTKM_EXEC_CONT
+  vtkm::Id operator()(const vtkm::Id index) const
+  {
+    vtkm::Id3 slab_dims = m_dims;
+    slab_dims[m_axis] = 1;
+    vtkm::Id3 ijk(index % slab_dims[0],
+                  (index / slab_dims[0]) % slab_dims[1],
+                  index / (slab_dims[0] * slab_dims[1]));
+    ijk[m_axis] = m_layer;
+    return ijk[0] + m_dims[0] * (ijk[1] + m_dims[1] * ijk[2]);
+  }
+};
+
+class BlendLayers : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Float64 m_t;
+public:
+  VTKM_CONT
+  BlendLayers(const vtkm::Float64 t)
+    : m_t(t)
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3);
+
+  template<typename T>
+  VTKM_EXEC
+  void operator()(const T &a, const T &b, T &res) const
+  {
+    using Traits = vtkm::VecTraits<T>;
+    using ComponentType = typename Traits::ComponentType;
+    res = a;
+    const vtkm::IdComponent num_components = Traits::GetNumberOfComponents(a);
+    for(vtkm::IdComponent c = 0; c < num_components; ++c)
+    {
+      const vtkm::Float64 va = static_cast<vtkm::Float64>(Traits::GetComponent(a, c));
+      const vtkm::Float64 vb = static_cast<vtkm::Float64>(Traits::GetComponent(b, c));
+      Traits::SetComponent(res, c, static_cast<ComponentType>(va + (vb - va) * m_t));
+    }
+  }
+}; //class BlendLayers
+
+struct SlabFieldFunctor
+{
+  SlabIndex m_index;
+  vtkm::Id m_size;
+  // blend layer m_index.m_layer with the next one, points only
+  bool m_blend;
+  vtkm::Float64 m_t;
+  vtkm::cont::UnknownArrayHandle m_result;
+
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &input)
+  {
+    auto layer =
+      vtkm::cont::make_ArrayHandlePermutation(vtkm::cont::make_ArrayHandleImplicit(m_index, m_size),
+                                              input);
+    vtkm::cont::ArrayHandle<T> output;
+    if(m_blend)
+    {
+      SlabIndex next_index = m_index;
+      next_index.m_layer += 1;
+      auto next_layer =
+        vtkm::cont::make_ArrayHandlePermutation(vtkm::cont::make_ArrayHandleImplicit(next_index, m_size),
+                                                input);
+      vtkm::cont::Invoker invoke;
+      invoke(BlendLayers(m_t), layer, next_layer, output);
+    }
+    else
+    {
+      vtkm::cont::Algorithm::Copy(layer, output);
+    }
+    m_result = output;
+  }
+};
+
+// positions of the points along a uniform axis
+struct UniformAxis
+{
+  vtkm::Float64 m_origin;
+  vtkm::Float64 m_spacing;
+  vtkm::Id m_size;
+
+  vtkm::Float64 Get(const vtkm::Id index) const
+  {
+    return m_origin + static_cast<vtkm::Float64>(index) * m_spacing;
+  }
+
+  vtkm::Id GetNumberOfValues() const
+  {
+    return m_size;
+  }
+};
+
+//
+// finds the layer of points [layer, layer + 1] holding position,
+// with t the position between them
+//
+template<typename PortalType>
+bool FindLayer(const PortalType &positions,
+               const vtkm::Float64 position,
+               vtkm::Id &layer,
+               vtkm::Float64 &t)
+{
+  const vtkm::Id size = positions.GetNumberOfValues();
+  if(size < 2 ||
+     position < positions.Get(0) ||
+     position > positions.Get(size - 1))
+  {
+    return false;
+  }
+
+  layer = 0;
+  while(layer < size - 2 && positions.Get(layer + 1) <= position)
+  {
+    ++layer;
+  }
+
+  const vtkm::Float64 start = positions.Get(layer);
+  const vtkm::Float64 width = positions.Get(layer + 1) - start;
+  t = width > 0. ? vtkm::Min(1., (position - start) / width) : 0.;
+  return true;
+}
+
+template<typename T>
+bool RectilinearSlab(const vtkm::cont::UnknownArrayHandle &coords,
+                     const std::string &coords_name,
+                     const int axis,
+                     const vtkm::Float64 position,
+                     vtkm::Id &layer,
+                     vtkm::Float64 &t,
+                     vtkm::cont::CoordinateSystem &slab_coords)
+{
+  using AxisType = vtkm::cont::ArrayHandle<T>;
+  using RectilinearType = vtkm::cont::ArrayHandleCartesianProduct<AxisType, AxisType, AxisType>;
+  if(!coords.IsType<RectilinearType>())
+  {
+    return false;
+  }
+
+  RectilinearType rect = coords.AsArrayHandle<RectilinearType>();
+  AxisType axes[3] = {rect.GetFirstArray(), rect.GetSecondArray(), rect.GetThirdArray()};
+  if(!FindLayer(axes[axis].ReadPortal(), position, layer, t))
+  {
+    return false;
+  }
+
+  axes[axis] = vtkm::cont::make_ArrayHandle(std::vector<T>(1, static_cast<T>(position)),
+                                            vtkm::CopyFlag::On);
+  slab_coords = vtkm::cont::CoordinateSystem(coords_name,
+                                             vtkm::cont::make_ArrayHandleCartesianProduct(axes[0],
+                                                                                          axes[1],
+                                                                                          axes[2]));
+  return true;
+}
+
+//
+// Slices a uniform or rectilinear domain with a plane normal to axis,
+// producing a 2D structured data set directly instead of contouring
+// a distance field. Point fields are interpolated between the two
+// layers of points around the plane, cell fields are taken from the
+// layer of cells it crosses. Returns false for any other kind of
+// domain or field we cannot handle, so the caller can fall back.
+//
+bool SliceStructured(const vtkm::cont::DataSet &dom,
+                     const int axis,
+                     const vtkm::Float64 position,
+                     vtkm::cont::DataSet &result)
+{
+  if(!dom.GetCellSet().IsType<vtkm::cont::CellSetStructured<3>>())
+  {
+    return false;
+  }
+
+  vtkm::cont::CellSetStructured<3> cell_set =
+    dom.GetCellSet().AsCellSet<vtkm::cont::CellSetStructured<3>>();
+  const vtkm::Id3 dims = cell_set.GetPointDimensions();
+  const int axis_a = axis == 0 ? 1 : 0;
+  const int axis_b = axis == 2 ? 1 : 2;
+  if(dims[axis] < 2 || dims[axis_a] < 2 || dims[axis_b] < 2)
+  {
+    return false;
+  }
+
+  try
+  {
+    const vtkm::cont::CoordinateSystem coords = dom.GetCoordinateSystem();
+    const vtkm::cont::UnknownArrayHandle coords_data = coords.GetData();
+    vtkm::cont::CoordinateSystem slab_coords;
+    vtkm::Id layer = 0;
+    vtkm::Float64 t = 0.;
+
+    using UniformType = vtkm::cont::ArrayHandleUniformPointCoordinates;
+    if(coords_data.IsType<UniformType>())
+    {
+      UniformType uniform = coords_data.AsArrayHandle<UniformType>();
+      vtkm::Vec3f origin = uniform.GetOrigin();
+      const vtkm::Vec3f spacing = uniform.GetSpacing();
+      const UniformAxis positions{origin[axis], spacing[axis], dims[axis]};
+      if(!FindLayer(positions, position, layer, t))
+      {
+        return false;
+      }
+      vtkm::Id3 slab_dims = dims;
+      slab_dims[axis] = 1;
+      origin[axis] = static_cast<vtkm::FloatDefault>(position);
+      slab_coords = vtkm::cont::CoordinateSystem(coords.GetName(),
+                                                 UniformType(slab_dims, origin, spacing));
+    }
+    else if(!RectilinearSlab<vtkm::Float32>(coords_data, coords.GetName(), axis,
+                                            position, layer, t, slab_coords) &&
+            !RectilinearSlab<vtkm::Float64>(coords_data, coords.GetName(), axis,
+                                            position, layer, t, slab_coords))
+    {
+      return false;
+    }
+
+    vtkm::cont::CellSetStructured<2> slab_cells;
+    slab_cells.SetPointDimensions(vtkm::Id2(dims[axis_a], dims[axis_b]));
+
+    vtkm::cont::DataSet slab;
+    slab.SetCellSet(slab_cells);
+    slab.AddCoordinateSystem(slab_coords);
+
+    const vtkm::Id3 cell_dims = dims - vtkm::Id3(1);
+    const int num_fields = dom.GetNumberOfFields();
+    for(int f = 0; f < num_fields; ++f)
+    {
+      const vtkm::cont::Field &field = dom.GetField(f);
+      if(field.GetAssociation() != vtkm::cont::Field::Association::Points &&
+         field.GetAssociation() != vtkm::cont::Field::Association::Cells)
+      {
+        slab.AddField(field);
+        continue;
+      }
+
+      SlabFieldFunctor functor;
+      if(field.GetAssociation() == vtkm::cont::Field::Association::Points)
+      {
+        functor.m_index = SlabIndex{dims, axis, layer};
+        functor.m_size = dims[axis_a] * dims[axis_b];
+        functor.m_blend = t > 0.;
+      }
+      else
+      {
+        functor.m_index = SlabIndex{cell_dims, axis, vtkm::Min(layer, cell_dims[axis] - 1)};
+        functor.m_size = cell_dims[axis_a] * cell_dims[axis_b];
+        functor.m_blend = false;
+      }
+      functor.m_t = t;
+
+      field.GetData().ResetTypes(vtkm::TypeListCommon(),VTKM_DEFAULT_STORAGE_LIST{})
+        .CastAndCall(functor);
+      slab.AddField(vtkm::cont::Field(field.GetName(),
+                                      field.GetAssociation(),
+                                      functor.m_result));
+    }
+
+    result = slab;
+  }
+  catch(const vtkm::cont::Error &)
+  {
+    // unsupported coordinate or field types, let the caller contour
+    return false;
+  }
+  return true;
+}
+
+//
+// Emits the two triangles of each quad of a 2D structured
+// slice into merged connectivity
+//
+class QuadTriangles : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Id m_row_size;
+  vtkm::Id m_conn_offset;
+  vtkm::Id m_point_offset;
+public:
+  VTKM_CONT
+  QuadTriangles(const vtkm::Id row_size,
+                const vtkm::Id conn_offset,
+                const vtkm::Id point_offset)
+    : m_row_size(row_size),
+      m_conn_offset(conn_offset),
+      m_point_offset(point_offset)
+  {
+  }
+
+  typedef void ControlSignature(FieldIn, WholeArrayInOut);
+  typedef void ExecutionSignature(_1, _2);
+
+  template<typename PortalType>
+  VTKM_EXEC
+  void operator()(const vtkm::Id &quad, PortalType conn) const
+  {
+    const vtkm::Id i = quad % (m_row_size - 1);
+    const vtkm::Id j = quad / (m_row_size - 1);
+    const vtkm::Id p0 = m_point_offset + i + j * m_row_size;
+    const vtkm::Id p1 = p0 + 1;
+    const vtkm::Id p2 = p0 + 1 + m_row_size;
+    const vtkm::Id p3 = p0 + m_row_size;
+    const vtkm::Id start = m_conn_offset + quad * 6;
+    conn.Set(start + 0, p0);
+    conn.Set(start + 1, p1);
+    conn.Set(start + 2, p2);
+    conn.Set(start + 3, p0);
+    conn.Set(start + 4, p2);
+    conn.Set(start + 5, p3);
+  }
+}; //class QuadTriangles
+
+// each quad of a structured slice becomes two triangles
+struct HalfIndex
+{
+  VTKM_EXEC_CONT
+  vtkm::Id operator()(const vtkm::Id index) const
+  {
+    return index / 2;
+  }
+};
+
 class MergeContours
 {
   std::vector<vtkh::DataSet*> &m_data_sets;
@@ -136,43 +523,53 @@ public:
     input.CastAndCall(func);
   }
 
+  // kinds of slices we know how to merge
+  enum { SKIPPED, TRIANGLES, STRUCTURED };
+
+  template<typename T>
+  struct CopyInto
+  {
+    vtkm::cont::ArrayHandle<T> m_output;
+    vtkm::Id m_offset;
+    bool m_split_quads;
+
+    template<typename S>
+    void operator()(const vtkm::cont::ArrayHandle<T,S> &input)
+    {
+      vtkm::Id start = 0;
+      vtkm::Id copy_size = input.GetNumberOfValues();
+      if(m_split_quads)
+      {
+        // both triangles of a quad get the value of the quad
+        copy_size *= 2;
+        auto split = vtkm::cont::make_ArrayHandlePermutation(
+                       vtkm::cont::make_ArrayHandleImplicit(HalfIndex(), copy_size),
+                       input);
+        vtkm::cont::Algorithm::CopySubRange(split, start, copy_size, m_output, m_offset);
+      }
+      else
+      {
+        vtkm::cont::Algorithm::CopySubRange(input, start, copy_size, m_output, m_offset);
+      }
+    }
+  };
+
   struct CopyField
   {
     vtkm::cont::DataSet &m_data_set;
-    std::vector<vtkm::cont::DataSet> m_in_data_sets;
-    vtkm::Id *m_point_offsets;
-    vtkm::Id *m_cell_offsets;
-    vtkm::Id  m_field_index;
+    const std::vector<vtkm::cont::DataSet> &m_in_data_sets;
+    const std::vector<int> &m_kinds;
+    const std::vector<vtkm::Id> &m_point_offsets;
+    const std::vector<vtkm::Id> &m_cell_offsets;
+    std::string m_field_name;
+    vtkm::cont::Field::Association m_assoc;
     vtkm::Id  m_num_points;
     vtkm::Id  m_num_cells;
 
-    CopyField(vtkm::cont::DataSet &data_set,
-              std::vector<vtkm::cont::DataSet> in_data_sets,
-              vtkm::Id *point_offsets,
-              vtkm::Id *cell_offsets,
-              vtkm::Id num_points,
-              vtkm::Id num_cells,
-              vtkm::Id field_index)
-      : m_data_set(data_set),
-        m_in_data_sets(in_data_sets),
-        m_point_offsets(point_offsets),
-        m_cell_offsets(cell_offsets),
-        m_field_index(field_index),
-        m_num_points(num_points),
-        m_num_cells(num_cells)
-    {}
-
     template<typename T, typename S>
     void operator()(const vtkm::cont::ArrayHandle<T,S> &vtkmNotUsed(field)) const
     {
-      //check to see if this is a supported field ;
-      const vtkm::cont::Field &scalar_field = m_in_data_sets[0].GetField(m_field_index);
-      bool is_supported = (scalar_field.GetAssociation() == vtkm::cont::Field::Association::Points ||
-                           scalar_field.GetAssociation() == vtkm::cont::Field::Association::Cells);
-
-      if(!is_supported) return;
-
-      bool assoc_points = scalar_field.GetAssociation() == vtkm::cont::Field::Association::Points;
+      const bool assoc_points = m_assoc == vtkm::cont::Field::Association::Points;
       vtkm::cont::ArrayHandle<T> out;
       if(assoc_points)
       {
@@ -185,31 +582,53 @@ public:
 
       for(size_t i = 0; i < m_in_data_sets.size(); ++i)
       {
-        const vtkm::cont::Field &f = m_in_data_sets[i].GetField(m_field_index);
-        vtkm::cont::ArrayHandle<T,S> in = f.GetData().AsArrayHandle<vtkm::cont::ArrayHandle<T,S>>();
-        vtkm::Id start = 0;
-        vtkm::Id copy_size = in.GetNumberOfValues();
-        vtkm::Id offset = assoc_points ? m_point_offsets[i] : m_cell_offsets[i];
-
-        vtkm::cont::Algorithm::CopySubRange(in, start, copy_size, out, offset);
+        if(m_kinds[i] == SKIPPED)
+        {
+          continue;
+        }
+        CopyInto<T> copier{out,
+                           assoc_points ? m_point_offsets[i] : m_cell_offsets[i],
+                           !assoc_points && m_kinds[i] == STRUCTURED};
+        const vtkm::cont::Field &f = m_in_data_sets[i].GetField(m_field_name);
+        f.GetData().ResetTypes(vtkm::List<T>(),VTKM_DEFAULT_STORAGE_LIST{}).CastAndCall(copier);
       }
 
-      vtkm::cont::Field out_field(scalar_field.GetName(),
-                                  scalar_field.GetAssociation(),
-                                  out);
+      vtkm::cont::Field out_field(m_field_name, m_assoc, out);
       m_data_set.AddField(out_field);
-
     }
   };
 
+  vtkm::cont::DataSet WithoutSkipField(const vtkm::cont::DataSet &dom)
+  {
+    vtkm::cont::DataSet res;
+    res.CopyStructure(dom);
+    const int num_fields = dom.GetNumberOfFields();
+    for(int f = 0; f < num_fields; ++f)
+    {
+      const vtkm::cont::Field &field = dom.GetField(f);
+      if(field.GetName() != m_skip_field)
+      {
+        res.AddField(field);
+      }
+    }
+    return res;
+  }
+
   vtkm::cont::DataSet MergeDomains(std::vector<vtkm::cont::DataSet> &doms)
   {
+    // a domain cut by a single plane needs no merging
+    if(doms.size() == 1)
+    {
+      return WithoutSkipField(doms[0]);
+    }
+
     vtkm::cont::DataSet res;
 
     vtkm::Id num_cells = 0;
     vtkm::Id num_points = 0;
-    std::vector<vtkm::Id> cell_offsets(doms.size());
-    std::vector<vtkm::Id> point_offsets(doms.size());
+    std::vector<vtkm::Id> cell_offsets(doms.size(), 0);
+    std::vector<vtkm::Id> point_offsets(doms.size(), 0);
+    std::vector<int> kinds(doms.size(), SKIPPED);
 
     for(size_t dom = 0; dom < doms.size(); ++dom)
     {
@@ -221,7 +640,18 @@ public:
       // this output will be all triangles.
       // this becomes more complicated if we want to support mixed types
       //if(!cell_set.IsType(vtkm::cont::CellSetSingleType<>())) continue;
-      if(!cell_set.IsType<vtkm::cont::CellSetExplicit<>>())
+      vtkm::Id dom_cells = cell_set.GetNumberOfCells();
+      if(cell_set.IsType<vtkm::cont::CellSetExplicit<>>())
+      {
+        kinds[dom] = TRIANGLES;
+      }
+      else if(cell_set.IsType<vtkm::cont::CellSetStructured<2>>())
+      {
+        // slices of structured domains are split into triangles
+        kinds[dom] = STRUCTURED;
+        dom_cells *= 2;
+      }
+      else
       {
         std::cout<<"expected explicit cell set as the result of contour\n";
 
@@ -229,7 +659,7 @@ public:
       }
 
       cell_offsets[dom] = num_cells;
-      num_cells += cell_set.GetNumberOfCells();
+      num_cells += dom_cells;
 
       auto coords = doms[dom].GetCoordinateSystem();
       point_offsets[dom] = num_points;
@@ -246,59 +676,53 @@ public:
     // handle coordinate merging
     vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float64, 3>> out_coords;
     out_coords.Allocate(num_points);
-    // coordinate type that contour produces
-    //using CoordsType3f = vtkm::cont::ArrayHandleVirtual<vtkm::Vec<vtkm::Float32,3>>;
-    //using CoordsType3d = vtkm::cont::ArrayHandleVirtual<vtkm::Vec<vtkm::Float64,3>>;
 
     for(size_t dom = 0; dom < doms.size(); ++dom)
     {
       auto cell_set = doms[dom].GetCellSet();
 
-      //if(!cell_set.IsType(vtkm::cont::CellSetSingleType<>())) continue;
-      if(!cell_set.IsType<vtkm::cont::CellSetExplicit<>>())
+      if(kinds[dom] == SKIPPED)
       {
-        std::cout<<"expected explicit cell set as the result of contour\n";
         continue;
       }
 
-      // grab the connectivity and copy it into the larger array
-      //vtkm::cont::CellSetSingleType<> single_type = cell_set.Cast<vtkm::cont::CellSetSingleType<>>();
-      vtkm::cont::CellSetExplicit<> single_type =
-        cell_set.AsCellSet<vtkm::cont::CellSetExplicit<>>();
-      const vtkm::cont::ArrayHandle<vtkm::Id> dconn = single_type.GetConnectivityArray(
-        vtkm::TopologyElementTagCell(),
-        vtkm::TopologyElementTagPoint());
-
-      vtkm::Id copy_size = dconn.GetNumberOfValues();
-      vtkm::Id start = 0;
-
-      vtkm::cont::Algorithm::CopySubRange(dconn, start, copy_size, conn, cell_offsets[dom]*3);
-      // now we offset the connectiviy we just copied in so we references the
-      // correct points
-      if(cell_offsets[dom] != 0)
+      if(kinds[dom] == STRUCTURED)
       {
-        vtkm::cont::ArrayHandleCounting<vtkm::Id> indexes(cell_offsets[dom]*3, 1, copy_size);
-        vtkm::worklet::DispatcherMapField<detail::Offset>(detail::Offset(point_offsets[dom]))
-          .Invoke(indexes, conn);
+        vtkm::cont::CellSetStructured<2> structured =
+          cell_set.AsCellSet<vtkm::cont::CellSetStructured<2>>();
+        const vtkm::Id num_quads = structured.GetNumberOfCells();
+        vtkm::worklet::DispatcherMapField<detail::QuadTriangles>(
+            detail::QuadTriangles(structured.GetPointDimensions()[0],
+                                  cell_offsets[dom] * 3,
+                                  point_offsets[dom]))
+          .Invoke(vtkm::cont::ArrayHandleIndex(num_quads), conn);
+      }
+      else
+      {
+        // grab the connectivity and copy it into the larger array
+        vtkm::cont::CellSetExplicit<> single_type =
+          cell_set.AsCellSet<vtkm::cont::CellSetExplicit<>>();
+        const vtkm::cont::ArrayHandle<vtkm::Id> dconn = single_type.GetConnectivityArray(
+          vtkm::TopologyElementTagCell(),
+          vtkm::TopologyElementTagPoint());
+
+        vtkm::Id copy_size = dconn.GetNumberOfValues();
+        vtkm::Id start = 0;
+
+        vtkm::cont::Algorithm::CopySubRange(dconn, start, copy_size, conn, cell_offsets[dom]*3);
+        // now we offset the connectiviy we just copied in so we references the
+        // correct points
+        if(cell_offsets[dom] != 0)
+        {
+          vtkm::cont::ArrayHandleCounting<vtkm::Id> indexes(cell_offsets[dom]*3, 1, copy_size);
+          vtkm::worklet::DispatcherMapField<detail::Offset>(detail::Offset(point_offsets[dom]))
+            .Invoke(indexes, conn);
+        }
       }
 
       // merge coodinates
       auto coords = doms[dom].GetCoordinateSystem().GetData();
       this->CopyCoords(coords, out_coords, point_offsets[dom]);
-      //if(coords == CoordsType3f())
-      //{
-      //  CoordsType3f in = coords.Cast<CoordsType3f>();
-      //  this->CopyCoords(in, out_coords, point_offsets[dom]);
-      //}
-      //if(coords.IsType<CoordsType3d>())
-      //{
-      //  CoordsType3d in = coords.Cast<CoordsType3d>();
-      //  this->CopyCoords(in, out_coords, point_offsets[dom]);
-      //}
-      //else
-      //{
-      //  throw Error("Merge contour: unknown coordinate type");
-      //}
 
     } // for each domain
 
@@ -309,7 +733,9 @@ public:
 
     res.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", out_coords));
 
-    // handle fields, they are all the same since they came from the same data set
+    // handle fields. Contour and the structured slices keep the fields
+    // of the data set, but look them up by name since their order can
+    // differ and the slice field only exists on contoured domains
     const int num_fields = doms[0].GetNumberOfFields();
 
     for(int f = 0; f < num_fields; ++f)
@@ -318,13 +744,30 @@ public:
 
       if(field.GetName() == m_skip_field) continue;
 
-      CopyField copier(res,
+      const bool is_supported = (field.GetAssociation() == vtkm::cont::Field::Association::Points ||
+                                 field.GetAssociation() == vtkm::cont::Field::Association::Cells);
+      if(!is_supported) continue;
+
+      bool everywhere = true;
+      for(size_t dom = 1; dom < doms.size(); ++dom)
+      {
+        if(kinds[dom] != SKIPPED &&
+           !doms[dom].HasField(field.GetName(), field.GetAssociation()))
+        {
+          everywhere = false;
+        }
+      }
+      if(!everywhere) continue;
+
+      CopyField copier{res,
                        doms,
-                       &point_offsets[0],
-                       &cell_offsets[0],
+                       kinds,
+                       point_offsets,
+                       cell_offsets,
+                       field.GetName(),
+                       field.GetAssociation(),
                        num_points,
-                       num_cells,
-                       f);
+                       num_cells};
 
       auto full = field.GetData().ResetTypes(vtkm::TypeListCommon(),VTKM_DEFAULT_STORAGE_LIST{});
       full.CastAndCall(copier);
@@ -488,28 +931,65 @@ Slice::DoExecute()
   {
     vtkm::Vec<vtkm::Float32,3> point = m_points[s];
     vtkm::Vec<vtkm::Float32,3> normal = m_normals[s];
-    vtkh::DataSet temp_ds = *(this->m_input);
-    // shallow copy the input so we don't propagate the slice field
-    // to the input data set, since it might be used in other places
+    const int axis = detail::AlignedAxis(normal);
+
+    // domains the plane crosses that need a contour, and the
+    // slices of uniform and rectilinear domains cut along an axis
+    vtkh::DataSet temp_ds;
+    std::vector<vtkm::cont::DataSet> structured_slices;
+    std::vector<vtkm::Id> structured_ids;
     for(int i = 0; i < num_domains; ++i)
     {
-      vtkm::cont::DataSet &dom = temp_ds.GetDomain(i);
+      if(!detail::PlaneIntersects(this->m_input->GetDomainBounds(i), point, normal))
+      {
+        continue;
+      }
+
+      vtkm::Id domain_id;
+      vtkm::cont::DataSet dom;
+      this->m_input->GetDomain(i, dom, domain_id);
 
+      vtkm::cont::DataSet structured_slice;
+      if(axis != -1 &&
+         detail::SliceStructured(dom, axis, point[axis], structured_slice))
+      {
+        structured_slices.push_back(structured_slice);
+        structured_ids.push_back(domain_id);
+        continue;
+      }
+
+      // dom is a shallow copy, so we don't propagate the slice field
+      // to the input data set, since it might be used in other places
       vtkm::cont::ArrayHandle<vtkm::Float32> slice_field;
       vtkm::worklet::DispatcherMapField<detail::SliceField>(detail::SliceField(point, normal))
         .Invoke(dom.GetCoordinateSystem().GetData(), slice_field);
 
       dom.AddField(vtkm::cont::Field(fname,
-                                      vtkm::cont::Field::Association::Points,
-                                      slice_field));
+                                     vtkm::cont::Field::Association::Points,
+                                     slice_field));
+      temp_ds.AddDomain(dom, domain_id);
     } // each domain
 
-    vtkh::MarchingCubes marcher;
-    marcher.SetInput(&temp_ds);
-    marcher.SetIsoValue(0.);
-    marcher.SetField(fname);
-    marcher.Update();
-    slices.push_back(marcher.GetOutput());
+    vtkh::DataSet *slice = nullptr;
+    if(temp_ds.GetGlobalNumberOfDomains() > 0)
+    {
+      vtkh::MarchingCubes marcher;
+      marcher.SetInput(&temp_ds);
+      marcher.SetIsoValue(0.);
+      marcher.SetField(fname);
+      marcher.Update();
+      slice = marcher.GetOutput();
+    }
+    else
+    {
+      slice = new vtkh::DataSet();
+    }
+
+    for(size_t i = 0; i < structured_slices.size(); ++i)
+    {
+      slice->AddDomain(structured_slices[i], structured_ids[i]);
+    }
+    slices.push_back(slice);
   } // each slice
 
   if(slices.size() > 1)
@@ -520,6 +1000,7 @@ Slice::DoExecute()
   else
   {
     this->m_output = slices[0];
+    this->m_output->RemoveField(fname);
   }
 }
 
@@ -12,14 +12,63 @@ class VTKH_API Statistics
 {
 public:
 
+  // Central moments of a set of values. Moments of disjoint sets are
+  // merged with Combine (Chan et al. / Pebay), so they can be built in
+  // one pass and reduced over values, domains and ranks in any order.
+  struct Moments
+  {
+    vtkm::Id      n;
+    vtkm::Float64 mean;
+    vtkm::Float64 M2;
+    vtkm::Float64 M3;
+    vtkm::Float64 M4;
+
+    VTKM_EXEC_CONT Moments()
+      : n(0), mean(0), M2(0), M3(0), M4(0)
+    {}
+
+    VTKM_EXEC_CONT explicit Moments(const vtkm::Float64 value)
+      : n(1), mean(value), M2(0), M3(0), M4(0)
+    {}
+
+    VTKM_EXEC_CONT static Moments Combine(const Moments &a, const Moments &b)
+    {
+      if(a.n == 0) return b;
+      if(b.n == 0) return a;
+
+      const vtkm::Float64 na = static_cast<vtkm::Float64>(a.n);
+      const vtkm::Float64 nb = static_cast<vtkm::Float64>(b.n);
+      const vtkm::Float64 n = na + nb;
+      const vtkm::Float64 delta = b.mean - a.mean;
+      const vtkm::Float64 delta_n = delta / n;
+      const vtkm::Float64 delta_n2 = delta_n * delta_n;
+      const vtkm::Float64 term1 = delta * delta_n * na * nb;
+
+      Moments res;
+      res.n = a.n + b.n;
+      res.mean = a.mean + nb * delta_n;
+      res.M4 = a.M4 + b.M4
+             + term1 * delta_n2 * (na * na - na * nb + nb * nb)
+             + 6. * delta_n2 * (na * na * b.M2 + nb * nb * a.M2)
+             + 4. * delta_n * (na * b.M3 - nb * a.M3);
+      res.M3 = a.M3 + b.M3
+             + term1 * delta_n * (na - nb)
+             + 3. * delta_n * (na * b.M2 - nb * a.M2);
+      res.M2 = a.M2 + b.M2 + term1;
+      return res;
+    }
+  };
+
   struct Result
   {
-    vtkm::Float32 mean;
-    vtkm::Float32 variance;
-    vtkm::Float32 skewness;
-    vtkm::Float32 kurtosis;
+    vtkm::Id      count;
+    vtkm::Float64 mean;
+    vtkm::Float64 variance;
+    vtkm::Float64 skewness;
+    vtkm::Float64 kurtosis;
     void Print(std::ostream &out)
     {
+      out<<"Count   : "<<count<<"\n";
       out<<"Mean    : "<<mean<<"\n";
       out<<"Variance: "<<variance<<"\n";
       out<<"Skewness: "<<skewness<<"\n";
@@ -31,6 +80,10 @@ public:
   ~Statistics();
   Statistics::Result Run(vtkh::DataSet &data_set, const std::string field_name);
 
+  // one pass over every domain with the field, merged across ranks
+  // with a single collective
+  static Moments GlobalMoments(vtkh::DataSet &data_set, const std::string &field_name);
+
 };
 
 } //namespace vtkh
@@ -2,6 +2,7 @@
 #include <vtkh/filters/WarpXStreamline.hpp>
 #include <vtkm/filter/flow/WarpXStreamline.h>
 #include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 
@@ -123,8 +124,10 @@ void WarpXStreamline::DoExecute()
       {
         vtkm::cont::ArrayHandle<vtkm::Vec3f> pos, mom;
         vtkm::cont::ArrayHandle<vtkm::Float64> mass, charge, w;
-        dom.GetCoordinateSystem().GetData().AsArrayHandle(pos);
-        dom.GetField(m_momentum_field_name).GetData().AsArrayHandle(mom);
+        // positions and momentum can be soa arrays, only copy when
+        // they are not already basic
+        vtkm::cont::ArrayCopyShallowIfPossible(dom.GetCoordinateSystem().GetData(), pos);
+        vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField(m_momentum_field_name).GetData(), mom);
         dom.GetField(m_mass_field_name).GetData().AsArrayHandle(mass);
         dom.GetField(m_charge_field_name).GetData().AsArrayHandle(charge);
         dom.GetField(m_weighting_field_name).GetData().AsArrayHandle(w);
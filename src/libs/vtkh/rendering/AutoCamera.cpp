@@ -2,7 +2,9 @@
 #include "vtkh/rendering/ScalarRenderer.hpp"
 #include <vtkh/Error.hpp>
 
+#include <algorithm>
 #include <math.h>
+#include <numeric>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -393,52 +395,41 @@ double
 calculateDataEntropy(vtkh::DataSet* dataset, std::string field_name, double field_min, double field_max, int bins)
 {
   double entropy = 0.0;
-  int rank = 0;
-  #if VTKH_PARALLEL 
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Comm_rank(mpi_comm, &rank);
-  #endif
 //dataset->PrintSummary(std::cerr);
   using data_d = vtkm::cont::ArrayHandle<vtkm::Float64>;
   using data_f = vtkm::cont::ArrayHandle<vtkm::Float32>;
   
-  if(rank == 0)
-  {
-    vtkm::cont::Field field = dataset->GetField(field_name,0);
+  vtkm::cont::Field field = dataset->GetField(field_name,0);
 
-    if(field.GetData().IsType<data_d>())
+  if(field.GetData().IsType<data_d>())
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, field_name.c_str());
+    if (field_data.GetNumberOfValues() > 0) 
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, field_name.c_str());
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckZero;
-        field_data = copyWithChecks<vtkm::Float64>(field_data, checks);
-        entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, field_min, field_max);
-      } 
-      else
-      {
-        entropy = 0;
-      }
+      DataCheckFlags checks = CheckNan | CheckZero;
+      field_data = copyWithChecks<vtkm::Float64>(field_data, checks);
+      entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, field_min, field_max);
+    } 
+    else
+    {
+      entropy = 0;
     }
+  }
+  else
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, field_name.c_str());
+    if (field_data.GetNumberOfValues() > 0) 
+    {
+      DataCheckFlags checks = CheckNan | CheckZero;
+      field_data = copyWithChecks<vtkm::Float32>(field_data, checks);
+      entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, vtkm::Float32(field_min), vtkm::Float32(field_max));
+    } 
     else
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, field_name.c_str());
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckZero;
-        field_data = copyWithChecks<vtkm::Float32>(field_data, checks);
-        entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, vtkm::Float32(field_min), vtkm::Float32(field_max));
-      } 
-      else
-      {
-        entropy = 0;
-      }
+      entropy = 0;
     }
   }
 
-  #if VTKH_PARALLEL
-  MPI_Bcast(&entropy, 1, MPI_DOUBLE, 0, mpi_comm);
-  #endif
   return entropy;
 }
 
@@ -447,59 +438,48 @@ calculateDepthEntropy(vtkh::DataSet* dataset, std::string field_name, double dia
 {
 
   double entropy = 0.0;
-  int rank = 0;
-  #if VTKH_PARALLEL 
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Comm_rank(mpi_comm, &rank);
-  #endif
 
   using data_d = vtkm::cont::ArrayHandle<vtkm::Float64>;
   using data_f = vtkm::cont::ArrayHandle<vtkm::Float32>;
 
-  if(rank == 0)
-  {
-    vtkm::cont::Field field = dataset->GetField(field_name,0);
+  vtkm::cont::Field field = dataset->GetField(field_name,0);
 
-    if(field.GetData().IsType<data_d>())
+  if(field.GetData().IsType<data_d>())
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, "depth");
+    if (field_data.GetNumberOfValues() > 0) 
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, "depth");
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
-        DataCheckVals<vtkm::Float64> checkVals; 
+      DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
+      DataCheckVals<vtkm::Float64> checkVals; 
 	checkVals.Min = 0;
-       	checkVals.Max = vtkm::Float64(INT_MAX);
-        field_data = copyWithChecks<vtkm::Float64>(field_data, checks, checkVals);
+     	checkVals.Max = vtkm::Float64(INT_MAX);
+      field_data = copyWithChecks<vtkm::Float64>(field_data, checks, checkVals);
 	vtkm::Float64 min = 0.0;
-        entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, min, diameter);
-      } 
-      else
-      {
-        entropy = 0;
-      }
-    }
+      entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, min, diameter);
+    } 
     else
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, "depth");
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
-        DataCheckVals<vtkm::Float32> checkVals; 
+      entropy = 0;
+    }
+  }
+  else
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, "depth");
+    if (field_data.GetNumberOfValues() > 0) 
+    {
+      DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
+      DataCheckVals<vtkm::Float32> checkVals; 
 	checkVals.Min = 0;
-       	checkVals.Max = vtkm::Float32(INT_MAX);
-        field_data = copyWithChecks<vtkm::Float32>(field_data, checks, checkVals);
+     	checkVals.Max = vtkm::Float32(INT_MAX);
+      field_data = copyWithChecks<vtkm::Float32>(field_data, checks, checkVals);
 	vtkm::Float32 min = 0.0;
-        entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, min, vtkm::Float32(diameter));
-      } 
-      else
-      {
-        entropy = 0;
-      }
+      entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, min, vtkm::Float32(diameter));
+    } 
+    else
+    {
+      entropy = 0;
     }
   }
-  #if VTKH_PARALLEL
-  MPI_Bcast(&entropy, 1, MPI_DOUBLE, 0, mpi_comm);
-  #endif
   return entropy;
 }
 
@@ -508,61 +488,50 @@ calculateShadingEntropy(vtkh::DataSet* dataset, std::string field_name, int bins
 {
 
   double entropy = 0.0;
-  int rank = 0;
-  #if VTKH_PARALLEL 
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Comm_rank(mpi_comm, &rank);
-  #endif
 
   using data_d = vtkm::cont::ArrayHandle<vtkm::Float64>;
   using data_f = vtkm::cont::ArrayHandle<vtkm::Float32>;
 
-  if(rank == 0)
-  {
-    vtkm::cont::Field field = dataset->GetField(field_name,0);
+  vtkm::cont::Field field = dataset->GetField(field_name,0);
 
-    if(field.GetData().IsType<data_d>())
+  if(field.GetData().IsType<data_d>())
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, "shading");
+    if (field_data.GetNumberOfValues() > 0) 
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float64>(*dataset, "shading");
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
-        DataCheckVals<vtkm::Float64> checkVals; 
+      DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
+      DataCheckVals<vtkm::Float64> checkVals; 
 	checkVals.Min = 0;
-       	checkVals.Max = vtkm::Float64(INT_MAX);
-        field_data = copyWithChecks<vtkm::Float64>(field_data, checks, checkVals);
+     	checkVals.Max = vtkm::Float64(INT_MAX);
+      field_data = copyWithChecks<vtkm::Float64>(field_data, checks, checkVals);
 	vtkm::Float32 min = 0.0;
 	vtkm::Float32 max = 1.0;
-        entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, min, max);
-      } 
-      else
-      {
-        entropy = 0;
-      }
-    }
+      entropy = calcEntropyMM<vtkm::Float64>(field_data, bins, min, max);
+    } 
     else
     {
-      auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, "shading");
-      if (field_data.GetNumberOfValues() > 0) 
-      {
-        DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
-        DataCheckVals<vtkm::Float32> checkVals; 
+      entropy = 0;
+    }
+  }
+  else
+  {
+    auto field_data = GetScalarDataAsArrayHandle<vtkm::Float32>(*dataset, "shading");
+    if (field_data.GetNumberOfValues() > 0) 
+    {
+      DataCheckFlags checks = CheckNan | CheckMinExclusive | CheckMaxExclusive;
+      DataCheckVals<vtkm::Float32> checkVals; 
 	checkVals.Min = 0;
-       	checkVals.Max = vtkm::Float32(INT_MAX);
-        field_data = copyWithChecks<vtkm::Float32>(field_data, checks, checkVals);
+     	checkVals.Max = vtkm::Float32(INT_MAX);
+      field_data = copyWithChecks<vtkm::Float32>(field_data, checks, checkVals);
 	vtkm::Float32 min = 0.0;
 	vtkm::Float32 max = 1.0;
-        entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, min, max);
-      } 
-      else
-      {
-        entropy = 0;
-      }
+      entropy = calcEntropyMM<vtkm::Float32>(field_data, bins, min, max);
+    } 
+    else
+    {
+      entropy = 0;
     }
   }
-  #if VTKH_PARALLEL
-  MPI_Bcast(&entropy, 1, MPI_DOUBLE, 0, mpi_comm);
-  #endif
   return entropy;
 }
 
@@ -609,12 +578,68 @@ calculateDiameter(vtkm::Bounds bounds, double &diameter)
 
 }
 
+//
+// Renders every camera with one scalar renderer, so the acceleration
+// structures are built once, and scores the views on rank 0 where the
+// composited images land. All the scores are sent back in one broadcast.
+//
+std::vector<double>
+scoreViews(vtkh::DataSet *input,
+           std::vector<vtkmCamera> &cameras,
+           int width,
+           int height,
+           int batch_size,
+           std::string metric,
+           std::string field_name,
+           vtkm::Float64 field_min,
+           vtkm::Float64 field_max,
+           double diameter,
+           int bins)
+{
+  const int num_views = static_cast<int>(cameras.size());
+  std::vector<double> scores(num_views, 0.0);
+
+  vtkh::ScalarRenderer tracer;
+  tracer.SetWidth(width);
+  tracer.SetHeight(height);
+  tracer.SetBatchSize(batch_size);
+  tracer.SetInput(input);
+  tracer.SetCameras(cameras);
+  tracer.Update();
+
+  vtkh::DataSet *output = tracer.GetOutput();
+  // the domain id of each image is the index of its camera
+  for(int view = 0; view < num_views; ++view)
+  {
+    if(!output->HasDomainId(view))
+    {
+      continue;
+    }
+    vtkh::DataSet image;
+    image.AddDomain(output->GetDomainById(view), 0);
+    scores[view] = calculateMetricScore(&image, metric, field_name,
+                                        field_min, field_max, diameter,
+                                        bins);
+  }
+  delete output;
+
+#ifdef VTKH_PARALLEL
+  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
+  MPI_Bcast(&scores[0], num_views, MPI_DOUBLE, 0, mpi_comm);
+#endif
+  return scores;
+}
+
 } // namespace detail
 
 AutoCamera::AutoCamera()
   : m_bins(256),
     m_height(1024),
-    m_width(1024)
+    m_width(1024),
+    m_samples(1),
+    m_batch_size(8),
+    m_coarse_scale(1),
+    m_refine(4)
 {
 
 }
@@ -696,6 +721,42 @@ AutoCamera::GetWidth()
   return m_width;
 }
 
+void
+AutoCamera::SetBatchSize(int batch_size)
+{
+  m_batch_size = batch_size;
+}
+
+int
+AutoCamera::GetBatchSize()
+{
+  return m_batch_size;
+}
+
+void
+AutoCamera::SetCoarseScale(int scale)
+{
+  m_coarse_scale = scale;
+}
+
+int
+AutoCamera::GetCoarseScale()
+{
+  return m_coarse_scale;
+}
+
+void
+AutoCamera::SetNumRefine(int refine)
+{
+  m_refine = refine;
+}
+
+int
+AutoCamera::GetNumRefine()
+{
+  return m_refine;
+}
+
 vtkmCamera
 AutoCamera::GetCamera()
 {
@@ -711,15 +772,22 @@ AutoCamera::PreExecute()
 void
 AutoCamera::DoExecute()
 {
+  if(m_samples < 1)
+  {
+    std::stringstream msg;
+    msg<<"AutoCamera: the number of samples must be positive, got "<<m_samples;
+    throw Error(msg.str());
+  }
+  // scores are only computed on rank 0, so catch a bad
+  // metric here while every rank can still throw
+  if(m_metric != "data_entropy" && m_metric != "dds_entropy" &&
+     m_metric != "shading_entropy" && m_metric != "depth_entropy")
+  {
+    std::stringstream msg;
+    msg<< "This metric '" << m_metric << "' is not supported. \n";
+    throw Error(msg.str());
+  }
 
-  int rank = 0;
-  int world_size = 0;
-  #if VTKH_PARALLEL
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Comm_size(mpi_comm, &world_size);
-  MPI_Comm_rank(mpi_comm, &rank);
-  #endif
-  
   vtkm::Range range = this->m_input->GetGlobalRange(m_field).ReadPortal().Get(0);
   vtkm::Float64 field_min = range.Min;
   vtkm::Float64 field_max = range.Max;
@@ -728,63 +796,62 @@ AutoCamera::DoExecute()
   double diameter = 0.0;
   detail::calculateDiameter(g_bounds, diameter);
 
-  vtkmCamera *camera = new vtkmCamera;
-  camera->ResetToBounds(g_bounds);
-  vtkm::Vec<vtkm::Float32,3> lookat = camera->GetLookAt();
+  vtkmCamera camera;
+  camera.ResetToBounds(g_bounds);
+  vtkm::Vec<vtkm::Float32,3> lookat = camera.GetLookAt();
   float focus[3] = {lookat[0],lookat[1],lookat[2]};
 
-  double winning_score  = -1;
-  double losing_score   = 10000;
-  int   winning_sample = -1;
-  int   losing_sample  = -1;
-
-  int count = 0;
-
-  //loop through number of camera samples.
+  std::vector<vtkmCamera> cameras(m_samples, camera);
   for(int sample = 0; sample < m_samples; sample++)
   {
-  /*================ Scalar Renderer Code ======================*/
-
     double cam_pos[3];
     detail::GetCamera(sample, m_samples, diameter, focus, cam_pos);
     vtkm::Vec<vtkm::Float64, 3> pos{cam_pos[0],
                             cam_pos[1],
                             cam_pos[2]};
+    cameras[sample].SetPosition(pos);
+  }
 
-    camera->SetPosition(pos);
-    vtkh::ScalarRenderer tracer;
-    tracer.SetWidth(m_width);
-    tracer.SetHeight(m_height);
-    tracer.SetInput(this->m_input); //vtkh dataset by toponame
-    tracer.SetCamera(*camera);
-    tracer.Update();
-
-    vtkh::DataSet *output = tracer.GetOutput();
-    //output->PrintSummary(std::cerr);
+  // the samples that get scored at full resolution
+  std::vector<int> candidates(m_samples);
+  std::iota(candidates.begin(), candidates.end(), 0);
 
-    double score = detail::calculateMetricScore(output, m_metric, m_field, 
-						field_min, field_max, diameter, 
-						m_bins);
-    
-    //std::cerr << "sample " << sample << " score: " << score << std::endl;
+  const int coarse_width = m_coarse_scale > 1 ? m_width / m_coarse_scale : 0;
+  const int coarse_height = m_coarse_scale > 1 ? m_height / m_coarse_scale : 0;
+  if(m_refine < m_samples && coarse_width > 0 && coarse_height > 0)
+  {
+    // rank every sample on small images and only keep the best ones
+    std::vector<double> coarse_scores
+      = detail::scoreViews(this->m_input, cameras, coarse_width, coarse_height,
+                           m_batch_size, m_metric, m_field, field_min, field_max,
+                           diameter, m_bins);
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](int a, int b) { return coarse_scores[a] > coarse_scores[b]; });
+    candidates.resize(std::max(m_refine, 1));
+    std::sort(candidates.begin(), candidates.end());
+  }
 
-    delete output;
+  std::vector<vtkmCamera> refine_cameras;
+  for(size_t i = 0; i < candidates.size(); ++i)
+  {
+    refine_cameras.push_back(cameras[candidates[i]]);
+  }
 
-  /*================ End Scalar Renderer  ======================*/
+  std::vector<double> scores
+    = detail::scoreViews(this->m_input, refine_cameras, m_width, m_height,
+                         m_batch_size, m_metric, m_field, field_min, field_max,
+                         diameter, m_bins);
 
-    //original
-    if(winning_score < score)
-    {
-      winning_score = score;
-      winning_sample = sample;
-    }
-    if(losing_score > score)
+  double winning_score  = -1;
+  int   winning_sample = -1;
+  for(size_t i = 0; i < candidates.size(); ++i)
+  {
+    if(winning_score < scores[i])
     {
-      losing_score = score;
-      losing_sample = sample;
+      winning_score = scores[i];
+      winning_sample = candidates[i];
     }
-    count++;
-  } //end of sample loop
+  }
 
   if(winning_sample == -1)
   {
@@ -793,16 +860,7 @@ AutoCamera::DoExecute()
     throw Error(msg.str());
   }
 
-  //std::cerr << "winner is sample " << winning_sample << " with score: " << winning_score << std::endl;
-
-  double best_c[3];
-  detail::GetCamera(winning_sample, m_samples, diameter, focus, best_c);
-
-  vtkm::Vec<vtkm::Float64, 3> pos{best_c[0], 
-				best_c[1], 
-				best_c[2]}; 
-  camera->SetPosition(pos);
-  m_camera = *camera;
+  m_camera = cameras[winning_sample];
 
   this->m_output = this->m_input;
 }
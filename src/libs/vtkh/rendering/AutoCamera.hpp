@@ -26,6 +26,9 @@ public:
   int GetNumBins();
   int GetHeight();
   int GetWidth();
+  int GetBatchSize();
+  int GetCoarseScale();
+  int GetNumRefine();
 
   vtkmCamera GetCamera();
 
@@ -35,7 +38,14 @@ public:
   void SetNumBins(int bins);
   void SetHeight(int height);
   void SetWidth(int width);
-  
+  // number of views composited together in one exchange
+  void SetBatchSize(int batch_size);
+  // When scale > 1, every sample is first scored on images scale times
+  // smaller and only the best 'refine' samples are rendered at full
+  // resolution to pick the winner.
+  void SetCoarseScale(int scale);
+  void SetNumRefine(int refine);
+
 protected:
   void PreExecute() override;
   void PostExecute() override;
@@ -44,6 +54,9 @@ protected:
   int m_height;
   int m_width;
   int m_samples;
+  int m_batch_size;
+  int m_coarse_scale;
+  int m_refine;
   std::string m_field;
   std::string m_metric;
   vtkmCamera m_camera;
@@ -0,0 +1,332 @@
+#include "ImageWriter.hpp"
+#include <vtkh/Error.hpp>
+#include <png_utils/ascent_png_encoder.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace vtkh
+{
+
+namespace detail
+{
+
+struct ImageJob
+{
+  std::vector<float> m_rgba;
+  int m_width;
+  int m_height;
+  std::vector<std::string> m_comments;
+  std::string m_file_name;
+};
+
+void
+encode_and_save(const float *rgba,
+                const int width,
+                const int height,
+                const std::vector<std::string> &comments,
+                const std::string &file_name,
+                const bool parallel_strips)
+{
+  ascent::PNGEncoder encoder;
+  if(parallel_strips)
+  {
+    // 1MB strips are large enough to keep the compression ratio
+    encoder.SetStripSize(1 << 20);
+  }
+  encoder.Encode(rgba, width, height, comments);
+  encoder.Save(file_name);
+}
+
+class ImageQueue
+{
+public:
+  ImageQueue()
+    : m_async(false),
+      m_async_refs(0),
+      m_num_threads(4),
+      m_queue_size(16),
+      m_active(0),
+      m_stop(false)
+  {
+  }
+
+  ~ImageQueue()
+  {
+    // don't throw from the destructor, just drain and join
+    StopWorkers();
+  }
+
+  void Push(ImageJob &job)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_workers.size() == 0)
+    {
+      m_stop = false;
+      for(int i = 0; i < m_num_threads; ++i)
+      {
+        m_workers.push_back(std::thread(&ImageQueue::Work, this));
+      }
+    }
+    m_not_full.wait(lock, [this]{ return (int)m_queue.size() < m_queue_size; });
+    m_queue.push_back(ImageJob());
+    std::swap(m_queue.back(), job);
+    m_not_empty.notify_one();
+  }
+
+  void Wait()
+  {
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_idle.wait(lock, [this]{ return m_queue.empty() && m_active == 0; });
+      std::swap(error, m_error);
+    }
+
+    if(error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // waits for pending images, but leaves any error for Wait()
+  void Drain()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]{ return m_queue.empty() && m_active == 0; });
+  }
+
+  bool IsAsync() const
+  {
+    return m_async || m_async_refs > 0;
+  }
+
+  void StopWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_not_empty.notify_all();
+    for(size_t i = 0; i < m_workers.size(); ++i)
+    {
+      m_workers[i].join();
+    }
+    m_workers.clear();
+  }
+
+  int Pending()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (int)m_queue.size() + m_active;
+  }
+
+  // SetAsync and the number of AcquireAsync references, changed
+  // under m_mode_mutex
+  std::atomic<bool> m_async;
+  std::atomic<int> m_async_refs;
+  std::mutex m_mode_mutex;
+  int m_num_threads;
+  int m_queue_size;
+private:
+  void Work()
+  {
+    while(true)
+    {
+      ImageJob job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+        // workers drain the queue before honoring a stop
+        if(m_queue.empty())
+        {
+          return;
+        }
+        std::swap(job, m_queue.front());
+        m_queue.pop_front();
+        m_active++;
+      }
+      m_not_full.notify_one();
+
+      std::exception_ptr error;
+      try
+      {
+        encode_and_save(job.m_rgba.data(),
+                        job.m_width,
+                        job.m_height,
+                        job.m_comments,
+                        job.m_file_name,
+                        false);
+      }
+      catch(...)
+      {
+        error = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_active--;
+        if(error && !m_error)
+        {
+          m_error = error;
+        }
+        if(m_queue.empty() && m_active == 0)
+        {
+          m_idle.notify_all();
+        }
+      }
+    }
+  }
+
+  int m_active;
+  bool m_stop;
+  std::deque<ImageJob> m_queue;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_not_empty;
+  std::condition_variable m_not_full;
+  std::condition_variable m_idle;
+  std::exception_ptr m_error;
+};
+
+ImageQueue &
+image_queue()
+{
+  static ImageQueue queue;
+  return queue;
+}
+
+} // namespace detail
+
+void
+ImageWriter::SetAsync(bool on)
+{
+  detail::ImageQueue &queue = detail::image_queue();
+  std::lock_guard<std::mutex> lock(queue.m_mode_mutex);
+  const bool was_async = queue.IsAsync();
+  queue.m_async = on;
+  if(was_async && !queue.IsAsync())
+  {
+    // flush anything that is in flight before going back
+    // to synchronous writes
+    queue.Wait();
+    queue.StopWorkers();
+  }
+}
+
+void
+ImageWriter::AcquireAsync()
+{
+  detail::ImageQueue &queue = detail::image_queue();
+  std::lock_guard<std::mutex> lock(queue.m_mode_mutex);
+  queue.m_async_refs++;
+}
+
+void
+ImageWriter::ReleaseAsync()
+{
+  detail::ImageQueue &queue = detail::image_queue();
+  std::lock_guard<std::mutex> lock(queue.m_mode_mutex);
+  if(queue.m_async_refs == 0)
+  {
+    return;
+  }
+  queue.m_async_refs--;
+  if(!queue.IsAsync())
+  {
+    queue.Drain();
+    queue.StopWorkers();
+  }
+}
+
+bool
+ImageWriter::GetAsync()
+{
+  return detail::image_queue().IsAsync();
+}
+
+void
+ImageWriter::SetNumberOfThreads(int num_threads)
+{
+  if(num_threads < 1)
+  {
+    throw Error("ImageWriter: number of threads must be at least 1");
+  }
+  detail::ImageQueue &queue = detail::image_queue();
+  if(queue.m_num_threads != num_threads)
+  {
+    // workers are restarted on the next write
+    queue.Wait();
+    queue.StopWorkers();
+    queue.m_num_threads = num_threads;
+  }
+}
+
+int
+ImageWriter::GetNumberOfThreads()
+{
+  return detail::image_queue().m_num_threads;
+}
+
+void
+ImageWriter::SetQueueSize(int queue_size)
+{
+  if(queue_size < 1)
+  {
+    throw Error("ImageWriter: queue size must be at least 1");
+  }
+  detail::ImageQueue &queue = detail::image_queue();
+  queue.Wait();
+  queue.m_queue_size = queue_size;
+}
+
+int
+ImageWriter::GetQueueSize()
+{
+  return detail::image_queue().m_queue_size;
+}
+
+void
+ImageWriter::Write(const float *rgba,
+                   const int width,
+                   const int height,
+                   const std::vector<std::string> &comments,
+                   const std::string &file_name)
+{
+  detail::ImageQueue &queue = detail::image_queue();
+  if(!queue.IsAsync())
+  {
+    // async workers already encode images concurrently, in sync
+    // mode the strips of a single image are encoded in parallel
+    detail::encode_and_save(rgba, width, height, comments, file_name, true);
+    return;
+  }
+
+  // the canvas is reused by the next render, so the job
+  // keeps its own copy of the color buffer
+  detail::ImageJob job;
+  job.m_rgba.assign(rgba, rgba + width * height * 4);
+  job.m_width = width;
+  job.m_height = height;
+  job.m_comments = comments;
+  job.m_file_name = file_name;
+  queue.Push(job);
+}
+
+void
+ImageWriter::Wait()
+{
+  detail::image_queue().Wait();
+}
+
+int
+ImageWriter::GetNumberOfPending()
+{
+  return detail::image_queue().Pending();
+}
+
+} // namespace vtkh
@@ -0,0 +1,53 @@
+#ifndef VTK_H_IMAGE_WRITER_HPP
+#define VTK_H_IMAGE_WRITER_HPP
+
+#include <vtkh/vtkh_exports.h>
+
+#include <string>
+#include <vector>
+
+namespace vtkh {
+//
+// ImageWriter encodes and writes the final images produced by
+// Render::Save. By default images are written synchronously. In
+// async mode, images are copied into a bounded queue and a pool of
+// worker threads does the flip, png encoding and file write, so
+// the caller only pays for the copy. Callers must call Wait()
+// before relying on the files being on disk.
+//
+// Several users in one process (e.g. Ascent instances) should use
+// AcquireAsync and ReleaseAsync instead of SetAsync. Images are
+// written asynchronously while any reference is held, and the last
+// release flushes the queue. Threads and queue size are shared.
+//
+class VTKH_API ImageWriter
+{
+public:
+  static void SetAsync(bool on);
+  static void AcquireAsync();
+  // does not throw, errors from pending images are kept for Wait()
+  static void ReleaseAsync();
+  static bool GetAsync();
+  // number of worker threads used in async mode
+  static void SetNumberOfThreads(int num_threads);
+  static int  GetNumberOfThreads();
+  // max number of images waiting to be written before
+  // Write blocks the caller
+  static void SetQueueSize(int queue_size);
+  static int  GetQueueSize();
+
+  static void Write(const float *rgba,
+                    const int width,
+                    const int height,
+                    const std::vector<std::string> &comments,
+                    const std::string &file_name);
+
+  // blocks until all queued images are written. Rethrows
+  // the first error encountered by a worker
+  static void Wait();
+  // number of images queued or being written
+  static int  GetNumberOfPending();
+};
+
+} // namespace vtkh
+#endif
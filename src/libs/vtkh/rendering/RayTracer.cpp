@@ -1,11 +1,131 @@
 #include "RayTracer.hpp"
 
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ColorTable.h>
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/MapperRayTracer.h>
+#include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/RayOperations.h>
+#include <vtkm/rendering/raytracing/RayTracer.h>
+#include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
 #include <memory>
 
 namespace vtkh {
-  
+
+namespace detail
+{
+
+static vtkm::cont::ArrayHandle<vtkm::Vec4f_32>
+sample_color_map(const vtkm::cont::ColorTable &color_table)
+{
+  // same sampling as vtkm::rendering::Mapper::SetActiveColorTable
+  constexpr vtkm::Float32 conversionToFloatSpace = (1.0f / 255.0f);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec4ui_8> temp;
+  {
+    vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
+    color_table.Sample(1024, temp);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> color_map;
+  color_map.Allocate(1024);
+  auto portal = color_map.WritePortal();
+  auto colorPortal = temp.ReadPortal();
+  for (vtkm::Id i = 0; i < 1024; ++i)
+  {
+    auto color = colorPortal.Get(i);
+    vtkm::Vec4f_32 t(color[0] * conversionToFloatSpace,
+                     color[1] * conversionToFloatSpace,
+                     color[2] * conversionToFloatSpace,
+                     color[3] * conversionToFloatSpace);
+    portal.Set(i, t);
+  }
+  return color_map;
+}
+
+//
+// Holds the external triangles of one domain and the bvh built
+// over them. MapperRayTracer extracts the triangles and builds
+// the bvh on every call, which for cinema means once per domain
+// per camera. The wrapper builds them once and every camera
+// traces against the same acceleration structure.
+//
+class SurfaceWrapper
+{
+protected:
+  vtkm::cont::DataSet m_data_set;
+  vtkm::Id m_num_cells;
+  vtkm::Bounds m_shape_bounds;
+  std::shared_ptr<vtkm::rendering::raytracing::TriangleIntersector> m_intersector;
+  vtkm::rendering::raytracing::RayTracer m_tracer;
+public:
+  SurfaceWrapper() = delete;
+
+  SurfaceWrapper(vtkm::cont::DataSet &data_set)
+    : m_data_set(data_set)
+  {
+    const vtkm::cont::UnknownCellSet &cellset = m_data_set.GetCellSet();
+    const vtkm::cont::CoordinateSystem &coords = m_data_set.GetCoordinateSystem();
+    m_num_cells = cellset.GetNumberOfCells();
+
+    // MapperRayTracer is always called without ghosts, so neither are we
+    vtkm::cont::Field ghosts =
+      vtkm::cont::make_FieldCell(vtkm::cont::GetGlobalGhostCellFieldName(),
+                                 vtkm::cont::ArrayHandleConstant<vtkm::UInt8>(0, m_num_cells));
+
+    vtkm::rendering::raytracing::TriangleExtractor extractor;
+    extractor.ExtractCells(cellset, ghosts);
+    if(extractor.GetNumberOfTriangles() > 0)
+    {
+      m_intersector = std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>();
+      m_intersector->SetData(coords, extractor.GetTriangles());
+      m_tracer.AddShapeIntersector(m_intersector);
+      m_shape_bounds.Include(m_intersector->GetShapeBounds());
+    }
+  }
+
+  vtkm::Id num_cells() const
+  {
+    return m_num_cells;
+  }
+
+  void render(const std::string &field_name,
+              const vtkm::Range &range,
+              const vtkm::cont::ArrayHandle<vtkm::Vec4f_32> &color_map,
+              const bool shading,
+              const vtkm::rendering::Camera &camera,
+              vtkm::rendering::CanvasRayTracer &canvas)
+  {
+    if(m_intersector == nullptr || !m_data_set.HasField(field_name))
+    {
+      return;
+    }
+
+    const vtkm::cont::Field &field = m_data_set.GetField(field_name);
+
+    vtkm::rendering::raytracing::Camera rayCamera;
+    vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+    vtkm::Int32 width = (vtkm::Int32) canvas.GetWidth();
+    vtkm::Int32 height = (vtkm::Int32) canvas.GetHeight();
+
+    rayCamera.SetParameters(camera, width, height);
+    rayCamera.CreateRays(rays, m_shape_bounds);
+    rays.Buffers.at(0).InitConst(0.f);
+    vtkm::rendering::raytracing::RayOperations::MapCanvasToRays(rays, camera, canvas);
+
+    m_tracer.SetField(field, range);
+    m_tracer.GetCamera() = rayCamera;
+    m_tracer.SetColorMap(color_map);
+    m_tracer.SetShadingOn(shading);
+    m_tracer.Render(rays);
+
+    canvas.WriteToCanvas(rays, rays.Buffers.at(0), camera);
+  }
+};
+
+} // namespace detail
+
 RayTracer::RayTracer()
 {
   typedef vtkm::rendering::MapperRayTracer TracerType;
@@ -16,6 +136,7 @@ RayTracer::RayTracer()
 
 RayTracer::~RayTracer()
 {
+  ClearWrappers();
 }
 
 Renderer::vtkmCanvasPtr 
@@ -38,4 +159,97 @@ RayTracer::SetShadingOn(bool on)
   std::static_pointer_cast<TracerType>(this->m_mapper)->SetShadingOn(on);
 }
 
+void
+RayTracer::SetInput(DataSet *input)
+{
+  Filter::SetInput(input);
+  ClearWrappers();
+}
+
+void
+RayTracer::BuildWrappers()
+{
+  const int num_domains = static_cast<int>(m_input->GetNumberOfDomains());
+
+  // the wrappers live until the input changes, but make sure
+  // the domains were not swapped out from under us
+  bool valid = static_cast<int>(m_wrappers.size()) == num_domains;
+  for(int dom = 0; valid && dom < num_domains; ++dom)
+  {
+    vtkm::cont::DataSet data_set;
+    vtkm::Id domain_id;
+    m_input->GetDomain(dom, data_set, domain_id);
+    const vtkm::Id num_cells = data_set.GetCellSet().GetNumberOfCells();
+    if(m_wrappers[dom] == nullptr)
+    {
+      valid = num_cells == 0;
+    }
+    else
+    {
+      valid = m_wrappers[dom]->num_cells() == num_cells;
+    }
+  }
+
+  if(valid)
+  {
+    return;
+  }
+
+  ClearWrappers();
+  m_wrappers.resize(num_domains, nullptr);
+  for(int dom = 0; dom < num_domains; ++dom)
+  {
+    vtkm::cont::DataSet data_set;
+    vtkm::Id domain_id;
+    m_input->GetDomain(dom, data_set, domain_id);
+    if(data_set.GetCellSet().GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+    m_wrappers[dom] = new detail::SurfaceWrapper(data_set);
+  }
+}
+
+void
+RayTracer::ClearWrappers()
+{
+  const int num_wrappers = m_wrappers.size();
+  for(int i = 0; i < num_wrappers; ++i)
+  {
+    delete m_wrappers[i];
+  }
+  m_wrappers.clear();
+}
+
+void
+RayTracer::DoExecute()
+{
+  BuildWrappers();
+
+  // the color map is the same for every domain and camera
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> color_map
+    = detail::sample_color_map(m_color_table);
+
+  const int total_renders = static_cast<int>(m_renders.size());
+  const int num_domains = static_cast<int>(m_wrappers.size());
+  for(int dom = 0; dom < num_domains; ++dom)
+  {
+    detail::SurfaceWrapper *wrapper = m_wrappers[dom];
+    if(wrapper == nullptr)
+    {
+      continue;
+    }
+
+    for(int i = 0; i < total_renders; ++i)
+    {
+      wrapper->render(m_field_name,
+                      m_range,
+                      color_map,
+                      m_renders[i].GetShadingOn(),
+                      m_renders[i].GetCamera(),
+                      m_renders[i].GetCanvas());
+    }
+  }
+}
+
 } // namespace vtkh
@@ -6,6 +6,11 @@
 
 namespace vtkh {
 
+namespace detail
+{
+  class SurfaceWrapper;
+}
+
 class VTKH_API RayTracer : public Renderer
 {
 public:
@@ -14,6 +19,16 @@ public:
   std::string GetName() const override;
   void SetShadingOn(bool on) override;
   static Renderer::vtkmCanvasPtr GetNewCanvas(int width = 1024, int height = 1024);
+
+  virtual void SetInput(DataSet *input) override;
+protected:
+  virtual void DoExecute() override;
+
+  // per domain triangles and bvh, kept alive for every
+  // render and batch of renders of the same input
+  void ClearWrappers();
+  void BuildWrappers();
+  std::vector<detail::SurfaceWrapper*> m_wrappers;
 };
 
 } // namespace vtkh
@@ -5,6 +5,7 @@
 #include <vtkh/utils/vtkm_array_utils.hpp>
 #include <vtkh/utils/vtkm_dataset_info.hpp>
 #include <vtkm/rendering/raytracing/Logger.h>
+#include <algorithm>
 
 namespace vtkh {
 
@@ -99,31 +100,93 @@ Renderer::Composite(const int &num_images)
 {
   VTKH_DATA_OPEN("Composite");
   m_compositor->SetCompositeMode(Compositor::Z_BUFFER_SURFACE);
-  for(int i = 0; i < num_images; ++i)
+
+  if(num_images == 0)
+  {
+    VTKH_DATA_CLOSE();
+    return;
+  }
+
+  const int width = m_renders[0].GetCanvas().GetWidth();
+  const int height = m_renders[0].GetCanvas().GetHeight();
+  bool same_size = true;
+  for(int i = 1; i < num_images; ++i)
   {
-    float* color_buffer = &GetVTKMPointer(m_renders[i].GetCanvas().GetColorBuffer())[0][0];
-    float* depth_buffer = GetVTKMPointer(m_renders[i].GetCanvas().GetDepthBuffer());
+    same_size &= m_renders[i].GetCanvas().GetWidth() == width &&
+                 m_renders[i].GetCanvas().GetHeight() == height;
+  }
 
-    int height = m_renders[i].GetCanvas().GetHeight();
-    int width = m_renders[i].GetCanvas().GetWidth();
+  if(!same_size || num_images == 1)
+  {
+    for(int i = 0; i < num_images; ++i)
+    {
+      float* color_buffer = &GetVTKMPointer(m_renders[i].GetCanvas().GetColorBuffer())[0][0];
+      float* depth_buffer = GetVTKMPointer(m_renders[i].GetCanvas().GetDepthBuffer());
 
-    m_compositor->AddImage(color_buffer,
-                           depth_buffer,
-                           width,
-                           height);
+      const int image_height = m_renders[i].GetCanvas().GetHeight();
+      const int image_width = m_renders[i].GetCanvas().GetWidth();
 
-    Image result = m_compositor->Composite();
+      m_compositor->AddImage(color_buffer,
+                             depth_buffer,
+                             image_width,
+                             image_height);
+
+      Image result = m_compositor->Composite();
 
 #ifdef VTKH_PARALLEL
-    if(vtkh::GetMPIRank() == 0)
-    {
-      ImageToCanvas(result, m_renders[i].GetCanvas(), true);
-    }
+      if(vtkh::GetMPIRank() == 0)
+      {
+        ImageToCanvas(result, m_renders[i].GetCanvas(), true);
+      }
 #else
-    ImageToCanvas(result, m_renders[i].GetCanvas(), true);
+      ImageToCanvas(result, m_renders[i].GetCanvas(), true);
 #endif
-    m_compositor->ClearImages();
-  } // for image
+      m_compositor->ClearImages();
+    } // for image
+    VTKH_DATA_CLOSE();
+    return;
+  }
+
+  //
+  // All the canvases of the batch have the same size (always the case
+  // for cinema), so we stack them on top of each other into one tall
+  // image. Images are row major, so each canvas is a contiguous slice
+  // and the whole batch goes through a single exchange instead of one
+  // exchange per camera. The stack stays in float so the compositor
+  // quantizes colors and handles depths exactly like a single canvas.
+  //
+  const int size = width * height;
+  std::vector<float> colors(static_cast<size_t>(size) * 4 * num_images);
+  std::vector<float> depths(static_cast<size_t>(size) * num_images);
+  for(int i = 0; i < num_images; ++i)
+  {
+    const float* color_buffer = &GetVTKMPointer(m_renders[i].GetCanvas().GetColorBuffer())[0][0];
+    const float* depth_buffer = GetVTKMPointer(m_renders[i].GetCanvas().GetDepthBuffer());
+    std::copy(color_buffer,
+              color_buffer + static_cast<size_t>(size) * 4,
+              &colors[static_cast<size_t>(size) * 4 * i]);
+    std::copy(depth_buffer,
+              depth_buffer + size,
+              &depths[static_cast<size_t>(size) * i]);
+  }
+
+  m_compositor->AddImage(&colors[0],
+                         &depths[0],
+                         width,
+                         height * num_images);
+
+  Image result = m_compositor->Composite();
+
+#ifdef VTKH_PARALLEL
+  if(vtkh::GetMPIRank() == 0)
+#endif
+  {
+    for(int i = 0; i < num_images; ++i)
+    {
+      ImageToCanvas(result, m_renders[i].GetCanvas(), true, size * i);
+    }
+  }
+  m_compositor->ClearImages();
   VTKH_DATA_CLOSE();
 }
 
@@ -249,7 +312,10 @@ Renderer::DoExecute()
 }
 
 void
-Renderer::ImageToCanvas(Image &image, vtkm::rendering::Canvas &canvas, bool get_depth)
+Renderer::ImageToCanvas(Image &image,
+                        vtkm::rendering::Canvas &canvas,
+                        bool get_depth,
+                        const int pixel_offset)
 {
   const int width = canvas.GetWidth();
   const int height = canvas.GetHeight();
@@ -262,11 +328,11 @@ Renderer::ImageToCanvas(Image &image, vtkm::rendering::Canvas &canvas, bool get_
 #endif
   for(int i = 0; i < color_size; ++i)
   {
-    color_buffer[i] = static_cast<float>(image.m_pixels[i]) * one_over_255;
+    color_buffer[i] = static_cast<float>(image.m_pixels[pixel_offset * 4 + i]) * one_over_255;
   }
 
   float* depth_buffer = GetVTKMPointer(canvas.GetDepthBuffer());
-  if(get_depth) memcpy(depth_buffer, &image.m_depths[0], sizeof(float) * size);
+  if(get_depth) memcpy(depth_buffer, &image.m_depths[pixel_offset], sizeof(float) * size);
 }
 
 std::vector<Render>
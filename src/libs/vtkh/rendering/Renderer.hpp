@@ -64,7 +64,12 @@ protected:
   virtual void DoExecute() override;
 
   virtual void Composite(const int &num_images);
-  void ImageToCanvas(Image &image, vtkm::rendering::Canvas &canvas, bool get_depth);
+  // pixel_offset is the first pixel of the canvas inside image, which
+  // lets a stacked batch of images be split back into its canvases
+  void ImageToCanvas(Image &image,
+                     vtkm::rendering::Canvas &canvas,
+                     bool get_depth,
+                     const int pixel_offset = 0);
 };
 
 } // namespace vtkh
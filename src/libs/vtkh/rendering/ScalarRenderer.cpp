@@ -12,7 +12,10 @@
 #ifdef VTKH_PARALLEL
   #include <mpi.h>
 #endif
+#include <algorithm>
 #include <assert.h>
+#include <limits>
+#include <sstream>
 #include <string.h>
 
 using namespace std;
@@ -55,7 +58,8 @@ filter_scalar_fields(vtkm::cont::DataSet &dataset)
 
 ScalarRenderer::ScalarRenderer()
   : m_width(1024),
-    m_height(1024)
+    m_height(1024),
+    m_batch_size(1)
 {
 }
 
@@ -72,7 +76,32 @@ ScalarRenderer::GetName() const
 void
 ScalarRenderer::SetCamera(vtkmCamera &camera)
 {
-  m_camera = camera;
+  m_cameras.clear();
+  m_cameras.push_back(camera);
+}
+
+void
+ScalarRenderer::SetCameras(const std::vector<vtkmCamera> &cameras)
+{
+  m_cameras = cameras;
+}
+
+int
+ScalarRenderer::GetNumberOfCameras() const
+{
+  return static_cast<int>(m_cameras.size());
+}
+
+void
+ScalarRenderer::SetBatchSize(const int batch_size)
+{
+  if(batch_size < 1)
+  {
+    std::stringstream msg;
+    msg<<"Scalar Renderer: batch size must be positive, got "<<batch_size;
+    throw Error(msg.str());
+  }
+  m_batch_size = batch_size;
 }
 
 void
@@ -107,6 +136,12 @@ ScalarRenderer::DoExecute()
   int num_domains = static_cast<int>(m_input->GetNumberOfDomains());
   this->m_output = new DataSet();
 
+  const int num_cameras = static_cast<int>(m_cameras.size());
+  if(num_cameras == 0)
+  {
+    throw Error("Scalar Renderer: no camera was set");
+  }
+
   //
   // There external faces + bvh construction happens
   // when we set the input for the renderer, which
@@ -114,8 +149,9 @@ ScalarRenderer::DoExecute()
   // We could be processing AMR patches, numbering
   // in the 1000s, and with 100 images * 1000s amr
   // patches we could blow memory. We will set the input
-  // once and composite after every image (todo: batch images
-  // in groups of X).
+  // once and composite the images in batches: the images
+  // of a batch are stacked on top of each other into one
+  // tall image, so a single exchange composites all of them.
   //
   std::vector<vtkm::rendering::ScalarRenderer> renderers;
   std::vector<vtkm::Id> cell_counts;
@@ -132,144 +168,167 @@ ScalarRenderer::DoExecute()
     renderers[dom].SetHeight(m_height);
 
     // all the data sets better be the same
-    cell_counts.push_back(data_set.GetCellSet().GetNumberOfCells());
+    cell_counts[dom] = data_set.GetCellSet().GetNumberOfCells();
+  }
+
+  int num_cells = 0;
+  for(int dom = 0; dom < num_domains; ++dom)
+  {
+    num_cells += static_cast<int>(cell_counts[dom]);
   }
 
   // basic sanity checking
   int min_p = std::numeric_limits<int>::max();
   int max_p = std::numeric_limits<int>::min();
-  bool do_once = true;
 
   std::vector<std::string> field_names;
-  PayloadCompositor compositor;
-
-  int num_cells = 0;
-
-  // make no assumptions
-  bool no_data = num_cells == 0;
+  // the field names and payload size are the same for every
+  // batch, so we only need to agree on them once
+  bool have_layout = false;
+  bool no_data = true;
 
-  //Bounds needed for parallel execution
-  float bounds[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};;
-  for(int dom = 0; dom < num_domains; ++dom)
+  for(int first = 0; first < num_cameras; first += m_batch_size)
   {
-    vtkm::cont::DataSet data_set;
-    vtkm::Id domain_id;
-    m_input->GetDomain(dom, data_set, domain_id);
-    num_cells = data_set.GetCellSet().GetNumberOfCells();
+    const int batch = std::min(m_batch_size, num_cameras - first);
 
-    if(data_set.GetCellSet().GetNumberOfCells())
+    vtkm::Bounds stack_bounds;
+    stack_bounds.X.Min = 1;
+    stack_bounds.X.Max = m_width;
+    stack_bounds.Y.Min = 1;
+    stack_bounds.Y.Max = m_height * batch;
+
+    PayloadCompositor compositor;
+    for(int dom = 0; dom < num_domains; ++dom)
     {
-      no_data = num_cells == 0;
+      if(cell_counts[dom] == 0)
+      {
+        continue;
+      }
 
-      Result res = renderers[dom].Render(m_camera);
-
-      field_names = res.ScalarNames;
-      PayloadImage *pimage = Convert(res);
-      min_p = std::min(min_p, pimage->m_payload_bytes);
-      max_p = std::max(max_p, pimage->m_payload_bytes);
-      compositor.AddImage(*pimage);
-      bounds[0] = pimage->m_bounds.X.Min;
-      bounds[1] = pimage->m_bounds.X.Max;
-      bounds[2] = pimage->m_bounds.Y.Min;
-      bounds[3] = pimage->m_bounds.Y.Max;
-      bounds[4] = pimage->m_bounds.Z.Min;
-      bounds[5] = pimage->m_bounds.Z.Max;
-      delete pimage;
+      PayloadImage *stack = nullptr;
+      for(int c = 0; c < batch; ++c)
+      {
+        Result res = renderers[dom].Render(m_cameras[first + c]);
+
+        field_names = res.ScalarNames;
+        PayloadImage *pimage = Convert(res);
+        min_p = std::min(min_p, pimage->m_payload_bytes);
+        max_p = std::max(max_p, pimage->m_payload_bytes);
+        if(stack == nullptr)
+        {
+          stack = new PayloadImage(stack_bounds, pimage->m_payload_bytes);
+        }
+        // camera c goes into rows [c * height, (c + 1) * height)
+        pimage->m_bounds.Y.Min += c * m_height;
+        pimage->m_bounds.Y.Max += c * m_height;
+        pimage->SubsetTo(*stack);
+        delete pimage;
+      }
+      compositor.AddImage(*stack);
+      delete stack;
     }
-  }
 
+    if(!have_layout)
+    {
+      no_data = num_cells == 0;
 #ifdef VTKH_PARALLEL
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
+      MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
 
-  int comm_size = GetMPISize();
-  int rank = GetMPIRank();
-  std::vector<int> votes;
+      int comm_size = GetMPISize();
+      std::vector<int> votes;
 
-  if(!no_data && num_cells == 0)
-    num_cells = 1;
-  int vote = num_cells > 0 ? 1 : 0;
-  votes.resize(comm_size);
+      int vote = num_cells > 0 ? 1 : 0;
+      votes.resize(comm_size);
 
-  MPI_Allgather(&vote, 1, MPI_INT, &votes[0], 1, MPI_INT, mpi_comm);
-  int winner = -1;
-  for(int i = 0; i < comm_size; ++i)
-  {
-    if(votes[i] == 1)
-    {
-      winner = i;
-      break;
-    }
-  }
-  if(winner != -1)
-  {
-    MPI_Bcast(bounds, 6, MPI_FLOAT, winner, mpi_comm);
-    MPI_Bcast(&max_p, 1, MPI_INT, winner, mpi_comm);
-    MPI_Bcast(&min_p, 1, MPI_INT, winner, mpi_comm);
-    no_data = false;
-  }
+      MPI_Allgather(&vote, 1, MPI_INT, &votes[0], 1, MPI_INT, mpi_comm);
+      int winner = -1;
+      for(int i = 0; i < comm_size; ++i)
+      {
+        if(votes[i] == 1)
+        {
+          winner = i;
+          break;
+        }
+      }
+      if(winner != -1)
+      {
+        MPI_Bcast(&max_p, 1, MPI_INT, winner, mpi_comm);
+        MPI_Bcast(&min_p, 1, MPI_INT, winner, mpi_comm);
+        no_data = false;
+      }
 
-  if(winner > 0)
-  {
-    if(vtkh::GetMPIRank() == 0 && num_cells == 0)
-    {
-      MPI_Status status;
-      int num_fields = 0;
-      MPI_Recv(&num_fields, 1, MPI_INT, winner, 0, mpi_comm, &status);
-      for(int i = 0; i < num_fields; i++)
+      if(winner > 0)
       {
-        int len = 0;
-        MPI_Recv(&len, 1, MPI_INT, winner, 0, mpi_comm, &status);
-        char * array = new char[len];
-        MPI_Recv(array, len, MPI_CHAR, winner, 0, mpi_comm, &status);
-        std::string name;
-        name.assign(array,len);
-        field_names.push_back(name);
-        memset(array, 0, sizeof(*array));
-        delete[] array;
+        if(vtkh::GetMPIRank() == 0 && num_cells == 0)
+        {
+          MPI_Status status;
+          int num_fields = 0;
+          MPI_Recv(&num_fields, 1, MPI_INT, winner, 0, mpi_comm, &status);
+          for(int i = 0; i < num_fields; i++)
+          {
+            int len = 0;
+            MPI_Recv(&len, 1, MPI_INT, winner, 0, mpi_comm, &status);
+            char * array = new char[len];
+            MPI_Recv(array, len, MPI_CHAR, winner, 0, mpi_comm, &status);
+            std::string name;
+            name.assign(array,len);
+            field_names.push_back(name);
+            delete[] array;
+          }
+        }
+        if(vtkh::GetMPIRank() == winner)
+        {
+          int num_fields = field_names.size();
+          MPI_Send(&num_fields, 1, MPI_INT, 0, 0, mpi_comm);
+          for(int i = 0; i < num_fields; i++)
+          {
+            int len = strlen(field_names[i].c_str());
+            MPI_Send(&len, 1, MPI_INT, 0, 0, mpi_comm);
+            MPI_Send(field_names[i].c_str(),strlen(field_names[i].c_str()),MPI_CHAR, 0, 0,mpi_comm);
+          }
+        }
       }
-    }
-    if(vtkh::GetMPIRank() == winner)
-    {
-      int num_fields = field_names.size();
-      MPI_Send(&num_fields, 1, MPI_INT, 0, 0, mpi_comm); 
-      for(int i = 0; i < num_fields; i++)
+#endif
+      if(!no_data && min_p != max_p)
       {
-        int len = strlen(field_names[i].c_str());
-        MPI_Send(&len, 1, MPI_INT, 0, 0, mpi_comm);
-        MPI_Send(field_names[i].c_str(),strlen(field_names[i].c_str()),MPI_CHAR, 0, 0,mpi_comm);
+        throw Error("Scalar Renderer: mismatch in payload bytes");
       }
+      have_layout = true;
     }
-  }
-#endif
 
-  if(!no_data)
-  {
-    if(num_cells == 0)
+    if(no_data)
     {
-      vtkm::Bounds b(bounds);
-      PayloadImage p(b, max_p);
-      int size = p.m_depths.size();
-      std::vector<float> depths(size);
-      for(int i = 0; i < size; i++)
-        depths[i] = std::numeric_limits<int>::max();
-      std::copy(&depths[0], &depths[0] + size, &p.m_depths[0]);
-      compositor.AddImage(p);
+      break;
     }
 
-    if(min_p != max_p)
+    if(num_cells == 0)
     {
-      throw Error("Scalar Renderer: mismatch in payload bytes");
+      // this rank still has to take part in the composite
+      PayloadImage p(stack_bounds, max_p);
+      std::fill(p.m_depths.begin(),
+                p.m_depths.end(),
+                static_cast<float>(std::numeric_limits<int>::max()));
+      compositor.AddImage(p);
     }
 
     PayloadImage final_image = compositor.Composite();
     if(vtkh::GetMPIRank() == 0)
     {
-      Result final_result = Convert(final_image, field_names);
-      if(final_result.Scalars.size() != 0)
+      for(int c = 0; c < batch; ++c)
       {
-        vtkm::cont::DataSet dset = final_result.ToDataSet();
-        const int domain_id = 0;
-        this->m_output->AddDomain(dset, domain_id);
+        vtkm::Bounds slot = stack_bounds;
+        slot.Y.Min = 1 + c * m_height;
+        slot.Y.Max = (c + 1) * m_height;
+        PayloadImage image;
+        image.SubsetFrom(final_image, slot);
+
+        Result final_result = Convert(image, field_names);
+        if(final_result.Scalars.size() != 0)
+        {
+          vtkm::cont::DataSet dset = final_result.ToDataSet();
+          // the domain id is the index of the camera
+          this->m_output->AddDomain(dset, first + c);
+        }
       }
     }
   }
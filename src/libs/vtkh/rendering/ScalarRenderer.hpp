@@ -25,6 +25,12 @@ public:
   virtual std::string GetName() const override;
 
   void SetCamera(vtkmCamera &camera);
+  // Renders every camera against the same acceleration structures.
+  // The output has one domain per camera, the domain id being the
+  // index of the camera.
+  void SetCameras(const std::vector<vtkmCamera> &cameras);
+  // Number of images composited together in one exchange
+  void SetBatchSize(const int batch_size);
 
   int GetNumberOfCameras() const;
   vtkh::DataSet *GetInput();
@@ -34,8 +40,9 @@ protected:
 
   int m_width;
   int m_height;
+  int m_batch_size;
   // image related data with cinema support
-  vtkmCamera  m_camera;
+  std::vector<vtkmCamera> m_cameras;
   // methods
   virtual void PreExecute() override;
   virtual void PostExecute() override;
@@ -69,3 +69,55 @@ TEST(apcomp_partials, apcomp_volume_partial)
   EXPECT_TRUE(check_test_image(output_file, t_apcomp_baseline_dir()));
 }
 
+
+//-----------------------------------------------------------------------------
+TEST(apcomp_partials, apcomp_volume_partial_order)
+{
+  apcomp::PartialCompositor<apcomp::VolumePartial<float>> compositor;
+
+  // the same compositor is used for several frames
+  for(int frame = 0; frame < 2; ++frame)
+  {
+    std::vector<std::vector<apcomp::VolumePartial<float>>> in_partials;
+    in_partials.resize(3);
+    // pixel 7 gets one partial from each image, given back to front
+    for(int i = 0; i < 3; ++i)
+    {
+      apcomp::VolumePartial<float> partial;
+      partial.m_pixel_id = 7;
+      partial.m_depth = 3.f - float(i);
+      partial.m_pixel[i] = 0.5f;
+      partial.m_alpha = 0.5f;
+      in_partials[i].push_back(partial);
+    }
+    // pixel 3 + frame only has one partial
+    apcomp::VolumePartial<float> single;
+    single.m_pixel_id = 3 + frame;
+    single.m_depth = 1.f;
+    single.m_pixel[0] = 0.25f;
+    single.m_alpha = 0.25f;
+    in_partials[1].push_back(single);
+
+    std::vector<apcomp::VolumePartial<float>> output;
+    compositor.composite(in_partials, output);
+
+    ASSERT_EQ(output.size(), (size_t)2);
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+      if(output[i].m_pixel_id == 7)
+      {
+        // front to back: blue, green then red
+        EXPECT_NEAR(output[i].m_pixel[2], 0.5f, 1e-6f);
+        EXPECT_NEAR(output[i].m_pixel[1], 0.25f, 1e-6f);
+        EXPECT_NEAR(output[i].m_pixel[0], 0.125f, 1e-6f);
+        EXPECT_NEAR(output[i].m_alpha, 0.875f, 1e-6f);
+      }
+      else
+      {
+        EXPECT_EQ(output[i].m_pixel_id, 3 + frame);
+        EXPECT_NEAR(output[i].m_pixel[0], 0.25f, 1e-6f);
+        EXPECT_NEAR(output[i].m_alpha, 0.25f, 1e-6f);
+      }
+    }
+  }
+}
@@ -19,6 +19,8 @@
 #include <iostream>
 #include <math.h>
 #include <sstream>
+#include <chrono>
+#include <thread>
 
 #include <conduit_blueprint.hpp>
 
@@ -269,3 +271,85 @@ TEST(ascent_pipeline, test_register_transform)
     EXPECT_TRUE(check_test_image(output_file));
 }
 
+//-----------------------------------------------------------------------------
+// serial extract that waits (with a timeout) for a file to appear, used to
+// show that a concurrent relay extract overlaps with it
+//-----------------------------------------------------------------------------
+class WaitForFileExtract: public ::flow::Filter
+{
+    public:
+        static bool s_found;
+
+        WaitForFileExtract():Filter()
+        {}
+        ~WaitForFileExtract()
+        {}
+
+        void declare_interface(Node &i)
+        {
+            i["type_name"]   = "wait_for_file_extract";
+            i["port_names"].append() = "in";
+            i["output_port"] = "false";
+        }
+
+        void execute()
+        {
+            const std::string path = params()["path"].as_string();
+            auto start = std::chrono::steady_clock::now();
+            while(!conduit::utils::is_file(path) &&
+                  std::chrono::steady_clock::now() - start < std::chrono::seconds(60))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            s_found = conduit::utils::is_file(path);
+        }
+};
+
+bool WaitForFileExtract::s_found = false;
+
+//-----------------------------------------------------------------------------
+TEST(ascent_pipeline, test_flow_threads_overlap_extracts)
+{
+    AscentRuntime::register_filter_type<WaitForFileExtract>("extracts",
+                                                            "wait_for_file");
+
+    Node data, info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                               5,
+                                               5,
+                                               5,
+                                               data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,info));
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_flow_threads_relay");
+    string output_root = output_file + ".cycle_000100.root";
+    remove_test_file(output_root);
+
+    // the wait only finishes if the relay extract, which opts into
+    // concurrent execution, runs on a worker thread at the same time
+    conduit::Node extracts;
+    extracts["e1/type"]  = "relay";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+    extracts["e2/type"]  = "wait_for_file";
+    extracts["e2/params/path"] = output_root;
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["flow_threads"] = 2;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    WaitForFileExtract::s_found = false;
+    ascent.execute(actions);
+    ascent.close();
+
+    EXPECT_TRUE(WaitForFileExtract::s_found);
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+}
@@ -556,6 +556,95 @@ TEST(ascent_expressions, test_identifier)
   EXPECT_EQ(res2["type"].as_string(), "vector");
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, batch_evaluate)
+{
+  // the vtkm runtime is currently our only rendering runtime
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with vtkm support
+  if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+  {
+    ASCENT_INFO("Ascent support disabled, skipping test");
+    return;
+  }
+
+  //
+  // Create an example mesh.
+  //
+  Node data, verify_info;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+
+  std::vector<std::string> exprs;
+  std::vector<std::string> names;
+  exprs.push_back("max(field('braid'))");
+  names.push_back("batch_max");
+  exprs.push_back("min(field('braid'))");
+  names.push_back("batch_min");
+  exprs.push_back("avg(field('braid'))");
+  names.push_back("batch_avg");
+  exprs.push_back("sum(field('braid'))");
+  names.push_back("batch_sum");
+  exprs.push_back("histogram(field('braid'), num_bins=10)");
+  names.push_back("batch_hist");
+  exprs.push_back("histogram(field('braid'), num_bins=4, min_val=0, max_val=1.0)");
+  names.push_back("batch_hist_range");
+  exprs.push_back("max(field('braid')) - min(field('braid'))");
+  names.push_back("batch_range");
+  // refers to an earlier result of the batch
+  exprs.push_back("batch_max.value > 0");
+  names.push_back("batch_positive");
+  // assignments are evaluated on their own
+  exprs.push_back("mx = max(field('braid'))\nmx.value * 2");
+  names.push_back("batch_double");
+  exprs.push_back("1 + 2");
+  names.push_back("");
+
+  runtime::expressions::ExpressionEval batch_eval(&multi_dom);
+  std::vector<conduit::Node> batch = batch_eval.evaluate(exprs, names);
+  ASSERT_EQ(batch.size(), exprs.size());
+
+  for(size_t i = 0; i < exprs.size(); ++i)
+  {
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+    conduit::Node res = eval.evaluate(exprs[i]);
+    EXPECT_EQ(batch[i]["type"].as_string(), res["type"].as_string());
+    if(res["type"].as_string() == "histogram")
+    {
+      EXPECT_FALSE(batch[i]["attrs/value/value"].diff(res["attrs/value/value"],
+                                                      verify_info));
+      continue;
+    }
+    if(res["type"].as_string() == "value_position")
+    {
+      EXPECT_EQ(batch[i]["attrs/value/value"].to_float64(),
+                res["attrs/value/value"].to_float64());
+      EXPECT_FALSE(batch[i]["attrs/position/value"].diff(res["attrs/position/value"],
+                                                         verify_info));
+      EXPECT_EQ(batch[i]["attrs/element/index"].to_int32(),
+                res["attrs/element/index"].to_int32());
+      continue;
+    }
+    EXPECT_NEAR(batch[i]["value"].to_float64(), res["value"].to_float64(), 1e-8)
+      << exprs[i];
+  }
+
+  // the batch caches its results like evaluate does
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+  conduit::Node res = eval.evaluate("batch_sum");
+  EXPECT_NEAR(res["value"].to_float64(), batch[3]["value"].to_float64(), 1e-8);
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_expressions, test_history)
 {
@@ -164,6 +164,139 @@ TEST(ascent_hola_mpi, test_hola_mpi_helpers)
         EXPECT_EQ(data.number_of_children(),9);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_transfer_options)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int total_size = relay::mpi::size(comm);
+    int rank_split = 5;
+    int src_size = rank_split;
+
+    Node my_maps;
+    my_maps["wts"] = DataType::int32(total_size);
+    my_maps["wtd"] = DataType::int32(total_size);
+
+    int32_array world_to_src  = my_maps["wts"].value();
+    int32_array world_to_dest = my_maps["wtd"].value();
+
+    for(int i=0;i<total_size;i++)
+    {
+        if(i < src_size)
+        {
+            world_to_dest[i] = -1;
+            world_to_src[i]  = i;
+        }
+        else
+        {
+            world_to_dest[i] = i - src_size;
+            world_to_src[i] = -1;
+        }
+    }
+
+    // a tiny in flight limit forces the sender to wait between
+    // domains, and the second cycle reuses the schemas of the first
+    Node opts;
+    opts["max_in_flight_bytes"] = 8;
+    opts["reuse_layout"] = "true";
+
+    for(int cycle = 0; cycle < 2; cycle++)
+    {
+        Node data;
+        if(rank < src_size)
+        {
+            hola_mpi_helpers_test_setup_src_data(rank,data);
+        }
+
+        Node comm_map;
+        hola_mpi_comm_map(data,
+                          comm,
+                          world_to_src,
+                          world_to_dest,
+                          comm_map);
+
+        if(rank < src_size)
+        {
+            hola_mpi_send(data,comm,rank,comm_map,opts);
+        }
+        else
+        {
+            int dest_idx = rank - rank_split;
+            hola_mpi_recv(comm,dest_idx,comm_map,opts,data);
+
+            // domains must arrive in global order
+            int32_array src_offsets = comm_map["src_offsets"].value();
+            int32_array dest_offsets = comm_map["dest_offsets"].value();
+            int32_array dest_counts = comm_map["dest_counts"].value();
+            EXPECT_EQ(data.number_of_children(),dest_counts[dest_idx]);
+            for(int i=0; i < data.number_of_children(); i++)
+            {
+                int src_rank = data.child(i)["src_rank"].to_int();
+                int local_id = data.child(i)["src_local_domain_id"].to_int();
+                EXPECT_EQ(src_offsets[src_rank] + local_id,
+                          dest_offsets[dest_idx] + i);
+            }
+        }
+        MPI_Barrier(comm);
+    }
+
+    hola_mpi_clear_layout_cache();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_reuse_layout_count_change)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int rank_split = 5;
+
+    Node opts;
+    opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    opts["rank_split"] = rank_split;
+    opts["reuse_layout"] = "true";
+
+    // the third cycle drops a domain on rank 0, the cached comm map
+    // must be rebuilt instead of hanging the receivers
+    for(int cycle = 0; cycle < 3; cycle++)
+    {
+        Node data;
+        if(rank < rank_split)
+        {
+            hola_mpi_helpers_test_setup_src_data(rank,data);
+            if(cycle == 2 && rank == 0)
+            {
+                data.remove(data.number_of_children() - 1);
+            }
+        }
+
+        hola_mpi(opts,data);
+
+        int num_recv = 0;
+        if(rank >= rank_split)
+        {
+            num_recv = static_cast<int>(data.number_of_children());
+            // domains arrive in (src rank, local id) order
+            for(int i=1; i < data.number_of_children(); i++)
+            {
+                int prev_rank = data.child(i-1)["src_rank"].to_int();
+                int prev_id = data.child(i-1)["src_local_domain_id"].to_int();
+                int curr_rank = data.child(i)["src_rank"].to_int();
+                int curr_id = data.child(i)["src_local_domain_id"].to_int();
+                EXPECT_TRUE(prev_rank < curr_rank ||
+                            (prev_rank == curr_rank && prev_id + 1 == curr_id));
+            }
+        }
+
+        int total_recv = 0;
+        MPI_Allreduce(&num_recv, &total_recv, 1, MPI_INT, MPI_SUM, comm);
+        EXPECT_EQ(total_recv, cycle == 2 ? 22 : 23);
+    }
+
+    hola_mpi_clear_layout_cache();
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_hola_mpi, test_hola_mpi)
 {
@@ -15,7 +15,9 @@
 
 #include <ascent.hpp>
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <math.h>
 #include <stdio.h>
 
@@ -91,6 +93,129 @@ TEST(ascent_htg, test_htg)
     EXPECT_TRUE(conduit::utils::is_file(output_root));
 }
 
+//-----------------------------------------------------------------------------
+// one block of an 8^3 grid over [-10,10]^3, with a blank sphere. The
+// values are exact in float, so the output does not depend on the
+// platform.
+void htg_test_domain(int oi, int oj, int ok,
+                     int ni, int nj, int nk,
+                     Node &dom)
+{
+    const int nx = 8;
+    const double spacing = 20.0 / nx;
+    conduit::blueprint::mesh::examples::basic("uniform",
+                                              ni + 1,
+                                              nj + 1,
+                                              nk + 1,
+                                              dom);
+    dom["coordsets/coords/origin/x"] = -10.0 + oi * spacing;
+    dom["coordsets/coords/origin/y"] = -10.0 + oj * spacing;
+    dom["coordsets/coords/origin/z"] = -10.0 + ok * spacing;
+    dom["coordsets/coords/spacing/dx"] = spacing;
+    dom["coordsets/coords/spacing/dy"] = spacing;
+    dom["coordsets/coords/spacing/dz"] = spacing;
+
+    dom["fields/field/values"].set(DataType::float64(ni * nj * nk));
+    float64_array vals = dom["fields/field/values"].value();
+    int idx = 0;
+    for(int k = ok; k < ok + nk; k++)
+    {
+        for(int j = oj; j < oj + nj; j++)
+        {
+            for(int i = oi; i < oi + ni; i++)
+            {
+                int x = 2 * i - 5;
+                int y = 2 * j - 8;
+                int z = 2 * k - 4;
+                bool blank = x * x + y * y + z * z < 16;
+                vals[idx++] = blank ? -10000. : 0.5 * i + 0.25 * j * k - 0.125 * k;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void htg_test_extract(const Node &data, const string &output_file)
+{
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"]  = "htg";
+    add_extracts["extracts/e1/params/path"] = output_file;
+    add_extracts["extracts/e1/params/blank_value"] = float32(-10000.);
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+string htg_test_read(const string &path)
+{
+    std::ifstream ifs(path.c_str());
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_htg, test_htg_multi_domain)
+{
+    string output_path = prepare_output_dir();
+    string single_file = conduit::utils::join_file_path(output_path,"tout_htg_single_domain");
+    string multi_file = conduit::utils::join_file_path(output_path,"tout_htg_multi_domain");
+    remove_test_file(single_file + ".htg");
+    remove_test_file(multi_file + ".htg");
+
+    Node single;
+    htg_test_domain(0, 0, 0, 8, 8, 8, single);
+    htg_test_extract(single, single_file);
+
+    // the same grid split at offsets that are not powers of 2
+    Node multi;
+    htg_test_domain(0, 0, 0, 3, 8, 8, multi.append());
+    htg_test_domain(3, 0, 0, 5, 8, 3, multi.append());
+    htg_test_domain(3, 0, 3, 5, 8, 5, multi.append());
+    for(index_t d = 0; d < multi.number_of_children(); d++)
+    {
+        multi.child(d)["state/domain_id"] = d;
+    }
+    htg_test_extract(multi, multi_file);
+
+    // the baseline was written by the single domain serial writer,
+    // the tree must not depend on how the grid is split
+    string baseline_file = conduit::utils::join_file_path(ASCENT_T_SRC_DIR,"_baseline_images");
+    baseline_file = conduit::utils::join_file_path(baseline_file,"tout_htg_multi_domain.htg");
+    string baseline_htg = htg_test_read(baseline_file);
+    EXPECT_FALSE(baseline_htg.empty());
+    EXPECT_EQ(htg_test_read(single_file + ".htg"), baseline_htg);
+    EXPECT_EQ(htg_test_read(multi_file + ".htg"), baseline_htg);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_htg, test_htg_overlapping_domains)
+{
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_htg_overlapping_domains");
+    remove_test_file(output_file + ".htg");
+
+    // the domains share a layer of cells, so the field is skipped
+    Node multi;
+    htg_test_domain(0, 0, 0, 8, 8, 5, multi.append());
+    htg_test_domain(0, 0, 4, 8, 8, 4, multi.append());
+    for(index_t d = 0; d < multi.number_of_children(); d++)
+    {
+        multi.child(d)["state/domain_id"] = d;
+    }
+    htg_test_extract(multi, output_file);
+
+    EXPECT_FALSE(conduit::utils::is_file(output_file + ".htg"));
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
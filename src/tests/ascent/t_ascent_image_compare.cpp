@@ -17,8 +17,12 @@
 
 #include <iostream>
 #include <math.h>
+#include <string.h>
+#include <vector>
 
 #include <conduit_blueprint.hpp>
+#include <png_utils/ascent_png_encoder.hpp>
+#include <png_utils/ascent_png_decoder.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -102,6 +106,80 @@ TEST(ascent_image_compare, test_image_diff)
 }
 
 
+//-----------------------------------------------------------------------------
+TEST(ascent_image_compare, test_png_encoder_options)
+{
+    string output_path = prepare_output_dir();
+
+    // gradient image, bottom to top like our renders
+    const int width = 301;
+    const int height = 203;
+    std::vector<float> rgba(width * height * 4);
+    std::vector<unsigned char> expected(width * height * 4);
+    for(int y = 0; y < height; ++y)
+    {
+      for(int x = 0; x < width; ++x)
+      {
+        const int offset = (y * width + x) * 4;
+        rgba[offset + 0] = float(x) / float(width);
+        rgba[offset + 1] = float(y) / float(height);
+        rgba[offset + 2] = float((x * y) % 256) / 255.f;
+        rgba[offset + 3] = 1.f;
+        const int flip_offset = ((height - y - 1) * width + x) * 4;
+        for(int c = 0; c < 4; ++c)
+        {
+          expected[flip_offset + c] = (unsigned char)(rgba[offset + c] * 255.f);
+        }
+      }
+    }
+
+    const int levels[4] = {-1, 0, 1, 6};
+    const size_t strip_sizes[3] = {0, 4096, 1 << 20};
+    for(int l = 0; l < 4; ++l)
+    {
+      for(int s = 0; s < 3; ++s)
+      {
+        PNGEncoder encoder;
+        encoder.SetCompressionLevel(levels[l]);
+        encoder.SetFilterStrategy(PNGEncoder::FILTER_NONE);
+        encoder.SetStripSize(strip_sizes[s]);
+        encoder.Encode(&rgba[0], width, height);
+
+        string output_file = conduit::utils::join_file_path(output_path,
+                                                            "tout_png_encoder_options.png");
+        encoder.Save(output_file);
+
+        unsigned char *decoded = nullptr;
+        int decoded_width, decoded_height;
+        PNGDecoder decoder;
+        decoder.Decode(decoded, decoded_width, decoded_height, output_file);
+
+        EXPECT_EQ(decoded_width, width);
+        EXPECT_EQ(decoded_height, height);
+        EXPECT_EQ(memcmp(decoded, &expected[0], expected.size()), 0)
+          << "level " << levels[l] << " strip size " << strip_sizes[s];
+        free(decoded);
+      }
+    }
+
+    // rows already top to bottom, encoded without a copy
+    PNGEncoder encoder;
+    encoder.SetFlipY(false);
+    encoder.SetStripSize(4096);
+    encoder.Encode(&expected[0], width, height);
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_png_encoder_no_flip.png");
+    encoder.Save(output_file);
+
+    unsigned char *decoded = nullptr;
+    int decoded_width, decoded_height;
+    PNGDecoder decoder;
+    decoder.Decode(decoded, decoded_width, decoded_height, output_file);
+    EXPECT_EQ(memcmp(decoded, &expected[0], expected.size()), 0);
+    free(decoded);
+}
+
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
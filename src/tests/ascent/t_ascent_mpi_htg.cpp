@@ -0,0 +1,253 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_mpi_htg.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <mpi.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <math.h>
+
+#include <conduit_blueprint.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+//-----------------------------------------------------------------------------
+// one block of an nx^3 grid over [-10,10]^3, with a blank sphere. The
+// values are exact in float, so the output does not depend on the
+// platform. Matches htg_test_domain in t_ascent_htg.cpp for nx = 8.
+void htg_test_domain(int nx,
+                     int oi, int oj, int ok,
+                     int ni, int nj, int nk,
+                     Node &dom)
+{
+    const double spacing = 20.0 / nx;
+    conduit::blueprint::mesh::examples::basic("uniform",
+                                              ni + 1,
+                                              nj + 1,
+                                              nk + 1,
+                                              dom);
+    dom["coordsets/coords/origin/x"] = -10.0 + oi * spacing;
+    dom["coordsets/coords/origin/y"] = -10.0 + oj * spacing;
+    dom["coordsets/coords/origin/z"] = -10.0 + ok * spacing;
+    dom["coordsets/coords/spacing/dx"] = spacing;
+    dom["coordsets/coords/spacing/dy"] = spacing;
+    dom["coordsets/coords/spacing/dz"] = spacing;
+
+    dom["fields/field/values"].set(DataType::float64(ni * nj * nk));
+    float64_array vals = dom["fields/field/values"].value();
+    int idx = 0;
+    for(int k = ok; k < ok + nk; k++)
+    {
+        for(int j = oj; j < oj + nj; j++)
+        {
+            for(int i = oi; i < oi + ni; i++)
+            {
+                int x = 2 * i - 5;
+                int y = 2 * j - 8;
+                int z = 2 * k - 4;
+                bool blank = x * x + y * y + z * z < 16;
+                vals[idx++] = blank ? -10000. : 0.5 * i + 0.25 * j * k - 0.125 * k;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Adds domain d of the list to the data of the rank it is assigned to.
+// Domains go round robin to every rank but the last, so the last rank
+// holds no domain.
+void htg_test_add_domain(int nx,
+                         const int *box,
+                         int d,
+                         Node &data)
+{
+    int par_rank;
+    int par_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &par_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &par_size);
+
+    const int data_ranks = par_size > 1 ? par_size - 1 : 1;
+    if(d % data_ranks == par_rank)
+    {
+        Node &dom = data.append();
+        htg_test_domain(nx,
+                        box[0], box[1], box[2],
+                        box[3], box[4], box[5],
+                        dom);
+        dom["state/domain_id"] = d;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void htg_test_extract(const Node &data,
+                      const string &output_file,
+                      MPI_Comm comm)
+{
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"]  = "htg";
+    add_extracts["extracts/e1/params/path"] = output_file;
+    add_extracts["extracts/e1/params/blank_value"] = float32(-10000.);
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+string htg_test_read(const string &path)
+{
+    std::ifstream ifs(path.c_str());
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_htg, test_htg_multi_domain)
+{
+    int par_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_htg_mpi_multi_domain");
+    if(par_rank == 0)
+    {
+        remove_test_file(output_file + ".htg");
+    }
+    MPI_Barrier(comm);
+
+    // the domains of the serial multi domain test, spread over the ranks
+    const int boxes[3][6] = {{0, 0, 0, 3, 8, 8},
+                             {3, 0, 0, 5, 8, 3},
+                             {3, 0, 3, 5, 8, 5}};
+    Node data;
+    for(int d = 0; d < 3; d++)
+    {
+        htg_test_add_domain(8, boxes[d], d, data);
+    }
+    htg_test_extract(data, output_file, comm);
+
+    if(par_rank == 0)
+    {
+        string baseline_file = conduit::utils::join_file_path(ASCENT_T_SRC_DIR,"_baseline_images");
+        baseline_file = conduit::utils::join_file_path(baseline_file,"tout_htg_multi_domain.htg");
+        string baseline_htg = htg_test_read(baseline_file);
+        EXPECT_FALSE(baseline_htg.empty());
+        EXPECT_EQ(htg_test_read(output_file + ".htg"), baseline_htg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_htg, test_htg_blocks_across_ranks)
+{
+    int par_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+
+    string output_path = prepare_output_dir();
+    string single_file = conduit::utils::join_file_path(output_path,"tout_htg_mpi_single_domain_64");
+    string multi_file = conduit::utils::join_file_path(output_path,"tout_htg_mpi_multi_domain_64");
+
+    // rank 0 writes the reference on its own
+    if(par_rank == 0)
+    {
+        remove_test_file(single_file + ".htg");
+        remove_test_file(multi_file + ".htg");
+
+        Node single;
+        htg_test_domain(64, 0, 0, 0, 64, 64, 64, single);
+        htg_test_extract(single, single_file, MPI_COMM_SELF);
+    }
+    MPI_Barrier(comm);
+
+    // a 64^3 grid is built from 2^3 blocks. The splits at x = 31 and
+    // z = 33 are odd, so the blocks along them hold cells of domains
+    // on different ranks and are sent to the lowest of those ranks.
+    const int boxes[3][6] = {{ 0, 0,  0, 31, 64, 64},
+                             {31, 0,  0, 33, 64, 33},
+                             {31, 0, 33, 33, 64, 31}};
+    Node data;
+    for(int d = 0; d < 3; d++)
+    {
+        htg_test_add_domain(64, boxes[d], d, data);
+    }
+    htg_test_extract(data, multi_file, comm);
+
+    if(par_rank == 0)
+    {
+        string single_htg = htg_test_read(single_file + ".htg");
+        EXPECT_FALSE(single_htg.empty());
+        EXPECT_EQ(htg_test_read(multi_file + ".htg"), single_htg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_htg, test_htg_overlapping_domains)
+{
+    int par_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_htg_mpi_overlapping_domains");
+    if(par_rank == 0)
+    {
+        remove_test_file(output_file + ".htg");
+    }
+    MPI_Barrier(comm);
+
+    // the domains share a layer of cells and live on different ranks,
+    // every rank has to agree to skip the field
+    const int boxes[2][6] = {{0, 0, 0, 8, 8, 5},
+                             {0, 0, 4, 8, 8, 4}};
+    Node data;
+    for(int d = 0; d < 2; d++)
+    {
+        htg_test_add_domain(8, boxes[d], d, data);
+    }
+    htg_test_extract(data, output_file, comm);
+
+    MPI_Barrier(comm);
+    EXPECT_FALSE(conduit::utils::is_file(output_file + ".htg"));
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    result = RUN_ALL_TESTS();
+    MPI_Finalize();
+
+    return result;
+}
@@ -133,6 +133,68 @@ TEST(ascent_partition, test_global_ranks_non_unique)
     EXPECT_THROW(ascent.publish(data),conduit::Error);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_partition, test_unique_ids_layout_change)
+{
+    Node n;
+    ascent::about(n);
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+
+    //
+    //Set Up MPI
+    //
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    // use spiral , with 20 domains
+    conduit::blueprint::mpi::mesh::examples::spiral_round_robin(20,data,comm);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    int root = 0;
+    if(par_rank == root)
+    	ASCENT_INFO("Testing unique IDs across repeated publishes");
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent_opts["exceptions"] = "forward";
+    ascent.open(ascent_opts);
+
+    // the spiral example provides unique ids, the second publish
+    // reuses the result of the first check
+    EXPECT_NO_THROW(ascent.publish(data));
+    EXPECT_NO_THROW(ascent.publish(data));
+
+    // changing the layout must trigger a new check, with more
+    // than one rank the new ids collide across ranks
+    int num_domains = data.number_of_children();
+    for(int i = 0; i < num_domains; i++)
+    {
+      conduit::Node &dom = data.child(i);
+      dom["state/domain_id"] = i;
+    }
+
+    if(par_size > 1)
+    {
+      EXPECT_THROW(ascent.publish(data),conduit::Error);
+    }
+    ascent.close();
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -390,6 +390,127 @@ TEST(ascent_multi_topo, adapter_test)
     delete collection;
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, mesh_cache)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data["domain_0"]);
+    data["domain_0/state/domain_id"] = 0;
+
+    VTKHMeshCache cache;
+
+    // first conversion fills the cache
+    VTKHCollection* collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,
+                                                                            true,
+                                                                            &cache);
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 1);
+    EXPECT_TRUE(collection->has_field("braid"));
+    delete collection;
+
+    // same buffers, the mesh is reused and fields are re-bound
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data, true, &cache);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 1);
+    EXPECT_TRUE(collection->has_field("braid"));
+    delete collection;
+
+    // a new topology generation invalidates the cached mesh
+    data["domain_0/state/topology_generation"] = 1;
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data, true, &cache);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 2);
+
+    Node out_data, verify_info;
+    VTKHDataAdapter::VTKHCollectionToBlueprintDataSet(collection, out_data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(out_data, verify_info));
+    delete collection;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, copy_report)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data["domain_0"]);
+    data["domain_0/state/domain_id"] = 0;
+
+    // an int field has to be converted to a type vtk-h supports
+    const int neles = data["domain_0/fields/radial/values"].dtype().number_of_elements();
+    data["domain_0/fields/ids/association"] = "element";
+    data["domain_0/fields/ids/topology"] = "mesh";
+    data["domain_0/fields/ids/values"].set(DataType::int32(neles));
+    int32 *ids = data["domain_0/fields/ids/values"].value();
+    for(int i = 0; i < neles; ++i)
+    {
+      ids[i] = i;
+    }
+
+    VTKHDataAdapter::ResetCopyReport();
+    VTKHCollection* collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true);
+
+    Node report;
+    VTKHDataAdapter::CopyReport(report);
+    report.print();
+
+    // the vel components are wrapped, not copied
+    bool ids_copied = false;
+    NodeConstIterator itr = report["arrays"].children();
+    while(itr.has_next())
+    {
+      const Node &entry = itr.next();
+      const std::string path = entry["path"].as_string();
+      EXPECT_EQ(path.find("fields/vel"), std::string::npos);
+      if(path == "domain_0/fields/ids/values")
+      {
+        ids_copied = true;
+        EXPECT_EQ(entry["reason"].as_string(), "dtype conversion");
+        EXPECT_EQ(entry["bytes"].to_int64(), (int64)(neles * sizeof(float64)));
+      }
+    }
+    EXPECT_TRUE(ids_copied);
+    EXPECT_TRUE(collection->has_field("vel"));
+
+    Node out_data, verify_info;
+    VTKHDataAdapter::VTKHCollectionToBlueprintDataSet(collection, out_data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(out_data, verify_info));
+    EXPECT_TRUE(out_data.child(0).has_path("fields/vel/values/w"));
+    delete collection;
+
+    // copies that are asked for are reported too
+    const int64 zero_copy_bytes = report["bytes"].to_int64();
+    VTKHDataAdapter::ResetCopyReport();
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,false);
+    VTKHDataAdapter::CopyReport(report);
+    EXPECT_GT(report["bytes"].to_int64(), zero_copy_bytes);
+    delete collection;
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
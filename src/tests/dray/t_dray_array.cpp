@@ -5,6 +5,9 @@
 
 #include "gtest/gtest.h"
 #include <dray/array.hpp>
+#include <dray/linear_bvh_builder.hpp>
+
+#include <vector>
 
 TEST (dray_array, dray_array_basic)
 {
@@ -18,3 +21,43 @@ TEST (dray_array, dray_array_basic)
   ASSERT_EQ (host2[0], 0);
   ASSERT_EQ (host2[1], 1);
 }
+
+TEST (dray_array, dray_sort_mcodes)
+{
+  // large enough to be split into several chunks
+  const int size = 100000;
+  dray::Array<dray::uint32> mcodes;
+  mcodes.resize (size);
+  dray::uint32 *codes = mcodes.get_host_ptr ();
+  std::vector<dray::uint32> orig (size);
+  for (int i = 0; i < size; ++i)
+  {
+    // 30 bit codes with plenty of duplicates
+    codes[i] = ((dray::uint32)i * 2654435761u) % (1u << 30) / 7u;
+    if (i % 10 == 0)
+    {
+      codes[i] = 42;
+    }
+    orig[i] = codes[i];
+  }
+
+  dray::Array<dray::int32> ids = dray::sort_mcodes (mcodes);
+  ASSERT_EQ (ids.size (), size);
+  ASSERT_EQ (mcodes.size (), size);
+
+  const dray::uint32 *sorted = mcodes.get_host_ptr ();
+  const dray::int32 *ids_ptr = ids.get_host_ptr ();
+  for (int i = 0; i < size; ++i)
+  {
+    ASSERT_EQ (sorted[i], orig[ids_ptr[i]]);
+    if (i > 0)
+    {
+      ASSERT_LE (sorted[i - 1], sorted[i]);
+      // equal codes keep their input order
+      if (sorted[i - 1] == sorted[i])
+      {
+        ASSERT_LT (ids_ptr[i - 1], ids_ptr[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "gtest/gtest.h"
+#include <dray/array_utils.hpp>
+#include <dray/dray.hpp>
+#include <dray/linear_bvh_builder.hpp>
+
+#include <cstring>
+
+namespace
+{
+
+dray::Array<dray::AABB<>> make_boxes (const int size, const float shift)
+{
+  dray::Array<dray::AABB<>> aabbs;
+  aabbs.resize (size);
+  dray::AABB<> *aabb_ptr = aabbs.get_host_ptr ();
+  for (int i = 0; i < size; ++i)
+  {
+    const float x = float (i % 10) + shift;
+    const float y = float ((i / 10) % 10);
+    const float z = float (i / 100);
+    dray::AABB<> box;
+    box.include (dray::Vec<dray::float32, 3> ({x, y, z}));
+    box.include (dray::Vec<dray::float32, 3> ({x + 0.5f, y + 0.5f, z + 0.5f}));
+    aabb_ptr[i] = box;
+  }
+  return aabbs;
+}
+
+} // namespace
+
+TEST (dray_bvh, dray_bvh_refit)
+{
+  const int size = 1000;
+  dray::LinearBVHBuilder builder;
+  dray::Array<dray::AABB<>> aabbs = make_boxes (size, 0.f);
+  dray::BVH bvh = builder.construct (aabbs);
+  EXPECT_GT (bvh.m_build_cost, 0.f);
+
+  // translating the boxes keeps the tree, every node moves with them
+  const float shift = 2.f;
+  dray::Array<dray::AABB<>> moved = make_boxes (size, shift);
+  dray::BVH refit = builder.refit (bvh, moved, dray::array_counting (size, 0, 1));
+
+  ASSERT_EQ (refit.m_inner_nodes.size (), bvh.m_inner_nodes.size ());
+  EXPECT_EQ (refit.m_build_cost, bvh.m_build_cost);
+  EXPECT_EQ (refit.m_bounds.m_ranges[0].min (), shift);
+  EXPECT_EQ (refit.m_bounds.m_ranges[0].max (), 9.5f + shift);
+
+  const dray::Vec<dray::float32, 4> *orig_ptr = bvh.m_inner_nodes.get_host_ptr ();
+  const dray::Vec<dray::float32, 4> *refit_ptr = refit.m_inner_nodes.get_host_ptr ();
+  const int inner_size = bvh.m_inner_nodes.size () / 4;
+  for (int n = 0; n < inner_size; ++n)
+  {
+    // x ranges of the left and right child
+    EXPECT_EQ (refit_ptr[n * 4 + 0][0], orig_ptr[n * 4 + 0][0] + shift);
+    EXPECT_EQ (refit_ptr[n * 4 + 0][3], orig_ptr[n * 4 + 0][3] + shift);
+    EXPECT_EQ (refit_ptr[n * 4 + 1][2], orig_ptr[n * 4 + 1][2] + shift);
+    EXPECT_EQ (refit_ptr[n * 4 + 2][1], orig_ptr[n * 4 + 2][1] + shift);
+    // same children, the links are int32 stored in the float slots
+    // and leaf links read as NaN, so compare them as ints
+    dray::int32 refit_links[2], orig_links[2];
+    std::memcpy (refit_links, &refit_ptr[n * 4 + 3][0], sizeof (refit_links));
+    std::memcpy (orig_links, &orig_ptr[n * 4 + 3][0], sizeof (orig_links));
+    EXPECT_EQ (refit_links[0], orig_links[0]);
+    EXPECT_EQ (refit_links[1], orig_links[1]);
+  }
+
+  // a threshold below one turns refitting off
+  const float threshold = dray::dray::get_bvh_refit_threshold ();
+  dray::dray::set_bvh_refit_threshold (0.f);
+  dray::BVH rebuilt = builder.refit (bvh, moved, dray::array_counting (size, 0, 1));
+  dray::BVH built = builder.construct (moved);
+  EXPECT_EQ (rebuilt.m_build_cost, built.m_build_cost);
+  dray::dray::set_bvh_refit_threshold (threshold);
+}
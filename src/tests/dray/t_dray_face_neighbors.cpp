@@ -0,0 +1,157 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+
+#include "gtest/gtest.h"
+
+#include "t_utils.hpp"
+#include "t_config.hpp"
+
+#include <conduit_blueprint.hpp>
+
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/data_model/unstructured_mesh.hpp>
+
+const int EXAMPLE_MESH_SIDE_DIM = 6;
+
+namespace
+{
+
+// every interior face must be shared by exactly two elements
+template <typename MeshType>
+void check_face_neighbors (MeshType *mesh,
+                           const int faces_per_elem,
+                           const int expected_boundary)
+{
+  dray::Array<dray::int32> neighbors = mesh->get_face_neighbors ();
+  const int cells = mesh->cells ();
+  ASSERT_EQ (neighbors.size (), cells * faces_per_elem);
+
+  const dray::int32 *neighbors_ptr = neighbors.get_host_ptr_const ();
+  int boundary = 0;
+  for (int el = 0; el < cells; ++el)
+  {
+    for (int face = 0; face < faces_per_elem; ++face)
+    {
+      const int other = neighbors_ptr[el * faces_per_elem + face];
+      if (other == -1)
+      {
+        boundary++;
+        continue;
+      }
+      ASSERT_GE (other, 0);
+      ASSERT_LT (other, cells);
+      EXPECT_NE (other, el);
+      // the neighbor points back through exactly one of its faces
+      int back = 0;
+      for (int other_face = 0; other_face < faces_per_elem; ++other_face)
+      {
+        if (neighbors_ptr[other * faces_per_elem + other_face] == el)
+        {
+          back++;
+        }
+      }
+      EXPECT_EQ (back, 1);
+    }
+  }
+  EXPECT_EQ (boundary, expected_boundary);
+}
+
+// the walk must find the same element as the bvh, whether the hint is
+// the element itself, a few faces away, too far to walk to, or outside
+template <typename MeshType>
+void check_walk_locate (MeshType *mesh)
+{
+  // samples along a line that starts and ends outside the [-10,10] box
+  const int samples = 60;
+  dray::Array<dray::Vec<dray::Float, 3>> points;
+  points.resize (samples);
+  dray::Vec<dray::Float, 3> *points_ptr = points.get_host_ptr ();
+  for (int i = 0; i < samples; ++i)
+  {
+    const float t = float (i) / float (samples - 1);
+    points_ptr[i] = { -12.3f + 24.1f * t, -11.7f + 23.3f * t, -10.9f + 21.7f * t };
+  }
+
+  dray::Array<dray::Location> expected = mesh->locate (points);
+  const dray::Location *expected_ptr = expected.get_host_ptr_const ();
+
+  int outside = 0;
+  for (int i = 0; i < samples; ++i)
+  {
+    outside += expected_ptr[i].m_cell_id == -1 ? 1 : 0;
+  }
+  EXPECT_GT (outside, 0);
+  EXPECT_LT (outside, samples);
+
+  // hints from 1, 4 and 12 samples back cross 0-1, a few and more
+  // elements than the walk is allowed to take
+  const int strides[3] = { 1, 4, 12 };
+  for (int s = 0; s < 3; ++s)
+  {
+    dray::Array<dray::Location> hints;
+    hints.resize (samples);
+    dray::Location *hints_ptr = hints.get_host_ptr ();
+    for (int i = 0; i < samples; ++i)
+    {
+      const int from = i - strides[s];
+      hints_ptr[i] = from < 0 ? dray::Location{ -1, { -1.f, -1.f, -1.f } } : expected_ptr[from];
+    }
+
+    dray::Array<dray::Location> walked = mesh->locate (points, hints);
+    const dray::Location *walked_ptr = walked.get_host_ptr_const ();
+    for (int i = 0; i < samples; ++i)
+    {
+      EXPECT_EQ (walked_ptr[i].m_cell_id, expected_ptr[i].m_cell_id)
+        << "sample " << i << " stride " << strides[s];
+      if (expected_ptr[i].m_cell_id != -1)
+      {
+        for (int d = 0; d < 3; ++d)
+        {
+          EXPECT_NEAR (walked_ptr[i].m_ref_pt[d], expected_ptr[i].m_ref_pt[d], 1e-3f);
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST (dray_face_neighbors, dray_hex_face_neighbors)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             data);
+
+  dray::DataSet domain = dray::BlueprintLowOrder::import(data);
+  dray::HexMesh_P1 *mesh = dynamic_cast<dray::HexMesh_P1*>(domain.mesh());
+  ASSERT_TRUE (mesh != nullptr);
+
+  const int side = EXAMPLE_MESH_SIDE_DIM - 1;
+  check_face_neighbors (mesh, 6, 6 * side * side);
+  check_walk_locate (mesh);
+}
+
+TEST (dray_face_neighbors, dray_tet_face_neighbors)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("tets",
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             data);
+
+  dray::DataSet domain = dray::BlueprintLowOrder::import(data);
+  dray::TetMesh_P1 *mesh = dynamic_cast<dray::TetMesh_P1*>(domain.mesh());
+  ASSERT_TRUE (mesh != nullptr);
+
+  // each boundary quad of the hexes is split into two triangles
+  const int side = EXAMPLE_MESH_SIDE_DIM - 1;
+  check_face_neighbors (mesh, 4, 2 * 6 * side * side);
+  check_walk_locate (mesh);
+}
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
+
 #include <dray/data_model/collection.hpp>
+#include <dray/data_model/unstructured_field.hpp>
 #include <dray/filters/isosurfacing.hpp>
 #include <dray/filters/marching_cubes.hpp>
 
@@ -52,6 +55,11 @@ isosurface_3d(const conduit::Node &dset, const std::string name,
 
   handle_test(std::string("iso_") + name, output);
 
+  // Visiting only the cells picked by the span index gives the same surface
+  iso.set_use_span_index(true);
+  output = iso.execute(collection);
+  handle_test(std::string("iso_") + name, output);
+
   // NOTE: Make sure that baselines are generated by the MarchingCubes filter.
 #ifndef GENERATE_BASELINES
   // Should also get the same result from the ExtractIsosurface filter
@@ -178,3 +186,97 @@ TEST (t_dray_isosurfacing_low_order, tets_braid)
 
   isosurface_3d(data, "tets_braid", "braid");
 }
+
+//-----------------------------------------------------------------------------
+TEST (t_dray_isosurfacing_low_order, span_index_candidates)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("structured",
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             data);
+  dray::DataSet domain = dray::BlueprintReader::blueprint_to_dray(data);
+  using FieldType = dray::UnstructuredField<dray::HexScalar_P1>;
+  FieldType *field = dynamic_cast<FieldType*>(domain.field("braid"));
+  ASSERT_TRUE(field != nullptr);
+
+  const dray::SpanIndex &index = field->span_index();
+  EXPECT_TRUE(index.is_built());
+  EXPECT_EQ(index.num_elems(), field->get_num_elem());
+  // the index is built once and cached on the field
+  EXPECT_EQ(&index, &field->span_index());
+
+  const dray::GridFunction<1> &gf = field->get_dof_data();
+  const dray::int32 *ctrl_ptr = gf.m_ctrl_idx.get_host_ptr_const();
+  const dray::Vec<dray::Float,1> *values_ptr = gf.m_values.get_host_ptr_const();
+  const dray::Range range = field->range()[0];
+
+  // sweep values across (and past) the field range and compare
+  // against classifying every cell
+  const int num_values = 20;
+  for(int v = 0; v < num_values; ++v)
+  {
+    const dray::Float value = range.min() - 1.f
+      + (range.length() + 2.f) * dray::Float(v) / dray::Float(num_values - 1);
+
+    std::vector<dray::int32> expected;
+    for(dray::int32 el = 0; el < gf.m_size_el; ++el)
+    {
+      dray::Float min_val = values_ptr[ctrl_ptr[el * gf.m_el_dofs]][0];
+      dray::Float max_val = min_val;
+      for(dray::int32 i = 1; i < gf.m_el_dofs; ++i)
+      {
+        const dray::Float val = values_ptr[ctrl_ptr[el * gf.m_el_dofs + i]][0];
+        min_val = std::min(min_val, val);
+        max_val = std::max(max_val, val);
+      }
+      if(min_val <= value && value < max_val)
+      {
+        expected.push_back(el);
+      }
+    }
+
+    dray::Array<dray::int32> cands = index.candidates(value);
+    ASSERT_EQ(cands.size(), expected.size());
+    const dray::int32 *cands_ptr = cands.get_host_ptr_const();
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+      EXPECT_EQ(cands_ptr[i], expected[i]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST (t_dray_isosurfacing_low_order, span_index_sweep)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("tets",
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             EXAMPLE_MESH_SIDE_DIM,
+                                             data);
+  dray::Collection collection;
+  collection.add_domain(dray::BlueprintReader::blueprint_to_dray(data));
+
+  const dray::Float isovalues[] = {-5.f, -2.5f, 0.f, 2.5f, 5.f};
+  const int num_isovalues = 5;
+
+  dray::MarchingCubes iso;
+  iso.set_field("braid");
+  iso.set_isovalues(isovalues, num_isovalues);
+  dray::Collection full = iso.execute(collection);
+  iso.set_use_span_index(true);
+  dray::Collection indexed = iso.execute(collection);
+
+  // one surface per isovalue
+  ASSERT_EQ(full.local_size(), num_isovalues);
+  ASSERT_EQ(indexed.local_size(), num_isovalues);
+  for(int i = 0; i < num_isovalues; ++i)
+  {
+    dray::DataSet a = full.domain(i);
+    dray::DataSet b = indexed.domain(i);
+    EXPECT_EQ(a.mesh()->cells(), b.mesh()->cells());
+    EXPECT_EQ(a.field("braid")->range()[0].min(), b.field("braid")->range()[0].min());
+  }
+}
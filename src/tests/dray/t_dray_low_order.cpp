@@ -224,3 +224,83 @@ TEST (dray_low_order, dray_structured_hexs)
 
   render_3d(data, "structured_hexs");
 }
+
+TEST (dray_low_order, dray_cull_domains)
+{
+  // three braid boxes: one in front of the camera, one hidden behind
+  // it and one outside the view. The hidden and outside domains come
+  // first so the unculled render traces them before the front one.
+  const double z_origins[3] = { -50.0, -10.0, -10.0 };
+  const double x_origins[3] = { -10.0, 200.0, -10.0 };
+  dray::Collection dataset;
+  for(int d = 0; d < 3; ++d)
+  {
+    conduit::Node data;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               data);
+    data["coordsets/coords/origin/x"] = x_origins[d];
+    data["coordsets/coords/origin/z"] = z_origins[d];
+    dataset.add_domain(dray::BlueprintLowOrder::import(data));
+  }
+
+  std::string output_path = prepare_output_dir ();
+  std::string output_file =
+  conduit::utils::join_file_path (output_path, "cull_domains");
+  remove_test_image (output_file);
+
+  const int c_width  = 512;
+  const int c_height = 512;
+  dray::Camera camera;
+  camera.set_width (c_width);
+  camera.set_height (c_height);
+  camera.set_pos ({{ 5.f, 3.f, 60.f }});
+  camera.set_look_at ({{ 0.f, 0.f, 0.f }});
+  camera.set_up ({{ 0.f, 1.f, 0.f }});
+
+  std::shared_ptr<dray::Surface> surface
+    = std::make_shared<dray::Surface>(dataset);
+  surface->field("braid");
+  surface->color_map().color_table(dray::ColorTable("cool2warm"));
+  surface->draw_mesh (true);
+  surface->line_thickness(.1);
+
+  dray::Renderer renderer;
+  renderer.add(surface);
+
+  renderer.cull_domains(false);
+  dray::Framebuffer full_fb = renderer.render(camera);
+
+  renderer.cull_domains(true);
+  dray::Framebuffer cull_fb = renderer.render(camera);
+
+  // culled rays never reach a visible surface, so the images are the same
+  dray::Array<dray::Vec<dray::float32,4>> full_colors = full_fb.colors();
+  dray::Array<dray::Vec<dray::float32,4>> cull_colors = cull_fb.colors();
+  dray::Array<dray::float32> full_depths = full_fb.depths();
+  dray::Array<dray::float32> cull_depths = cull_fb.depths();
+  ASSERT_EQ (full_colors.size(), cull_colors.size());
+  const dray::Vec<dray::float32,4> *full_color_ptr = full_colors.get_host_ptr_const();
+  const dray::Vec<dray::float32,4> *cull_color_ptr = cull_colors.get_host_ptr_const();
+  const dray::float32 *full_depth_ptr = full_depths.get_host_ptr_const();
+  const dray::float32 *cull_depth_ptr = cull_depths.get_host_ptr_const();
+  int diffs = 0;
+  int covered = 0;
+  for(int i = 0; i < full_colors.size(); ++i)
+  {
+    covered += full_color_ptr[i][3] > 0.f ? 1 : 0;
+    bool same = full_depth_ptr[i] == cull_depth_ptr[i];
+    for(int c = 0; c < 4; ++c)
+    {
+      same = same && full_color_ptr[i][c] == cull_color_ptr[i][c];
+    }
+    diffs += same ? 0 : 1;
+  }
+  EXPECT_GT (covered, 0);
+  EXPECT_EQ (diffs, 0);
+
+  cull_fb.composite_background();
+  cull_fb.save(output_file);
+}
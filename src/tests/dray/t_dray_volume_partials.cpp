@@ -9,15 +9,22 @@
 #include "t_utils.hpp"
 #include "t_config.hpp"
 
+#include <conduit.hpp>
+
 #include <dray/rendering/renderer.hpp>
 #include <dray/rendering/volume.hpp>
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/rendering/colors.hpp>
 #include <dray/math.hpp>
 #include <dray/array_registry.hpp>
 
 #include <dray/utils/appstats.hpp>
 
+#include <cmath>
 #include <fstream>
+#include <map>
+#include <vector>
 #include <stdlib.h>
 
 //---------------------------------------------------------------------------//
@@ -31,6 +38,171 @@ mfem_enabled()
 #endif
 }
 
+//---------------------------------------------------------------------------//
+// A comb of COMB_TEETH unit wide hexes along x separated by unit gaps.
+// Each cell gets its own vertices so the field can jump at the faces:
+// the teeth have value 1. With fill_gaps the gaps are meshed too with
+// value 0, which gives the same image from a convex mesh.
+const int COMB_TEETH = 8;
+
+void
+make_comb(bool fill_gaps, conduit::Node &data)
+{
+  const int cols = 2 * COMB_TEETH - 1;
+  std::vector<double> x, y, z, values;
+  std::vector<conduit::int32> conn;
+  // vtk hex ordering
+  const int corners[8][3] = {{0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+                             {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1}};
+  for(int i = 0; i < cols; ++i)
+  {
+    const bool tooth = i % 2 == 0;
+    if(!tooth && !fill_gaps)
+    {
+      continue;
+    }
+    for(int c = 0; c < 8; ++c)
+    {
+      conn.push_back(static_cast<conduit::int32>(x.size()));
+      x.push_back(i + corners[c][0]);
+      y.push_back(2.0 * corners[c][1]);
+      z.push_back(2.0 * corners[c][2]);
+      values.push_back(tooth ? 1.0 : 0.0);
+    }
+  }
+
+  data["coordsets/coords/type"] = "explicit";
+  data["coordsets/coords/values/x"].set(x);
+  data["coordsets/coords/values/y"].set(y);
+  data["coordsets/coords/values/z"].set(z);
+  data["topologies/mesh/type"] = "unstructured";
+  data["topologies/mesh/coordset"] = "coords";
+  data["topologies/mesh/elements/shape"] = "hex";
+  data["topologies/mesh/elements/connectivity"].set(conn);
+  data["fields/density/association"] = "vertex";
+  data["fields/density/topology"] = "mesh";
+  data["fields/density/values"].set(values);
+}
+
+//---------------------------------------------------------------------------//
+dray::Array<dray::VolumePartial>
+comb_partials(bool fill_gaps, dray::Array<dray::Ray> &rays)
+{
+  conduit::Node data;
+  make_comb(fill_gaps, data);
+  dray::Collection dataset;
+  dataset.add_domain(dray::BlueprintLowOrder::import(data));
+
+  dray::ColorTable color_table ("Spectral");
+  color_table.add_alpha (0.f, 0.00f);
+  color_table.add_alpha (0.5f, 0.00f);
+  color_table.add_alpha (0.6f, 0.05f);
+  color_table.add_alpha (1.0f, 0.05f);
+
+  dray::Range range;
+  range.include(0.f);
+  range.include(1.f);
+
+  dray::Volume volume(dataset);
+  volume.field("density");
+  volume.samples(300);
+  volume.use_lighting(false);
+  // the gaps must be sampled like the teeth for a single segment
+  volume.skip_empty_space(false);
+  volume.color_map().color_table(color_table);
+  volume.color_map().scalar_range(range);
+
+  dray::Array<dray::PointLight> lights;
+  return volume.integrate(rays, lights);
+}
+
+//---------------------------------------------------------------------------//
+// front to back composite of the segments of each pixel
+std::map<int, dray::Vec<dray::float32,4>>
+composite_partials(dray::Array<dray::VolumePartial> &partials)
+{
+  std::map<int, dray::Vec<dray::float32,4>> pixels;
+  const dray::VolumePartial *partials_ptr = partials.get_host_ptr_const();
+  for(int i = 0; i < partials.size(); ++i)
+  {
+    const dray::VolumePartial &p = partials_ptr[i];
+    if(pixels.find(p.m_pixel_id) == pixels.end())
+    {
+      pixels[p.m_pixel_id] = p.m_color;
+    }
+    else
+    {
+      dray::pre_mult_alpha_blend_host(pixels[p.m_pixel_id], p.m_color);
+    }
+  }
+  return pixels;
+}
+
+//---------------------------------------------------------------------------//
+TEST (dray_volume_partials, dray_volume_partials_reentry)
+{
+  // rays along the comb, each one enters every tooth
+  const int ray_side = 4;
+  dray::Array<dray::Ray> rays;
+  rays.resize(ray_side * ray_side);
+  dray::Ray *rays_ptr = rays.get_host_ptr();
+  for(int j = 0; j < ray_side; ++j)
+  {
+    for(int k = 0; k < ray_side; ++k)
+    {
+      dray::Ray ray;
+      ray.m_orig = {{ -5.f, 0.3f + 0.3f * j, 0.35f + 0.3f * k }};
+      ray.m_dir = {{ 1.f, 0.01f, 0.005f }};
+      ray.m_dir.normalize();
+      ray.m_near = 0.f;
+      ray.m_far = dray::infinity<dray::Float>();
+      ray.m_pixel_id = j * ray_side + k;
+      rays_ptr[j * ray_side + k] = ray;
+    }
+  }
+
+  dray::Array<dray::Ray> comb_rays = rays;
+  dray::Array<dray::VolumePartial> comb = comb_partials(false, comb_rays);
+  dray::Array<dray::Ray> filled_rays = rays;
+  dray::Array<dray::VolumePartial> filled = comb_partials(true, filled_rays);
+
+  const int num_rays = ray_side * ray_side;
+  // every entry into a tooth is a segment, stored ray by ray
+  // front to back
+  ASSERT_EQ(comb.size(), num_rays * COMB_TEETH);
+  const dray::VolumePartial *comb_ptr = comb.get_host_ptr_const();
+  for(int r = 0; r < num_rays; ++r)
+  {
+    for(int s = 0; s < COMB_TEETH; ++s)
+    {
+      const dray::VolumePartial &p = comb_ptr[r * COMB_TEETH + s];
+      EXPECT_EQ(p.m_pixel_id, r);
+      EXPECT_GT(p.m_color[3], 0.f);
+      if(s > 0)
+      {
+        EXPECT_GT(p.m_depth, comb_ptr[r * COMB_TEETH + s - 1].m_depth);
+      }
+    }
+  }
+
+  // the convex mesh gives one segment per ray
+  ASSERT_EQ(filled.size(), num_rays);
+
+  // and the same image
+  std::map<int, dray::Vec<dray::float32,4>> comb_pixels = composite_partials(comb);
+  std::map<int, dray::Vec<dray::float32,4>> filled_pixels = composite_partials(filled);
+  ASSERT_EQ(comb_pixels.size(), filled_pixels.size());
+  for(auto &pixel : filled_pixels)
+  {
+    ASSERT_TRUE(comb_pixels.find(pixel.first) != comb_pixels.end());
+    for(int c = 0; c < 4; ++c)
+    {
+      EXPECT_NEAR(comb_pixels[pixel.first][c], pixel.second[c], 1e-4f)
+        << "pixel " << pixel.first;
+    }
+  }
+}
+
 //---------------------------------------------------------------------------//
 TEST (dray_volume_partials, dray_volume_partials)
 {
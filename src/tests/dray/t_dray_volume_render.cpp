@@ -9,11 +9,15 @@
 #include "t_utils.hpp"
 #include "t_config.hpp"
 
+#include <conduit_blueprint.hpp>
+
 #include <dray/rendering/renderer.hpp>
 #include <dray/rendering/volume.hpp>
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
 #include <dray/math.hpp>
 
+#include <cmath>
 #include <fstream>
 #include <stdlib.h>
 
@@ -132,3 +136,78 @@ TEST (dray_volume_render, dray_volume_render_triple)
   // note: dray diff tolerance was 0.2f prior to import
   EXPECT_TRUE (check_test_image (output_file,dray_baselines_dir(),0.05));
 }
+
+TEST (dray_volume_render, dray_volume_render_skip_empty)
+{
+  conduit::Node data;
+  conduit::blueprint::mesh::examples::braid("hexs", 20, 20, 20, data);
+
+  dray::Collection dataset;
+  dataset.add_domain(dray::BlueprintLowOrder::import(data));
+
+  std::string output_path = prepare_output_dir ();
+  std::string output_file =
+  conduit::utils::join_file_path (output_path, "braid_vr_skip_empty");
+  remove_test_image (output_file);
+
+  // two fully transparent ranges, so whole elements are skipped
+  dray::ColorTable color_table ("Spectral");
+  color_table.add_alpha (0.f, 0.00f);
+  color_table.add_alpha (0.3f, 0.00f);
+  color_table.add_alpha (0.4f, 0.50f);
+  color_table.add_alpha (0.5f, 0.50f);
+  color_table.add_alpha (0.6f, 0.00f);
+  color_table.add_alpha (0.75f, 0.00f);
+  color_table.add_alpha (0.85f, 0.8f);
+  color_table.add_alpha (1.0f, 0.8f);
+
+  const int c_width = 256;
+  const int c_height = 256;
+  dray::Camera camera;
+  camera.set_width (c_width);
+  camera.set_height (c_height);
+  camera.azimuth (30);
+  camera.elevate (20);
+  camera.reset_to_bounds (dataset.bounds());
+
+  std::shared_ptr<dray::Volume> volume
+    = std::make_shared<dray::Volume>(dataset);
+  volume->field("braid");
+  volume->color_map().color_table(color_table);
+
+  dray::Renderer renderer;
+  renderer.volume(volume);
+
+  volume->skip_empty_space(false);
+  dray::Framebuffer full_fb = renderer.render(camera);
+
+  volume->skip_empty_space(true);
+  dray::Framebuffer skip_fb = renderer.render(camera);
+
+  // skipping only moves rays along the same sample positions, so the
+  // images must match up to blending order round off
+  dray::Array<dray::Vec<dray::float32,4>> full_colors = full_fb.colors();
+  dray::Array<dray::Vec<dray::float32,4>> skip_colors = skip_fb.colors();
+  ASSERT_EQ (full_colors.size(), skip_colors.size());
+  const dray::Vec<dray::float32,4> *full_ptr = full_colors.get_host_ptr_const();
+  const dray::Vec<dray::float32,4> *skip_ptr = skip_colors.get_host_ptr_const();
+  int diffs = 0;
+  int covered = 0;
+  for(int i = 0; i < full_colors.size(); ++i)
+  {
+    covered += full_ptr[i][3] > 0.f ? 1 : 0;
+    for(int c = 0; c < 4; ++c)
+    {
+      if(std::abs(full_ptr[i][c] - skip_ptr[i][c]) > 1e-3f)
+      {
+        diffs++;
+        break;
+      }
+    }
+  }
+  EXPECT_GT (covered, 0);
+  EXPECT_EQ (diffs, 0);
+
+  skip_fb.composite_background();
+  skip_fb.save (output_file);
+}
@@ -16,7 +16,11 @@
 #include <flow_builtin_filters.hpp>
 
 #include <iostream>
+#include <sstream>
 #include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -160,6 +164,101 @@ public:
 
 
 
+//-----------------------------------------------------------------------------
+class ConcurrentIncFilter: public Filter
+{
+public:
+    ConcurrentIncFilter()
+    : Filter()
+    {}
+
+    virtual ~ConcurrentIncFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "concurrent_inc";
+        i["output_port"] = "true";
+        i["concurrent"]  = "true";
+        i["port_names"].append().set("in");
+        i["default_params"]["inc"].set((int)1);
+    }
+
+    virtual void execute()
+    {
+        int inc  = params()["inc"].value();
+
+        Node *in = input<Node>("in");
+        int val  = in->to_int();
+
+        val+= inc;
+
+        Node *res = new Node();
+        res->set(val);
+
+        set_output<Node>(res);
+    }
+
+};
+
+//-----------------------------------------------------------------------------
+// concurrent filter that waits (with a timeout) until another instance
+// is executing at the same time, used to show branches really overlap
+class RendezvousFilter: public Filter
+{
+public:
+    static std::atomic<int> s_arrived;
+    static std::atomic<int> s_met;
+
+    static void reset()
+    {
+        s_arrived = 0;
+        s_met = 0;
+    }
+
+    RendezvousFilter()
+    : Filter()
+    {}
+
+    virtual ~RendezvousFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "rendezvous";
+        i["output_port"] = "true";
+        i["concurrent"]  = "true";
+        i["port_names"].append().set("in");
+    }
+
+    virtual void execute()
+    {
+        s_arrived++;
+        auto start = std::chrono::steady_clock::now();
+        while(s_arrived < 2 &&
+              std::chrono::steady_clock::now() - start < std::chrono::seconds(30))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if(s_arrived >= 2)
+        {
+            s_met++;
+        }
+
+        Node *in = input<Node>("in");
+        Node *res = new Node();
+        res->set(in->to_int());
+        set_output<Node>(res);
+    }
+
+};
+
+std::atomic<int> RendezvousFilter::s_arrived(0);
+std::atomic<int> RendezvousFilter::s_met(0);
+
+
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph)
 {
@@ -752,3 +851,178 @@ TEST(ascent_flow_workspace, dag_graph_missing_input_error)
 
     Workspace::clear_supported_filter_types();
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, dag_graph_concurrent_execute)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+    Workspace::register_filter_type<ConcurrentIncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+    w.set_number_of_threads(4);
+    EXPECT_EQ(w.number_of_threads(),4);
+
+    // one source feeding several independent branches
+    // s -> (c0_0 -> c0_1 -> ... ) ... -> chain of adds
+    const int num_branches = 8;
+    const int branch_len   = 4;
+
+    w.graph().add_filter("src","s");
+
+    std::string prev_sum = "";
+    for(int b = 0; b < num_branches; b++)
+    {
+        std::string prev = "s";
+        for(int i = 0; i < branch_len; i++)
+        {
+            std::ostringstream oss;
+            oss << "c" << b << "_" << i;
+            // mix in non-concurrent filters
+            std::string f_type = (i == 1) ? "inc" : "concurrent_inc";
+            w.graph().add_filter(f_type,oss.str());
+            w.graph().connect(prev,oss.str(),"in");
+            prev = oss.str();
+        }
+
+        if(prev_sum.empty())
+        {
+            prev_sum = prev;
+        }
+        else
+        {
+            std::ostringstream oss;
+            oss << "sum_" << b;
+            w.graph().add_filter("add",oss.str());
+            w.graph().connect(prev_sum,oss.str(),"a");
+            w.graph().connect(prev,oss.str(),"b");
+            prev_sum = oss.str();
+        }
+    }
+
+    w.execute();
+
+    Node *res = w.registry().fetch<Node>(prev_sum);
+    ASCENT_INFO("Final result: " << res->to_json());
+    EXPECT_EQ(res->to_int(),num_branches * branch_len);
+    w.registry().consume(prev_sum);
+
+    // execute again, results should match the serial case
+    w.set_number_of_threads(1);
+    w.execute();
+    res = w.registry().fetch<Node>(prev_sum);
+    EXPECT_EQ(res->to_int(),num_branches * branch_len);
+    w.registry().consume(prev_sum);
+
+    EXPECT_THROW(w.set_number_of_threads(0),conduit::Error);
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, dag_graph_concurrent_branches_overlap)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<RendezvousFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+    w.set_number_of_threads(2);
+
+    // s -> r1 -> a
+    //   -> r2 ->
+    // each rendezvous filter only returns early if the other one
+    // is running at the same time
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("rendezvous","r1");
+    w.graph().add_filter("rendezvous","r2");
+    w.graph().add_filter("add","a");
+
+    w.graph().connect("s","r1","in");
+    w.graph().connect("s","r2","in");
+    w.graph().connect("r1","a","a");
+    w.graph().connect("r2","a","b");
+
+    RendezvousFilter::reset();
+    w.execute();
+
+    EXPECT_EQ(RendezvousFilter::s_met,2);
+
+    Node *res = w.registry().fetch<Node>("a");
+    EXPECT_EQ(res->to_int(),0);
+    w.registry().consume("a");
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, dag_graph_concurrent_missing_input_error)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<ConcurrentIncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+    w.set_number_of_threads(2);
+
+    w.graph().add_filter("src","v1");
+    w.graph().add_filter("concurrent_inc","i1");
+    w.graph().add_filter("add","a1");
+
+    w.graph().connect("v1","i1","in");
+    w.graph().connect("i1","a1","a");
+    // omit connection to trigger error
+    //w.graph().connect("v1","a1","b");
+
+    EXPECT_THROW(w.execute(),conduit::Error);
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, linear_graph_plan_reuse)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().add_filter("inc","b");
+
+    w.graph().connect("s","a","in");
+    w.graph().connect("a","b","in");
+
+    // the compiled plan is reused when the graph does not change
+    for(int i = 0; i < 3; i++)
+    {
+        w.execute();
+        Node *res = w.registry().fetch<Node>("b");
+        EXPECT_EQ(res->to_int(),2);
+        w.registry().consume("b");
+    }
+
+    // changing the graph must invalidate the plan
+    w.graph().add_filter("inc","c");
+    w.graph().connect("b","c","in");
+
+    w.execute();
+    Node *res = w.registry().fetch<Node>("c");
+    EXPECT_EQ(res->to_int(),3);
+    w.registry().consume("c");
+
+    // a reset graph must also invalidate the plan
+    w.reset();
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().connect("s","a","in");
+
+    w.execute();
+    res = w.registry().fetch<Node>("a");
+    EXPECT_EQ(res->to_int(),1);
+    w.registry().consume("a");
+
+    Workspace::clear_supported_filter_types();
+}
@@ -68,3 +68,57 @@ TEST(vtkh_dataset, vtkh_range)
   EXPECT_EQ(3, topo_dims);
 
 }
+
+//-----------------------------------------------------------------------------
+TEST(vtkh_dataset, vtkh_global_summary)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  data_set.AddDomain(CreateTestData(0, num_blocks, base_size), 0);
+
+  const vtkh::DataSet::GlobalSummary &summary = data_set.GetGlobalSummary();
+  EXPECT_EQ(1, summary.m_num_domains);
+  EXPECT_EQ(data_set.GetNumberOfCells(), summary.m_num_cells);
+  EXPECT_TRUE(summary.m_has_bounds);
+  EXPECT_TRUE(data_set.GlobalFieldExists("cell_data_Float64"));
+  EXPECT_FALSE(data_set.GlobalFieldExists("bananas"));
+  EXPECT_EQ(3, data_set.NumberOfComponents("vector_data_Float64"));
+  EXPECT_EQ(0, data_set.NumberOfComponents("bananas"));
+
+  bool valid = false;
+  vtkm::cont::Field::Association assoc
+    = data_set.GetFieldAssociation("cell_data_Float64", valid);
+  EXPECT_TRUE(valid);
+  EXPECT_EQ(vtkm::cont::Field::Association::Cells, assoc);
+  data_set.GetFieldAssociation("bananas", valid);
+  EXPECT_FALSE(valid);
+
+  // adding a domain refreshes the cached values
+  data_set.AddDomain(CreateTestData(1, num_blocks, base_size), 1);
+  EXPECT_EQ(2, data_set.GetGlobalNumberOfDomains());
+  EXPECT_EQ(data_set.GetNumberOfCells(), data_set.GetGlobalNumberOfCells());
+
+  vtkm::Bounds bounds = data_set.GetGlobalBounds();
+  EXPECT_EQ(vtkm::Float64(base_size * num_blocks), bounds.X.Max);
+
+  vtkm::cont::ArrayHandle<vtkm::Range> range = data_set.GetGlobalRange("point_data_Float64");
+  vtkm::cont::ArrayHandle<vtkm::Range> local_range = data_set.GetRange("point_data_Float64");
+  EXPECT_EQ(1, range.GetNumberOfValues());
+  EXPECT_EQ(local_range.ReadPortal().Get(0).Min, range.ReadPortal().Get(0).Min);
+  EXPECT_EQ(local_range.ReadPortal().Get(0).Max, range.ReadPortal().Get(0).Max);
+
+  data_set.RemoveField("point_data_Float64");
+  EXPECT_FALSE(data_set.GlobalFieldExists("point_data_Float64"));
+
+  // copies do not share the cache
+  vtkh::DataSet copy = data_set;
+  copy.AddConstantPointField(1.f, "constant");
+  EXPECT_TRUE(copy.GlobalFieldExists("constant"));
+  EXPECT_FALSE(data_set.GlobalFieldExists("constant"));
+}
@@ -0,0 +1,203 @@
+//-----------------------------------------------------------------------------
+///
+/// file: t_vtk-h_image_exchange_par.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <vtkh/compositing/vtkh_diy_image_block.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mpi.h>
+
+namespace
+{
+
+// width x height image with every pixel set to the background
+vtkh::Image make_image(const int width,
+                       const int height,
+                       const unsigned char *bg_color,
+                       const float bg_depth)
+{
+  vtkm::Bounds bounds;
+  bounds.X.Min = 1;
+  bounds.Y.Min = 1;
+  bounds.X.Max = width;
+  bounds.Y.Max = height;
+  vtkh::Image image(bounds);
+  const int size = width * height;
+  for(int i = 0; i < size; ++i)
+  {
+    std::memcpy(&image.m_pixels[i * 4], bg_color, 4);
+    image.m_depths[i] = bg_depth;
+  }
+  image.m_orig_rank = 3;
+  image.m_composite_order = 7;
+  return image;
+}
+
+void set_active(vtkh::Image &image, const int index)
+{
+  image.m_pixels[index * 4 + 0] = static_cast<unsigned char>(index % 251);
+  image.m_pixels[index * 4 + 1] = static_cast<unsigned char>(index % 13);
+  image.m_pixels[index * 4 + 2] = 200;
+  image.m_pixels[index * 4 + 3] = 255;
+  image.m_depths[index] = 0.25f + static_cast<float>(index) * 1e-3f;
+}
+
+// saves and loads the image, checks that the result is the same bit for
+// bit and returns true if it was active pixel encoded
+bool check_round_trip(const vtkh::Image &image)
+{
+  vtkh::ImageExchangeStats stats;
+  vtkhdiy::MemoryBuffer bb;
+  vtkhdiy::Serialization<vtkh::Image>::save(bb, image, &stats);
+  const size_t saved = bb.size();
+  bb.reset();
+
+  vtkh::Image res;
+  vtkhdiy::load(bb, res);
+  EXPECT_EQ(bb.position, saved);
+
+  EXPECT_EQ(res.m_orig_bounds, image.m_orig_bounds);
+  EXPECT_EQ(res.m_bounds, image.m_bounds);
+  EXPECT_EQ(res.m_orig_rank, image.m_orig_rank);
+  EXPECT_EQ(res.m_composite_order, image.m_composite_order);
+  EXPECT_EQ(res.GetNumberOfPixels(), image.GetNumberOfPixels());
+  EXPECT_EQ(res.m_pixels.size(), image.m_pixels.size());
+  EXPECT_EQ(res.m_depths.size(), image.m_depths.size());
+  if(res.m_pixels.size() == image.m_pixels.size() &&
+     res.m_depths.size() == image.m_depths.size())
+  {
+    EXPECT_EQ(std::memcmp(res.m_pixels.data(),
+                          image.m_pixels.data(),
+                          image.m_pixels.size()), 0);
+    EXPECT_EQ(std::memcmp(res.m_depths.data(),
+                          image.m_depths.data(),
+                          image.m_depths.size() * sizeof(float)), 0);
+  }
+
+  const size_t dense = vtkh::ActivePixelSpans::DenseBytes(image.GetNumberOfPixels());
+  EXPECT_EQ(stats.m_images, 1u);
+  EXPECT_EQ(stats.m_dense_bytes, dense);
+  if(stats.m_encoded_images == 1)
+  {
+    EXPECT_LT(stats.m_sent_bytes, dense);
+  }
+  else
+  {
+    EXPECT_EQ(stats.m_sent_bytes, dense);
+  }
+  return stats.m_encoded_images == 1;
+}
+
+const unsigned char bg_color[4] = {10, 20, 30, 255};
+
+} // namespace
+
+//----------------------------------------------------------------------------
+TEST(vtkh_image_exchange, vtkh_background_image)
+{
+  vtkh::Image image = make_image(64, 32, bg_color, 1.0f);
+  EXPECT_TRUE(check_round_trip(image));
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_image_exchange, vtkh_active_image)
+{
+  // only the first pixel is background, encoding cannot win
+  vtkh::Image image = make_image(64, 32, bg_color, 1.0f);
+  for(int i = 1; i < image.GetNumberOfPixels(); ++i)
+  {
+    set_active(image, i);
+  }
+  EXPECT_FALSE(check_round_trip(image));
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_image_exchange, vtkh_short_spans)
+{
+  // three background pixels for every active one, ending on a partial
+  // pair of spans
+  vtkh::Image image = make_image(63, 17, bg_color, 1.0f);
+  for(int i = 3; i < image.GetNumberOfPixels(); i += 4)
+  {
+    set_active(image, i);
+  }
+  EXPECT_TRUE(check_round_trip(image));
+
+  // one background pixel for every active one, the spans cost as much
+  // as the background they save so the dense image is sent
+  vtkh::Image dense = make_image(63, 17, bg_color, 1.0f);
+  for(int i = 1; i < dense.GetNumberOfPixels(); i += 2)
+  {
+    set_active(dense, i);
+  }
+  EXPECT_FALSE(check_round_trip(dense));
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_image_exchange, vtkh_nan_and_negative_zero_background)
+{
+  // a nan background depth must still match itself
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  vtkh::Image image = make_image(40, 20, bg_color, nan);
+  for(int i = 100; i < 140; ++i)
+  {
+    set_active(image, i);
+  }
+  EXPECT_TRUE(check_round_trip(image));
+
+  // +0 is not the -0 background, depths are compared by their bits
+  vtkh::Image zero = make_image(40, 20, bg_color, -0.0f);
+  for(int i = 200; i < 260; ++i)
+  {
+    zero.m_depths[i] = 0.0f;
+  }
+  EXPECT_TRUE(check_round_trip(zero));
+
+  vtkhdiy::MemoryBuffer bb;
+  vtkhdiy::save(bb, zero);
+  bb.reset();
+  vtkh::Image res;
+  vtkhdiy::load(bb, res);
+  EXPECT_TRUE(std::signbit(res.m_depths[0]));
+  EXPECT_FALSE(std::signbit(res.m_depths[200]));
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_image_exchange, vtkh_sub_image)
+{
+  vtkh::Image image = make_image(64, 32, bg_color, 1.0f);
+  for(int i = 0; i < image.GetNumberOfPixels(); i += 5)
+  {
+    set_active(image, i);
+  }
+
+  // a region away from the origin, like the pieces radix-k sends
+  vtkm::Bounds sub_bounds;
+  sub_bounds.X.Min = 17;
+  sub_bounds.X.Max = 40;
+  sub_bounds.Y.Min = 9;
+  sub_bounds.Y.Max = 20;
+  vtkh::Image sub_image;
+  sub_image.SubsetFrom(image, sub_bounds);
+  EXPECT_EQ(sub_image.GetNumberOfPixels(), 24 * 12);
+  check_round_trip(sub_image);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+  result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
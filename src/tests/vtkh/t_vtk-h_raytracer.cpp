@@ -10,9 +10,11 @@
 #include <vtkh/DataSet.hpp>
 #include <vtkh/rendering/RayTracer.hpp>
 #include <vtkh/rendering/Scene.hpp>
+#include <vtkh/utils/vtkm_array_utils.hpp>
 #include "t_vtkm_test_utils.hpp"
 
 #include <iostream>
+#include <string>
 
 
 
@@ -52,3 +54,87 @@ TEST(vtkh_raytracer, vtkh_serial_render)
   scene.AddRenderer(&tracer);
   scene.Render();
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_raytracer, vtkh_batched_cameras)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  vtkm::Bounds bounds = data_set.GetGlobalBounds();
+
+  // render several cameras through the same tracer with a batch
+  // size that splits them, like a cinema database would
+  const int num_cameras = 3;
+  std::vector<vtkh::Render> renders;
+  std::vector<vtkm::rendering::Camera> cameras;
+  for(int i = 0; i < num_cameras; ++i)
+  {
+    vtkm::rendering::Camera camera;
+    camera.SetPosition(vtkm::Vec<vtkm::Float64,3>(-16, -16, -16));
+    camera.ResetToBounds(bounds);
+    camera.Azimuth(40.f * i);
+    cameras.push_back(camera);
+    renders.push_back(vtkh::MakeRender(256,
+                                       256,
+                                       camera,
+                                       data_set,
+                                       "ray_tracer_batch_" + std::to_string(i)));
+  }
+
+  vtkh::RayTracer tracer;
+  tracer.SetInput(&data_set);
+  tracer.SetField("point_data_Float64");
+
+  vtkh::Scene scene;
+  scene.SetRenderBatchSize(2);
+  for(int i = 0; i < num_cameras; ++i)
+  {
+    scene.AddRender(renders[i]);
+  }
+  scene.AddRenderer(&tracer);
+  scene.Render();
+
+  // the first two cameras were composited together in one stacked
+  // image and the last one was traced against the structures built
+  // for the first batch, all of them must match a render on its own
+  const int size = 256 * 256 * 4;
+  for(int c = 0; c < num_cameras; ++c)
+  {
+    vtkh::Render single = vtkh::MakeRender(256,
+                                           256,
+                                           cameras[c],
+                                           data_set,
+                                           "ray_tracer_batch_single_" + std::to_string(c));
+    vtkh::RayTracer single_tracer;
+    single_tracer.SetInput(&data_set);
+    single_tracer.SetField("point_data_Float64");
+
+    vtkh::Scene single_scene;
+    single_scene.AddRender(single);
+    single_scene.AddRenderer(&single_tracer);
+    single_scene.Render();
+
+    float *batched = &vtkh::GetVTKMPointer(renders[c].GetCanvas().GetColorBuffer())[0][0];
+    float *expected = &vtkh::GetVTKMPointer(single.GetCanvas().GetColorBuffer())[0][0];
+    int diffs = 0;
+    for(int i = 0; i < size; ++i)
+    {
+      if(batched[i] != expected[i])
+      {
+        diffs++;
+      }
+    }
+    EXPECT_EQ(diffs, 0) << "camera " << c;
+  }
+}
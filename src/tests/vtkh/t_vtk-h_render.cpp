@@ -8,11 +8,14 @@
 
 #include <vtkh/vtkh.hpp>
 #include <vtkh/DataSet.hpp>
+#include <vtkh/compositing/Compositor.hpp>
+#include <vtkh/rendering/ImageWriter.hpp>
 #include <vtkh/rendering/RayTracer.hpp>
 #include <vtkh/rendering/Scene.hpp>
 #include "t_vtkm_test_utils.hpp"
 
 #include <iostream>
+#include <fstream>
 
 
 
@@ -246,3 +249,151 @@ TEST(vtkh_render, vtkh_bg_color)
   scene.AddRenderer(&tracer);
   scene.Render();
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_render, vtkh_async_image_output)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  vtkm::Bounds bounds = data_set.GetGlobalBounds();
+
+  vtkh::ImageWriter::SetAsync(true);
+  vtkh::ImageWriter::SetNumberOfThreads(2);
+  vtkh::ImageWriter::SetQueueSize(2);
+
+  vtkh::RayTracer tracer;
+  tracer.SetInput(&data_set);
+  tracer.SetField("point_data_Float64");
+
+  vtkh::Scene scene;
+  const int num_images = 6;
+  for(int i = 0; i < num_images; ++i)
+  {
+    vtkm::rendering::Camera camera;
+    camera.ResetToBounds(bounds);
+    camera.Azimuth(float(i) * 60.f);
+    std::string name = "async_image_output_" + std::to_string(i);
+    vtkh::Render render = vtkh::MakeRender(256,
+                                           256,
+                                           camera,
+                                           data_set,
+                                           name);
+    scene.AddRender(render);
+  }
+  scene.AddRenderer(&tracer);
+  scene.Render();
+
+  vtkh::ImageWriter::Wait();
+  EXPECT_EQ(vtkh::ImageWriter::GetNumberOfPending(), 0);
+
+  for(int i = 0; i < num_images; ++i)
+  {
+    std::string name = "async_image_output_" + std::to_string(i) + ".png";
+    std::ifstream file(name.c_str());
+    EXPECT_TRUE(file.good());
+  }
+
+  vtkh::ImageWriter::SetAsync(false);
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_render, vtkh_async_image_output_refs)
+{
+  // two users of async output, the first to finish must not turn
+  // it off for the other
+  vtkh::ImageWriter::AcquireAsync();
+  vtkh::ImageWriter::AcquireAsync();
+  EXPECT_TRUE(vtkh::ImageWriter::GetAsync());
+  vtkh::ImageWriter::ReleaseAsync();
+  EXPECT_TRUE(vtkh::ImageWriter::GetAsync());
+  vtkh::ImageWriter::ReleaseAsync();
+  EXPECT_FALSE(vtkh::ImageWriter::GetAsync());
+
+  // extra releases are ignored
+  vtkh::ImageWriter::ReleaseAsync();
+  vtkh::ImageWriter::AcquireAsync();
+  EXPECT_TRUE(vtkh::ImageWriter::GetAsync());
+
+  // SetAsync(false) leaves held references alone
+  vtkh::ImageWriter::SetAsync(true);
+  vtkh::ImageWriter::SetAsync(false);
+  EXPECT_TRUE(vtkh::ImageWriter::GetAsync());
+  vtkh::ImageWriter::ReleaseAsync();
+  EXPECT_FALSE(vtkh::ImageWriter::GetAsync());
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_render, vtkh_composite_zbuffer_blend)
+{
+  const int width = 4;
+  const int height = 2;
+  const int size = width * height;
+
+  // three layers, added out of depth order. Pixel 0 gets a half
+  // transparent green in front of a half transparent blue in front
+  // of opaque red. Pixel 1 only has the blue layer.
+  float depths[3][size];
+  unsigned char colors[3][size * 4];
+  for(int l = 0; l < 3; ++l)
+  {
+    for(int i = 0; i < size; ++i)
+    {
+      depths[l][i] = 2.f;
+      colors[l][i * 4 + 0] = 0;
+      colors[l][i * 4 + 1] = 0;
+      colors[l][i * 4 + 2] = 0;
+      colors[l][i * 4 + 3] = 0;
+    }
+  }
+
+  // opaque red, back
+  depths[0][0] = 0.8f;
+  colors[0][0] = 255;
+  colors[0][3] = 255;
+  // transparent green, front
+  depths[1][0] = 0.2f;
+  colors[1][1] = 128;
+  colors[1][3] = 128;
+  // transparent blue, middle
+  depths[2][0] = 0.5f;
+  colors[2][2] = 128;
+  colors[2][3] = 128;
+  depths[2][1] = 0.5f;
+  colors[2][6] = 128;
+  colors[2][7] = 128;
+
+  vtkh::Compositor compositor;
+  compositor.SetCompositeMode(vtkh::Compositor::Z_BUFFER_BLEND);
+  for(int l = 0; l < 3; ++l)
+  {
+    compositor.AddImage(colors[l], depths[l], width, height);
+  }
+
+  vtkh::Image result = compositor.Composite();
+  EXPECT_EQ(result.GetNumberOfPixels(), size);
+
+  EXPECT_EQ(result.m_pixels[0], 64);
+  EXPECT_EQ(result.m_pixels[1], 128);
+  EXPECT_EQ(result.m_pixels[2], 63);
+  EXPECT_EQ(result.m_pixels[3], 255);
+  EXPECT_FLOAT_EQ(result.m_depths[0], 0.2f);
+
+  EXPECT_EQ(result.m_pixels[6], 128);
+  EXPECT_EQ(result.m_pixels[7], 128);
+  EXPECT_FLOAT_EQ(result.m_depths[1], 0.5f);
+
+  // background is untouched
+  EXPECT_EQ(result.m_pixels[11], 0);
+  EXPECT_GT(result.m_depths[2], 1.f);
+}
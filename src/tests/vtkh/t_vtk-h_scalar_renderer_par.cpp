@@ -62,6 +62,51 @@ TEST(vtkh_scalar_renderer, vtkh_parallel_render)
     vtkm::io::VTKDataSetWriter writer("scalar_data.vtk");
     writer.WriteDataSet(result);
   }
+  delete output;
+
+  // render several views at once: the images are composited in batches
+  // and must match rendering each camera on its own
+  std::vector<vtkm::rendering::Camera> cameras;
+  for(int i = 0; i < 3; ++i)
+  {
+    vtkm::rendering::Camera view = camera;
+    view.Azimuth(40.f * i);
+    cameras.push_back(view);
+  }
+
+  vtkh::ScalarRenderer batched;
+  batched.SetInput(&data_set);
+  batched.SetCameras(cameras);
+  batched.SetBatchSize(2);
+  batched.Update();
+  vtkh::DataSet *batched_output = batched.GetOutput();
+  EXPECT_EQ(batched.GetNumberOfCameras(), 3);
+
+  for(int i = 0; i < 3; ++i)
+  {
+    vtkh::ScalarRenderer single;
+    single.SetInput(&data_set);
+    single.SetCamera(cameras[i]);
+    single.Update();
+    vtkh::DataSet *single_output = single.GetOutput();
+
+    if(vtkh::GetMPIRank() == 0)
+    {
+      ASSERT_TRUE(batched_output->HasDomainId(i));
+      vtkm::cont::ArrayHandle<vtkm::Float32> expected, actual;
+      single_output->GetDomain(0).GetField("depth").GetData().AsArrayHandle(expected);
+      batched_output->GetDomainById(i).GetField("depth").GetData().AsArrayHandle(actual);
+      ASSERT_EQ(expected.GetNumberOfValues(), actual.GetNumberOfValues());
+      auto expected_portal = expected.ReadPortal();
+      auto actual_portal = actual.ReadPortal();
+      for(vtkm::Id p = 0; p < expected.GetNumberOfValues(); ++p)
+      {
+        EXPECT_EQ(expected_portal.Get(p), actual_portal.Get(p));
+      }
+    }
+    delete single_output;
+  }
+  delete batched_output;
 
   MPI_Finalize();
 }
@@ -13,7 +13,132 @@
 #include <vtkh/rendering/Scene.hpp>
 #include "t_vtkm_test_utils.hpp"
 
+#include <vtkm/cont/ArrayCopy.h>
+
+#include <cmath>
 #include <iostream>
+#include <set>
+
+namespace
+{
+
+// Copies the coordinates into an explicit array. The slice can not take
+// the structured path for such data and contours it instead.
+vtkm::cont::DataSet ExplicitCoords(const vtkm::cont::DataSet &dom)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopy(dom.GetCoordinateSystem().GetData(), points);
+  vtkm::cont::DataSet res = dom;
+  res.AddCoordinateSystem(vtkm::cont::CoordinateSystem(dom.GetCoordinateSystem().GetName(),
+                                                       points));
+  return res;
+}
+
+// the scalar fields of CreateTestData, for the rectilinear test data
+void AddScalarFields(vtkm::cont::DataSet &dom)
+{
+  auto coords = dom.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  const vtkm::Id num_points = coords.GetNumberOfValues();
+  std::vector<vtkm::Float64> values(num_points);
+  for(vtkm::Id i = 0; i < num_points; ++i)
+  {
+    vtkm::Vec<vtkm::Float64,3> point(coords.Get(i));
+    values[i] = vtkm::Magnitude(point) + 1.;
+  }
+  dom.AddPointField("point_data_Float64", values);
+  dom.AddField(CreateCellScalarField<vtkm::Float64>(dom.GetNumberOfCells(),
+                                                    "cell_data_Float64"));
+}
+
+std::vector<vtkm::Float64> FieldValues(const vtkm::cont::DataSet &dom,
+                                       const std::string &name)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float64> values;
+  vtkm::cont::ArrayCopyShallowIfPossible(dom.GetField(name).GetData(), values);
+  auto portal = values.ReadPortal();
+  std::vector<vtkm::Float64> res(portal.GetNumberOfValues());
+  for(size_t i = 0; i < res.size(); ++i)
+  {
+    res[i] = portal.Get(i);
+  }
+  return res;
+}
+
+// Compares the structured slice of a [0,size]^3 unit grid at x = position
+// with the contoured slice of the same data. Every contour point lies on
+// a point of the structured slice and every triangle in one of its quads.
+void CompareSlices(const vtkm::cont::DataSet &structured,
+                   const vtkm::cont::DataSet &contoured,
+                   const int size,
+                   const vtkm::Float64 position)
+{
+  EXPECT_TRUE(structured.GetCellSet().IsType<vtkm::cont::CellSetStructured<2>>());
+  EXPECT_FALSE(contoured.GetCellSet().IsType<vtkm::cont::CellSetStructured<2>>());
+  ASSERT_EQ(size * size, structured.GetNumberOfCells());
+  ASSERT_EQ(2 * size * size, contoured.GetNumberOfCells());
+
+  const std::vector<vtkm::Float64> s_points = FieldValues(structured, "point_data_Float64");
+  const std::vector<vtkm::Float64> s_cells = FieldValues(structured, "cell_data_Float64");
+  const std::vector<vtkm::Float64> c_points = FieldValues(contoured, "point_data_Float64");
+  const std::vector<vtkm::Float64> c_cells = FieldValues(contoured, "cell_data_Float64");
+  ASSERT_EQ((size_t)((size + 1) * (size + 1)), s_points.size());
+  ASSERT_EQ((size_t)(size * size), s_cells.size());
+
+  auto coords = contoured.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  ASSERT_EQ((size_t)coords.GetNumberOfValues(), c_points.size());
+  for(vtkm::Id i = 0; i < coords.GetNumberOfValues(); ++i)
+  {
+    const vtkm::Vec3f point = coords.Get(i);
+    const int j = static_cast<int>(std::lround(point[1]));
+    const int k = static_cast<int>(std::lround(point[2]));
+    EXPECT_NEAR(position, point[0], 1e-5);
+    EXPECT_NEAR(j, point[1], 1e-5);
+    EXPECT_NEAR(k, point[2], 1e-5);
+    const vtkm::Float64 expected = s_points[j + k * (size + 1)];
+    EXPECT_NEAR(expected, c_points[i], 1e-5 * expected) << "point " << i;
+  }
+
+  const vtkm::cont::CellSet *cells = contoured.GetCellSet().GetCellSetBase();
+  std::vector<int> hits(size * size, 0);
+  for(vtkm::Id c = 0; c < contoured.GetNumberOfCells(); ++c)
+  {
+    ASSERT_EQ(3, cells->GetNumberOfPointsInCell(c));
+    vtkm::Id ids[3];
+    cells->GetCellPointIds(c, ids);
+    vtkm::Float64 y = 0., z = 0.;
+    for(int p = 0; p < 3; ++p)
+    {
+      y += coords.Get(ids[p])[1] / 3.;
+      z += coords.Get(ids[p])[2] / 3.;
+    }
+    const int quad = static_cast<int>(y) + static_cast<int>(z) * size;
+    hits[quad]++;
+    EXPECT_EQ(s_cells[quad], c_cells[c]) << "cell " << c;
+  }
+  for(int q = 0; q < size * size; ++q)
+  {
+    EXPECT_EQ(2, hits[q]) << "quad " << q;
+  }
+}
+
+vtkm::cont::DataSet SliceDomain(const vtkm::cont::DataSet &dom,
+                                const vtkm::Float32 position)
+{
+  vtkh::DataSet data_set;
+  data_set.AddDomain(dom, 0);
+  vtkh::Slice slicer;
+  slicer.AddPlane(vtkm::Vec<vtkm::Float32,3>(position, 0.f, 0.f),
+                  vtkm::Vec<vtkm::Float32,3>(1.f, 0.f, 0.f));
+  slicer.SetInput(&data_set);
+  slicer.Update();
+  vtkh::DataSet *slice = slicer.GetOutput();
+  EXPECT_EQ(1, slice->GetNumberOfDomains());
+  vtkm::cont::DataSet res = slice->GetDomain(0);
+  delete slice;
+  return res;
+}
+
+} // namespace
 
 TEST(vtkh_slice, vtkh_slice)
 {
@@ -112,3 +237,132 @@ TEST(vtkh_slice, vtkh_mulit_slice)
 
   delete slice1;
 }
+
+TEST(vtkh_slice, vtkh_slice_axis_aligned)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  data_set.AddDomain(CreateTestData(0, 1, base_size), 0);
+
+  // uniform data cut along an axis is sliced without contouring
+  vtkh::Slice slicer;
+  slicer.AddPlane(vtkm::Vec<vtkm::Float32,3>(16.5f, 0.f, 0.f),
+                  vtkm::Vec<vtkm::Float32,3>(1.f, 0.f, 0.f));
+  slicer.SetInput(&data_set);
+  slicer.Update();
+  vtkh::DataSet *slice = slicer.GetOutput();
+
+  EXPECT_EQ(1, slice->GetNumberOfDomains());
+  vtkm::cont::DataSet dom = slice->GetDomain(0);
+  EXPECT_TRUE(dom.GetCellSet().IsType<vtkm::cont::CellSetStructured<2>>());
+  EXPECT_EQ(base_size * base_size, dom.GetNumberOfCells());
+  EXPECT_TRUE(dom.HasField("point_data_Float64"));
+  EXPECT_TRUE(dom.HasField("cell_data_Float64"));
+
+  vtkm::Bounds bounds = slice->GetGlobalBounds();
+  EXPECT_NEAR(16.5, bounds.X.Min, 1e-5);
+  EXPECT_NEAR(16.5, bounds.X.Max, 1e-5);
+  delete slice;
+
+  // three axis planes are merged into one triangle domain
+  vtkh::Slice three_slicer;
+  three_slicer.AddPlane(vtkm::Vec<vtkm::Float32,3>(16.5f, 16.5f, 16.5f),
+                        vtkm::Vec<vtkm::Float32,3>(1.f, 0.f, 0.f));
+  three_slicer.AddPlane(vtkm::Vec<vtkm::Float32,3>(16.5f, 16.5f, 16.5f),
+                        vtkm::Vec<vtkm::Float32,3>(0.f, 1.f, 0.f));
+  three_slicer.AddPlane(vtkm::Vec<vtkm::Float32,3>(16.5f, 16.5f, 16.5f),
+                        vtkm::Vec<vtkm::Float32,3>(0.f, 0.f, 1.f));
+  three_slicer.SetInput(&data_set);
+  three_slicer.Update();
+  slice = three_slicer.GetOutput();
+  EXPECT_EQ(1, slice->GetNumberOfDomains());
+  EXPECT_EQ(3 * 2 * base_size * base_size, slice->GetNumberOfCells());
+  delete slice;
+
+  // a plane outside the data produces nothing
+  vtkh::Slice miss;
+  miss.AddPlane(vtkm::Vec<vtkm::Float32,3>(100.f, 0.f, 0.f),
+                vtkm::Vec<vtkm::Float32,3>(.5f, .5f, .5f));
+  miss.SetInput(&data_set);
+  miss.Update();
+  slice = miss.GetOutput();
+  EXPECT_EQ(0, slice->GetGlobalNumberOfCells());
+  delete slice;
+
+  // the structured path matches contouring the same data, on uniform
+  // and rectilinear coordinates
+  vtkm::cont::DataSet uniform = CreateTestData(0, 1, base_size);
+  CompareSlices(SliceDomain(uniform, 16.5f),
+                SliceDomain(ExplicitCoords(uniform), 16.5f),
+                base_size,
+                16.5);
+
+  vtkm::cont::DataSet rectilinear = CreateTestDataRectilinear(0, 1, base_size);
+  AddScalarFields(rectilinear);
+  CompareSlices(SliceDomain(rectilinear, 16.5f),
+                SliceDomain(ExplicitCoords(rectilinear), 16.5f),
+                base_size,
+                16.5);
+
+  // domains the plane misses are culled, for the structured path and
+  // for contouring
+  const int num_blocks = 8;
+  vtkh::DataSet blocks;
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    blocks.AddDomain(CreateTestData(i, num_blocks, 4), i);
+  }
+
+  std::set<vtkm::Id> left;
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    if(blocks.GetDomainBounds(i).X.Max <= 16.)
+    {
+      left.insert(blocks.GetDomainIds()[i]);
+    }
+  }
+  EXPECT_EQ(4u, left.size());
+
+  vtkh::Slice part;
+  part.AddPlane(vtkm::Vec<vtkm::Float32,3>(8.5f, 0.f, 0.f),
+                vtkm::Vec<vtkm::Float32,3>(1.f, 0.f, 0.f));
+  part.SetInput(&blocks);
+  part.Update();
+  slice = part.GetOutput();
+  std::vector<vtkm::Id> ids = slice->GetDomainIds();
+  EXPECT_EQ(left, std::set<vtkm::Id>(ids.begin(), ids.end()));
+  EXPECT_EQ(32 * 32, slice->GetNumberOfCells());
+  delete slice;
+
+  // x + y + z = 6 only crosses the block at the origin
+  vtkh::Slice corner;
+  corner.AddPlane(vtkm::Vec<vtkm::Float32,3>(2.f, 2.f, 2.f),
+                  vtkm::Vec<vtkm::Float32,3>(1.f, 1.f, 1.f));
+  corner.SetInput(&blocks);
+  corner.Update();
+  slice = corner.GetOutput();
+  EXPECT_EQ(1, slice->GetNumberOfDomains());
+  EXPECT_GT(slice->GetNumberOfCells(), 0);
+  for(int i = 0; i < slice->GetNumberOfDomains(); ++i)
+  {
+    vtkm::Id domain_id;
+    vtkm::cont::DataSet dom;
+    slice->GetDomain(i, dom, domain_id);
+    vtkm::Bounds in_bounds;
+    for(int b = 0; b < num_blocks; ++b)
+    {
+      if(blocks.GetDomainIds()[b] == domain_id)
+      {
+        in_bounds = blocks.GetDomainBounds(b);
+      }
+    }
+    EXPECT_EQ(0., in_bounds.X.Min);
+    EXPECT_EQ(0., in_bounds.Y.Min);
+    EXPECT_EQ(0., in_bounds.Z.Min);
+  }
+  delete slice;
+}
@@ -12,8 +12,46 @@
 #include "t_vtkm_test_utils.hpp"
 
 #include <iostream>
+#include <vector>
 #include <mpi.h>
 
+//----------------------------------------------------------------------------
+TEST(vtkh_statistics_par, vtkh_moments_combine)
+{
+  // merging partial moments must match the moments of all values
+  std::vector<double> values;
+  for(int i = 0; i < 100; ++i)
+  {
+    values.push_back(1e6 + (i % 7) * 0.5 + i * 0.01);
+  }
+
+  vtkh::Statistics::Moments all, left, right;
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    vtkh::Statistics::Moments value(values[i]);
+    all = vtkh::Statistics::Moments::Combine(all, value);
+    if(i < 30) left = vtkh::Statistics::Moments::Combine(left, value);
+    else right = vtkh::Statistics::Moments::Combine(value, right);
+  }
+  vtkh::Statistics::Moments merged = vtkh::Statistics::Moments::Combine(left, right);
+
+  double mean = 0.;
+  for(double v : values) mean += v;
+  mean /= double(values.size());
+  double m2 = 0., m4 = 0.;
+  for(double v : values)
+  {
+    m2 += (v - mean) * (v - mean);
+    m4 += (v - mean) * (v - mean) * (v - mean) * (v - mean);
+  }
+
+  EXPECT_EQ(100, merged.n);
+  EXPECT_NEAR(mean, merged.mean, 1e-6);
+  EXPECT_NEAR(m2, merged.M2, 1e-6 * m2);
+  EXPECT_NEAR(m4, merged.M4, 1e-6 * m4);
+  EXPECT_NEAR(all.M2, merged.M2, 1e-6 * m2);
+}
+
 //----------------------------------------------------------------------------
 TEST(vtkh_statistics_par, vtkh_stats)
 {
@@ -43,6 +81,8 @@ TEST(vtkh_statistics_par, vtkh_stats)
   vtkh::Statistics stats;
 
   res = stats.Run(data_set,"point_data_Float64");
+  EXPECT_EQ(data_set.GetGlobalNumberOfCells() > 0, res.count > 0);
+  EXPECT_GE(res.variance, 0.);
 
   if(rank == 0) res.Print(std::cout);
 
@@ -788,6 +788,18 @@ unsigned lodepng_deflate(unsigned char** out, size_t* outsize,
                          const unsigned char* in, size_t insize,
                          const LodePNGCompressSettings* settings);
 
+/*
+Compress one chunk of a larger buffer with deflate. If final_chunk is 0, the
+last block is not marked final and the output is byte aligned (it ends with an
+empty stored block), so the outputs of consecutive chunks, with only the last
+one final, can be concatenated into a single deflate stream. Chunks do not
+reference each other, which allows compressing them independently.
+*/
+unsigned lodepng_deflate_chunk(unsigned char** out, size_t* outsize,
+                               const unsigned char* in, size_t insize,
+                               const LodePNGCompressSettings* settings,
+                               unsigned final_chunk);
+
 #endif /*LODEPNG_COMPILE_ENCODER*/
 #endif /*LODEPNG_COMPILE_ZLIB*/
 